@@ -0,0 +1,501 @@
+#include "BenchmarkSuite.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <dirent.h>
+    #include <sys/stat.h>
+#endif
+
+using namespace cagd;
+using namespace std;
+
+namespace
+{
+    // measured times of a repetition (in nanoseconds per iteration)
+    class Measurement
+    {
+    public:
+        GLuint   iteration_count;
+        GLdouble real_time;
+        GLdouble cpu_time;
+    };
+
+    Measurement measure(const BenchmarkSuite::Body& body, GLuint iteration_count)
+    {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        clock_t cpu_start = clock();
+
+        body(iteration_count);
+
+        clock_t cpu_end = clock();
+        chrono::steady_clock::time_point end = chrono::steady_clock::now();
+
+        Measurement result;
+
+        result.iteration_count = iteration_count;
+        result.real_time       = chrono::duration<GLdouble, nano>(end - start).count() / iteration_count;
+        result.cpu_time        = 1.0e9 * (cpu_end - cpu_start) / CLOCKS_PER_SEC / iteration_count;
+
+        return result;
+    }
+
+    // text of a JSON string literal
+    string quoted(const string& text)
+    {
+        string result = "\"";
+
+        for (string::const_iterator it = text.begin(); it != text.end(); ++it)
+        {
+            switch (*it)
+            {
+            case '"':  result += "\\\""; break;
+            case '\\': result += "\\\\"; break;
+            case '\n': result += "\\n";  break;
+            case '\t': result += "\\t";  break;
+            default:   result += *it;
+            }
+        }
+
+        return result + "\"";
+    }
+
+    string number(GLdouble value)
+    {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "%.10g", value);
+        return buffer;
+    }
+
+    // e.g. 1.23 us
+    string duration(GLdouble nanoseconds)
+    {
+        char buffer[32];
+
+        if (nanoseconds < 1.0e3)
+            snprintf(buffer, sizeof(buffer), "%.1f ns", nanoseconds);
+        else if (nanoseconds < 1.0e6)
+            snprintf(buffer, sizeof(buffer), "%.2f us", 1.0e-3 * nanoseconds);
+        else if (nanoseconds < 1.0e9)
+            snprintf(buffer, sizeof(buffer), "%.2f ms", 1.0e-6 * nanoseconds);
+        else
+            snprintf(buffer, sizeof(buffer), "%.3f s", 1.0e-9 * nanoseconds);
+
+        return buffer;
+    }
+
+    // e.g. 12.3M/s or 4.56GB/s
+    string rate(GLdouble per_second, const char *unit = "")
+    {
+        const char *prefix[] = {"", "k", "M", "G", "T"};
+        GLuint      p = 0;
+
+        while (per_second >= 1.0e3 && p < 4)
+        {
+            per_second *= 1.0e-3;
+            ++p;
+        }
+
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "%.3g%s%s/s", per_second, prefix[p], unit);
+        return buffer;
+    }
+
+    // JSON object of a repetition or of an aggregate
+    string runObject(const string& name, const string& run_name, const string& aggregate_name,
+                     GLuint repetition_count, GLuint repetition_index, const Measurement& m,
+                     GLdouble items_per_iteration, GLdouble bytes_per_iteration,
+                     const BenchmarkSuite::Parameters& parameters)
+    {
+        ostringstream json;
+
+        json << "    {\n"
+             << "      \"name\": " << quoted(name) << ",\n"
+             << "      \"run_name\": " << quoted(run_name) << ",\n"
+             << "      \"run_type\": " << quoted(aggregate_name.empty() ? "iteration" : "aggregate") << ",\n"
+             << "      \"repetitions\": " << repetition_count << ",\n";
+
+        if (aggregate_name.empty())
+            json << "      \"repetition_index\": " << repetition_index << ",\n";
+        else
+            json << "      \"aggregate_name\": " << quoted(aggregate_name) << ",\n";
+
+        json << "      \"threads\": 1,\n"
+             << "      \"iterations\": " << m.iteration_count << ",\n"
+             << "      \"real_time\": " << number(m.real_time) << ",\n"
+             << "      \"cpu_time\": " << number(m.cpu_time) << ",\n"
+             << "      \"time_unit\": \"ns\"";
+
+        if (items_per_iteration > 0.0 && m.real_time > 0.0)
+            json << ",\n      \"items_per_second\": " << number(1.0e9 * items_per_iteration / m.real_time);
+
+        if (bytes_per_iteration > 0.0 && m.real_time > 0.0)
+            json << ",\n      \"bytes_per_second\": " << number(1.0e9 * bytes_per_iteration / m.real_time);
+
+        for (BenchmarkSuite::Parameters::const_iterator it = parameters.begin(); it != parameters.end(); ++it)
+            json << ",\n      " << quoted(it->first) << ": " << quoted(it->second);
+
+        json << "\n    }";
+
+        return json.str();
+    }
+}
+
+// default constructor
+BenchmarkSuite::BenchmarkSuite():
+    _filter(".*"),
+    _minimum_time(0.2),
+    _repetition_count(3),
+    _json_format(GL_FALSE),
+    _list_only(GL_FALSE)
+{
+}
+
+GLboolean BenchmarkSuite::ParseCommandLine(int argc, char **argv, vector<string>& other_arguments)
+{
+    if (argc > 0)
+        _executable = argv[0];
+
+    other_arguments.clear();
+
+    for (int i = 1; i < argc; ++i)
+    {
+        string argument(argv[i]);
+        string::size_type separator = argument.find('=');
+        string option = argument.substr(0, separator);
+        string value  = (separator == string::npos) ? string() : argument.substr(separator + 1);
+
+        if (option == "--benchmark_filter")
+            _filter = value;
+        else if (option == "--benchmark_min_time")
+            _minimum_time = atof(value.c_str());
+        else if (option == "--benchmark_repetitions")
+            _repetition_count = static_cast<GLuint>(max(1, atoi(value.c_str())));
+        else if (option == "--benchmark_format")
+        {
+            if (value != "console" && value != "json")
+                return GL_FALSE;
+
+            _json_format = (value == "json");
+        }
+        else if (option == "--benchmark_out")
+            _output_file_name = value;
+        else if (option == "--benchmark_list_tests")
+            _list_only = (value.empty() || value == "true");
+        else if (option.compare(0, 12, "--benchmark_") == 0)
+            return GL_FALSE;
+        else
+            other_arguments.push_back(argument);
+    }
+
+    try
+    {
+        regex check(_filter);
+    }
+    catch (const regex_error&)
+    {
+        return GL_FALSE;
+    }
+
+    return GL_TRUE;
+}
+
+GLvoid BenchmarkSuite::Register(
+        const string& name, const Parameters& parameters, const Fixture& fixture,
+        GLdouble items_per_iteration, GLdouble bytes_per_iteration)
+{
+    Case c;
+
+    c.name = name;
+
+    for (Parameters::const_iterator it = parameters.begin(); it != parameters.end(); ++it)
+        c.name += "/" + it->first + ":" + it->second;
+
+    c.parameters          = parameters;
+    c.fixture             = fixture;
+    c.items_per_iteration = items_per_iteration;
+    c.bytes_per_iteration = bytes_per_iteration;
+
+    _cases.push_back(c);
+}
+
+FILE* BenchmarkSuite::MessageStream() const
+{
+    return _json_format ? stderr : stdout;
+}
+
+GLboolean BenchmarkSuite::IsListingOnly() const
+{
+    return _list_only;
+}
+
+GLboolean BenchmarkSuite::Run() const
+{
+    regex filter(_filter);
+
+    vector<const Case*> selected;
+
+    for (vector<Case>::const_iterator it = _cases.begin(); it != _cases.end(); ++it)
+        if (regex_search(it->name, filter))
+            selected.push_back(&*it);
+
+    if (_list_only)
+    {
+        for (vector<const Case*>::const_iterator it = selected.begin(); it != selected.end(); ++it)
+            printf("%s\n", (*it)->name.c_str());
+
+        return GL_TRUE;
+    }
+
+    FILE *messages = MessageStream();
+
+    // context of the measurements
+    time_t now = time(nullptr);
+    char   date[64];
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+    ostringstream json;
+
+    json << "{\n"
+         << "  \"context\": {\n"
+         << "    \"date\": " << quoted(date) << ",\n"
+         << "    \"executable\": " << quoted(_executable) << ",\n"
+         << "    \"num_cpus\": " << thread::hardware_concurrency() << ",\n"
+#ifdef _OPENMP
+         << "    \"openmp_threads\": " << omp_get_max_threads() << ",\n"
+#endif
+#ifdef NDEBUG
+         << "    \"library_build_type\": \"release\"\n"
+#else
+         << "    \"library_build_type\": \"debug\"\n"
+#endif
+         << "  },\n"
+         << "  \"benchmarks\": [\n";
+
+    fprintf(messages, "%s, %u logical processors\n", date, thread::hardware_concurrency());
+    // the first column is as wide as the longest selected name
+    GLint name_width = 9;
+
+    for (vector<const Case*>::const_iterator it = selected.begin(); it != selected.end(); ++it)
+        name_width = max(name_width, static_cast<GLint>((*it)->name.size()));
+
+    fprintf(messages, "%-*s %12s %12s %12s %12s\n", name_width, "Benchmark", "Time", "CPU", "Iterations", "Throughput");
+    fprintf(messages, "%s\n", string(name_width + 52, '-').c_str());
+
+    GLboolean success      = GL_TRUE;
+    GLboolean first_object = GL_TRUE;
+
+    for (vector<const Case*>::const_iterator it = selected.begin(); it != selected.end(); ++it)
+    {
+        const Case& c = **it;
+
+        Body body = c.fixture();
+
+        if (!body)
+        {
+            fprintf(messages, "%-*s preparation FAILED\n", name_width, c.name.c_str());
+            success = GL_FALSE;
+            continue;
+        }
+
+        // the iteration count is increased until a run lasts at least the minimum time, these runs also
+        // warm up the caches
+        GLuint iteration_count = 1;
+
+        for (;;)
+        {
+            Measurement m = measure(body, iteration_count);
+
+            GLdouble elapsed = 1.0e-9 * m.real_time * iteration_count;
+
+            if (elapsed >= _minimum_time || iteration_count >= 1000000000u)
+                break;
+
+            GLdouble predicted = 1.4 * _minimum_time / max(1.0e-9 * m.real_time, 1.0e-12);
+
+            iteration_count = static_cast<GLuint>(min(predicted, min(10.0 * iteration_count, 1.0e9)));
+            iteration_count = max(iteration_count, 1u);
+        }
+
+        vector<Measurement> repetitions;
+
+        for (GLuint r = 0; r < _repetition_count; ++r)
+            repetitions.push_back(measure(body, iteration_count));
+
+        // aggregates
+        Measurement mean = {iteration_count, 0.0, 0.0}, median, deviation = {iteration_count, 0.0, 0.0};
+
+        for (vector<Measurement>::const_iterator m = repetitions.begin(); m != repetitions.end(); ++m)
+        {
+            mean.real_time += m->real_time / _repetition_count;
+            mean.cpu_time  += m->cpu_time  / _repetition_count;
+        }
+
+        for (vector<Measurement>::const_iterator m = repetitions.begin(); m != repetitions.end(); ++m)
+        {
+            deviation.real_time += (m->real_time - mean.real_time) * (m->real_time - mean.real_time);
+            deviation.cpu_time  += (m->cpu_time  - mean.cpu_time)  * (m->cpu_time  - mean.cpu_time);
+        }
+
+        if (_repetition_count > 1)
+        {
+            deviation.real_time = sqrt(deviation.real_time / (_repetition_count - 1));
+            deviation.cpu_time  = sqrt(deviation.cpu_time  / (_repetition_count - 1));
+        }
+
+        vector<Measurement> sorted(repetitions);
+
+        sort(sorted.begin(), sorted.end(), [](const Measurement& lhs, const Measurement& rhs) { return lhs.real_time < rhs.real_time; });
+        median = sorted[sorted.size() / 2];
+
+        // console output: the median repetition
+        string throughput;
+
+        if (c.bytes_per_iteration > 0.0)
+            throughput = rate(1.0e9 * c.bytes_per_iteration / median.real_time, "B");
+        else if (c.items_per_iteration > 0.0)
+            throughput = rate(1.0e9 * c.items_per_iteration / median.real_time);
+
+        fprintf(messages, "%-*s %12s %12s %12u %12s\n",
+                name_width, c.name.c_str(), duration(median.real_time).c_str(), duration(median.cpu_time).c_str(),
+                iteration_count, throughput.c_str());
+
+        // JSON output: the repetitions and their aggregates
+        for (GLuint r = 0; r < _repetition_count; ++r)
+        {
+            json << (first_object ? "" : ",\n")
+                 << runObject(c.name, c.name, "", _repetition_count, r, repetitions[r],
+                              c.items_per_iteration, c.bytes_per_iteration, c.parameters);
+            first_object = GL_FALSE;
+        }
+
+        if (_repetition_count > 1)
+        {
+            json << ",\n" << runObject(c.name + "_mean", c.name, "mean", _repetition_count, 0, mean,
+                                       c.items_per_iteration, c.bytes_per_iteration, c.parameters)
+                 << ",\n" << runObject(c.name + "_median", c.name, "median", _repetition_count, 0, median,
+                                       c.items_per_iteration, c.bytes_per_iteration, c.parameters)
+                 << ",\n" << runObject(c.name + "_stddev", c.name, "stddev", _repetition_count, 0, deviation,
+                                       0.0, 0.0, c.parameters);
+        }
+    }
+
+    json << "\n  ]\n}\n";
+
+    fprintf(messages, "\n");
+
+    if (_json_format)
+    {
+        fputs(json.str().c_str(), stdout);
+        fflush(stdout);
+    }
+
+    if (!_output_file_name.empty())
+    {
+        FILE *file = fopen(_output_file_name.c_str(), "w");
+
+        if (!file)
+        {
+            fprintf(messages, "could not write %s\n", _output_file_name.c_str());
+            return GL_FALSE;
+        }
+
+        fputs(json.str().c_str(), file);
+        fclose(file);
+    }
+
+    return success;
+}
+
+GLboolean cagd::FindFiles(const string& directory, const string& extension, vector<string>& file_names)
+{
+    vector<string> directories(1, directory);
+    vector<string> found;
+
+    while (!directories.empty())
+    {
+        string current = directories.back();
+        directories.pop_back();
+
+#ifdef _WIN32
+        WIN32_FIND_DATAA entry;
+        HANDLE handle = FindFirstFileA((current + "\\*").c_str(), &entry);
+
+        if (handle == INVALID_HANDLE_VALUE)
+        {
+            if (current == directory)
+                return GL_FALSE;
+            continue;
+        }
+
+        do
+        {
+            string name(entry.cFileName);
+
+            if (name == "." || name == "..")
+                continue;
+
+            string path = current + "/" + name;
+
+            if (entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+                directories.push_back(path);
+            else if (name.size() >= extension.size() &&
+                     name.compare(name.size() - extension.size(), extension.size(), extension) == 0)
+                found.push_back(path);
+        }
+        while (FindNextFileA(handle, &entry));
+
+        FindClose(handle);
+#else
+        DIR *handle = opendir(current.c_str());
+
+        if (!handle)
+        {
+            if (current == directory)
+                return GL_FALSE;
+            continue;
+        }
+
+        while (dirent *entry = readdir(handle))
+        {
+            string name(entry->d_name);
+
+            if (name == "." || name == "..")
+                continue;
+
+            string path = current + "/" + name;
+
+            struct stat status;
+
+            if (stat(path.c_str(), &status) != 0)
+                continue;
+
+            if (S_ISDIR(status.st_mode))
+                directories.push_back(path);
+            else if (name.size() >= extension.size() &&
+                     name.compare(name.size() - extension.size(), extension.size(), extension) == 0)
+                found.push_back(path);
+        }
+
+        closedir(handle);
+#endif
+    }
+
+    sort(found.begin(), found.end());
+    file_names.swap(found);
+
+    return GL_TRUE;
+}
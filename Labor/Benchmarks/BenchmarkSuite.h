@@ -0,0 +1,88 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cagd
+{
+    //---------------------
+    // class BenchmarkSuite
+    //---------------------
+    // Registry and runner of parameterized micro-benchmarks. The supported command line options and the
+    // layout of the JSON output follow the conventions of Google Benchmark, thus its comparison tools
+    // (e.g. compare.py) can be used for regression tracking:
+    //
+    //   --benchmark_filter=<regex>         runs only the cases the full names of which match the expression
+    //   --benchmark_min_time=<seconds>     minimum duration of a repetition (default: 0.2)
+    //   --benchmark_repetitions=<count>    number of measured repetitions (default: 3)
+    //   --benchmark_format=<console|json>  format of the standard output (default: console)
+    //   --benchmark_out=<file name>        the results are also written into the given JSON file
+    //   --benchmark_list_tests             lists the full names of the cases without running them
+    class BenchmarkSuite
+    {
+    public:
+        // pairs of parameter names and values, the full name of a case is completed by "/name:value"
+        // for each parameter (e.g. CyclicCurve3::GenerateImage/n:8/samples:256)
+        typedef std::vector<std::pair<std::string, std::string> > Parameters;
+
+        // performs the measured work iteration_count times
+        typedef std::function<GLvoid(GLuint iteration_count)> Body;
+
+        // prepares the data of a case right before its measurement and returns its body (the data is
+        // released after the measurement), an empty body indicates that the preparation failed
+        typedef std::function<Body()> Fixture;
+
+    protected:
+        class Case
+        {
+        public:
+            std::string name;
+            Parameters  parameters;
+            Fixture     fixture;
+            GLdouble    items_per_iteration;
+            GLdouble    bytes_per_iteration;
+        };
+
+        std::vector<Case> _cases;
+
+        std::string       _executable;
+        std::string       _filter;
+        GLdouble          _minimum_time;
+        GLuint            _repetition_count;
+        GLboolean         _json_format;
+        GLboolean         _list_only;
+        std::string       _output_file_name;
+
+    public:
+        // default constructor
+        BenchmarkSuite();
+
+        // processes the benchmark options, the remaining arguments (except for the name of the executable)
+        // are returned in other_arguments; returns GL_FALSE if a benchmark option is invalid
+        GLboolean ParseCommandLine(int argc, char **argv, std::vector<std::string>& other_arguments);
+
+        // registers a parameterized case, items_per_iteration and bytes_per_iteration are used for
+        // reporting throughputs (zeros are not reported)
+        GLvoid Register(
+                const std::string& name, const Parameters& parameters, const Fixture& fixture,
+                GLdouble items_per_iteration = 0.0, GLdouble bytes_per_iteration = 0.0);
+
+        // human readable messages have to be printed into this stream: it is the standard error if the
+        // JSON results are written to the standard output, otherwise it is the standard output
+        FILE* MessageStream() const;
+
+        // returns GL_TRUE if --benchmark_list_tests was given
+        GLboolean IsListingOnly() const;
+
+        // measures the selected cases, returns GL_FALSE if a fixture failed or the results could not be written
+        GLboolean Run() const;
+    };
+
+    // collects the names of the files in the given directory and in its subdirectories the names of which
+    // end with the given extension (e.g. ".off"), the file names are sorted
+    GLboolean FindFiles(const std::string& directory, const std::string& extension, std::vector<std::string>& file_names);
+}
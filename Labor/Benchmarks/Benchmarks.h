@@ -0,0 +1,34 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <cstdio>
+#include <string>
+#include "BenchmarkSuite.h"
+
+namespace cagd
+{
+    // registration of the parameterized cases, see ConversionBenchmarks.cpp, MatrixBenchmarks.cpp,
+    // CurveBenchmarks.cpp, SurfaceBenchmarks.cpp and MeshBenchmarks.cpp
+    GLvoid RegisterConversionBenchmarks(BenchmarkSuite& suite);
+    GLvoid RegisterMatrixBenchmarks(BenchmarkSuite& suite);
+    GLvoid RegisterCurveBenchmarks(BenchmarkSuite& suite);
+    GLvoid RegisterSurfaceBenchmarks(BenchmarkSuite& suite);
+    GLvoid RegisterMeshBenchmarks(BenchmarkSuite& suite, const std::string& model_directory);
+
+    // checks whether the optimized code paths reproduce the results of their reference implementations,
+    // the outcomes are printed into the given stream
+    GLboolean CheckConversions(FILE *stream);
+    GLboolean CheckBandedSolver(FILE *stream);
+    GLboolean CheckCachedInterpolation(FILE *stream);
+    GLboolean CheckCyclicImageSynthesis(FILE *stream);
+    GLboolean CheckParametricCurveTemplate(FILE *stream);
+    GLboolean CheckParametricSurfaceTemplate(FILE *stream);
+    GLboolean CheckPackedCurveImages(FILE *stream);
+    GLboolean CheckPackedSurfaceImages(FILE *stream);
+    GLboolean CheckSurfaceInterpolation(FILE *stream);
+    GLboolean CheckParallelMeshLoading(FILE *stream, const std::string& model_directory);
+    GLboolean CheckMeshRegistry(FILE *stream, const std::string& model_directory);
+
+    // formats a parameter value, e.g. 1.5708
+    std::string ToString(GLdouble value);
+}
@@ -0,0 +1,36 @@
+# Console application that measures the performance critical kernels of the framework.
+# It does not need an OpenGL rendering context, therefore it uses neither Qt nor OpenGL: it links only the
+# static library cagd_core of the geometric core (see ../CAGD.pro).
+#
+# The command line options and the JSON output follow Google Benchmark, e.g.
+#   Benchmarks --benchmark_filter=CyclicCurve3 --benchmark_format=json --benchmark_out=results.json
+# runs the cases of cyclic curves and stores their results; see BenchmarkSuite.h for the details.
+TEMPLATE = app
+
+CONFIG += console c++11
+CONFIG -= app_bundle qt
+
+include(../Core/cagd_core.pri)
+
+# models measured by the mesh loading cases (can be overridden by --models=<directory>)
+DEFINES += CAGD_MODELS_DIRECTORY=\\\"$$PWD/../../Models\\\"
+
+msvc {
+    QMAKE_CXXFLAGS += -arch:AVX
+    QMAKE_CXXFLAGS_RELEASE *= -O2
+}
+
+HEADERS += \
+    BenchmarkSuite.h \
+    Benchmarks.h \
+    ../Test/TestFunctions.h
+
+SOURCES += \
+    BenchmarkSuite.cpp \
+    ConversionBenchmarks.cpp \
+    CurveBenchmarks.cpp \
+    MatrixBenchmarks.cpp \
+    MeshBenchmarks.cpp \
+    SurfaceBenchmarks.cpp \
+    main.cpp \
+    ../Test/TestFunctions.cpp
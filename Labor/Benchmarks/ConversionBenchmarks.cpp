@@ -0,0 +1,183 @@
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "../Core/DCoordinates3.h"
+#include "../Core/FloatConversions.h"
+
+using namespace cagd;
+using namespace std;
+
+namespace
+{
+    // 16-byte aligned array of floats (mapped buffer objects are at least 16-byte aligned)
+    class FloatBuffer
+    {
+    private:
+        vector<GLfloat> _storage;
+        GLfloat         *_data;
+
+    public:
+        FloatBuffer(size_t size): _storage(size + 4)
+        {
+            uintptr_t address = reinterpret_cast<uintptr_t>(_storage.data());
+            _data = _storage.data() + ((16 - address % 16) % 16) / sizeof(GLfloat);
+        }
+
+        GLfloat* Data()
+        {
+            return _data;
+        }
+    };
+
+    // random points, derivatives and a destination of their conversion
+    class ConversionData
+    {
+    public:
+        vector<DCoordinate3> point, derivative;
+        FloatBuffer          result;
+
+        ConversionData(GLuint point_count):
+            point(point_count), derivative(point_count), result(6 * point_count)
+        {
+            srand(1);
+
+            for (GLuint i = 0; i < point_count; ++i)
+            {
+                point[i]      = DCoordinate3(rand() / (GLdouble)RAND_MAX, rand() / (GLdouble)RAND_MAX, rand() / (GLdouble)RAND_MAX);
+                derivative[i] = DCoordinate3(rand() / (GLdouble)RAND_MAX, rand() / (GLdouble)RAND_MAX, rand() / (GLdouble)RAND_MAX);
+            }
+        }
+    };
+
+    const GLdouble derivative_scale = 0.25;
+
+    // reference implementations: the component-wise loops that were used before the packed kernels
+    GLvoid convertPoints(const vector<DCoordinate3>& point, GLfloat *coordinate)
+    {
+        for (GLuint i = 0; i < point.size(); ++i)
+        {
+            for (GLuint j = 0; j < 3; ++j)
+            {
+                *coordinate = (GLfloat)point[i][j];
+                ++coordinate;
+            }
+        }
+    }
+
+    GLvoid convertDerivativeEndpoints(const vector<DCoordinate3>& point, const vector<DCoordinate3>& derivative, GLfloat *coordinate)
+    {
+        for (GLuint i = 0; i < point.size(); ++i)
+        {
+            DCoordinate3 sum = point[i];
+            sum += derivative_scale * derivative[i];
+
+            for (GLint j = 0; j < 3; ++j)
+            {
+                *coordinate = (GLfloat)point[i][j];
+                *(coordinate + 3) = (GLfloat)sum[j];
+                ++coordinate;
+            }
+
+            coordinate += 3;
+        }
+    }
+
+    // variants of the measured conversions
+    enum Variant {LOOP, PACKED, NON_TEMPORAL};
+
+    const char *variant_name[] = {"component_wise_loop", "packed", "packed_non_temporal"};
+}
+
+//--------------------------------------------
+// double to float conversion of VBO uploads
+//--------------------------------------------
+GLvoid cagd::RegisterConversionBenchmarks(BenchmarkSuite& suite)
+{
+    const GLuint point_counts[] = {1u << 12, 1u << 20};
+
+    for (GLuint c = 0; c < 2; ++c)
+    {
+        GLuint point_count = point_counts[c];
+
+        for (GLuint variant = LOOP; variant <= NON_TEMPORAL; ++variant)
+        {
+            BenchmarkSuite::Parameters parameters = {
+                {"points",  to_string(point_count)},
+                {"variant", variant_name[variant]}};
+
+            // points: 24 bytes are read and 12 bytes are written per point
+            suite.Register("ConvertToFloat", parameters, [point_count, variant]() -> BenchmarkSuite::Body
+            {
+                shared_ptr<ConversionData> data = make_shared<ConversionData>(point_count);
+
+                return [data, variant](GLuint iteration_count)
+                {
+                    for (GLuint i = 0; i < iteration_count; ++i)
+                    {
+                        if (variant == LOOP)
+                            convertPoints(data->point, data->result.Data());
+                        else
+                            ConvertToFloat(data->point.data(), data->point.size(), data->result.Data(), variant == NON_TEMPORAL);
+                    }
+                };
+            }, point_count, 36.0 * point_count);
+
+            // derivative endpoints: 48 bytes are read and 24 bytes are written per point
+            suite.Register("ConvertDerivativeEndpointsToFloat", parameters, [point_count, variant]() -> BenchmarkSuite::Body
+            {
+                shared_ptr<ConversionData> data = make_shared<ConversionData>(point_count);
+
+                return [data, variant](GLuint iteration_count)
+                {
+                    for (GLuint i = 0; i < iteration_count; ++i)
+                    {
+                        if (variant == LOOP)
+                            convertDerivativeEndpoints(data->point, data->derivative, data->result.Data());
+                        else
+                            ConvertDerivativeEndpointsToFloat(
+                                    data->point.data(), data->derivative.data(), data->point.size(),
+                                    derivative_scale, data->result.Data(), variant == NON_TEMPORAL);
+                    }
+                };
+            }, point_count, 72.0 * point_count);
+        }
+    }
+}
+
+GLboolean cagd::CheckConversions(FILE *stream)
+{
+    GLuint point_count = (1u << 12) + 3;
+
+    ConversionData data(point_count);
+    FloatBuffer    reference(6 * point_count);
+
+    GLboolean identical = GL_TRUE;
+
+    convertPoints(data.point, reference.Data());
+
+    for (GLuint variant = PACKED; variant <= NON_TEMPORAL; ++variant)
+    {
+        ConvertToFloat(data.point.data(), point_count, data.result.Data(), variant == NON_TEMPORAL);
+        identical = identical && equal(reference.Data(), reference.Data() + 3 * point_count, data.result.Data());
+    }
+
+    convertDerivativeEndpoints(data.point, data.derivative, reference.Data());
+
+    for (GLuint variant = PACKED; variant <= NON_TEMPORAL; ++variant)
+    {
+        ConvertDerivativeEndpointsToFloat(
+                data.point.data(), data.derivative.data(), point_count,
+                derivative_scale, data.result.Data(), variant == NON_TEMPORAL);
+        identical = identical && equal(reference.Data(), reference.Data() + 6 * point_count, data.result.Data());
+    }
+
+    fprintf(stream, "results of the packed conversion kernels are %s to the component-wise loops\n",
+            identical ? "identical" : "NOT identical");
+
+    return identical;
+}
@@ -0,0 +1,470 @@
+#include "Benchmarks.h"
+
+#include <cmath>
+#include <memory>
+
+#include "../Core/Constants.h"
+#include "../Cyclic/CyclicCurves3.h"
+#include "../Parametric/ParametricCurves3.h"
+#include "../Test/TestFunctions.h"
+#include "../Trigonometric/SecondOrderTrigonometricArc3.h"
+
+using namespace cagd;
+using namespace std;
+
+namespace
+{
+    // arc the control points of which lie on a helix
+    shared_ptr<SecondOrderTrigonometricArc3> makeArc(GLdouble alpha)
+    {
+        shared_ptr<SecondOrderTrigonometricArc3> arc = make_shared<SecondOrderTrigonometricArc3>(alpha);
+
+        for (GLuint i = 0; i < 4; ++i)
+            (*arc)[i] = DCoordinate3(cos(i * PI / 2.0), sin(i * PI / 2.0), 0.1 * i);
+
+        return arc;
+    }
+
+    // cyclic curve of order n the control points of which lie on a circle
+    shared_ptr<CyclicCurve3> makeCyclicCurve(GLuint n)
+    {
+        shared_ptr<CyclicCurve3> curve = make_shared<CyclicCurve3>(n);
+
+        GLuint dimension = 2 * n + 1;
+
+        for (GLuint i = 0; i < dimension; ++i)
+            (*curve)[i] = DCoordinate3(cos(i * TWO_PI / dimension), sin(i * TWO_PI / dimension), 0.0);
+
+        return curve;
+    }
+
+    // torus knot of the test functions, evaluated by function pointers and by the functor-based template
+    shared_ptr<ParametricCurve3> makeTorusKnot()
+    {
+        RowMatrix<ParametricCurve3::Derivative> derivatives(3);
+
+        derivatives[0] = torus_knot::d0;
+        derivatives[1] = torus_knot::d1;
+        derivatives[2] = torus_knot::d2;
+
+        return make_shared<ParametricCurve3>(derivatives, torus_knot::u_min, torus_knot::u_max);
+    }
+
+    typedef ParametricCurve3T<torus_knot::Derivatives> TorusKnot3T;
+
+    shared_ptr<TorusKnot3T> makeTorusKnotT()
+    {
+        return make_shared<TorusKnot3T>(torus_knot::Derivatives(), torus_knot::u_min, torus_knot::u_max);
+    }
+
+    // uniform knot vector and data points of a cyclic interpolation problem
+    GLvoid makeCyclicInterpolationProblem(
+            GLuint n, ColumnMatrix<GLdouble>& knot_vector, ColumnMatrix<DCoordinate3>& data_points)
+    {
+        GLuint dimension = 2 * n + 1;
+
+        knot_vector.ResizeRows(dimension);
+        data_points.ResizeRows(dimension);
+
+        for (GLuint i = 0; i < dimension; ++i)
+        {
+            knot_vector[i] = i * TWO_PI / dimension;
+            data_points[i] = DCoordinate3(cos(knot_vector[i]), sin(knot_vector[i]), 0.1 * (i % 3));
+        }
+    }
+}
+
+//------------------------------------------------------------
+// evaluation, image generation and interpolation of curves
+//------------------------------------------------------------
+GLvoid cagd::RegisterCurveBenchmarks(BenchmarkSuite& suite)
+{
+    // second order trigonometric arcs
+    const GLdouble alphas[] = {0.5, PI / 2.0, 3.0};
+
+    for (GLuint a = 0; a < 3; ++a)
+    {
+        GLdouble alpha = alphas[a];
+
+        suite.Register("SecondOrderTrigonometricArc3::CalculateDerivatives", {{"alpha", ToString(alpha)}, {"order", "2"}},
+                       [alpha]() -> BenchmarkSuite::Body
+        {
+            shared_ptr<SecondOrderTrigonometricArc3>   arc = makeArc(alpha);
+            shared_ptr<LinearCombination3::Derivatives> d   = make_shared<LinearCombination3::Derivatives>(2);
+
+            return [arc, d, alpha](GLuint iteration_count)
+            {
+                GLdouble step = alpha / iteration_count;
+
+                for (GLuint i = 0; i < iteration_count; ++i)
+                    arc->CalculateDerivatives(2, i * step, *d);
+            };
+        }, 1.0);
+    }
+
+    const GLuint sample_counts[] = {16, 256, 4096};
+
+    for (GLuint s = 0; s < 3; ++s)
+    {
+        GLuint sample_count = sample_counts[s];
+
+        // the blending sums of all samples on a structure of arrays versus the per-sample evaluation
+        for (GLuint packed = 0; packed < 2; ++packed)
+        {
+            suite.Register("SecondOrderTrigonometricArc3::GenerateImage",
+                           {{"order", "2"}, {"samples", to_string(sample_count)}, {"sampling", packed ? "packed" : "per_sample"}},
+                           [packed, sample_count]() -> BenchmarkSuite::Body
+            {
+                shared_ptr<SecondOrderTrigonometricArc3> arc = makeArc(PI / 2.0);
+
+                if (packed)
+                {
+                    return [arc, sample_count](GLuint iteration_count)
+                    {
+                        for (GLuint i = 0; i < iteration_count; ++i)
+                            delete arc->GenerateImage(2, sample_count);
+                    };
+                }
+
+                return [arc, sample_count](GLuint iteration_count)
+                {
+                    for (GLuint i = 0; i < iteration_count; ++i)
+                        delete arc->LinearCombination3::GenerateImage(2, sample_count);
+                };
+            }, sample_count);
+        }
+    }
+
+    // parametric curves: function pointers versus the functor-based template
+    for (GLuint s = 0; s < 3; ++s)
+    {
+        GLuint sample_count = sample_counts[s];
+
+        for (GLuint functor = 0; functor < 2; ++functor)
+        {
+            suite.Register("ParametricCurve3::GenerateImage",
+                           {{"curve", "torus_knot"}, {"evaluator", functor ? "template" : "pointers"}, {"samples", to_string(sample_count)}},
+                           [functor, sample_count]() -> BenchmarkSuite::Body
+            {
+                if (functor)
+                {
+                    shared_ptr<TorusKnot3T> knot = makeTorusKnotT();
+
+                    return [knot, sample_count](GLuint iteration_count)
+                    {
+                        for (GLuint i = 0; i < iteration_count; ++i)
+                            delete knot->GenerateImage(sample_count);
+                    };
+                }
+
+                shared_ptr<ParametricCurve3> knot = makeTorusKnot();
+
+                return [knot, sample_count](GLuint iteration_count)
+                {
+                    for (GLuint i = 0; i < iteration_count; ++i)
+                        delete knot->GenerateImage(sample_count);
+                };
+            }, sample_count);
+        }
+    }
+
+    // cyclic curves
+    const GLuint orders[] = {1, 4, 16};
+
+    for (GLuint o = 0; o < 3; ++o)
+    {
+        GLuint n = orders[o];
+
+        suite.Register("CyclicCurve3::CalculateDerivatives", {{"n", to_string(n)}, {"order", "2"}},
+                       [n]() -> BenchmarkSuite::Body
+        {
+            shared_ptr<CyclicCurve3>                    curve = makeCyclicCurve(n);
+            shared_ptr<LinearCombination3::Derivatives> d     = make_shared<LinearCombination3::Derivatives>(2);
+
+            return [curve, d](GLuint iteration_count)
+            {
+                GLdouble step = TWO_PI / iteration_count;
+
+                for (GLuint i = 0; i < iteration_count; ++i)
+                    curve->CalculateDerivatives(2, i * step, *d);
+            };
+        }, 1.0);
+
+        // the Fourier synthesis of the images versus the inherited per-sample evaluation
+        for (GLuint s = 0; s < 3; ++s)
+        {
+            GLuint sample_count = sample_counts[s];
+
+            for (GLuint fft = 0; fft < 2; ++fft)
+            {
+                suite.Register("CyclicCurve3::GenerateImage",
+                               {{"n", to_string(n)}, {"order", "2"}, {"samples", to_string(sample_count)}, {"sampling", fft ? "fft" : "per_sample"}},
+                               [n, sample_count, fft]() -> BenchmarkSuite::Body
+                {
+                    shared_ptr<CyclicCurve3> curve = makeCyclicCurve(n);
+
+                    return [curve, sample_count, fft](GLuint iteration_count)
+                    {
+                        for (GLuint i = 0; i < iteration_count; ++i)
+                            delete (fft ? curve->GenerateImageByFourierSynthesis(2, sample_count)
+                                        : curve->LinearCombination3::GenerateImage(2, sample_count));
+                    };
+                }, sample_count);
+            }
+        }
+    }
+
+    // interpolation: on a fixed knot vector only the substitutions are performed (the LU decomposition
+    // is cached), while varying knots require the decomposition of a new collocation matrix
+    const GLuint interpolation_orders[] = {4, 16, 64};
+
+    for (GLuint o = 0; o < 3; ++o)
+    {
+        GLuint n = interpolation_orders[o];
+
+        for (GLuint fixed = 0; fixed < 2; ++fixed)
+        {
+            suite.Register("CyclicCurve3::UpdateDataForInterpolation", {{"n", to_string(n)}, {"knots", fixed ? "fixed" : "varying"}},
+                           [n, fixed]() -> BenchmarkSuite::Body
+            {
+                shared_ptr<CyclicCurve3>               curve       = makeCyclicCurve(n);
+                shared_ptr<ColumnMatrix<GLdouble> >     knot_vector = make_shared<ColumnMatrix<GLdouble> >();
+                shared_ptr<ColumnMatrix<DCoordinate3> > data_points = make_shared<ColumnMatrix<DCoordinate3> >();
+
+                makeCyclicInterpolationProblem(n, *knot_vector, *data_points);
+
+                if (!curve->UpdateDataForInterpolation(*knot_vector, *data_points))
+                    return BenchmarkSuite::Body();
+
+                return [curve, knot_vector, data_points, fixed](GLuint iteration_count)
+                {
+                    GLuint dimension = data_points->GetRowCount();
+
+                    for (GLuint i = 0; i < iteration_count; ++i)
+                    {
+                        // a dragged data point or a slightly shifted knot
+                        if (fixed)
+                            (*data_points)[i % dimension][2] += 1.0e-3;
+                        else
+                            (*knot_vector)[0] = (i % 2) ? 1.0e-3 : 0.0;
+
+                        curve->UpdateDataForInterpolation(*knot_vector, *data_points);
+                    }
+                };
+            }, 1.0);
+        }
+    }
+}
+
+//------------------------------------------------------------
+// repeated interpolation on a fixed knot vector
+//------------------------------------------------------------
+// Dragging interpolation points changes only the right-hand sides of the collocation systems, thus
+// after the first call UpdateDataForInterpolation has to reuse the cached LU decomposition. The
+// cached solutions have to coincide with the ones of freshly constructed objects, and changing a
+// shape parameter has to discard the cache.
+GLboolean cagd::CheckCachedInterpolation(FILE *stream)
+{
+    GLboolean identical = GL_TRUE;
+
+    const GLuint orders[] = {16, 64};
+
+    for (GLuint o = 0; o < 2; ++o)
+    {
+        GLuint n = orders[o], dimension = 2 * n + 1;
+
+        ColumnMatrix<GLdouble>     knot_vector;
+        ColumnMatrix<DCoordinate3> data_points;
+
+        makeCyclicInterpolationProblem(n, knot_vector, data_points);
+
+        CyclicCurve3 cached_curve(n);
+
+        for (GLuint moved_point = 0; moved_point < dimension; ++moved_point)
+        {
+            data_points[moved_point][2] += 0.01;
+            cached_curve.UpdateDataForInterpolation(knot_vector, data_points);
+        }
+
+        CyclicCurve3 reference_curve(n);
+        reference_curve.UpdateDataForInterpolation(knot_vector, data_points);
+
+        for (GLuint i = 0; i < dimension; ++i)
+            for (GLuint j = 0; j < 3; ++j)
+                identical = identical && (cached_curve[i][j] == reference_curve[i][j]);
+    }
+
+    // second order trigonometric arcs: a new shape parameter invalidates the cache
+    ColumnMatrix<GLdouble>     arc_knot_vector(4);
+    ColumnMatrix<DCoordinate3> arc_data_points(4);
+
+    for (GLuint i = 0; i < 4; ++i)
+    {
+        arc_knot_vector[i] = i / 3.0;
+        arc_data_points[i] = DCoordinate3(i, i * i, 0.0);
+    }
+
+    SecondOrderTrigonometricArc3 cached_arc(PI / 2.0), reference_arc(1.0);
+
+    cached_arc.UpdateDataForInterpolation(arc_knot_vector, arc_data_points);
+    cached_arc.SetAlpha(1.0);
+    cached_arc.UpdateDataForInterpolation(arc_knot_vector, arc_data_points);
+    reference_arc.UpdateDataForInterpolation(arc_knot_vector, arc_data_points);
+
+    for (GLuint i = 0; i < 4; ++i)
+        for (GLuint j = 0; j < 3; ++j)
+            identical = identical && (cached_arc[i][j] == reference_arc[i][j]);
+
+    fprintf(stream, "cached interpolating solutions are %s to the ones of fresh objects\n",
+            identical ? "identical" : "NOT identical");
+
+    return identical;
+}
+
+//------------------------------------------------------------
+// functor-based parametric curves
+//------------------------------------------------------------
+// ParametricCurve3 accumulates its parameter values step by step, while ParametricCurve3T calculates them
+// directly, therefore the images of the torus knot have to coincide up to rounding errors.
+GLboolean cagd::CheckParametricCurveTemplate(FILE *stream)
+{
+    shared_ptr<ParametricCurve3> pointer_knot = makeTorusKnot();
+    shared_ptr<TorusKnot3T>      knot         = makeTorusKnotT();
+
+    const GLuint point_counts[] = {2, 17, 1000};
+
+    GLboolean success       = GL_TRUE;
+    GLdouble  maximum_error = 0.0;
+
+    for (GLuint p = 0; p < 3; ++p)
+    {
+        unique_ptr<GenericCurve3> image(knot->GenerateImage(point_counts[p]));
+        unique_ptr<GenericCurve3> reference(pointer_knot->GenerateImage(point_counts[p]));
+
+        if (!image || !reference || image->GetMaximumOrderOfDerivatives() != reference->GetMaximumOrderOfDerivatives())
+        {
+            success = GL_FALSE;
+            continue;
+        }
+
+        for (GLuint r = 0; r <= 2; ++r)
+            for (GLuint m = 0; m < point_counts[p]; ++m)
+                maximum_error = max(maximum_error, ((*image)(r, m) - (*reference)(r, m)).length() /
+                                                   max(1.0, (*reference)(r, m).length()));
+    }
+
+    success &= (maximum_error < 1.0e-10);
+
+    fprintf(stream, "images of the torus knot generated by ParametricCurve3T: maximum relative error %.3g %s\n",
+            maximum_error, success ? "" : "FAILED");
+
+    return success;
+}
+
+// The images generated by the packed blending sums of FixedLinearCombination3 have to be identical to the
+// ones of the per-sample evaluation of the base class, since the terms are accumulated in the same order.
+GLboolean cagd::CheckPackedCurveImages(FILE *stream)
+{
+    shared_ptr<SecondOrderTrigonometricArc3> arc = makeArc(PI / 2.0);
+
+    const GLuint point_counts[] = {2, 3, 17, 1000};
+
+    GLboolean identical = GL_TRUE;
+
+    for (GLuint p = 0; p < 4; ++p)
+    {
+        for (GLuint order = 0; order <= 2; ++order)
+        {
+            unique_ptr<GenericCurve3> image(arc->GenerateImage(order, point_counts[p]));
+            unique_ptr<GenericCurve3> reference(arc->LinearCombination3::GenerateImage(order, point_counts[p]));
+
+            if (!image || !reference || image->GetMaximumOrderOfDerivatives() != reference->GetMaximumOrderOfDerivatives())
+            {
+                identical = GL_FALSE;
+                continue;
+            }
+
+            for (GLuint r = 0; r <= order; ++r)
+                for (GLuint m = 0; m < point_counts[p]; ++m)
+                    for (GLuint c = 0; c < 3; ++c)
+                        identical &= ((*image)(r, m)[c] == (*reference)(r, m)[c]);
+        }
+    }
+
+    // orders that are not supported by the fixed blending functions are rejected
+    unique_ptr<GenericCurve3> unsupported(arc->GenerateImage(3, 17));
+
+    identical &= !unsupported;
+
+    fprintf(stream, "images of the second order trigonometric arc generated by packed blending sums are %s to the per-sample ones\n",
+            identical ? "identical" : "NOT identical");
+
+    return identical;
+}
+
+//------------------------------------------------------------
+// Fourier synthesis of the images of cyclic curves
+//------------------------------------------------------------
+// The images of full periods are synthesized by inverse fast Fourier transforms (both of power-of-two and
+// of other sizes): each sample of each derivative has to coincide with the one of the per-sample evaluation
+// up to rounding errors, while definition domains that are not full periods have to be rejected.
+GLboolean cagd::CheckCyclicImageSynthesis(FILE *stream)
+{
+    const GLuint   orders[]         = {1, 2, 5, 16, 40};
+    const GLuint   point_counts[]   = {2, 3, 17, 100, 1025};
+    const GLdouble domains[][2]     = {{0.0, TWO_PI}, {1.0, 1.0 + TWO_PI}, {0.0, PI}};  // the last one is not a period
+    const GLuint   max_order        = 3;
+
+    GLboolean success       = GL_TRUE;
+    GLdouble  maximum_error = 0.0;
+
+    for (GLuint o = 0; o < 5; ++o)
+    {
+        GLuint n = orders[o], dimension = 2 * n + 1;
+
+        CyclicCurve3 curve(n);
+
+        for (GLuint i = 0; i < dimension; ++i)
+            curve[i] = DCoordinate3(cos(i * TWO_PI / dimension) + 0.1 * (i % 3), sin(2.0 * i * TWO_PI / dimension), 0.2 * (i % 5));
+
+        for (GLuint d = 0; d < 3; ++d)
+        {
+            curve.SetDefinitionDomain(domains[d][0], domains[d][1]);
+
+            for (GLuint p = 0; p < 5; ++p)
+            {
+                unique_ptr<GenericCurve3> image(curve.GenerateImageByFourierSynthesis(max_order, point_counts[p]));
+                unique_ptr<GenericCurve3> reference(curve.LinearCombination3::GenerateImage(max_order, point_counts[p]));
+
+                if (!reference || !image != (d == 2))
+                    success = GL_FALSE;
+
+                if (!image || !reference)
+                    continue;
+
+                // the errors are measured relative to the largest derivative of the same order
+                for (GLuint r = 0; r <= max_order; ++r)
+                {
+                    GLdouble scale = 1.0, error = 0.0;
+
+                    for (GLuint m = 0; m < point_counts[p]; ++m)
+                    {
+                        DCoordinate3 difference = (*image)(r, m) - (*reference)(r, m);
+
+                        scale = max(scale, (*reference)(r, m).length());
+                        error = max(error, difference.length());
+                    }
+
+                    maximum_error = max(maximum_error, error / scale);
+                }
+            }
+        }
+    }
+
+    success &= (maximum_error < 1.0e-10);
+
+    fprintf(stream, "Fourier synthesized images of cyclic curves: maximum relative error %.3g %s\n",
+            maximum_error, success ? "" : "FAILED");
+
+    return success;
+}
@@ -0,0 +1,230 @@
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+
+#include "../Core/BandedMatrices.h"
+#include "../Core/RealSquareMatrices.h"
+
+using namespace cagd;
+using namespace std;
+
+namespace
+{
+    // random banded matrix, the diagonal elements are set to zero with the given probability in order to
+    // force row interchanges
+    GLvoid makeBandedSystem(GLuint n, GLuint lower_bandwidth, GLuint upper_bandwidth, GLdouble zero_diagonal_probability,
+                            mt19937& generator, RealSquareMatrix& dense, BandedMatrix& banded)
+    {
+        uniform_real_distribution<GLdouble> element(-1.0, 1.0), probability(0.0, 1.0);
+
+        dense  = RealSquareMatrix(n);
+        banded = BandedMatrix(n, lower_bandwidth, upper_bandwidth);
+
+        for (GLuint i = 0; i < n; ++i)
+        {
+            for (GLuint j = 0; j < n; ++j)
+            {
+                GLboolean in_band = (j + lower_bandwidth >= i && j <= i + upper_bandwidth);
+
+                dense(i, j) = !in_band || (i == j && probability(generator) < zero_diagonal_probability) ?
+                              0.0 : element(generator);
+
+                if (in_band)
+                    banded(i, j) = dense(i, j);
+            }
+        }
+    }
+
+    // largest absolute value of the elements
+    GLdouble maximumNorm(const Matrix<GLdouble>& m)
+    {
+        GLdouble norm = 0.0;
+
+        for (GLuint i = 0; i < m.GetRowCount(); ++i)
+            for (GLuint j = 0; j < m.GetColumnCount(); ++j)
+                norm = max(norm, abs(m(i, j)));
+
+        return norm;
+    }
+
+    // largest absolute difference of two solutions relative to the largest absolute value of the reference
+    GLdouble relativeError(const Matrix<GLdouble>& x, const Matrix<GLdouble>& reference)
+    {
+        GLdouble error = 0.0, norm = 0.0;
+
+        for (GLuint i = 0; i < x.GetRowCount(); ++i)
+        {
+            for (GLuint j = 0; j < x.GetColumnCount(); ++j)
+            {
+                error = max(error, abs(x(i, j) - reference(i, j)));
+                norm  = max(norm, abs(reference(i, j)));
+            }
+        }
+
+        return norm > 0.0 ? error / norm : error;
+    }
+
+    // banded matrix of the given bandwidths with a dominant diagonal, and a single right-hand side
+    class BandedProblem
+    {
+    public:
+        RealSquareMatrix       dense;
+        BandedMatrix           banded;
+        ColumnMatrix<GLdouble> b;
+
+        BandedProblem(GLuint n, GLuint bandwidth): dense(n), banded(n, bandwidth, bandwidth), b(n)
+        {
+            for (GLuint i = 0; i < n; ++i)
+            {
+                b[i] = sin(0.1 * i);
+
+                GLuint first = (i > bandwidth) ? i - bandwidth : 0, last = min(n - 1, i + bandwidth);
+
+                for (GLuint j = first; j <= last; ++j)
+                    banded(i, j) = dense(i, j) = (i == j) ? 2.0 * bandwidth + 1.0 : 1.0 / (1.0 + abs(GLdouble(i) - j));
+            }
+        }
+    };
+}
+
+//------------------------------------------------------------
+// banded and dense linear systems
+//------------------------------------------------------------
+GLvoid cagd::RegisterMatrixBenchmarks(BenchmarkSuite& suite)
+{
+    // each iteration decomposes a copy of the matrix and solves a single system, i.e., the banded solver
+    // needs O(n * b^2) operations, while the dense one needs O(n^3)
+    const GLuint sizes[] = {64, 256, 1024};
+    const GLuint bandwidths[] = {1, 3};
+
+    for (GLuint s = 0; s < 3; ++s)
+    {
+        GLuint n = sizes[s];
+
+        for (GLuint w = 0; w < 2; ++w)
+        {
+            GLuint bandwidth = bandwidths[w];
+
+            for (GLuint solver = 0; solver < 2; ++solver)
+            {
+                suite.Register("BandedMatrix::SolveLinearSystem",
+                               {{"n", to_string(n)}, {"bandwidth", to_string(bandwidth)}, {"solver", solver ? "dense" : "banded"}},
+                               [n, bandwidth, solver]() -> BenchmarkSuite::Body
+                {
+                    shared_ptr<BandedProblem>          problem = make_shared<BandedProblem>(n, bandwidth);
+                    shared_ptr<ColumnMatrix<GLdouble>> x       = make_shared<ColumnMatrix<GLdouble>>(n);
+
+                    if (solver)
+                    {
+                        return [problem, x](GLuint iteration_count)
+                        {
+                            for (GLuint i = 0; i < iteration_count; ++i)
+                            {
+                                RealSquareMatrix dense(problem->dense);
+                                dense.SolveLinearSystem(problem->b, *x);
+                            }
+                        };
+                    }
+
+                    return [problem, x](GLuint iteration_count)
+                    {
+                        for (GLuint i = 0; i < iteration_count; ++i)
+                        {
+                            BandedMatrix banded(problem->banded);
+                            banded.SolveLinearSystem(problem->b, *x);
+                        }
+                    };
+                }, n);
+            }
+        }
+    }
+}
+
+// The banded solver is compared to the dense one on random systems of both layouts, the diagonals of which
+// are often zero, i.e., most of them are solved by row interchanges. Moreover, a system that cannot be solved
+// without a row interchange and a singular system are checked separately.
+GLboolean cagd::CheckBandedSolver(FILE *stream)
+{
+    mt19937 generator(2024);
+
+    GLboolean success = GL_TRUE;
+    GLuint    system_count = 0, singular_system_count = 0;
+    GLdouble  maximum_error = 0.0;
+
+    RealSquareMatrix dense;
+    BandedMatrix     banded;
+
+    for (GLuint n = 8; n < 68; ++n)
+    {
+        for (GLuint lower_bandwidth = 0; lower_bandwidth <= 2; ++lower_bandwidth)
+        {
+            for (GLuint upper_bandwidth = 0; upper_bandwidth <= 2; ++upper_bandwidth)
+            {
+                // zero diagonal elements can be pivoted only if there are sub-diagonals
+                makeBandedSystem(n, lower_bandwidth, upper_bandwidth, lower_bandwidth ? 0.3 : 0.0, generator, dense, banded);
+
+                // the right-hand sides of the row layout are the transposed ones of the column layout
+                Matrix<GLdouble> column_b(n, 3), row_b(3, n);
+                uniform_real_distribution<GLdouble> element(-1.0, 1.0);
+
+                for (GLuint i = 0; i < n; ++i)
+                    for (GLuint k = 0; k < 3; ++k)
+                        row_b(k, i) = column_b(i, k) = element(generator);
+
+                // singular systems are skipped, since the dense solver does not reject all of them; the rounding
+                // errors of numerically singular systems result in huge solutions, which cannot be compared either
+                Matrix<GLdouble> column_x, row_x, column_reference, row_reference;
+
+                if (!banded.SolveLinearSystem(column_b, column_x, GL_TRUE) || maximumNorm(column_x) > 1.0e6)
+                {
+                    ++singular_system_count;
+                    continue;
+                }
+
+                if (!banded.SolveLinearSystem(row_b, row_x, GL_FALSE) ||
+                    !dense.SolveLinearSystem(column_b, column_reference, GL_TRUE) ||
+                    !dense.SolveLinearSystem(row_b, row_reference, GL_FALSE))
+                {
+                    success = GL_FALSE;
+                    continue;
+                }
+
+                maximum_error = max(maximum_error, max(relativeError(column_x, column_reference),
+                                                       relativeError(row_x, row_reference)));
+                ++system_count;
+            }
+        }
+    }
+
+    success &= (system_count > 0 && maximum_error < 1.0e-8);
+
+    // the first pivot is zero, i.e., the first two rows have to be interchanged
+    BandedMatrix swapped(3, 1, 1);
+
+    swapped(0, 1) = 1.0;
+    swapped(1, 0) = 1.0; swapped(1, 1) = 1.0; swapped(1, 2) = 1.0;
+    swapped(2, 1) = 1.0; swapped(2, 2) = 2.0;
+
+    ColumnMatrix<GLdouble> b(3), x;
+
+    b[0] = 2.0; b[1] = 6.0; b[2] = 8.0;
+
+    success &= (swapped.SolveLinearSystem(b, x) &&
+                abs(x[0] - 1.0) < 1.0e-14 && abs(x[1] - 2.0) < 1.0e-14 && abs(x[2] - 3.0) < 1.0e-14);
+
+    // the second column is zero, the singular matrix cannot be decomposed
+    BandedMatrix singular(3, 1, 1);
+
+    singular(0, 0) = 1.0; singular(1, 2) = 1.0; singular(2, 2) = 1.0;
+
+    success &= !singular.PerformLUDecomposition();
+
+    fprintf(stream, "%u random banded systems solved in both layouts (%u singular ones skipped): maximum relative difference "
+            "to the dense solver %.3g, forced row interchange and singular matrix %s\n",
+            system_count, singular_system_count, maximum_error, success ? "handled" : "FAILED");
+
+    return success;
+}
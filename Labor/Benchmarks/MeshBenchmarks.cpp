@@ -0,0 +1,219 @@
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../Core/MeshLoaders.h"
+#include "../Core/MeshRegistries.h"
+#include "../Core/TriangulatedMeshes3.h"
+
+using namespace cagd;
+using namespace std;
+
+//------------------------------------------------------------
+// loading the shipped models
+//------------------------------------------------------------
+// Each OFF file of the model directory (and of its subdirectories) is a separate case, the names of
+// which contain the paths relative to the model directory.
+GLvoid cagd::RegisterMeshBenchmarks(BenchmarkSuite& suite, const string& model_directory)
+{
+    vector<string> file_names;
+
+    if (!FindFiles(model_directory, ".off", file_names))
+    {
+        fprintf(suite.MessageStream(), "the model directory %s could not be read\n", model_directory.c_str());
+        return;
+    }
+
+    for (vector<string>::const_iterator it = file_names.begin(); it != file_names.end(); ++it)
+    {
+        string file_name = *it;
+
+        suite.Register("TriangulatedMesh3::LoadFromOFF", {{"model", file_name.substr(model_directory.size() + 1)}},
+                       [file_name]() -> BenchmarkSuite::Body
+        {
+            shared_ptr<TriangulatedMesh3> mesh = make_shared<TriangulatedMesh3>();
+
+            if (!mesh->LoadFromOFF(file_name, GL_TRUE))
+                return BenchmarkSuite::Body();
+
+            return [mesh, file_name](GLuint iteration_count)
+            {
+                for (GLuint i = 0; i < iteration_count; ++i)
+                    mesh->LoadFromOFF(file_name, GL_TRUE);
+            };
+        });
+    }
+
+    // the whole model directory is loaded by the worker threads of a MeshLoader, the case of a single
+    // worker corresponds to the serial loading of the models
+    vector<MeshLoader::Job> jobs;
+
+    for (GLuint i = 0; i < file_names.size(); ++i)
+        jobs.push_back(MeshLoader::Job(i, file_names[i], GL_TRUE));
+
+    GLuint hardware_thread_count = max(thread::hardware_concurrency(), 1u);
+
+    for (GLuint thread_count = 1; ; thread_count *= 2)
+    {
+        thread_count = min(thread_count, hardware_thread_count);
+
+        suite.Register("MeshLoader", {{"threads", ToString(thread_count)}}, [jobs, thread_count]() -> BenchmarkSuite::Body
+        {
+            return [jobs, thread_count](GLuint iteration_count)
+            {
+                for (GLuint i = 0; i < iteration_count; ++i)
+                {
+                    MeshLoader loader(jobs, thread_count);
+
+                    loader.Wait();
+
+                    vector<MeshLoader::LoadedMesh*> loaded_meshes;
+                    loader.TakeLoadedMeshes(loaded_meshes);
+
+                    for (GLuint m = 0; m < loaded_meshes.size(); ++m)
+                        delete loaded_meshes[m];
+                }
+            };
+        }, static_cast<GLdouble>(jobs.size()));
+
+        if (thread_count == hardware_thread_count)
+            break;
+    }
+}
+
+//------------------------------------------------------------
+// comparing the parallel loading to the serial one
+//------------------------------------------------------------
+GLboolean cagd::CheckParallelMeshLoading(FILE *stream, const string& model_directory)
+{
+    vector<string> file_names;
+
+    if (!FindFiles(model_directory, ".off", file_names) || file_names.empty())
+    {
+        fprintf(stream, "parallel mesh loading could not be checked, since the model directory is empty\n");
+        return GL_TRUE;
+    }
+
+    vector<MeshLoader::Job> jobs;
+
+    for (GLuint i = 0; i < file_names.size(); ++i)
+        jobs.push_back(MeshLoader::Job(i, file_names[i], GL_TRUE));
+
+    // at least four workers are started in order to exercise the lock-free list even on small machines
+    MeshLoader loader(jobs, max(thread::hardware_concurrency(), 4u));
+
+    // the meshes are taken while the workers are running, like the rendering thread does it once per frame
+    vector<MeshLoader::LoadedMesh*> loaded_meshes;
+
+    while (!loader.IsFinished())
+    {
+        loader.TakeLoadedMeshes(loaded_meshes);
+        this_thread::yield();
+    }
+
+    loader.TakeLoadedMeshes(loaded_meshes);
+
+    vector<GLuint> arrival_count(jobs.size(), 0);
+    GLboolean      success = (loaded_meshes.size() == jobs.size());
+
+    for (GLuint m = 0; m < loaded_meshes.size(); ++m)
+    {
+        const MeshLoader::LoadedMesh *loaded = loaded_meshes[m];
+
+        if (loaded->id >= jobs.size() || arrival_count[loaded->id]++)
+        {
+            success = GL_FALSE;
+            continue;
+        }
+
+        TriangulatedMesh3          reference;
+        MeshRegistry::FileIdentity identity;
+        string                     content;
+        GLboolean                  reference_success = reference.LoadFromOFF(file_names[loaded->id], GL_TRUE) &&
+                                                       MeshRegistry::ReadFile(file_names[loaded->id], identity, content);
+
+        success &= (loaded->file_name == file_names[loaded->id] &&
+                    loaded->success == reference_success &&
+                    (!reference_success || (loaded->identity.hash == identity.hash &&
+                                            loaded->identity.byte_size == identity.byte_size)) &&
+                    loaded->mesh.VertexCount() == reference.VertexCount() &&
+                    loaded->mesh.FaceCount() == reference.FaceCount());
+    }
+
+    for (GLuint m = 0; m < loaded_meshes.size(); ++m)
+        delete loaded_meshes[m];
+
+    fprintf(stream, "%u models loaded by %u threads %s the serially loaded ones\n",
+            static_cast<GLuint>(jobs.size()), loader.ThreadCount(), success ? "match" : "DIFFER FROM");
+
+    return success;
+}
+
+//------------------------------------------------------------
+// sharing the models by a registry
+//------------------------------------------------------------
+GLboolean cagd::CheckMeshRegistry(FILE *stream, const string& model_directory)
+{
+    vector<string> file_names;
+
+    if (!FindFiles(model_directory, ".off", file_names) || file_names.size() < 2)
+    {
+        fprintf(stream, "the mesh registry could not be checked, since the model directory has less than two models\n");
+        return GL_TRUE;
+    }
+
+    MeshRegistry registry;
+
+    // different paths of the same file share a single mesh
+    string             file_name = file_names[0], other_path = model_directory + "/." + file_name.substr(model_directory.size());
+    TriangulatedMesh3  *mesh     = registry.Acquire(file_name, GL_TRUE);
+    TriangulatedMesh3  *shared   = registry.Acquire(other_path, GL_TRUE);
+    TriangulatedMesh3  *scaled   = registry.Acquire(file_name, GL_FALSE);
+
+    TriangulatedMesh3  reference;
+    reference.LoadFromOFF(file_name, GL_TRUE);
+
+    GLboolean success = (mesh && mesh == shared && scaled && scaled != mesh &&
+                         registry.MeshCount() == 2 && registry.ReferenceCount(mesh) == 2 &&
+                         mesh->VertexCount() == reference.VertexCount() &&
+                         mesh->FaceCount() == reference.FaceCount());
+
+    // an already loaded mesh is registered only once
+    TriangulatedMesh3          loaded_mesh;
+    MeshRegistry::FileIdentity identity;
+    string                     content;
+    loaded_mesh.LoadFromOFF(file_name, GL_TRUE);
+
+    success &= (MeshRegistry::ReadFile(other_path, identity, content) &&
+                registry.Register(identity, GL_TRUE, std::move(loaded_mesh)) == mesh &&
+                registry.ReferenceCount(mesh) == 3);
+
+    // unreferenced meshes are cached within the budget and the least recently released one is evicted first
+    registry.Release(mesh);
+    registry.Release(mesh);
+    registry.Release(shared);
+    registry.Release(scaled);
+
+    success &= (registry.MeshCount() == 2 && registry.ReferenceCount(mesh) == 0);
+
+    success &= (registry.AcquireIfRegistered(other_path, GL_TRUE) == mesh);
+    registry.Release(mesh);
+
+    registry.SetMemoryBudget(registry.MemoryUsage() - 1);
+
+    success &= (registry.MeshCount() == 1 && !registry.AcquireIfRegistered(file_name, GL_FALSE) &&
+                registry.AcquireIfRegistered(file_name, GL_TRUE) == mesh);
+
+    // referenced meshes are never evicted
+    registry.Clear();
+
+    success &= (registry.MeshCount() == 1 && registry.Release(mesh) &&
+                (registry.Clear(), registry.MeshCount() == 0 && registry.MemoryUsage() == 0));
+
+    fprintf(stream, "the mesh registry %s\n", success ? "shares and evicts the models correctly" : "FAILED");
+
+    return success;
+}
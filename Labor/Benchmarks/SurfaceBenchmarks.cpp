@@ -0,0 +1,425 @@
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+#include "../Core/Constants.h"
+#include "../Core/GridTopologies.h"
+#include "../Core/TensorProductSurfaces3.h"
+#include "../Parametric/ParametricSurfaces3.h"
+#include "../Test/TestFunctions.h"
+#include "../Trigonometric/SecondOrderTrigonometricPatch3.h"
+
+using namespace cagd;
+using namespace std;
+
+namespace
+{
+    // Tensor product surface of the inverse quadratic blending functions F_i(u) = 1 / (1 + 4 (u - i)^2)
+    // and G_j(v) = 1 / (1 + 4 (v - j)^2). At the integer knots their collocation matrices are dense and
+    // strictly diagonally dominant, thus they are suitable for measuring the dense solver on arbitrarily
+    // large interpolation grids.
+    class InverseQuadraticSurface3: public TensorProductSurface3
+    {
+    public:
+        InverseQuadraticSurface3(GLuint row_count, GLuint column_count):
+            TensorProductSurface3(0.0, row_count - 1.0, 0.0, column_count - 1.0, row_count, column_count)
+        {
+        }
+
+        GLboolean UBlendingFunctionValues(GLdouble u_knot, RowMatrix<GLdouble>& blending_values) const
+        {
+            blending_values.ResizeColumns(_data.GetRowCount());
+
+            for (GLuint i = 0; i < _data.GetRowCount(); ++i)
+                blending_values[i] = 1.0 / (1.0 + 4.0 * (u_knot - i) * (u_knot - i));
+
+            return GL_TRUE;
+        }
+
+        GLboolean VBlendingFunctionValues(GLdouble v_knot, RowMatrix<GLdouble>& blending_values) const
+        {
+            blending_values.ResizeColumns(_data.GetColumnCount());
+
+            for (GLuint j = 0; j < _data.GetColumnCount(); ++j)
+                blending_values[j] = 1.0 / (1.0 + 4.0 * (v_knot - j) * (v_knot - j));
+
+            return GL_TRUE;
+        }
+
+        // only surface points are needed by the benchmarks
+        GLboolean CalculatePartialDerivatives(
+                GLuint maximum_order_of_partial_derivatives,
+                GLdouble u, GLdouble v, PartialDerivatives& pd) const
+        {
+            if (maximum_order_of_partial_derivatives)
+                return GL_FALSE;
+
+            RowMatrix<GLdouble> u_blending_values, v_blending_values;
+
+            UBlendingFunctionValues(u, u_blending_values);
+            VBlendingFunctionValues(v, v_blending_values);
+
+            pd.ResizeRows(1);
+            pd.LoadNullVectors();
+
+            for (GLuint i = 0; i < _data.GetRowCount(); ++i)
+            {
+                DCoordinate3 aux;
+
+                for (GLuint j = 0; j < _data.GetColumnCount(); ++j)
+                    Axpy(v_blending_values[j], _data(i, j), aux);
+
+                Axpy(u_blending_values[i], aux, pd(0, 0));
+            }
+
+            return GL_TRUE;
+        }
+    };
+
+    // data of an interpolation problem on an n x n grid of integer knots
+    class GridInterpolationProblem
+    {
+    public:
+        RowMatrix<GLdouble>    u_knot_vector;
+        ColumnMatrix<GLdouble> v_knot_vector;
+        Matrix<DCoordinate3>   data_points;
+
+        GridInterpolationProblem(GLuint n): u_knot_vector(n), v_knot_vector(n), data_points(n, n)
+        {
+            for (GLuint i = 0; i < n; ++i)
+            {
+                u_knot_vector[i] = i;
+                v_knot_vector[i] = i;
+            }
+
+            for (GLuint i = 0; i < n; ++i)
+                for (GLuint j = 0; j < n; ++j)
+                    data_points(i, j) = DCoordinate3(i, j, sin(0.1 * i) * cos(0.1 * j));
+        }
+    };
+
+    // patch the control net of which is a slightly wavy grid
+    shared_ptr<SecondOrderTrigonometricPatch3> makePatch(GLdouble alpha)
+    {
+        shared_ptr<SecondOrderTrigonometricPatch3> patch = make_shared<SecondOrderTrigonometricPatch3>(alpha, alpha);
+
+        for (GLuint i = 0; i < 4; ++i)
+            for (GLuint j = 0; j < 4; ++j)
+                patch->SetData(i, j, i, j, 0.25 * ((i + j) % 3));
+
+        return patch;
+    }
+
+    // torus of the test functions, evaluated by function pointers and optionally by the fused evaluator
+    shared_ptr<ParametricSurface3> makeTorus(GLboolean fused)
+    {
+        TriangularMatrix<ParametricSurface3::PartialDerivative> pd(2);
+
+        pd(0, 0) = torusSurface::d00;
+        pd(1, 0) = torusSurface::d10;
+        pd(1, 1) = torusSurface::d01;
+
+        return make_shared<ParametricSurface3>(pd, torusSurface::u_min, torusSurface::u_max,
+                                               torusSurface::v_min, torusSurface::v_max,
+                                               fused ? torusSurface::fused : nullptr);
+    }
+
+    typedef ParametricSurface3T<torusSurface::Derivatives> TorusSurface3T;
+
+    shared_ptr<TorusSurface3T> makeTorusT()
+    {
+        return make_shared<TorusSurface3T>(torusSurface::Derivatives(), torusSurface::u_min, torusSurface::u_max,
+                                           torusSurface::v_min, torusSurface::v_max);
+    }
+}
+
+//------------------------------------------------------------
+// evaluation, image generation and interpolation of surfaces
+//------------------------------------------------------------
+GLvoid cagd::RegisterSurfaceBenchmarks(BenchmarkSuite& suite)
+{
+    // second order trigonometric patches
+    const GLdouble alphas[] = {0.5, PI / 2.0, 3.0};
+    const GLuint   sample_counts[] = {16, 64, 256};
+
+    for (GLuint a = 0; a < 3; ++a)
+    {
+        GLdouble alpha = alphas[a];
+
+        suite.Register("SecondOrderTrigonometricPatch3::CalculatePartialDerivatives", {{"alpha", ToString(alpha)}, {"order", "2"}},
+                       [alpha]() -> BenchmarkSuite::Body
+        {
+            shared_ptr<SecondOrderTrigonometricPatch3>                pd_patch = makePatch(alpha);
+            shared_ptr<TensorProductSurface3::PartialDerivatives>     pd       = make_shared<TensorProductSurface3::PartialDerivatives>(2);
+
+            return [pd_patch, pd, alpha](GLuint iteration_count)
+            {
+                GLdouble step = alpha / iteration_count;
+
+                for (GLuint i = 0; i < iteration_count; ++i)
+                    pd_patch->CalculatePartialDerivatives(2, i * step, alpha - i * step, *pd);
+            };
+        }, 1.0);
+
+        for (GLuint s = 0; s < 3; ++s)
+        {
+            GLuint sample_count = sample_counts[s];
+
+            // the rows of the grid on structures of arrays versus the per-sample evaluation
+            for (GLuint packed = 0; packed < 2; ++packed)
+            {
+                suite.Register("SecondOrderTrigonometricPatch3::GenerateImage",
+                               {{"alpha", ToString(alpha)}, {"samples", to_string(sample_count)}, {"sampling", packed ? "packed" : "per_sample"}},
+                               [alpha, packed, sample_count]() -> BenchmarkSuite::Body
+                {
+                    shared_ptr<SecondOrderTrigonometricPatch3> patch = makePatch(alpha);
+
+                    if (packed)
+                    {
+                        return [patch, sample_count](GLuint iteration_count)
+                        {
+                            for (GLuint i = 0; i < iteration_count; ++i)
+                                delete patch->GenerateImage(sample_count, sample_count);
+                        };
+                    }
+
+                    return [patch, sample_count](GLuint iteration_count)
+                    {
+                        for (GLuint i = 0; i < iteration_count; ++i)
+                            delete patch->TensorProductSurface3::GenerateImage(sample_count, sample_count);
+                    };
+                }, sample_count * sample_count);
+            }
+        }
+
+        for (GLuint fixed = 0; fixed < 2; ++fixed)
+        {
+            suite.Register("SecondOrderTrigonometricPatch3::UpdateDataForInterpolation", {{"alpha", ToString(alpha)}, {"knots", fixed ? "fixed" : "varying"}},
+                           [alpha, fixed]() -> BenchmarkSuite::Body
+            {
+                shared_ptr<SecondOrderTrigonometricPatch3> patch = makePatch(alpha);
+                shared_ptr<GridInterpolationProblem>       problem = make_shared<GridInterpolationProblem>(4);
+
+                for (GLuint i = 0; i < 4; ++i)
+                {
+                    problem->u_knot_vector[i] = i * alpha / 3.0;
+                    problem->v_knot_vector[i] = i * alpha / 3.0;
+                }
+
+                if (!patch->UpdateDataForInterpolation(problem->u_knot_vector, problem->v_knot_vector, problem->data_points))
+                    return BenchmarkSuite::Body();
+
+                return [patch, problem, fixed](GLuint iteration_count)
+                {
+                    for (GLuint i = 0; i < iteration_count; ++i)
+                    {
+                        if (fixed)
+                            problem->data_points(i % 4, (i / 4) % 4)[2] += 1.0e-3;
+                        else
+                            problem->u_knot_vector[0] = (i % 2) ? 1.0e-3 : 0.0;
+
+                        patch->UpdateDataForInterpolation(problem->u_knot_vector, problem->v_knot_vector, problem->data_points);
+                    }
+                };
+            }, 1.0);
+        }
+    }
+
+    // Large dense interpolation grids: the fixtures decompose the collocation matrices, thus the
+    // measured iterations (with modified data points) consist only of the substitutions of steps 3
+    // and 4 of TensorProductSurface3::UpdateDataForInterpolation.
+    const GLuint grid_sizes[] = {256, 1024};
+
+#ifdef _OPENMP
+    GLint maximum_thread_count = omp_get_max_threads();
+#else
+    GLint maximum_thread_count = 1;
+#endif
+
+    for (GLuint g = 0; g < 2; ++g)
+    {
+        GLuint n = grid_sizes[g];
+
+        for (GLint thread_count = 1; thread_count <= maximum_thread_count;
+             thread_count = (thread_count == maximum_thread_count) ? thread_count + 1 : maximum_thread_count)
+        {
+            suite.Register("TensorProductSurface3::UpdateDataForInterpolation", {{"grid", to_string(n)}, {"threads", to_string(thread_count)}},
+                           [n, thread_count]() -> BenchmarkSuite::Body
+            {
+                shared_ptr<InverseQuadraticSurface3> surface = make_shared<InverseQuadraticSurface3>(n, n);
+                shared_ptr<GridInterpolationProblem> problem = make_shared<GridInterpolationProblem>(n);
+
+                if (!surface->UpdateDataForInterpolation(problem->u_knot_vector, problem->v_knot_vector, problem->data_points))
+                    return BenchmarkSuite::Body();
+
+                return [surface, problem, n, thread_count](GLuint iteration_count)
+                {
+                #ifdef _OPENMP
+                    GLint previous_thread_count = omp_get_max_threads();
+                    omp_set_num_threads(thread_count);
+                #endif
+
+                    for (GLuint i = 0; i < iteration_count; ++i)
+                    {
+                        problem->data_points(i % n, (7 * i) % n)[2] += 0.01;
+                        surface->UpdateDataForInterpolation(problem->u_knot_vector, problem->v_knot_vector, problem->data_points);
+                    }
+
+                #ifdef _OPENMP
+                    omp_set_num_threads(previous_thread_count);
+                #endif
+                };
+            }, static_cast<GLdouble>(n) * n);
+        }
+    }
+
+    // parametric surfaces: function pointers, the fused evaluator and the functor-based template
+    const char *evaluators[] = {"pointers", "fused", "template"};
+
+    for (GLuint s = 0; s < 3; ++s)
+    {
+        GLuint sample_count = sample_counts[s];
+
+        for (GLuint e = 0; e < 3; ++e)
+        {
+            suite.Register("ParametricSurface3::GenerateImage", {{"surface", "torus"}, {"evaluator", evaluators[e]}, {"samples", to_string(sample_count)}},
+                           [e, sample_count]() -> BenchmarkSuite::Body
+            {
+                if (e == 2)
+                {
+                    shared_ptr<TorusSurface3T> torus = makeTorusT();
+
+                    return [torus, sample_count](GLuint iteration_count)
+                    {
+                        for (GLuint i = 0; i < iteration_count; ++i)
+                            delete torus->GenerateImage(sample_count, sample_count);
+                    };
+                }
+
+                shared_ptr<ParametricSurface3> torus = makeTorus(e == 1);
+
+                return [torus, sample_count](GLuint iteration_count)
+                {
+                    for (GLuint i = 0; i < iteration_count; ++i)
+                        delete torus->GenerateImage(sample_count, sample_count);
+                };
+            }, sample_count * sample_count);
+        }
+    }
+}
+
+//------------------------------------------------------------
+// interpolation by large tensor product surfaces
+//------------------------------------------------------------
+// The blocked and multithreaded substitutions have to satisfy the interpolation conditions.
+GLboolean cagd::CheckSurfaceInterpolation(FILE *stream)
+{
+    GLuint n = 256;
+
+    GridInterpolationProblem problem(n);
+    InverseQuadraticSurface3 surface(n, n);
+
+    if (!surface.UpdateDataForInterpolation(problem.u_knot_vector, problem.v_knot_vector, problem.data_points))
+    {
+        fprintf(stream, "interpolation of a %u x %u grid FAILED\n", n, n);
+        return GL_FALSE;
+    }
+
+    GLdouble                                  largest_error = 0.0;
+    TensorProductSurface3::PartialDerivatives pd(0);
+
+    for (GLuint k = 0; k < n; k += n / 16)
+    {
+        for (GLuint l = 0; l < n; l += n / 16)
+        {
+            surface.CalculatePartialDerivatives(0, k, l, pd);
+
+            DCoordinate3 error = pd(0, 0) - problem.data_points(k, l);
+
+            largest_error = max(largest_error, error.length() / (1.0 + problem.data_points(k, l).length()));
+        }
+    }
+
+    GLboolean success = (largest_error < 1.0e-10);
+
+    fprintf(stream, "largest relative error of a %u x %u grid interpolation at sampled knots: %e %s\n",
+            n, n, largest_error, success ? "" : "FAILED");
+
+    return success;
+}
+
+//------------------------------------------------------------
+// functor-based parametric surfaces
+//------------------------------------------------------------
+// The images of the torus generated by the template ParametricSurface3T have to be identical to the ones
+// generated by the function pointers and by the fused evaluator of ParametricSurface3.
+GLboolean cagd::CheckParametricSurfaceTemplate(FILE *stream)
+{
+    GLboolean identical = GL_TRUE, shared = GL_TRUE;
+
+    shared_ptr<ParametricSurface3> pointer_torus = makeTorus(GL_FALSE), fused_torus = makeTorus(GL_TRUE);
+    shared_ptr<TorusSurface3T>     torus         = makeTorusT();
+
+    const GLuint sample_counts[] = {2, 17, 100};
+
+    for (GLuint s = 0; s < 3; ++s)
+    {
+        GLuint sample_count = sample_counts[s];
+
+        unique_ptr<TriangulatedMesh3> image(torus->GenerateImage(sample_count, sample_count + 1));
+        unique_ptr<TriangulatedMesh3> pointer_image(pointer_torus->GenerateImage(sample_count, sample_count + 1));
+        unique_ptr<TriangulatedMesh3> fused_image(fused_torus->GenerateImage(sample_count, sample_count + 1));
+
+        identical = identical && image && pointer_image && fused_image &&
+                    image->HasIdenticalGeometry(*pointer_image) && image->HasIdenticalGeometry(*fused_image);
+
+        // the three images share a single face list
+        shared = shared && image && GridTopologyCache::GridCount() == 1 &&
+                 image->FaceCount() == 2 * (sample_count - 1) * sample_count;
+    }
+
+    // the face lists are released together with the last images
+    shared = shared && GridTopologyCache::GridCount() == 0;
+
+    fprintf(stream, "images of the torus generated by ParametricSurface3T are %s to the ones of ParametricSurface3, "
+            "their grid face lists are %s\n",
+            identical ? "identical" : "NOT identical", shared ? "shared and released" : "NOT shared or NOT released");
+
+    return identical && shared;
+}
+
+// The images generated by the packed rows of FixedTensorProductSurface3 have to be identical to the ones of
+// the per-sample evaluation of the base class, since the terms are accumulated in the same order.
+GLboolean cagd::CheckPackedSurfaceImages(FILE *stream)
+{
+    const GLdouble alphas[]        = {PI / 3.0, PI / 2.0};
+    const GLuint   sample_counts[] = {2, 3, 17, 100};
+
+    GLboolean identical = GL_TRUE;
+
+    for (GLuint a = 0; a < 2; ++a)
+    {
+        shared_ptr<SecondOrderTrigonometricPatch3> patch = makePatch(alphas[a]);
+
+        for (GLuint s = 0; s < 4; ++s)
+        {
+            GLuint sample_count = sample_counts[s];
+
+            unique_ptr<TriangulatedMesh3> image(patch->GenerateImage(sample_count, sample_count + 1));
+            unique_ptr<TriangulatedMesh3> reference(patch->TensorProductSurface3::GenerateImage(sample_count, sample_count + 1));
+
+            identical = identical && image && reference && image->HasIdenticalGeometry(*reference);
+        }
+    }
+
+    fprintf(stream, "images of the second order trigonometric patch generated by packed rows are %s to the per-sample ones\n",
+            identical ? "identical" : "NOT identical");
+
+    return identical;
+}
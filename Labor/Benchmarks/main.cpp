@@ -0,0 +1,365 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmarks.h"
+#include "../Core/Constants.h"
+#include "../Core/Profilers.h"
+#include "../Cyclic/CyclicCurves3.h"
+#include "../Trigonometric/SecondOrderTrigonometricArc3.h"
+#include "../Trigonometric/SecondOrderTrigonometricPatch3.h"
+
+using namespace cagd;
+using namespace std;
+
+namespace
+{
+    // number of dynamic memory allocations performed by the process so far
+    size_t allocation_count = 0;
+}
+
+//--------------------------------------------------------------------
+// replaced global allocation functions that count the allocations
+//--------------------------------------------------------------------
+void* operator new(size_t size)
+{
+    ++allocation_count;
+
+    if (GLvoid *pointer = malloc(size ? size : 1))
+        return pointer;
+
+    throw bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const nothrow_t&) noexcept
+{
+    ++allocation_count;
+    return malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const nothrow_t& tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+void operator delete(void *pointer) noexcept
+{
+    free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    free(pointer);
+}
+
+void operator delete(void *pointer, const nothrow_t&) noexcept
+{
+    free(pointer);
+}
+
+void operator delete[](void *pointer, const nothrow_t&) noexcept
+{
+    free(pointer);
+}
+
+namespace
+{
+    //--------------------------------------------
+    // heap allocations of steady-state evaluation
+    //--------------------------------------------
+    template <typename Function>
+    size_t CountAllocations(Function function)
+    {
+        size_t before = allocation_count;
+        function();
+        return allocation_count - before;
+    }
+
+    GLboolean Expect(FILE *stream, const char *name, size_t allocations, size_t expected_allocations)
+    {
+        GLboolean success = (allocations == expected_allocations);
+
+        fprintf(stream, "%-72s %8u allocations %s\n", name, (GLuint)allocations, success ? "" : "FAILED");
+
+        return success;
+    }
+
+    // Evaluators that reuse their output objects have to be allocation-free, while the number of
+    // allocations performed by the image generators must not depend on the number of samples.
+    GLboolean CheckSteadyStateAllocations(FILE *stream, GLuint sample_count)
+    {
+        fprintf(stream, "heap allocations of %u steady-state evaluations\n", sample_count);
+
+        GLboolean success = GL_TRUE;
+
+        // second order trigonometric arc
+        SecondOrderTrigonometricArc3 arc(PI / 2.0);
+
+        for (GLuint i = 0; i < 4; ++i)
+            arc[i] = DCoordinate3(cos(i * PI / 2.0), sin(i * PI / 2.0), 0.1 * i);
+
+        LinearCombination3::Derivatives d(2);
+        RowMatrix<GLdouble>             blending_values;
+
+        arc.CalculateDerivatives(2, 0.0, d);
+        arc.BlendingFunctionValues(0.0, blending_values);
+
+        GLdouble u_step = (PI / 2.0) / (sample_count - 1);
+
+        success &= Expect(stream, "SecondOrderTrigonometricArc3::CalculateDerivatives", CountAllocations([&]()
+        {
+            for (GLuint i = 0; i < sample_count; ++i)
+                arc.CalculateDerivatives(2, i * u_step, d);
+        }), 0);
+
+        success &= Expect(stream, "SecondOrderTrigonometricArc3::BlendingFunctionValues", CountAllocations([&]()
+        {
+            for (GLuint i = 0; i < sample_count; ++i)
+                arc.BlendingFunctionValues(i * u_step, blending_values);
+        }), 0);
+
+        // cyclic curve
+        CyclicCurve3 cyclic_curve(3);
+
+        for (GLuint i = 0; i < 7; ++i)
+            cyclic_curve[i] = DCoordinate3(cos(i * TWO_PI / 7.0), sin(i * TWO_PI / 7.0), 0.0);
+
+        cyclic_curve.CalculateDerivatives(2, 0.0, d);
+        cyclic_curve.BlendingFunctionValues(0.0, blending_values);
+
+        u_step = TWO_PI / (sample_count - 1);
+
+        success &= Expect(stream, "CyclicCurve3::CalculateDerivatives", CountAllocations([&]()
+        {
+            for (GLuint i = 0; i < sample_count; ++i)
+                cyclic_curve.CalculateDerivatives(2, i * u_step, d);
+        }), 0);
+
+        success &= Expect(stream, "CyclicCurve3::BlendingFunctionValues", CountAllocations([&]()
+        {
+            for (GLuint i = 0; i < sample_count; ++i)
+                cyclic_curve.BlendingFunctionValues(i * u_step, blending_values);
+        }), 0);
+
+        // second order trigonometric patch
+        SecondOrderTrigonometricPatch3 patch(1.0, 1.0);
+
+        for (GLuint i = 0; i < 4; ++i)
+            for (GLuint j = 0; j < 4; ++j)
+                patch.SetData(i, j, i, j, 0.25 * ((i + j) % 3));
+
+        TensorProductSurface3::PartialDerivatives                  pd(2);
+        SecondOrderTrigonometricPatch3::FixedPartialDerivatives    fixed_pd;
+
+        patch.CalculatePartialDerivatives(2, 0.0, 0.0, pd);
+
+        GLdouble step = 1.0 / (sample_count - 1);
+
+        success &= Expect(stream, "SecondOrderTrigonometricPatch3::CalculatePartialDerivatives", CountAllocations([&]()
+        {
+            for (GLuint i = 0; i < sample_count; ++i)
+                patch.CalculatePartialDerivatives(2, i * step, 1.0 - i * step, pd);
+        }), 0);
+
+        success &= Expect(stream, "SecondOrderTrigonometricPatch3::CalculateFixedPartialDerivatives", CountAllocations([&]()
+        {
+            for (GLuint i = 0; i < sample_count; ++i)
+                patch.CalculateFixedPartialDerivatives(2, i * step, 1.0 - i * step, fixed_pd);
+        }), 0);
+
+        // image generators: the first calls warm up the lazily allocated objects, the face list of a grid
+        // is allocated at once and released together with the image
+        delete arc.GenerateImage(2, 16);
+        delete patch.GenerateImage(16, 16);
+        delete patch.GenerateImage(128, 128);
+
+        success &= Expect(stream, "SecondOrderTrigonometricArc3::GenerateImage, 16 vs 1024 samples",
+                          CountAllocations([&]() { delete arc.GenerateImage(2, 1024); }),
+                          CountAllocations([&]() { delete arc.GenerateImage(2, 16); }));
+
+        success &= Expect(stream, "CyclicCurve3::GenerateImage, 16 vs 1024 samples",
+                          CountAllocations([&]() { delete cyclic_curve.GenerateImage(2, 1024); }),
+                          CountAllocations([&]() { delete cyclic_curve.GenerateImage(2, 16); }));
+
+        success &= Expect(stream, "SecondOrderTrigonometricPatch3::GenerateImage, 16^2 vs 128^2 samples",
+                          CountAllocations([&]() { delete patch.GenerateImage(128, 128); }),
+                          CountAllocations([&]() { delete patch.GenerateImage(16, 16); }));
+
+        return success;
+    }
+
+    //---------
+    // profiler
+    //---------
+    // Several threads record more events than the capacity of a profiler: recording has to be allocation-free,
+    // the last Capacity() events have to be kept, and each of them has to be exported into the trace.
+    GLboolean CheckProfiler(FILE *stream)
+    {
+        const GLuint thread_count = 4, event_count = 1 << 14;
+
+        Profiler profiler(1 << 12);
+
+        // the index of the calling thread is assigned by its first event
+        profiler.Record("warm-up", Profiler::Now(), Profiler::Now());
+
+        GLboolean success = Expect(stream, "Profiler::Record", CountAllocations([&]()
+        {
+            for (GLuint i = 0; i < event_count; ++i)
+            {
+                unsigned long long begin = Profiler::Now();
+                profiler.Record("main", begin, Profiler::Now());
+            }
+        }), 0);
+
+        vector<thread> threads;
+
+        for (GLuint t = 0; t < thread_count; ++t)
+        {
+            threads.push_back(thread([&profiler, t]()
+            {
+                const char *zones[2] = {"even", "odd"};
+
+                for (GLuint i = 0; i < event_count; ++i)
+                {
+                    unsigned long long begin = Profiler::Now();
+                    profiler.Record(zones[t % 2], begin, Profiler::Now());
+                }
+            }));
+        }
+
+        for (GLuint t = 0; t < thread_count; ++t)
+            threads[t].join();
+
+        vector<Profiler::ZoneStatistics> statistics;
+        profiler.CalculateStatistics(statistics);
+
+        GLuint recorded_event_count = 0;
+
+        for (GLuint i = 0; i < statistics.size(); ++i)
+        {
+            recorded_event_count += statistics[i].sample_count;
+
+            // the average may exceed the 99th percentile due to a few preempted events
+            success &= (statistics[i].minimum <= statistics[i].average &&
+                        statistics[i].minimum <= statistics[i].percentile_99) ? GL_TRUE : GL_FALSE;
+        }
+
+        success &= (recorded_event_count == profiler.Capacity()) ? GL_TRUE : GL_FALSE;
+
+        // each exported event is a complete event
+        string file_name = "cagd_profiler_check.json";
+
+        GLuint exported_event_count = 0;
+
+        if (profiler.ExportChromeTrace(file_name))
+        {
+            if (FILE *file = fopen(file_name.c_str(), "r"))
+            {
+                char line[512];
+
+                while (fgets(line, sizeof(line), file))
+                    if (strstr(line, "\"ph\": \"X\""))
+                        ++exported_event_count;
+
+                fclose(file);
+            }
+
+            remove(file_name.c_str());
+        }
+
+        success &= (exported_event_count == recorded_event_count) ? GL_TRUE : GL_FALSE;
+
+        fprintf(stream, "the last %u of %u events recorded by %u threads are kept and exported %s\n",
+                exported_event_count, thread_count * event_count, thread_count, success ? "" : "FAILED");
+
+        profiler.Clear();
+        profiler.CalculateStatistics(statistics);
+
+        if (!statistics.empty())
+        {
+            fprintf(stream, "the cleared profiler still has events FAILED\n");
+            success = GL_FALSE;
+        }
+
+        return success;
+    }
+
+    // default location of the shipped models (qmake defines the absolute path of the source tree)
+#ifdef CAGD_MODELS_DIRECTORY
+    const char *default_model_directory = CAGD_MODELS_DIRECTORY;
+#else
+    const char *default_model_directory = "../../Models";
+#endif
+}
+
+string cagd::ToString(GLdouble value)
+{
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%g", value);
+    return buffer;
+}
+
+// Besides the options of BenchmarkSuite, the directory of the measured OFF files can be given by
+// --models=<directory>. After the measurements the optimized code paths are compared to their
+// reference implementations; the exit code is non-zero if any of these checks fails.
+int main(int argc, char **argv)
+{
+    BenchmarkSuite suite;
+    vector<string> other_arguments;
+
+    if (!suite.ParseCommandLine(argc, argv, other_arguments))
+        return 2;
+
+    string model_directory = default_model_directory;
+
+    for (GLuint i = 0; i < other_arguments.size(); ++i)
+    {
+        if (other_arguments[i].compare(0, 9, "--models=") == 0)
+            model_directory = other_arguments[i].substr(9);
+        else
+        {
+            fprintf(stderr, "unknown argument: %s\n", other_arguments[i].c_str());
+            return 2;
+        }
+    }
+
+    RegisterConversionBenchmarks(suite);
+    RegisterMatrixBenchmarks(suite);
+    RegisterCurveBenchmarks(suite);
+    RegisterSurfaceBenchmarks(suite);
+    RegisterMeshBenchmarks(suite, model_directory);
+
+    GLboolean success = suite.Run();
+
+    if (suite.IsListingOnly())
+        return success ? 0 : 1;
+
+    FILE *stream = suite.MessageStream();
+
+    fprintf(stream, "\n");
+    success &= CheckConversions(stream);
+    success &= CheckBandedSolver(stream);
+    success &= CheckSteadyStateAllocations(stream, 1 << 16);
+    success &= CheckProfiler(stream);
+    success &= CheckCachedInterpolation(stream);
+    success &= CheckCyclicImageSynthesis(stream);
+    success &= CheckParametricCurveTemplate(stream);
+    success &= CheckParametricSurfaceTemplate(stream);
+    success &= CheckPackedCurveImages(stream);
+    success &= CheckPackedSurfaceImages(stream);
+    success &= CheckSurfaceInterpolation(stream);
+    success &= CheckParallelMeshLoading(stream, model_directory);
+    success &= CheckMeshRegistry(stream, model_directory);
+
+    return success ? 0 : 1;
+}
@@ -0,0 +1,23 @@
+# Builds the whole framework:
+#   - cagd_core:   static library of the pure CPU geometric core (Core, Cyclic, Parametric, Trigonometric),
+#   - cagd_gpu:    static library of the GPU-resource layer (buffer objects, lights, materials, shaders),
+#   - application: the Qt application, it links both libraries,
+#   - benchmarks:  the console benchmarks, they link only the core and do not need OpenGL,
+#   - render_benchmarks: the offscreen rendering benchmarks of the race and surface pages.
+TEMPLATE = subdirs
+
+SUBDIRS = cagd_core cagd_gpu application benchmarks render_benchmarks
+
+cagd_core.file      = Core/cagd_core.pro
+
+cagd_gpu.file       = GPU/cagd_gpu.pro
+cagd_gpu.depends    = cagd_core
+
+application.file    = QtFramework.pro
+application.depends = cagd_core cagd_gpu
+
+benchmarks.subdir   = Benchmarks
+benchmarks.depends  = cagd_core
+
+render_benchmarks.subdir  = RenderBenchmarks
+render_benchmarks.depends = cagd_core cagd_gpu
@@ -0,0 +1,167 @@
+#include "BandedMatrices.h"
+
+#include <cmath>
+
+using namespace cagd;
+using namespace std;
+
+//-------------------------------------
+// implementation of class BandedMatrix
+//-------------------------------------
+
+// special/default constructor
+BandedMatrix::BandedMatrix(GLuint size, GLuint lower_bandwidth, GLuint upper_bandwidth):
+        _size(size),
+        _lower_bandwidth(lower_bandwidth),
+        _upper_bandwidth(upper_bandwidth),
+        _row_width(2 * lower_bandwidth + upper_bandwidth + 1),
+        _data(size * _row_width, 0.0),
+        _lu_decomposition_is_done(GL_FALSE)
+{
+}
+
+// copies the band of a dense square matrix
+BandedMatrix::BandedMatrix(const Matrix<GLdouble>& m, GLuint lower_bandwidth, GLuint upper_bandwidth):
+        BandedMatrix(m.GetRowCount(), lower_bandwidth, upper_bandwidth)
+{
+    for (GLuint i = 0; i < _size; ++i)
+    {
+        GLuint first = (i > _lower_bandwidth) ? i - _lower_bandwidth : 0;
+        GLuint last  = min(_size - 1, i + _upper_bandwidth);
+
+        for (GLuint j = first; j <= last; ++j)
+            _data[_Index(i, j)] = m(i, j);
+    }
+}
+
+// determines the smallest bandwidths of a dense matrix
+GLvoid BandedMatrix::DetectBandwidths(const Matrix<GLdouble>& m, GLuint& lower_bandwidth, GLuint& upper_bandwidth, GLdouble tolerance)
+{
+    lower_bandwidth = upper_bandwidth = 0;
+
+    for (GLuint i = 0; i < m.GetRowCount(); ++i)
+    {
+        for (GLuint j = 0; j < m.GetColumnCount(); ++j)
+        {
+            if (abs(m(i, j)) > tolerance)
+            {
+                if (i > j)
+                    lower_bandwidth = max(lower_bandwidth, i - j);
+                else
+                    upper_bandwidth = max(upper_bandwidth, j - i);
+            }
+        }
+    }
+}
+
+// LU decomposition with partial pivoting, the multipliers of L are stored below the diagonal,
+// while U occupies the diagonal and the upper_bandwidth + lower_bandwidth super-diagonals; singular
+// matrices are rejected, since their solutions would consist of infinite or undefined values
+GLboolean BandedMatrix::PerformLUDecomposition()
+{
+    if (_lu_decomposition_is_done)
+        return GL_TRUE;
+
+    if (!_size)
+        return GL_FALSE;
+
+    _row_permutation.resize(_size);
+
+    for (GLuint k = 0; k < _size; ++k)
+    {
+        GLuint last_row    = min(_size - 1, k + _lower_bandwidth);
+        GLuint last_column = min(_size - 1, k + _lower_bandwidth + _upper_bandwidth);
+
+        // search for the largest pivot element in the k-th column
+        GLuint   imax = k;
+        GLdouble big  = abs(_data[_Index(k, k)]);
+
+        for (GLuint i = k + 1; i <= last_row; ++i)
+        {
+            GLdouble temp = abs(_data[_Index(i, k)]);
+            if (temp > big)
+            {
+                big = temp;
+                imax = i;
+            }
+        }
+
+        // the rows are interchanged only in the not yet eliminated columns, the multipliers
+        // of the previous steps are applied in their original order by the substitution
+        if (imax != k)
+        {
+            for (GLuint j = k; j <= last_column; ++j)
+                swap(_data[_Index(k, j)], _data[_Index(imax, j)]);
+        }
+
+        _row_permutation[k] = imax;
+
+        // each element of the k-th column is zero on and below the diagonal, i.e., the matrix is singular
+        GLdouble pivot = _data[_Index(k, k)];
+        if (pivot == 0.0)
+            return GL_FALSE;
+
+        for (GLuint i = k + 1; i <= last_row; ++i)
+        {
+            // divide by pivot element
+            GLdouble temp = _data[_Index(i, k)] /= pivot;
+
+            if (temp == 0.0)
+                continue;
+
+            // reduce remaining part of the band
+            for (GLuint j = k + 1; j <= last_column; ++j)
+                _data[_Index(i, j)] -= temp * _data[_Index(k, j)];
+        }
+    }
+
+    _lu_decomposition_is_done = GL_TRUE;
+
+    return GL_TRUE;
+}
+
+//------------------------------------------
+// implementation of class CollocationMatrix
+//------------------------------------------
+
+// special/default constructor
+CollocationMatrix::CollocationMatrix(GLuint size):
+        _dense(size),
+        _is_banded(GL_FALSE),
+        _lu_decomposition_is_done(GL_FALSE)
+{
+}
+
+GLboolean CollocationMatrix::SetRow(GLuint index, const RowMatrix<GLdouble>& row)
+{
+    if (_lu_decomposition_is_done)
+        return GL_FALSE;
+
+    return _dense.SetRow(index, row);
+}
+
+// selects and performs the LU decomposition
+GLboolean CollocationMatrix::PerformLUDecomposition()
+{
+    if (_lu_decomposition_is_done)
+        return GL_TRUE;
+
+    GLuint size = GetSize();
+    GLuint lower_bandwidth, upper_bandwidth;
+
+    BandedMatrix::DetectBandwidths(_dense, lower_bandwidth, upper_bandwidth);
+
+    _is_banded = (2 * lower_bandwidth + upper_bandwidth + 1 <= size / 2);
+
+    if (_is_banded)
+    {
+        _banded = BandedMatrix(_dense, lower_bandwidth, upper_bandwidth);
+        _lu_decomposition_is_done = _banded.PerformLUDecomposition();
+    }
+    else
+    {
+        _lu_decomposition_is_done = _dense.PerformLUDecomposition();
+    }
+
+    return _lu_decomposition_is_done;
+}
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <algorithm>
+#include <GL/glew.h>
+#include <vector>
+#include "Matrices.h"
+#include "RealSquareMatrices.h"
+#include "RowOperations.h"
+
+namespace cagd
+{
+    //-------------------
+    // class BandedMatrix
+    //-------------------
+    // Square matrix whose non-zero elements lie within lower_bandwidth sub-diagonals and upper_bandwidth
+    // super-diagonals. Each row stores only the 2 * lower_bandwidth + upper_bandwidth + 1 elements
+    // around the diagonal, since row interchanges of partial pivoting may move non-zero elements at
+    // most lower_bandwidth positions farther right. Hence LU decomposition requires
+    // O(n * lower_bandwidth * (lower_bandwidth + upper_bandwidth)) operations instead of O(n^3).
+    class BandedMatrix
+    {
+    protected:
+        GLuint                _size;
+        GLuint                _lower_bandwidth;
+        GLuint                _upper_bandwidth;
+        GLuint                _row_width;   // 2 * _lower_bandwidth + _upper_bandwidth + 1
+        std::vector<GLdouble> _data;        // row-major band storage
+        GLboolean             _lu_decomposition_is_done;
+        std::vector<GLuint>   _row_permutation;
+
+        // index of element (row, column) in the band storage, the element has to lie within the band
+        GLuint _Index(GLuint row, GLuint column) const;
+
+    public:
+        // special/default constructor, all elements are set to zero
+        BandedMatrix(GLuint size = 1, GLuint lower_bandwidth = 0, GLuint upper_bandwidth = 0);
+
+        // copies the band of a dense square matrix
+        BandedMatrix(const Matrix<GLdouble>& m, GLuint lower_bandwidth, GLuint upper_bandwidth);
+
+        // determines the smallest bandwidths that contain all elements of m the absolute values of
+        // which are greater than the given tolerance
+        static GLvoid DetectBandwidths(
+                const Matrix<GLdouble>& m,
+                GLuint& lower_bandwidth, GLuint& upper_bandwidth,
+                GLdouble tolerance = 0.0);
+
+        // get dimensions
+        GLuint GetSize() const;
+        GLuint GetLowerBandwidth() const;
+        GLuint GetUpperBandwidth() const;
+
+        // returns whether (row, column) lies within the band (including the fill-in of pivoting)
+        GLboolean IsInBand(GLuint row, GLuint column) const;
+
+        // get element by reference, the element has to lie within the band
+        GLdouble& operator ()(GLuint row, GLuint column);
+
+        // get copy of an element, elements outside of the band are zero
+        GLdouble operator ()(GLuint row, GLuint column) const;
+
+        // tries to determine the LU decomposition with partial pivoting of this banded matrix, fails if a zero
+        // pivot occurs (i.e. if the matrix is singular)
+        GLboolean PerformLUDecomposition();
+
+        // Solves linear systems of type A * x = b, where A is a regular banded matrix (i.e. *this),
+        // while b and x are row or column matrices with elements of type T (similarly to the method
+        // RealSquareMatrix::SolveLinearSystem, the independent systems are also distributed among
+        // OpenMP threads in the same way).
+        template <class T>
+        GLboolean SolveLinearSystem(const Matrix<T>& b, Matrix<T>& x, GLboolean represent_solutions_as_columns = GL_TRUE);
+    };
+
+    //------------------------
+    // class CollocationMatrix
+    //------------------------
+    // Square collocation matrix of an interpolation problem. Its rows are set one by one, then the LU
+    // decomposition detects the bandwidths of the matrix: if they are small compared to its size
+    // (e.g. in case of local-support blending functions) the band is factorized by a BandedMatrix,
+    // otherwise the dense RealSquareMatrix solver is used.
+    class CollocationMatrix
+    {
+    protected:
+        RealSquareMatrix _dense;
+        BandedMatrix     _banded;
+        GLboolean        _is_banded;
+        GLboolean        _lu_decomposition_is_done;
+
+    public:
+        // special/default constructor
+        CollocationMatrix(GLuint size = 1);
+
+        // get dimension
+        GLuint GetSize() const;
+
+        // update, fails after the LU decomposition
+        GLboolean SetRow(GLuint index, const RowMatrix<GLdouble>& row);
+
+        // a banded LU decomposition is performed if 2 * lower_bandwidth + upper_bandwidth + 1 <= size / 2
+        GLboolean PerformLUDecomposition();
+
+        // returns whether the banded solver was selected by the last LU decomposition
+        GLboolean IsBanded() const;
+
+        // solves linear systems of type A * x = b by means of the selected solver
+        template <class T>
+        GLboolean SolveLinearSystem(const Matrix<T>& b, Matrix<T>& x, GLboolean represent_solutions_as_columns = GL_TRUE);
+    };
+
+    //-------------------------------------
+    // implementation of class BandedMatrix
+    //-------------------------------------
+    inline GLuint BandedMatrix::_Index(GLuint row, GLuint column) const
+    {
+        return row * _row_width + (column + _lower_bandwidth - row);
+    }
+
+    inline GLuint BandedMatrix::GetSize() const
+    {
+        return _size;
+    }
+
+    inline GLuint BandedMatrix::GetLowerBandwidth() const
+    {
+        return _lower_bandwidth;
+    }
+
+    inline GLuint BandedMatrix::GetUpperBandwidth() const
+    {
+        return _upper_bandwidth;
+    }
+
+    inline GLboolean BandedMatrix::IsInBand(GLuint row, GLuint column) const
+    {
+        return row < _size && column < _size &&
+               column + _lower_bandwidth >= row &&
+               column <= row + _lower_bandwidth + _upper_bandwidth;
+    }
+
+    inline GLdouble& BandedMatrix::operator ()(GLuint row, GLuint column)
+    {
+        return _data[_Index(row, column)];
+    }
+
+    inline GLdouble BandedMatrix::operator ()(GLuint row, GLuint column) const
+    {
+        return IsInBand(row, column) ? _data[_Index(row, column)] : 0.0;
+    }
+
+    template <class T>
+    GLboolean BandedMatrix::SolveLinearSystem(const Matrix<T>& b, Matrix<T>& x, GLboolean represent_solutions_as_columns)
+    {
+        if (!_lu_decomposition_is_done)
+            if (!PerformLUDecomposition())
+                return GL_FALSE;
+
+        GLuint size = _size;
+
+        if (represent_solutions_as_columns ? b.GetRowCount() != size : b.GetColumnCount() != size)
+            return GL_FALSE;
+
+        x = b;
+
+        if (represent_solutions_as_columns)
+        {
+            GLint rhs_count   = static_cast<GLint>(b.GetColumnCount());
+            GLint block_count = (rhs_count + RIGHT_HAND_SIDE_BLOCK_SIZE - 1) / RIGHT_HAND_SIDE_BLOCK_SIZE;
+
+            #pragma omp parallel for schedule(static) if (block_count > 1)
+            for (GLint block = 0; block < block_count; ++block)
+            {
+                GLuint first = block * RIGHT_HAND_SIDE_BLOCK_SIZE;
+                GLuint count = std::min<GLuint>(RIGHT_HAND_SIDE_BLOCK_SIZE, rhs_count - first);
+
+                // forward substitution: the row interchanges and the multipliers of L are applied in
+                // the same order as they were generated
+                for (GLuint i = 0; i < size; ++i)
+                {
+                    GLuint ip = _row_permutation[i];
+
+                    if (ip != i)
+                        std::swap_ranges(&x(i, first), &x(i, first) + count, &x(ip, first));
+
+                    GLuint last = std::min(size - 1, i + _lower_bandwidth);
+
+                    for (GLuint r = i + 1; r <= last; ++r)
+                        if (_data[_Index(r, i)] != 0.0)
+                            SubtractScaledRow(count, _data[_Index(r, i)], &x(i, first), &x(r, first));
+                }
+
+                // backward substitution
+                for (GLint i = static_cast<GLint>(size) - 1; i >= 0; --i)
+                {
+                    DivideRow(count, _data[_Index(i, i)], &x(i, first));
+
+                    GLuint first_row = (static_cast<GLuint>(i) > _lower_bandwidth + _upper_bandwidth) ?
+                                       i - _lower_bandwidth - _upper_bandwidth : 0;
+
+                    for (GLuint r = first_row; r < static_cast<GLuint>(i); ++r)
+                        if (_data[_Index(r, i)] != 0.0)
+                            SubtractScaledRow(count, _data[_Index(r, i)], &x(i, first), &x(r, first));
+                }
+            }
+        }
+        else
+        {
+            GLint rhs_count = static_cast<GLint>(b.GetRowCount());
+
+            #pragma omp parallel for schedule(static) if (rhs_count > static_cast<GLint>(RIGHT_HAND_SIDE_BLOCK_SIZE))
+            for (GLint k = 0; k < rhs_count; ++k)
+            {
+                // forward substitution
+                for (GLuint i = 0; i < size; ++i)
+                {
+                    GLuint ip = _row_permutation[i];
+
+                    if (ip != i)
+                        std::swap(x(k, ip), x(k, i));
+
+                    GLuint last = std::min(size - 1, i + _lower_bandwidth);
+
+                    for (GLuint r = i + 1; r <= last; ++r)
+                        x(k, r) -= _data[_Index(r, i)] * x(k, i);
+                }
+
+                // backward substitution
+                for (GLint i = static_cast<GLint>(size) - 1; i >= 0; --i)
+                {
+                    T sum = x(k, i);
+
+                    GLuint last = std::min(size - 1, i + _lower_bandwidth + _upper_bandwidth);
+
+                    for (GLuint j = i + 1; j <= last; ++j)
+                        sum -= _data[_Index(i, j)] * x(k, j);
+
+                    x(k, i) = sum /= _data[_Index(i, i)];
+                }
+            }
+        }
+
+        return GL_TRUE;
+    }
+
+    //------------------------------------------
+    // implementation of class CollocationMatrix
+    //------------------------------------------
+    inline GLuint CollocationMatrix::GetSize() const
+    {
+        return _dense.GetRowCount();
+    }
+
+    inline GLboolean CollocationMatrix::IsBanded() const
+    {
+        return _is_banded;
+    }
+
+    template <class T>
+    GLboolean CollocationMatrix::SolveLinearSystem(const Matrix<T>& b, Matrix<T>& x, GLboolean represent_solutions_as_columns)
+    {
+        if (!_lu_decomposition_is_done)
+            if (!PerformLUDecomposition())
+                return GL_FALSE;
+
+        if (_is_banded)
+            return _banded.SolveLinearSystem(b, x, represent_solutions_as_columns);
+
+        return _dense.SolveLinearSystem(b, x, represent_solutions_as_columns);
+    }
+}
@@ -0,0 +1,328 @@
+#include "DCoordinate3Arrays.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// selecting the widest available instruction set at compile time
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define CAGD_DCOORDINATE3_ARRAY_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define CAGD_DCOORDINATE3_ARRAY_SSE2
+#endif
+
+using namespace cagd;
+using namespace std;
+
+namespace
+{
+    // thin wrappers around the packed double precision instructions, the kernels are written only once
+    // by means of them (the scalar fallback processes a single point per iteration)
+#if defined(CAGD_DCOORDINATE3_ARRAY_AVX)
+    typedef __m256d Packed;
+
+    const GLuint lane_count = 4;
+
+    inline Packed load(const GLdouble *p)        { return _mm256_loadu_pd(p); }
+    inline GLvoid store(GLdouble *p, Packed a)   { _mm256_storeu_pd(p, a); }
+    inline Packed broadcast(GLdouble a)          { return _mm256_set1_pd(a); }
+    inline Packed add(Packed a, Packed b)        { return _mm256_add_pd(a, b); }
+    inline Packed subtract(Packed a, Packed b)   { return _mm256_sub_pd(a, b); }
+    inline Packed multiply(Packed a, Packed b)   { return _mm256_mul_pd(a, b); }
+    inline Packed divide(Packed a, Packed b)     { return _mm256_div_pd(a, b); }
+    inline Packed square_root(Packed a)          { return _mm256_sqrt_pd(a); }
+    inline Packed minimum(Packed a, Packed b)    { return _mm256_min_pd(a, b); }
+    inline Packed maximum(Packed a, Packed b)    { return _mm256_max_pd(a, b); }
+
+    // zero lengths are replaced by 1
+    inline Packed nonzero(Packed a)
+    {
+        Packed zero = _mm256_setzero_pd();
+        return _mm256_blendv_pd(a, _mm256_set1_pd(1.0), _mm256_cmp_pd(a, zero, _CMP_EQ_OQ));
+    }
+#elif defined(CAGD_DCOORDINATE3_ARRAY_SSE2)
+    typedef __m128d Packed;
+
+    const GLuint lane_count = 2;
+
+    inline Packed load(const GLdouble *p)        { return _mm_loadu_pd(p); }
+    inline GLvoid store(GLdouble *p, Packed a)   { _mm_storeu_pd(p, a); }
+    inline Packed broadcast(GLdouble a)          { return _mm_set1_pd(a); }
+    inline Packed add(Packed a, Packed b)        { return _mm_add_pd(a, b); }
+    inline Packed subtract(Packed a, Packed b)   { return _mm_sub_pd(a, b); }
+    inline Packed multiply(Packed a, Packed b)   { return _mm_mul_pd(a, b); }
+    inline Packed divide(Packed a, Packed b)     { return _mm_div_pd(a, b); }
+    inline Packed square_root(Packed a)          { return _mm_sqrt_pd(a); }
+    inline Packed minimum(Packed a, Packed b)    { return _mm_min_pd(a, b); }
+    inline Packed maximum(Packed a, Packed b)    { return _mm_max_pd(a, b); }
+
+    // zero lengths are replaced by 1
+    inline Packed nonzero(Packed a)
+    {
+        Packed mask = _mm_cmpeq_pd(a, _mm_setzero_pd());
+        return _mm_or_pd(_mm_andnot_pd(mask, a), _mm_and_pd(mask, _mm_set1_pd(1.0)));
+    }
+#else
+    typedef GLdouble Packed;
+
+    const GLuint lane_count = 1;
+
+    inline Packed load(const GLdouble *p)        { return *p; }
+    inline GLvoid store(GLdouble *p, Packed a)   { *p = a; }
+    inline Packed broadcast(GLdouble a)          { return a; }
+    inline Packed add(Packed a, Packed b)        { return a + b; }
+    inline Packed subtract(Packed a, Packed b)   { return a - b; }
+    inline Packed multiply(Packed a, Packed b)   { return a * b; }
+    inline Packed divide(Packed a, Packed b)     { return a / b; }
+    inline Packed square_root(Packed a)          { return std::sqrt(a); }
+    inline Packed minimum(Packed a, Packed b)    { return (b < a) ? b : a; }
+    inline Packed maximum(Packed a, Packed b)    { return (a < b) ? b : a; }
+    inline Packed nonzero(Packed a)              { return (a == 0.0) ? 1.0 : a; }
+#endif
+
+    // returns the number of points that can be processed by full packed iterations
+    inline GLuint packed_count(GLuint size)
+    {
+        return size - size % lane_count;
+    }
+}
+
+// special/default constructor
+DCoordinate3Array::DCoordinate3Array(GLuint size):
+    _x(size, 0.0), _y(size, 0.0), _z(size, 0.0)
+{
+}
+
+// converting constructor
+DCoordinate3Array::DCoordinate3Array(const vector<DCoordinate3>& points)
+{
+    Assign(points);
+}
+
+GLvoid DCoordinate3Array::Assign(const vector<DCoordinate3>& points)
+{
+    Resize(static_cast<GLuint>(points.size()));
+
+    for (GLuint i = 0; i < points.size(); ++i)
+    {
+        _x[i] = points[i][0];
+        _y[i] = points[i][1];
+        _z[i] = points[i][2];
+    }
+}
+
+GLvoid DCoordinate3Array::CopyTo(vector<DCoordinate3>& points) const
+{
+    points.resize(_x.size());
+
+    for (GLuint i = 0; i < points.size(); ++i)
+    {
+        points[i][0] = _x[i];
+        points[i][1] = _y[i];
+        points[i][2] = _z[i];
+    }
+}
+
+GLvoid DCoordinate3Array::Resize(GLuint size)
+{
+    _x.resize(size);
+    _y.resize(size);
+    _z.resize(size);
+}
+
+GLvoid DCoordinate3Array::LoadNullVectors()
+{
+    fill(_x.begin(), _x.end(), 0.0);
+    fill(_y.begin(), _y.end(), 0.0);
+    fill(_z.begin(), _z.end(), 0.0);
+}
+
+GLvoid DCoordinate3Array::TranslateAndScale(const DCoordinate3& offset, GLdouble scale)
+{
+    GLuint size = GetSize(), i = 0;
+
+    Packed ox = broadcast(offset[0]), oy = broadcast(offset[1]), oz = broadcast(offset[2]);
+    Packed s  = broadcast(scale);
+
+    for (; i < packed_count(size); i += lane_count)
+    {
+        store(&_x[i], multiply(add(load(&_x[i]), ox), s));
+        store(&_y[i], multiply(add(load(&_y[i]), oy), s));
+        store(&_z[i], multiply(add(load(&_z[i]), oz), s));
+    }
+
+    for (; i < size; ++i)
+    {
+        _x[i] = (_x[i] + offset[0]) * scale;
+        _y[i] = (_y[i] + offset[1]) * scale;
+        _z[i] = (_z[i] + offset[2]) * scale;
+    }
+}
+
+GLboolean DCoordinate3Array::Axpy(GLdouble a, const DCoordinate3Array& x)
+{
+    if (x.GetSize() != GetSize())
+        return GL_FALSE;
+
+    GLuint size = GetSize(), i = 0;
+
+    Packed pa = broadcast(a);
+
+    for (; i < packed_count(size); i += lane_count)
+    {
+        store(&_x[i], add(load(&_x[i]), multiply(pa, load(&x._x[i]))));
+        store(&_y[i], add(load(&_y[i]), multiply(pa, load(&x._y[i]))));
+        store(&_z[i], add(load(&_z[i]), multiply(pa, load(&x._z[i]))));
+    }
+
+    for (; i < size; ++i)
+    {
+        _x[i] += a * x._x[i];
+        _y[i] += a * x._y[i];
+        _z[i] += a * x._z[i];
+    }
+
+    return GL_TRUE;
+}
+
+GLvoid DCoordinate3Array::AddScaled(const GLdouble *weights, const DCoordinate3& point)
+{
+    GLuint size = GetSize(), i = 0;
+
+    Packed px = broadcast(point[0]), py = broadcast(point[1]), pz = broadcast(point[2]);
+
+    for (; i < packed_count(size); i += lane_count)
+    {
+        Packed w = load(&weights[i]);
+
+        store(&_x[i], add(load(&_x[i]), multiply(w, px)));
+        store(&_y[i], add(load(&_y[i]), multiply(w, py)));
+        store(&_z[i], add(load(&_z[i]), multiply(w, pz)));
+    }
+
+    for (; i < size; ++i)
+    {
+        _x[i] += weights[i] * point[0];
+        _y[i] += weights[i] * point[1];
+        _z[i] += weights[i] * point[2];
+    }
+}
+
+// the components are evaluated in the same order as by DCoordinate3::operator ^=
+GLboolean DCoordinate3Array::Cross(const DCoordinate3Array& a, const DCoordinate3Array& b, DCoordinate3Array& result)
+{
+    if (a.GetSize() != b.GetSize())
+        return GL_FALSE;
+
+    GLuint size = a.GetSize(), i = 0;
+
+    result.Resize(size);
+
+    for (; i < packed_count(size); i += lane_count)
+    {
+        Packed ax = load(&a._x[i]), ay = load(&a._y[i]), az = load(&a._z[i]);
+        Packed bx = load(&b._x[i]), by = load(&b._y[i]), bz = load(&b._z[i]);
+
+        store(&result._x[i], subtract(multiply(ay, bz), multiply(az, by)));
+        store(&result._y[i], subtract(multiply(az, bx), multiply(ax, bz)));
+        store(&result._z[i], subtract(multiply(ax, by), multiply(ay, bx)));
+    }
+
+    for (; i < size; ++i)
+    {
+        GLdouble x = a._y[i] * b._z[i] - a._z[i] * b._y[i];
+        GLdouble y = a._z[i] * b._x[i] - a._x[i] * b._z[i];
+        GLdouble z = a._x[i] * b._y[i] - a._y[i] * b._x[i];
+
+        result._x[i] = x;
+        result._y[i] = y;
+        result._z[i] = z;
+    }
+
+    return GL_TRUE;
+}
+
+GLvoid DCoordinate3Array::Normalize()
+{
+    GLuint size = GetSize(), i = 0;
+
+    for (; i < packed_count(size); i += lane_count)
+    {
+        Packed x = load(&_x[i]), y = load(&_y[i]), z = load(&_z[i]);
+
+        // the length is evaluated in the same order as by DCoordinate3::length()
+        Packed l = nonzero(square_root(add(add(multiply(x, x), multiply(y, y)), multiply(z, z))));
+
+        store(&_x[i], divide(x, l));
+        store(&_y[i], divide(y, l));
+        store(&_z[i], divide(z, l));
+    }
+
+    for (; i < size; ++i)
+    {
+        GLdouble l = std::sqrt(_x[i] * _x[i] + _y[i] * _y[i] + _z[i] * _z[i]);
+
+        if (l)
+        {
+            _x[i] /= l;
+            _y[i] /= l;
+            _z[i] /= l;
+        }
+    }
+}
+
+GLboolean DCoordinate3Array::BoundingBox(DCoordinate3& leftmost, DCoordinate3& rightmost) const
+{
+    GLuint size = GetSize(), i = 0;
+
+    if (!size)
+        return GL_FALSE;
+
+    GLdouble lowest  = numeric_limits<GLdouble>::max();
+    GLdouble highest = -numeric_limits<GLdouble>::max();
+
+    Packed min_x = broadcast(lowest),  min_y = broadcast(lowest),  min_z = broadcast(lowest);
+    Packed max_x = broadcast(highest), max_y = broadcast(highest), max_z = broadcast(highest);
+
+    for (; i < packed_count(size); i += lane_count)
+    {
+        Packed x = load(&_x[i]), y = load(&_y[i]), z = load(&_z[i]);
+
+        min_x = minimum(min_x, x); max_x = maximum(max_x, x);
+        min_y = minimum(min_y, y); max_y = maximum(max_y, y);
+        min_z = minimum(min_z, z); max_z = maximum(max_z, z);
+    }
+
+    // horizontal reductions
+    GLdouble lane[6][lane_count];
+
+    store(lane[0], min_x); store(lane[1], min_y); store(lane[2], min_z);
+    store(lane[3], max_x); store(lane[4], max_y); store(lane[5], max_z);
+
+    leftmost  = DCoordinate3(lowest, lowest, lowest);
+    rightmost = DCoordinate3(highest, highest, highest);
+
+    for (GLuint k = 0; k < lane_count; ++k)
+    {
+        for (GLuint c = 0; c < 3; ++c)
+        {
+            leftmost[c]  = std::min(leftmost[c],  lane[c][k]);
+            rightmost[c] = std::max(rightmost[c], lane[3 + c][k]);
+        }
+    }
+
+    for (; i < size; ++i)
+    {
+        leftmost[0]  = std::min(leftmost[0],  _x[i]);
+        leftmost[1]  = std::min(leftmost[1],  _y[i]);
+        leftmost[2]  = std::min(leftmost[2],  _z[i]);
+
+        rightmost[0] = std::max(rightmost[0], _x[i]);
+        rightmost[1] = std::max(rightmost[1], _y[i]);
+        rightmost[2] = std::max(rightmost[2], _z[i]);
+    }
+
+    return GL_TRUE;
+}
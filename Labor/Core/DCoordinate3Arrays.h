@@ -0,0 +1,121 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <vector>
+#include "DCoordinates3.h"
+
+namespace cagd
+{
+    //------------------------
+    // class DCoordinate3Array
+    //------------------------
+    // Structure-of-arrays container of Descartes coordinates: the x, y and z components are stored in
+    // separate contiguous lanes, therefore the kernels below can process 2 (SSE2) or 4 (AVX) points
+    // per instruction. The kernels give the same results as the corresponding scalar operators of
+    // DCoordinate3, since they perform the same floating point operations in the same order.
+    class DCoordinate3Array
+    {
+    protected:
+        std::vector<GLdouble> _x, _y, _z;
+
+    public:
+        // special/default constructor
+        DCoordinate3Array(GLuint size = 0);
+
+        // converting constructor
+        DCoordinate3Array(const std::vector<DCoordinate3>& points);
+
+        // conversions from/to array of structures
+        GLvoid Assign(const std::vector<DCoordinate3>& points);
+        GLvoid CopyTo(std::vector<DCoordinate3>& points) const;
+
+        // get/set properties
+        GLuint GetSize() const;
+        GLvoid Resize(GLuint size);
+
+        // all points are set to the null vector
+        GLvoid LoadNullVectors();
+
+        // get/set points by value
+        DCoordinate3 operator [](GLuint index) const;
+        GLvoid Set(GLuint index, const DCoordinate3& point);
+
+        // get lanes
+        GLdouble* X();
+        GLdouble* Y();
+        GLdouble* Z();
+
+        const GLdouble* X() const;
+        const GLdouble* Y() const;
+        const GLdouble* Z() const;
+
+        // (*this)[i] = ((*this)[i] + offset) * scale
+        GLvoid TranslateAndScale(const DCoordinate3& offset, GLdouble scale);
+
+        // (*this)[i] += a * x[i], i.e., the contribution of a scaled sample row to a blending sum
+        GLboolean Axpy(GLdouble a, const DCoordinate3Array& x);
+
+        // (*this)[i] += weights[i] * point, i.e., the contribution of a control point to the blending
+        // sums of several samples
+        GLvoid AddScaled(const GLdouble *weights, const DCoordinate3& point);
+
+        // result[i] = a[i] ^ b[i]
+        static GLboolean Cross(const DCoordinate3Array& a, const DCoordinate3Array& b, DCoordinate3Array& result);
+
+        // points of non-zero length are normalized
+        GLvoid Normalize();
+
+        // corners of the axis aligned bounding box
+        GLboolean BoundingBox(DCoordinate3& leftmost, DCoordinate3& rightmost) const;
+    };
+
+    //------------------------------------------
+    // implementation of class DCoordinate3Array
+    //------------------------------------------
+    inline GLuint DCoordinate3Array::GetSize() const
+    {
+        return static_cast<GLuint>(_x.size());
+    }
+
+    inline DCoordinate3 DCoordinate3Array::operator [](GLuint index) const
+    {
+        return DCoordinate3(_x[index], _y[index], _z[index]);
+    }
+
+    inline GLvoid DCoordinate3Array::Set(GLuint index, const DCoordinate3& point)
+    {
+        _x[index] = point[0];
+        _y[index] = point[1];
+        _z[index] = point[2];
+    }
+
+    inline GLdouble* DCoordinate3Array::X()
+    {
+        return _x.data();
+    }
+
+    inline GLdouble* DCoordinate3Array::Y()
+    {
+        return _y.data();
+    }
+
+    inline GLdouble* DCoordinate3Array::Z()
+    {
+        return _z.data();
+    }
+
+    inline const GLdouble* DCoordinate3Array::X() const
+    {
+        return _x.data();
+    }
+
+    inline const GLdouble* DCoordinate3Array::Y() const
+    {
+        return _y.data();
+    }
+
+    inline const GLdouble* DCoordinate3Array::Z() const
+    {
+        return _z.data();
+    }
+}
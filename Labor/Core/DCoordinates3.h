@@ -277,6 +277,50 @@ namespace cagd
         return (_data[0] != rhs || _data[1] != rhs || _data[2] != rhs);
     }
 
+    //------------------------------------------------------
+    // fused operations that do not create temporary objects
+    //------------------------------------------------------
+
+    // y += a * x
+    inline GLvoid Axpy(const GLdouble& a, const DCoordinate3& x, DCoordinate3& y)
+    {
+        y[0] += a * x[0];
+        y[1] += a * x[1];
+        y[2] += a * x[2];
+    }
+
+    // result = weights[0] * points[0] + weights[1] * points[1] + ... + weights[count - 1] * points[count - 1],
+    // where weights and points can be any indexable sequences (e.g. pointers, std::vectors, row or column
+    // matrices); the terms are accumulated in the same order as by the chained operators + and *
+    template <typename Weights, typename Points>
+    inline GLvoid LinearCombination(GLuint count, const Weights& weights, const Points& points, DCoordinate3& result)
+    {
+        if (!count)
+        {
+            result[0] = result[1] = result[2] = 0.0;
+            return;
+        }
+
+        GLdouble w = weights[0];
+        const DCoordinate3& p = points[0];
+
+        GLdouble x = w * p[0], y = w * p[1], z = w * p[2];
+
+        for (GLuint i = 1; i < count; ++i)
+        {
+            GLdouble w_i = weights[i];
+            const DCoordinate3& p_i = points[i];
+
+            x += w_i * p_i[0];
+            y += w_i * p_i[1];
+            z += w_i * p_i[2];
+        }
+
+        result[0] = x;
+        result[1] = y;
+        result[2] = z;
+    }
+
     //----------------------------------------------------------------
     // definitions of overloaded input/output from/to stream operators
     //----------------------------------------------------------------
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include "DCoordinate3Arrays.h"
+#include "LinearCombination3.h"
+#include "Profilers.h"
+
+namespace cagd
+{
+    //---------------------------------------
+    // template class FixedLinearCombination3
+    //---------------------------------------
+    // Base class of linear combinations the data counts and maximum orders of derivatives of which are
+    // known at compile time (e.g. second order trigonometric arcs). The blending function values are
+    // evaluated into std::array objects on the stack and the sums over the control points have constant
+    // bounds, i.e., sampling does not allocate memory and the inner loops can be unrolled.
+    template <GLuint DataCount, GLuint MaximumOrderOfDerivatives>
+    class FixedLinearCombination3: public LinearCombination3
+    {
+    public:
+        // values[r][i] stores the r-th order derivative of the i-th blending function
+        typedef std::array<std::array<GLdouble, DataCount>, MaximumOrderOfDerivatives + 1> BlendingValues;
+
+        // special constructor
+        FixedLinearCombination3(GLdouble u_min, GLdouble u_max, GLenum data_usage_flag = GL_STATIC_DRAW);
+
+        // calculates the derivatives of orders 0, 1, ..., max_order_of_derivatives of the blending functions
+        virtual GLboolean BlendingFunctionDerivatives(
+                GLuint max_order_of_derivatives, GLdouble u, BlendingValues& values) const = 0;
+
+        // implementations of the abstract methods of the base class by means of the method above
+        GLboolean BlendingFunctionValues(GLdouble u, RowMatrix<GLdouble>& values) const;
+        GLboolean CalculateDerivatives(GLuint max_order_of_derivatives, GLdouble u, Derivatives& d) const;
+
+        // the blending function derivatives of all samples are evaluated first, then the blending sums
+        // of every order are accumulated control point by control point on a structure of arrays, i.e.,
+        // the samples are processed by packed SIMD instructions; the results are identical to the ones
+        // of the per-sample method of the base class
+        GenericCurve3* GenerateImage(GLuint max_order_of_derivatives, GLuint div_point_count, GLenum usage_flag = GL_STATIC_DRAW) const;
+    };
+
+    //---------------------------------------------------------
+    // implementation of template class FixedLinearCombination3
+    //---------------------------------------------------------
+    template <GLuint DataCount, GLuint MaximumOrderOfDerivatives>
+    FixedLinearCombination3<DataCount, MaximumOrderOfDerivatives>::FixedLinearCombination3(
+            GLdouble u_min, GLdouble u_max, GLenum data_usage_flag):
+        LinearCombination3(u_min, u_max, DataCount, data_usage_flag)
+    {
+    }
+
+    template <GLuint DataCount, GLuint MaximumOrderOfDerivatives>
+    GLboolean FixedLinearCombination3<DataCount, MaximumOrderOfDerivatives>::BlendingFunctionValues(
+            GLdouble u, RowMatrix<GLdouble>& values) const
+    {
+        BlendingValues fixed_values;
+
+        if (!BlendingFunctionDerivatives(0, u, fixed_values))
+            return GL_FALSE;
+
+        values.ResizeColumns(DataCount);
+
+        for (GLuint i = 0; i < DataCount; ++i)
+            values[i] = fixed_values[0][i];
+
+        return GL_TRUE;
+    }
+
+    template <GLuint DataCount, GLuint MaximumOrderOfDerivatives>
+    GLboolean FixedLinearCombination3<DataCount, MaximumOrderOfDerivatives>::CalculateDerivatives(
+            GLuint max_order_of_derivatives, GLdouble u, Derivatives& d) const
+    {
+        if (max_order_of_derivatives > MaximumOrderOfDerivatives)
+            return GL_FALSE;
+
+        BlendingValues values;
+
+        if (!BlendingFunctionDerivatives(max_order_of_derivatives, u, values))
+            return GL_FALSE;
+
+        d.ResizeRows(max_order_of_derivatives + 1);
+
+        for (GLuint r = 0; r <= max_order_of_derivatives; ++r)
+            LinearCombination(DataCount, values[r], _data, d[r]);
+
+        return GL_TRUE;
+    }
+
+    template <GLuint DataCount, GLuint MaximumOrderOfDerivatives>
+    GenericCurve3* FixedLinearCombination3<DataCount, MaximumOrderOfDerivatives>::GenerateImage(
+            GLuint max_order_of_derivatives, GLuint div_point_count, GLenum usage_flag) const
+    {
+        CAGD_PROFILE_ZONE("FixedLinearCombination3::GenerateImage");
+
+        if (div_point_count < 2 || max_order_of_derivatives > MaximumOrderOfDerivatives)
+            return nullptr;
+
+        GenericCurve3 *result = new (std::nothrow) GenericCurve3(max_order_of_derivatives, div_point_count, usage_flag);
+
+        if (!result)
+            return nullptr;
+
+        // weights[(r * DataCount + i) * div_point_count + k] stores the r-th order derivative of the i-th
+        // blending function at the k-th sample
+        std::vector<GLdouble> weights((max_order_of_derivatives + 1) * DataCount * div_point_count);
+
+        GLdouble step = (_u_max - _u_min) / (div_point_count - 1);
+
+        BlendingValues values;
+
+        for (GLuint k = 0; k < div_point_count; ++k)
+        {
+            GLdouble u = std::min(_u_min + k * step, _u_max);
+
+            if (!BlendingFunctionDerivatives(max_order_of_derivatives, u, values))
+            {
+                delete result;
+                return nullptr;
+            }
+
+            for (GLuint r = 0; r <= max_order_of_derivatives; ++r)
+                for (GLuint i = 0; i < DataCount; ++i)
+                    weights[(r * DataCount + i) * div_point_count + k] = values[r][i];
+        }
+
+        DCoordinate3Array d(div_point_count);
+
+        for (GLuint r = 0; r <= max_order_of_derivatives; ++r)
+        {
+            d.LoadNullVectors();
+
+            for (GLuint i = 0; i < DataCount; ++i)
+                d.AddScaled(&weights[(r * DataCount + i) * div_point_count], _data[i]);
+
+            for (GLuint k = 0; k < div_point_count; ++k)
+                result->SetDerivative(r, k, d[k]);
+        }
+
+        return result;
+    }
+}
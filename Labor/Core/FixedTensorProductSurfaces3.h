@@ -0,0 +1,308 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include "DCoordinate3Arrays.h"
+#include "Profilers.h"
+#include "TensorProductSurfaces3.h"
+
+namespace cagd
+{
+    //------------------------------------------
+    // template class FixedTensorProductSurface3
+    //------------------------------------------
+    // Base class of tensor product surfaces the control nets and maximum orders of partial derivatives
+    // of which are known at compile time (e.g. 4x4 patches of order 2). The blending function values
+    // and the partial derivatives of a surface point are evaluated into std::array objects on the stack,
+    // i.e., sampling does not allocate memory and the loops over the columns of the control net have
+    // constant bounds that can be unrolled by the compiler.
+    template <GLuint RowCount, GLuint ColumnCount, GLuint MaximumOrderOfPartialDerivatives>
+    class FixedTensorProductSurface3: public TensorProductSurface3
+    {
+    public:
+        // values[r][i] stores the r-th order derivative of the i-th blending function in direction u or v
+        typedef std::array<std::array<GLdouble, RowCount>,    MaximumOrderOfPartialDerivatives + 1> UBlendingValues;
+        typedef std::array<std::array<GLdouble, ColumnCount>, MaximumOrderOfPartialDerivatives + 1> VBlendingValues;
+
+        // stack allocated counterpart of the nested class PartialDerivatives, pd(r, s) stores the
+        // r-th order partial derivative which is differentiated s times with respect to v
+        class FixedPartialDerivatives
+        {
+        protected:
+            std::array<DCoordinate3, (MaximumOrderOfPartialDerivatives + 1) * (MaximumOrderOfPartialDerivatives + 2) / 2> _data;
+
+        public:
+            DCoordinate3& operator ()(GLuint row, GLuint column);
+            const DCoordinate3& operator ()(GLuint row, GLuint column) const;
+
+            GLvoid LoadNullVectors();
+        };
+
+        // special constructor
+        FixedTensorProductSurface3(
+                GLdouble u_min, GLdouble u_max,
+                GLdouble v_min, GLdouble v_max,
+                GLboolean u_closed = GL_FALSE, GLboolean v_closed = GL_FALSE);
+
+        // calculates the derivatives of orders 0, 1, ..., maximum_order_of_derivatives of the blending
+        // functions in direction u or v, should return GL_FALSE if the parameter value is outside of the
+        // definition domain
+        virtual GLboolean UBlendingFunctionDerivatives(
+                GLuint maximum_order_of_derivatives, GLdouble u_knot, UBlendingValues& values) const = 0;
+
+        virtual GLboolean VBlendingFunctionDerivatives(
+                GLuint maximum_order_of_derivatives, GLdouble v_knot, VBlendingValues& values) const = 0;
+
+        // blending function values required by the interpolation method of the base class
+        GLboolean UBlendingFunctionValues(GLdouble u_knot, RowMatrix<GLdouble>& blending_values) const;
+        GLboolean VBlendingFunctionValues(GLdouble v_knot, RowMatrix<GLdouble>& blending_values) const;
+
+        // allocation-free evaluation of the point and the (mixed) partial derivatives up to the given order
+        GLboolean CalculateFixedPartialDerivatives(
+                GLuint maximum_order_of_partial_derivatives,
+                GLdouble u, GLdouble v, FixedPartialDerivatives& pd) const;
+
+        // the results of the method above are copied into pd, which is resized only if its row count differs
+        GLboolean CalculatePartialDerivatives(
+                GLuint maximum_order_of_partial_derivatives,
+                GLdouble u, GLdouble v, PartialDerivatives& pd) const;
+
+        // The sums over the columns of the control net do not depend on u, therefore they are evaluated
+        // only once for all samples in direction v, then every row of the grid is accumulated from them on
+        // structures of arrays, i.e., the samples of a row are processed by packed SIMD instructions. The
+        // results are identical to the ones of the per-sample method of the base class.
+        TriangulatedMesh3* GenerateImage(
+                GLuint u_div_point_count, GLuint v_div_point_count,
+                GLenum usage_flag = GL_STATIC_DRAW) const;
+    };
+
+    //------------------------------------------------------------
+    // implementation of template class FixedTensorProductSurface3
+    //------------------------------------------------------------
+    template <GLuint RowCount, GLuint ColumnCount, GLuint MaximumOrderOfPartialDerivatives>
+    inline DCoordinate3& FixedTensorProductSurface3<RowCount, ColumnCount, MaximumOrderOfPartialDerivatives>::
+            FixedPartialDerivatives::operator ()(GLuint row, GLuint column)
+    {
+        return _data[row * (row + 1) / 2 + column];
+    }
+
+    template <GLuint RowCount, GLuint ColumnCount, GLuint MaximumOrderOfPartialDerivatives>
+    inline const DCoordinate3& FixedTensorProductSurface3<RowCount, ColumnCount, MaximumOrderOfPartialDerivatives>::
+            FixedPartialDerivatives::operator ()(GLuint row, GLuint column) const
+    {
+        return _data[row * (row + 1) / 2 + column];
+    }
+
+    template <GLuint RowCount, GLuint ColumnCount, GLuint MaximumOrderOfPartialDerivatives>
+    inline GLvoid FixedTensorProductSurface3<RowCount, ColumnCount, MaximumOrderOfPartialDerivatives>::
+            FixedPartialDerivatives::LoadNullVectors()
+    {
+        _data.fill(DCoordinate3());
+    }
+
+    template <GLuint RowCount, GLuint ColumnCount, GLuint MaximumOrderOfPartialDerivatives>
+    FixedTensorProductSurface3<RowCount, ColumnCount, MaximumOrderOfPartialDerivatives>::FixedTensorProductSurface3(
+            GLdouble u_min, GLdouble u_max,
+            GLdouble v_min, GLdouble v_max,
+            GLboolean u_closed, GLboolean v_closed):
+        TensorProductSurface3(u_min, u_max, v_min, v_max, RowCount, ColumnCount, u_closed, v_closed)
+    {
+    }
+
+    template <GLuint RowCount, GLuint ColumnCount, GLuint MaximumOrderOfPartialDerivatives>
+    GLboolean FixedTensorProductSurface3<RowCount, ColumnCount, MaximumOrderOfPartialDerivatives>::UBlendingFunctionValues(
+            GLdouble u_knot, RowMatrix<GLdouble>& blending_values) const
+    {
+        UBlendingValues values;
+
+        if (!UBlendingFunctionDerivatives(0, u_knot, values))
+            return GL_FALSE;
+
+        blending_values.ResizeColumns(RowCount);
+
+        for (GLuint i = 0; i < RowCount; ++i)
+            blending_values[i] = values[0][i];
+
+        return GL_TRUE;
+    }
+
+    template <GLuint RowCount, GLuint ColumnCount, GLuint MaximumOrderOfPartialDerivatives>
+    GLboolean FixedTensorProductSurface3<RowCount, ColumnCount, MaximumOrderOfPartialDerivatives>::VBlendingFunctionValues(
+            GLdouble v_knot, RowMatrix<GLdouble>& blending_values) const
+    {
+        VBlendingValues values;
+
+        if (!VBlendingFunctionDerivatives(0, v_knot, values))
+            return GL_FALSE;
+
+        blending_values.ResizeColumns(ColumnCount);
+
+        for (GLuint j = 0; j < ColumnCount; ++j)
+            blending_values[j] = values[0][j];
+
+        return GL_TRUE;
+    }
+
+    template <GLuint RowCount, GLuint ColumnCount, GLuint MaximumOrderOfPartialDerivatives>
+    GLboolean FixedTensorProductSurface3<RowCount, ColumnCount, MaximumOrderOfPartialDerivatives>::CalculateFixedPartialDerivatives(
+            GLuint maximum_order_of_partial_derivatives,
+            GLdouble u, GLdouble v, FixedPartialDerivatives& pd) const
+    {
+        if (maximum_order_of_partial_derivatives > MaximumOrderOfPartialDerivatives)
+            return GL_FALSE;
+
+        UBlendingValues u_values;
+        VBlendingValues v_values;
+
+        if (!UBlendingFunctionDerivatives(maximum_order_of_partial_derivatives, u, u_values) ||
+            !VBlendingFunctionDerivatives(maximum_order_of_partial_derivatives, v, v_values))
+            return GL_FALSE;
+
+        pd.LoadNullVectors();
+
+        for (GLuint row = 0; row < RowCount; ++row)
+        {
+            // aux[s] = sum_{j} _data(row, j) G_j^{(s)}(v)
+            std::array<DCoordinate3, MaximumOrderOfPartialDerivatives + 1> aux;
+
+            for (GLuint s = 0; s <= maximum_order_of_partial_derivatives; ++s)
+            {
+                for (GLuint column = 0; column < ColumnCount; ++column)
+                    Axpy(v_values[s][column], _data(row, column), aux[s]);
+            }
+
+            // pd(r, s) += aux[s] F_row^{(r - s)}(u)
+            for (GLuint r = 0; r <= maximum_order_of_partial_derivatives; ++r)
+            {
+                for (GLuint s = 0; s <= r; ++s)
+                    Axpy(u_values[r - s][row], aux[s], pd(r, s));
+            }
+        }
+
+        return GL_TRUE;
+    }
+
+    template <GLuint RowCount, GLuint ColumnCount, GLuint MaximumOrderOfPartialDerivatives>
+    GLboolean FixedTensorProductSurface3<RowCount, ColumnCount, MaximumOrderOfPartialDerivatives>::CalculatePartialDerivatives(
+            GLuint maximum_order_of_partial_derivatives,
+            GLdouble u, GLdouble v, PartialDerivatives& pd) const
+    {
+        FixedPartialDerivatives fixed_pd;
+
+        if (!CalculateFixedPartialDerivatives(maximum_order_of_partial_derivatives, u, v, fixed_pd))
+            return GL_FALSE;
+
+        pd.ResizeRows(maximum_order_of_partial_derivatives + 1);
+
+        for (GLuint r = 0; r <= maximum_order_of_partial_derivatives; ++r)
+        {
+            for (GLuint s = 0; s <= r; ++s)
+                pd(r, s) = fixed_pd(r, s);
+        }
+
+        return GL_TRUE;
+    }
+
+    template <GLuint RowCount, GLuint ColumnCount, GLuint MaximumOrderOfPartialDerivatives>
+    TriangulatedMesh3* FixedTensorProductSurface3<RowCount, ColumnCount, MaximumOrderOfPartialDerivatives>::GenerateImage(
+            GLuint u_div_point_count, GLuint v_div_point_count, GLenum usage_flag) const
+    {
+        // the unit normal vectors require first order partial derivatives
+        if (MaximumOrderOfPartialDerivatives < 1)
+            return TensorProductSurface3::GenerateImage(u_div_point_count, v_div_point_count, usage_flag);
+
+        CAGD_PROFILE_ZONE("FixedTensorProductSurface3::GenerateImage");
+
+        if (u_div_point_count <= 1 || v_div_point_count <= 1)
+            return nullptr;
+
+        TriangulatedMesh3 *result = new (std::nothrow) TriangulatedMesh3(u_div_point_count * v_div_point_count, 0, usage_flag);
+
+        if (!result)
+            return nullptr;
+
+        // the faces are shared by all grids of the same size
+        result->_SetGridTopology(u_div_point_count, v_div_point_count);
+
+        // uniform subdivision grid in the definition domain
+        GLdouble du = (_u_max - _u_min) / (u_div_point_count - 1);
+        GLdouble dv = (_v_max - _v_min) / (v_div_point_count - 1);
+
+        // uniform subdivision grid in the unit square
+        GLfloat sdu = 1.0f / (u_div_point_count - 1);
+        GLfloat tdv = 1.0f / (v_div_point_count - 1);
+
+        // v_weights[(s * ColumnCount + column) * v_div_point_count + j] stores the s-th order derivative of
+        // the blending function of the given column at the j-th sample in direction v
+        std::vector<GLdouble> v_weights(2 * ColumnCount * v_div_point_count);
+
+        VBlendingValues v_values;
+
+        for (GLuint j = 0; j < v_div_point_count; ++j)
+        {
+            GLdouble v = std::min(_v_min + j * dv, _v_max);
+
+            if (!VBlendingFunctionDerivatives(1, v, v_values))
+            {
+                delete result;
+                return nullptr;
+            }
+
+            for (GLuint s = 0; s <= 1; ++s)
+                for (GLuint column = 0; column < ColumnCount; ++column)
+                    v_weights[(s * ColumnCount + column) * v_div_point_count + j] = v_values[s][column];
+        }
+
+        // aux[s * RowCount + row][j] = sum_{column} _data(row, column) G_column^{(s)}(v_j)
+        std::vector<DCoordinate3Array> aux(2 * RowCount, DCoordinate3Array(v_div_point_count));
+
+        for (GLuint s = 0; s <= 1; ++s)
+            for (GLuint row = 0; row < RowCount; ++row)
+                for (GLuint column = 0; column < ColumnCount; ++column)
+                    aux[s * RowCount + row].AddScaled(&v_weights[(s * ColumnCount + column) * v_div_point_count], _data(row, column));
+
+        // surface points, partial derivatives and unit normal vectors of a row of the grid
+        DCoordinate3Array point(v_div_point_count), u_derivative(v_div_point_count), v_derivative(v_div_point_count), normal;
+
+        UBlendingValues u_values;
+
+        for (GLuint i = 0; i < u_div_point_count; ++i)
+        {
+            GLdouble u = std::min(_u_min + i * du, _u_max);
+            GLfloat  s = std::min(i * sdu, 1.0f);
+
+            if (!UBlendingFunctionDerivatives(1, u, u_values))
+            {
+                delete result;
+                return nullptr;
+            }
+
+            point.LoadNullVectors();
+            u_derivative.LoadNullVectors();
+            v_derivative.LoadNullVectors();
+
+            for (GLuint row = 0; row < RowCount; ++row)
+            {
+                point.Axpy(u_values[0][row], aux[row]);
+                u_derivative.Axpy(u_values[1][row], aux[row]);
+                v_derivative.Axpy(u_values[0][row], aux[RowCount + row]);
+            }
+
+            DCoordinate3Array::Cross(u_derivative, v_derivative, normal);
+            normal.Normalize();
+
+            for (GLuint j = 0; j < v_div_point_count; ++j)
+            {
+                GLuint index = i * v_div_point_count + j;
+
+                result->_vertex[index] = point[j];
+                result->_normal[index] = normal[j];
+
+                result->_tex[index].s() = s;
+                result->_tex[index].t() = std::min(j * tdv, 1.0f);
+            }
+        }
+
+        return result;
+    }
+}
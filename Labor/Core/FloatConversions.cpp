@@ -0,0 +1,140 @@
+#include "FloatConversions.h"
+
+#include <cstdint>
+#include <cstring>
+
+// selecting the widest available instruction set at compile time
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define CAGD_FLOAT_CONVERSIONS_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define CAGD_FLOAT_CONVERSIONS_SSE2
+#endif
+
+using namespace cagd;
+using namespace std;
+
+static_assert(sizeof(DCoordinate3) == 3 * sizeof(GLdouble), "DCoordinate3 has to be a tightly packed triplet of doubles");
+
+namespace
+{
+#if defined(CAGD_FLOAT_CONVERSIONS_AVX) || defined(CAGD_FLOAT_CONVERSIONS_SSE2)
+    // converts 4 doubles to 4 floats, the source is optionally scaled
+    inline __m128 convert4(const GLdouble *source, GLboolean scaled, GLdouble scale)
+    {
+    #if defined(CAGD_FLOAT_CONVERSIONS_AVX)
+        __m256d d = _mm256_loadu_pd(source);
+
+        if (scaled)
+            d = _mm256_mul_pd(d, _mm256_set1_pd(scale));
+
+        return _mm256_cvtpd_ps(d);
+    #else
+        __m128d lo = _mm_loadu_pd(source);
+        __m128d hi = _mm_loadu_pd(source + 2);
+
+        if (scaled)
+        {
+            __m128d s = _mm_set1_pd(scale);
+            lo = _mm_mul_pd(lo, s);
+            hi = _mm_mul_pd(hi, s);
+        }
+
+        return _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi));
+    #endif
+    }
+#endif
+
+    // flat conversion of n doubles
+    GLvoid convert(const GLdouble *source, GLuint n, GLboolean scaled, GLdouble scale,
+                   GLfloat *destination, GLboolean non_temporal)
+    {
+        GLuint k = 0;
+
+#if defined(CAGD_FLOAT_CONVERSIONS_AVX) || defined(CAGD_FLOAT_CONVERSIONS_SSE2)
+        GLboolean stream = non_temporal && (reinterpret_cast<uintptr_t>(destination) % sizeof(GLfloat) == 0);
+
+        if (stream)
+        {
+            // scalar prologue until the destination becomes 16-byte aligned
+            for (; k < n && reinterpret_cast<uintptr_t>(destination + k) % 16; ++k)
+                destination[k] = static_cast<GLfloat>(scaled ? scale * source[k] : source[k]);
+
+            for (; k + 4 <= n; k += 4)
+                _mm_stream_ps(destination + k, convert4(source + k, scaled, scale));
+
+            // the streaming stores have to be globally visible before the buffer is unmapped
+            _mm_sfence();
+        }
+        else
+        {
+            for (; k + 4 <= n; k += 4)
+                _mm_storeu_ps(destination + k, convert4(source + k, scaled, scale));
+        }
+#else
+        (GLvoid)non_temporal;
+#endif
+
+        for (; k < n; ++k)
+            destination[k] = static_cast<GLfloat>(scaled ? scale * source[k] : source[k]);
+    }
+}
+
+GLvoid cagd::ConvertToFloat(const DCoordinate3 *source, GLuint count, GLfloat *destination, GLboolean non_temporal)
+{
+    if (!count)
+        return;
+
+    convert(reinterpret_cast<const GLdouble*>(source), 3 * count, GL_FALSE, 1.0, destination, non_temporal);
+}
+
+GLvoid cagd::ConvertToFloat(const DCoordinate3 *source, GLuint count, GLdouble scale, GLfloat *destination, GLboolean non_temporal)
+{
+    if (!count)
+        return;
+
+    convert(reinterpret_cast<const GLdouble*>(source), 3 * count, GL_TRUE, scale, destination, non_temporal);
+}
+
+GLvoid cagd::ConvertDerivativeEndpointsToFloat(
+        const DCoordinate3 *point, const DCoordinate3 *derivative, GLuint count, GLdouble scale,
+        GLfloat *destination, GLboolean non_temporal)
+{
+    // the segments of consecutive points are interleaved at a 3-float granularity, thus the
+    // endpoints are written by overlapping unaligned stores instead of streaming ones
+    (GLvoid)non_temporal;
+
+    const GLdouble *p = reinterpret_cast<const GLdouble*>(point);
+    const GLdouble *d = reinterpret_cast<const GLdouble*>(derivative);
+
+    GLuint i = 0;
+
+#if defined(CAGD_FLOAT_CONVERSIONS_AVX) || defined(CAGD_FLOAT_CONVERSIONS_SSE2)
+    __m128d s = _mm_set1_pd(scale);
+
+    // each iteration writes 4 + 4 floats, the last one of them is overwritten by the next point,
+    // therefore the last point is processed by the scalar loop
+    for (; i + 1 < count; ++i, p += 3, d += 3, destination += 6)
+    {
+        __m128d p_xy = _mm_loadu_pd(p), p_z = _mm_load_sd(p + 2);
+        __m128d d_xy = _mm_loadu_pd(d), d_z = _mm_load_sd(d + 2);
+
+        // p + scale * d in the same order as DCoordinate3 sum = p; sum += scale * d;
+        __m128d e_xy = _mm_add_pd(p_xy, _mm_mul_pd(s, d_xy));
+        __m128d e_z  = _mm_add_sd(p_z,  _mm_mul_sd(s, d_z));
+
+        _mm_storeu_ps(destination,     _mm_movelh_ps(_mm_cvtpd_ps(p_xy), _mm_cvtpd_ps(p_z)));
+        _mm_storeu_ps(destination + 3, _mm_movelh_ps(_mm_cvtpd_ps(e_xy), _mm_cvtpd_ps(e_z)));
+    }
+#endif
+
+    for (; i < count; ++i, p += 3, d += 3, destination += 6)
+    {
+        for (GLuint j = 0; j < 3; ++j)
+        {
+            destination[j]     = static_cast<GLfloat>(p[j]);
+            destination[3 + j] = static_cast<GLfloat>(p[j] + scale * d[j]);
+        }
+    }
+}
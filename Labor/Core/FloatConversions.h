@@ -0,0 +1,35 @@
+#pragma once
+
+#include <GL/glew.h>
+#include "DCoordinates3.h"
+
+namespace cagd
+{
+    // Conversion kernels used by the Update...VertexBufferObjects methods. The source arrays are
+    // contiguous arrays of Descartes coordinates (e.g. the data of a std::vector<DCoordinate3> or a row
+    // of a Matrix<DCoordinate3>), i.e., they are processed as flat arrays of 3 * count doubles by means
+    // of packed SSE2/AVX conversions.
+    //
+    // If non_temporal is true and the destination is 16-byte aligned, the results are written by
+    // streaming stores that bypass the cache; this is the preferred way of filling mapped (usually
+    // write-combined) buffer objects that will not be read back by the CPU. Staging memory that is
+    // processed further should be written with non_temporal = false.
+
+    // destination[3 * i + j] = (GLfloat)source[i][j]
+    GLvoid ConvertToFloat(
+            const DCoordinate3 *source, GLuint count,
+            GLfloat *destination, GLboolean non_temporal = GL_FALSE);
+
+    // destination[3 * i + j] = (GLfloat)(scale * source[i][j])
+    GLvoid ConvertToFloat(
+            const DCoordinate3 *source, GLuint count, GLdouble scale,
+            GLfloat *destination, GLboolean non_temporal = GL_FALSE);
+
+    // generates the endpoints of the line segments that visualize derivative vectors:
+    // destination[6 * i + j]     = (GLfloat)point[i][j]
+    // destination[6 * i + 3 + j] = (GLfloat)(point[i][j] + scale * derivative[i][j])
+    // (the segments are written by overlapping stores, thus non_temporal is ignored)
+    GLvoid ConvertDerivativeEndpointsToFloat(
+            const DCoordinate3 *point, const DCoordinate3 *derivative, GLuint count, GLdouble scale,
+            GLfloat *destination, GLboolean non_temporal = GL_FALSE);
+}
@@ -0,0 +1,185 @@
+#include "FourierTransforms.h"
+#include "Constants.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace cagd;
+using namespace std;
+
+// the operator * of std::complex also handles infinities and NaNs, i.e., it is not inlined without -ffast-math
+static FastFourierTransform::Complex Product(
+        const FastFourierTransform::Complex& lhs, const FastFourierTransform::Complex& rhs)
+{
+    return FastFourierTransform::Complex(lhs.real() * rhs.real() - lhs.imag() * rhs.imag(),
+                                         lhs.real() * rhs.imag() + lhs.imag() * rhs.real());
+}
+
+//---------------------------------------------
+// implementation of class FastFourierTransform
+//---------------------------------------------
+
+// special/default constructor
+FastFourierTransform::FastFourierTransform(GLuint size):
+        _size(max(size, 1u)),
+        _radix_2_size(_size)
+{
+    if (!IsPowerOfTwo(_size))
+    {
+        _radix_2_size = 1;
+
+        while (_radix_2_size < 2 * _size - 1)
+            _radix_2_size <<= 1;
+    }
+
+    _twiddle_factor.resize(_radix_2_size / 2);
+
+    for (GLuint k = 0; k < _radix_2_size / 2; ++k)
+    {
+        GLdouble angle = TWO_PI * k / _radix_2_size;
+        _twiddle_factor[k] = Complex(cos(angle), sin(angle));
+    }
+
+    if (_radix_2_size == _size)
+        return;
+
+    // the exponents k^2 are reduced modulo 2 * _size in order to keep the angles small
+    _chirp.resize(_size);
+
+    for (GLuint k = 0; k < _size; ++k)
+    {
+        unsigned long long exponent = (static_cast<unsigned long long>(k) * k) % (2ull * _size);
+        GLdouble angle = PI * exponent / _size;
+        _chirp[k] = Complex(cos(angle), sin(angle));
+    }
+
+    // the filter of the cyclic convolution is the conjugate chirp at the indices -(_size - 1), ..., _size - 1,
+    // its transform is scaled by the normalization of the inverse radix-2 transform
+    _chirp_filter.assign(_radix_2_size, Complex(0.0, 0.0));
+
+    _chirp_filter[0] = conj(_chirp[0]);
+
+    for (GLuint k = 1; k < _size; ++k)
+        _chirp_filter[k] = _chirp_filter[_radix_2_size - k] = conj(_chirp[k]);
+
+    _Radix2(&_chirp_filter[0], GL_FALSE);
+
+    for (GLuint k = 0; k < _radix_2_size; ++k)
+        _chirp_filter[k] /= static_cast<GLdouble>(_radix_2_size);
+
+    _work.resize(_radix_2_size);
+}
+
+GLboolean FastFourierTransform::IsPowerOfTwo(GLuint size)
+{
+    return (size && !(size & (size - 1))) ? GL_TRUE : GL_FALSE;
+}
+
+GLuint FastFourierTransform::GetSize() const
+{
+    return _size;
+}
+
+// in-place radix-2 transform
+GLvoid FastFourierTransform::_Radix2(Complex *data, GLboolean inverse) const
+{
+    GLuint n = _radix_2_size;
+
+    // bit-reversal permutation
+    for (GLuint i = 1, j = 0; i < n; ++i)
+    {
+        GLuint bit = n >> 1;
+
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+
+        j ^= bit;
+
+        if (i < j)
+            swap(data[i], data[j]);
+    }
+
+    // butterflies
+    for (GLuint length = 2; length <= n; length <<= 1)
+    {
+        GLuint half = length / 2, stride = n / length;
+
+        for (GLuint first = 0; first < n; first += length)
+        {
+            for (GLuint k = 0; k < half; ++k)
+            {
+                const Complex &w = _twiddle_factor[k * stride];
+                const Complex &x = data[first + k + half];
+
+                Complex u = data[first + k];
+                Complex v = inverse ? Product(x, w) : Product(x, conj(w));
+
+                data[first + k]        = u + v;
+                data[first + k + half] = u - v;
+            }
+        }
+    }
+}
+
+// unnormalized inverse transform, other sizes than powers of two are calculated by Bluestein's algorithm:
+// j * k = (j^2 + k^2 - (k - j)^2) / 2, i.e., x[k] = chirp[k] * sum_j (X[j] * chirp[j]) * conj(chirp[k - j])
+GLvoid FastFourierTransform::_Inverse(Complex *data) const
+{
+    if (_radix_2_size == _size)
+    {
+        _Radix2(data, GL_TRUE);
+        return;
+    }
+
+    for (GLuint k = 0; k < _size; ++k)
+        _work[k] = Product(data[k], _chirp[k]);
+
+    fill(_work.begin() + _size, _work.end(), Complex(0.0, 0.0));
+
+    _Radix2(&_work[0], GL_FALSE);
+
+    for (GLuint k = 0; k < _radix_2_size; ++k)
+        _work[k] = Product(_work[k], _chirp_filter[k]);
+
+    _Radix2(&_work[0], GL_TRUE);
+
+    for (GLuint k = 0; k < _size; ++k)
+        data[k] = Product(_work[k], _chirp[k]);
+}
+
+GLvoid FastFourierTransform::Forward(Complex *data) const
+{
+    // the forward transform is the conjugate of the inverse transform of the conjugate data
+    for (GLuint k = 0; k < _size; ++k)
+        data[k] = conj(data[k]);
+
+    _Inverse(data);
+
+    for (GLuint k = 0; k < _size; ++k)
+        data[k] = conj(data[k]);
+}
+
+GLvoid FastFourierTransform::Inverse(Complex *data) const
+{
+    _Inverse(data);
+}
+
+GLboolean FastFourierTransform::Forward(vector<Complex>& data) const
+{
+    if (data.size() != _size)
+        return GL_FALSE;
+
+    Forward(&data[0]);
+
+    return GL_TRUE;
+}
+
+GLboolean FastFourierTransform::Inverse(vector<Complex>& data) const
+{
+    if (data.size() != _size)
+        return GL_FALSE;
+
+    Inverse(&data[0]);
+
+    return GL_TRUE;
+}
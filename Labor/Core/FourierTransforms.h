@@ -0,0 +1,57 @@
+#pragma once
+
+#include <complex>
+#include <GL/glew.h>
+#include <vector>
+
+namespace cagd
+{
+    //---------------------------
+    // class FastFourierTransform
+    //---------------------------
+    // Discrete Fourier transform of a fixed size N in O(N log N) operations. Powers of two are transformed
+    // by the iterative radix-2 algorithm; other sizes (e.g. the odd number of distinct samples of a closed
+    // curve) are reduced by Bluestein's chirp-z algorithm to a cyclic convolution of a power-of-two size
+    // M >= 2N - 1, the transformed chirp of which is calculated once by the constructor.
+    //
+    // Neither transform is normalized:
+    //   - Forward: X[k] = sum_{j=0}^{N-1} x[j] exp(-2 pi i j k / N),
+    //   - Inverse: x[j] = sum_{k=0}^{N-1} X[k] exp(+2 pi i j k / N).
+    //
+    // The Bluestein work buffer is a member, thus the same object must not be used by concurrent threads.
+    class FastFourierTransform
+    {
+    public:
+        typedef std::complex<GLdouble> Complex;
+
+    protected:
+        GLuint                      _size;
+        GLuint                      _radix_2_size;      // _size, or the size of the Bluestein convolution
+        std::vector<Complex>        _twiddle_factor;    // exp(2 pi i k / _radix_2_size), k < _radix_2_size / 2
+        std::vector<Complex>        _chirp;             // exp(pi i k^2 / _size), k < _size (Bluestein only)
+        std::vector<Complex>        _chirp_filter;      // transformed conjugate chirp (Bluestein only)
+        mutable std::vector<Complex> _work;
+
+        // in-place radix-2 transform of _radix_2_size elements, the sign of the exponent is positive if
+        // inverse is true
+        GLvoid _Radix2(Complex *data, GLboolean inverse) const;
+
+        // unnormalized inverse transform of _size elements
+        GLvoid _Inverse(Complex *data) const;
+
+    public:
+        // special/default constructor
+        FastFourierTransform(GLuint size = 1);
+
+        static GLboolean IsPowerOfTwo(GLuint size);
+
+        GLuint GetSize() const;
+
+        // in-place transforms of GetSize() elements
+        GLvoid Forward(Complex *data) const;
+        GLvoid Inverse(Complex *data) const;
+
+        GLboolean Forward(std::vector<Complex>& data) const;
+        GLboolean Inverse(std::vector<Complex>& data) const;
+    };
+}
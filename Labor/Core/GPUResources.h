@@ -0,0 +1,28 @@
+#pragma once
+
+#include <GL/glew.h>
+
+namespace cagd
+{
+    //------------------
+    // class GPUResource
+    //------------------
+    // Geometric objects of the core library (e.g. GenericCurve3, LinearCombination3, TensorProductSurface3
+    // and TriangulatedMesh3) may own GPU-side copies of their data, but they neither create nor render
+    // them: the derived classes are implemented by the GPU-resource layer (see the directory GPU), which
+    // is linked only into applications that have an OpenGL rendering context. The core objects copy,
+    // transfer and release their resources through this interface, therefore the core library does not
+    // call any OpenGL function (the header <GL/glew.h> is included only for the type definitions).
+    class GPUResource
+    {
+    public:
+        // duplicates the GPU-side data, returns a null pointer on failure (it is called by the copy
+        // constructors and assignment operators of the owners, i.e., in a valid rendering context)
+        virtual GPUResource* Clone() const = 0;
+
+        // releases the GPU-side data
+        virtual ~GPUResource()
+        {
+        }
+    };
+}
@@ -10,7 +10,7 @@ using namespace std;
 // default and special constructor
 GenericCurve3::GenericCurve3(GLuint maximum_order_of_derivatives, GLuint point_count, GLenum usage_flag):
         _usage_flag(usage_flag),
-        _vbo_derivative(maximum_order_of_derivatives + 1),
+        _vbo_derivative(nullptr),
         _derivative(maximum_order_of_derivatives + 1, point_count)
 {
 }
@@ -18,23 +18,17 @@ GenericCurve3::GenericCurve3(GLuint maximum_order_of_derivatives, GLuint point_c
 // special constructor
 GenericCurve3::GenericCurve3(const Matrix<DCoordinate3>& derivative, GLenum usage_flag):
         _usage_flag(usage_flag),
-        _vbo_derivative(RowMatrix<GLuint>(derivative.GetRowCount())),
+        _vbo_derivative(nullptr),
         _derivative(derivative)
 {
 }
 
-// copy constructor
+// copy constructor, the vertex buffer objects are duplicated on the GPU
 GenericCurve3::GenericCurve3(const GenericCurve3& curve):
         _usage_flag(curve._usage_flag),
-        _vbo_derivative(RowMatrix<GLuint>(curve._vbo_derivative.GetColumnCount())),
+        _vbo_derivative(curve._vbo_derivative ? curve._vbo_derivative->Clone() : nullptr),
         _derivative(curve._derivative)
 {
-    GLboolean vbo_update_is_possible = GL_TRUE;
-    for (GLuint i = 0; i < curve._vbo_derivative.GetColumnCount(); ++i)
-        vbo_update_is_possible &= curve._vbo_derivative(i);
-
-    if (vbo_update_is_possible)
-        UpdateVertexBufferObjects(_usage_flag);
 }
 
 // assignment operator
@@ -44,203 +38,44 @@ GenericCurve3& GenericCurve3::operator =(const GenericCurve3& rhs)
     {
         DeleteVertexBufferObjects();
 
-        _usage_flag = rhs._usage_flag;
-        _derivative = rhs._derivative;
-
-        GLboolean vbo_update_is_possible = GL_TRUE;
-        for (GLuint i = 0; i < rhs._vbo_derivative.GetColumnCount(); ++i)
-            vbo_update_is_possible &= rhs._vbo_derivative(i);
-
-        if (vbo_update_is_possible)
-            UpdateVertexBufferObjects(_usage_flag);
+        _usage_flag     = rhs._usage_flag;
+        _vbo_derivative = rhs._vbo_derivative ? rhs._vbo_derivative->Clone() : nullptr;
+        _derivative     = rhs._derivative;
     }
     return *this;
 }
 
 // vertex buffer object handling methods
-GLvoid GenericCurve3::DeleteVertexBufferObjects()
-{
-    for (GLuint i = 0; i < _vbo_derivative.GetColumnCount(); ++i)
-    {
-        if (_vbo_derivative(i))
-        {
-            glDeleteBuffers(1, &_vbo_derivative(i));
-            _vbo_derivative(i) = 0;
-        }
-    }
-}
-
-GLboolean GenericCurve3::RenderDerivatives(GLuint order, GLenum render_mode) const
+// move constructor
+GenericCurve3::GenericCurve3(GenericCurve3&& curve) noexcept:
+        _usage_flag(curve._usage_flag),
+        _vbo_derivative(curve._vbo_derivative),
+        _derivative(std::move(curve._derivative))
 {
-    GLuint max_order = _derivative.GetRowCount();
-    if (order >= max_order || !_vbo_derivative(order))
-        return GL_FALSE;
-
-    GLuint point_count = _derivative.GetColumnCount();
-
-    glEnableClientState(GL_VERTEX_ARRAY);
-        glBindBuffer(GL_ARRAY_BUFFER, _vbo_derivative(order));
-            glVertexPointer(3, GL_FLOAT, 0, (const GLvoid *)0);
-
-            if (!order)
-            {
-                if (render_mode != GL_LINE_STRIP &&
-                    render_mode != GL_LINE_LOOP  &&
-                    render_mode != GL_POINTS)
-                {
-                    glBindBuffer(GL_ARRAY_BUFFER, 0);
-                    glDisableClientState(GL_VERTEX_ARRAY);
-                    return GL_FALSE;
-                }
-
-                glDrawArrays(render_mode, 0, point_count);
-            }
-            else
-            {
-                if (render_mode != GL_LINES && render_mode != GL_POINTS)
-                {
-                    glBindBuffer(GL_ARRAY_BUFFER, 0);
-                    glDisableClientState(GL_VERTEX_ARRAY);
-                    return GL_FALSE;
-                }
-
-                glDrawArrays(render_mode, 0, 2 * point_count);
-            }
-
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glDisableClientState(GL_VERTEX_ARRAY);
-
-    return GL_TRUE;
+    curve._vbo_derivative = nullptr;
 }
 
-GLboolean GenericCurve3::UpdateVertexBufferObjects(GLdouble derivative_scale, GLenum usage_flag)
+// move assignment operator
+GenericCurve3& GenericCurve3::operator =(GenericCurve3&& rhs) noexcept
 {
-    if (usage_flag != GL_STREAM_DRAW  && usage_flag != GL_STREAM_READ  && usage_flag != GL_STREAM_COPY  &&
-        usage_flag != GL_DYNAMIC_DRAW && usage_flag != GL_DYNAMIC_READ && usage_flag != GL_DYNAMIC_COPY &&
-        usage_flag != GL_STATIC_DRAW  && usage_flag != GL_STATIC_READ  && usage_flag != GL_STATIC_COPY)
-        return GL_FALSE;
-
-    DeleteVertexBufferObjects();
-
-    _usage_flag = usage_flag;
-
-    for(GLuint d = 0; d < _vbo_derivative.GetColumnCount(); ++d)
-    {
-        glGenBuffers(1, &_vbo_derivative(d));
-
-        if (!_vbo_derivative(d))
-        {
-            for (GLuint i = 0; i < d; ++i)
-            {
-                glDeleteBuffers(1, &_vbo_derivative(i));
-                _vbo_derivative(i) = 0;
-            }
-
-            return GL_FALSE;
-        }
-    }
-
-    GLuint curve_point_count = _derivative.GetColumnCount();
-
-    GLfloat *coordinate = 0;
-
-    // curve points
-    GLuint curve_point_byte_size = 3 * curve_point_count * sizeof(GLfloat);
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo_derivative(0));
-    glBufferData(GL_ARRAY_BUFFER, curve_point_byte_size, 0, _usage_flag);
-
-    coordinate = (GLfloat*)glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
-
-    if (!coordinate)
-    {
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        DeleteVertexBufferObjects();
-        return GL_FALSE;
-    }
-
-    for (GLuint i = 0; i < curve_point_count; ++i)
-    {
-        for (GLuint j = 0; j < 3; ++j)
-        {
-            *coordinate = (GLfloat)_derivative(0,i)[j];
-            ++coordinate;
-        }
-    }
-
-    if (!glUnmapBuffer(GL_ARRAY_BUFFER))
+    if (this != &rhs)
     {
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
         DeleteVertexBufferObjects();
-        return GL_FALSE;
-    }
 
-    // higher order derivatives
-    GLuint higher_order_derivative_byte_size = 2 * curve_point_byte_size;
+        _usage_flag     = rhs._usage_flag;
+        _vbo_derivative = rhs._vbo_derivative;
+        _derivative     = std::move(rhs._derivative);
 
-    for (GLuint d = 1; d < _derivative.GetRowCount(); ++d)
-    {
-        glBindBuffer(GL_ARRAY_BUFFER, _vbo_derivative(d));
-        glBufferData(GL_ARRAY_BUFFER, higher_order_derivative_byte_size, 0, _usage_flag);
-
-        coordinate = (GLfloat*)glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
-
-        if (!coordinate)
-        {
-            glBindBuffer(GL_ARRAY_BUFFER, 0);
-            DeleteVertexBufferObjects();
-            return GL_FALSE;
-        }
-
-        for (GLuint i = 0; i < curve_point_count; ++i)
-        {
-            DCoordinate3 sum = _derivative(0, i);
-            sum += derivative_scale *  _derivative(d, i);
-
-            for (GLint j = 0; j < 3; ++j)
-            {
-                *coordinate = (GLfloat)_derivative(0, i)[j];
-                *(coordinate + 3) = (GLfloat)sum[j];
-                ++coordinate;
-            }
-
-            coordinate += 3;
-        }
-
-        if (!glUnmapBuffer(GL_ARRAY_BUFFER))
-        {
-            glBindBuffer(GL_ARRAY_BUFFER, 0);
-            DeleteVertexBufferObjects();
-            return GL_FALSE;
-        }
+        rhs._vbo_derivative = nullptr;
     }
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-    return GL_TRUE;
-}
-
-GLfloat* GenericCurve3::MapDerivatives(GLuint order, GLenum access_mode) const
-{
-    if (order >= _derivative.GetRowCount())
-        return 0;
-
-    if (access_mode != GL_READ_ONLY && access_mode != GL_WRITE_ONLY && access_mode != GL_READ_WRITE)
-        return 0;
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo_derivative(order));
-
-    return (GLfloat*)glMapBuffer(GL_ARRAY_BUFFER, access_mode);
+    return *this;
 }
 
-GLboolean GenericCurve3::UnmapDerivatives(GLuint order) const
+// the buffer objects are released by the GPU-resource layer through the virtual destructor
+GLvoid GenericCurve3::DeleteVertexBufferObjects()
 {
-    if (order >= _derivative.GetRowCount())
-        return GL_FALSE;
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo_derivative(order));
-
-    return glUnmapBuffer(GL_ARRAY_BUFFER);
+    delete _vbo_derivative;
+    _vbo_derivative = nullptr;
 }
 
 // get derivative by value
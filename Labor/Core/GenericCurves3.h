@@ -2,6 +2,7 @@
 
 #include "DCoordinates3.h"
 #include <GL/glew.h>
+#include "GPUResources.h"
 #include "Matrices.h"
 #include <iostream>
 
@@ -22,7 +23,7 @@ namespace cagd
 
     protected:
         GLenum               _usage_flag;
-        RowMatrix<GLuint>    _vbo_derivative;
+        GPUResource          *_vbo_derivative;     // vertex buffer objects of the derivatives (owned)
         Matrix<DCoordinate3> _derivative;
 
     public:
@@ -41,7 +42,13 @@ namespace cagd
         // assignment operator
         GenericCurve3& operator =(const GenericCurve3& rhs);
 
-        // vertex buffer object handling methods
+        // move constructor and move assignment operator, the vertex buffer objects are transferred
+        GenericCurve3(GenericCurve3&& curve) noexcept;
+        GenericCurve3& operator =(GenericCurve3&& rhs) noexcept;
+
+        // vertex buffer object handling methods, except for DeleteVertexBufferObjects they are implemented by
+        // the GPU-resource layer (GPU/GenericCurves3Rendering.cpp), i.e., they require the library cagd_gpu
+        // and a valid OpenGL rendering context
         GLvoid DeleteVertexBufferObjects();
         GLboolean RenderDerivatives(GLuint order, GLenum render_mode) const;
         GLboolean UpdateVertexBufferObjects(GLdouble derivative_scale = 1.0, GLenum usage_flag = GL_STATIC_DRAW);
@@ -0,0 +1,90 @@
+#include "GridTopologies.h"
+
+using namespace cagd;
+using namespace std;
+
+GridTopologyCache::FaceMap& GridTopologyCache::_Faces()
+{
+    static FaceMap faces;
+    return faces;
+}
+
+mutex& GridTopologyCache::_Mutex()
+{
+    static mutex m;
+    return m;
+}
+
+GridTopologyCache::FaceList GridTopologyCache::Faces(GLuint u_div_point_count, GLuint v_div_point_count)
+{
+    lock_guard<mutex> lock(_Mutex());
+
+    FaceMap &faces = _Faces();
+
+    // the entries of the released lists are removed, therefore the map contains only the used grid sizes
+    for (FaceMap::iterator it = faces.begin(); it != faces.end(); )
+    {
+        if (it->second.expired())
+            it = faces.erase(it);
+        else
+            ++it;
+    }
+
+    Key key(u_div_point_count, v_div_point_count);
+
+    FaceMap::iterator cached = faces.find(key);
+
+    if (cached != faces.end())
+        return cached->second.lock();
+
+    shared_ptr<vector<TriangularFace> > face = make_shared<vector<TriangularFace> >();
+
+    if (u_div_point_count > 1 && v_div_point_count > 1)
+    {
+        face->resize(2 * (u_div_point_count - 1) * (v_div_point_count - 1));
+
+        GLuint current_face = 0;
+
+        for (GLuint i = 0; i < u_div_point_count - 1; ++i)
+        {
+            for (GLuint j = 0; j < v_div_point_count - 1; ++j)
+            {
+                GLuint index[4];
+
+                index[0] = i * v_div_point_count + j;
+                index[1] = index[0] + 1;
+                index[2] = index[1] + v_div_point_count;
+                index[3] = index[2] - 1;
+
+                TriangularFace *f = &(*face)[current_face];
+
+                f[0][0] = index[0];
+                f[0][1] = index[1];
+                f[0][2] = index[2];
+
+                f[1][0] = index[0];
+                f[1][1] = index[2];
+                f[1][2] = index[3];
+
+                current_face += 2;
+            }
+        }
+    }
+
+    faces[key] = face;
+
+    return face;
+}
+
+GLuint GridTopologyCache::GridCount()
+{
+    lock_guard<mutex> lock(_Mutex());
+
+    GLuint count = 0;
+
+    for (FaceMap::const_iterator it = _Faces().begin(); it != _Faces().end(); ++it)
+        if (!it->second.expired())
+            ++count;
+
+    return count;
+}
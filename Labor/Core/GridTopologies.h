@@ -0,0 +1,51 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "TriangularFaces.h"
+
+namespace cagd
+{
+    //------------------------
+    // class GridTopologyCache
+    //------------------------
+    // Every regular grid of u_div_point_count x v_div_point_count vertices (generated e.g. by
+    // ParametricSurface3::GenerateImage or TensorProductSurface3::GenerateImage) has the same
+    // connectivity:
+    /*
+        3-2
+        |/|
+        0-1
+    */
+    // where index[0] = i * v_div_point_count + j, index[1] = index[0] + 1,
+    // index[2] = index[1] + v_div_point_count and index[3] = index[2] - 1.
+    //
+    // The cache builds the face list of a grid size only once while it is used: the lists are shared by
+    // reference counted pointers (e.g. the images of the same size share a single list instead of copying
+    // it), and a list is deleted when its last user releases it. (The corresponding element array buffer
+    // objects are shared by the GridIndexBufferCache of the GPU-resource layer.)
+    class GridTopologyCache
+    {
+    public:
+        typedef std::shared_ptr<const std::vector<TriangularFace> > FaceList;
+
+    private:
+        typedef std::pair<GLuint, GLuint>                                       Key;
+        typedef std::map<Key, std::weak_ptr<const std::vector<TriangularFace> > > FaceMap;
+
+        static FaceMap&    _Faces();
+        static std::mutex& _Mutex();
+
+    public:
+        // returns the shared triangular faces of the given grid (the list is empty if the grid has less
+        // than two rows or columns)
+        static FaceList Faces(GLuint u_div_point_count, GLuint v_div_point_count);
+
+        // returns the number of grid sizes whose face lists are currently used
+        static GLuint GridCount();
+    };
+}
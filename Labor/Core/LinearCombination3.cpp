@@ -1,5 +1,6 @@
 #include "LinearCombination3.h"
-#include "RealSquareMatrices.h"
+#include "BandedMatrices.h"
+#include "Profilers.h"
 
 using namespace cagd;
 using namespace std;
@@ -24,6 +25,21 @@ LinearCombination3::Derivatives& LinearCombination3::Derivatives::operator =(con
     return *this;
 }
 
+// move constructor
+LinearCombination3::Derivatives::Derivatives(LinearCombination3::Derivatives&& d) noexcept: ColumnMatrix<DCoordinate3>(std::move(d))
+{
+}
+
+// move assignment operator
+LinearCombination3::Derivatives& LinearCombination3::Derivatives::operator =(LinearCombination3::Derivatives&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        ColumnMatrix<DCoordinate3>::operator =(std::move(rhs));
+    }
+    return *this;
+}
+
 // set every derivative to null vector
 GLvoid LinearCombination3::Derivatives::LoadNullVectors()
 {
@@ -36,22 +52,24 @@ GLvoid LinearCombination3::Derivatives::LoadNullVectors()
 
 // special constructor
 LinearCombination3::LinearCombination3(GLdouble u_min, GLdouble u_max, GLuint data_count, GLenum data_usage_flag):
-        _vbo_data(0),
+        _vbo_data(nullptr),
         _data_usage_flag(data_usage_flag),
         _u_min(u_min), _u_max(u_max),
-        _data(data_count)
+        _data(data_count),
+        _collocation_matrix_is_valid(GL_FALSE)
 {
 }
 
-// copy constructor
+// copy constructor, the vertex buffer object of the data is duplicated on the GPU
 LinearCombination3::LinearCombination3(const LinearCombination3 &lc):
-        _vbo_data(0),
+        _vbo_data(lc._vbo_data ? lc._vbo_data->Clone() : nullptr),
         _data_usage_flag(lc._data_usage_flag),
         _u_min(lc._u_min), _u_max(lc._u_max),
-        _data(lc._data)
+        _data(lc._data),
+        _collocation_knot_vector(lc._collocation_knot_vector),
+        _collocation_matrix(lc._collocation_matrix),
+        _collocation_matrix_is_valid(lc._collocation_matrix_is_valid)
 {
-    if (lc._vbo_data)
-        UpdateVertexBufferObjectsOfData(_data_usage_flag);
 }
 
 // assignment operator
@@ -61,96 +79,63 @@ LinearCombination3& LinearCombination3::operator =(const LinearCombination3& rhs
     {
         DeleteVertexBufferObjectsOfData();
 
+        _vbo_data = rhs._vbo_data ? rhs._vbo_data->Clone() : nullptr;
         _data_usage_flag = rhs._data_usage_flag;
         _u_min = rhs._u_min;
         _u_max = rhs._u_max;
         _data = rhs._data;
 
-        if (rhs._vbo_data)
-            UpdateVertexBufferObjectsOfData(_data_usage_flag);
+        _collocation_knot_vector = rhs._collocation_knot_vector;
+        _collocation_matrix = rhs._collocation_matrix;
+        _collocation_matrix_is_valid = rhs._collocation_matrix_is_valid;
     }
 
     return *this;
 }
 
-// vbo handling methods
-GLvoid LinearCombination3::DeleteVertexBufferObjectsOfData()
-{
-    if (_vbo_data)
-    {
-        glDeleteBuffers(1, &_vbo_data);
-        _vbo_data = 0;
-    }
-}
-
-GLboolean LinearCombination3::RenderData(GLenum render_mode) const
+// move constructor
+LinearCombination3::LinearCombination3(LinearCombination3&& lc) noexcept:
+        _vbo_data(lc._vbo_data),
+        _data_usage_flag(lc._data_usage_flag),
+        _u_min(lc._u_min), _u_max(lc._u_max),
+        _data(std::move(lc._data)),
+        _collocation_knot_vector(std::move(lc._collocation_knot_vector)),
+        _collocation_matrix(std::move(lc._collocation_matrix)),
+        _collocation_matrix_is_valid(lc._collocation_matrix_is_valid)
 {
-    if (!_vbo_data)
-        return GL_FALSE;
-
-    if (render_mode != GL_LINE_STRIP && render_mode != GL_LINE_LOOP && render_mode != GL_POINTS)
-        return GL_FALSE;
-
-    glEnableClientState(GL_VERTEX_ARRAY);
-        glBindBuffer(GL_ARRAY_BUFFER, _vbo_data);
-            glVertexPointer(3, GL_FLOAT, 0, nullptr);
-            glDrawArrays(render_mode, 0, _data.GetRowCount());
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glDisableClientState(GL_VERTEX_ARRAY);
-
-    return GL_TRUE;
+    lc._vbo_data = nullptr;
+    lc._collocation_matrix_is_valid = GL_FALSE;
 }
 
-
-GLboolean LinearCombination3::UpdateVertexBufferObjectsOfData(GLenum usage_flag)
+// move assignment operator
+LinearCombination3& LinearCombination3::operator =(LinearCombination3&& rhs) noexcept
 {
-    GLuint data_count = _data.GetRowCount();
-    if (!data_count)
-        return GL_FALSE;
-
-    if (usage_flag != GL_STREAM_DRAW  && usage_flag != GL_STREAM_READ  && usage_flag != GL_STREAM_COPY
-     && usage_flag != GL_DYNAMIC_DRAW && usage_flag != GL_DYNAMIC_READ && usage_flag != GL_DYNAMIC_COPY
-     && usage_flag != GL_STATIC_DRAW  && usage_flag != GL_STATIC_READ  && usage_flag != GL_STATIC_COPY)
-        return GL_FALSE;
-
-    _data_usage_flag = usage_flag;
-
-    DeleteVertexBufferObjectsOfData();
-
-    glGenBuffers(1, &_vbo_data);
-    if (!_vbo_data)
-        return GL_FALSE;
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo_data);
-    glBufferData(GL_ARRAY_BUFFER, data_count * 3 * sizeof(GLfloat), nullptr, _data_usage_flag);
-
-    GLfloat *coordinate = (GLfloat*)glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
-    if (!coordinate)
+    if (this != &rhs)
     {
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
         DeleteVertexBufferObjectsOfData();
-        return GL_FALSE;
-    }
 
-    for (GLuint i = 0; i < data_count; ++i)
-    {
-        for (GLuint j = 0; j < 3; ++j)
-        {
-            *coordinate = static_cast<GLfloat>(_data[i][j]);
-            ++coordinate;
-        }
-    }
+        _vbo_data = rhs._vbo_data;
+        _data_usage_flag = rhs._data_usage_flag;
+        _u_min = rhs._u_min;
+        _u_max = rhs._u_max;
+        _data = std::move(rhs._data);
 
-    if (!glUnmapBuffer(GL_ARRAY_BUFFER))
-    {
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        DeleteVertexBufferObjectsOfData();
-        return GL_FALSE;
+        _collocation_knot_vector = std::move(rhs._collocation_knot_vector);
+        _collocation_matrix = std::move(rhs._collocation_matrix);
+        _collocation_matrix_is_valid = rhs._collocation_matrix_is_valid;
+
+        rhs._vbo_data = nullptr;
+        rhs._collocation_matrix_is_valid = GL_FALSE;
     }
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return *this;
+}
 
-    return GL_TRUE;
+// vbo handling methods, the buffer object is released by the GPU-resource layer through the virtual destructor
+GLvoid LinearCombination3::DeleteVertexBufferObjectsOfData()
+{
+    delete _vbo_data;
+    _vbo_data = nullptr;
 }
 
 // get data by value
@@ -170,24 +155,50 @@ DCoordinate3& LinearCombination3::operator [](GLuint index)
 // assure interpolation
 GLboolean LinearCombination3::UpdateDataForInterpolation(const ColumnMatrix<GLdouble>& knot_vector, const ColumnMatrix<DCoordinate3>& data_points_to_interpolate)
 {
+    CAGD_PROFILE_ZONE("LinearCombination3::UpdateDataForInterpolation");
+
     GLuint data_count = _data.GetRowCount();
 
     if (data_count != knot_vector.GetRowCount() ||
         data_count != data_points_to_interpolate.GetRowCount())
         return GL_FALSE;
 
-    RealSquareMatrix collocation_matrix(data_count);
+    GLboolean knot_vector_is_cached = _collocation_matrix_is_valid && _collocation_knot_vector.size() == data_count;
+
+    for (GLuint r = 0; knot_vector_is_cached && r < data_count; ++r)
+        knot_vector_is_cached = (_collocation_knot_vector[r] == knot_vector(r));
 
-    RowMatrix<GLdouble> current_blending_function_values(data_count);
-    for (GLuint r = 0; r < knot_vector.GetRowCount(); ++r)
+    if (!knot_vector_is_cached)
     {
-        if (!BlendingFunctionValues(knot_vector(r), current_blending_function_values))
+        _collocation_matrix_is_valid = GL_FALSE;
+        _collocation_matrix = CollocationMatrix(data_count);
+
+        RowMatrix<GLdouble> current_blending_function_values(data_count);
+        for (GLuint r = 0; r < knot_vector.GetRowCount(); ++r)
+        {
+            if (!BlendingFunctionValues(knot_vector(r), current_blending_function_values))
+                return GL_FALSE;
+            else
+                _collocation_matrix.SetRow(r, current_blending_function_values);
+        }
+
+        if (!_collocation_matrix.PerformLUDecomposition())
             return GL_FALSE;
-        else
-            collocation_matrix.SetRow(r, current_blending_function_values);
+
+        _collocation_knot_vector.resize(data_count);
+        for (GLuint r = 0; r < data_count; ++r)
+            _collocation_knot_vector[r] = knot_vector(r);
+
+        _collocation_matrix_is_valid = GL_TRUE;
     }
 
-    return collocation_matrix.SolveLinearSystem(data_points_to_interpolate, _data);
+    return _collocation_matrix.SolveLinearSystem(data_points_to_interpolate, _data);
+}
+
+// the cached LU decomposition of the collocation matrix is discarded
+GLvoid LinearCombination3::_InvalidateCollocationMatrix()
+{
+    _collocation_matrix_is_valid = GL_FALSE;
 }
 
 
@@ -209,6 +220,8 @@ GLvoid LinearCombination3::GetDefinitionDomain(GLdouble& u_min, GLdouble& u_max)
 // generate image/arc
 GenericCurve3* LinearCombination3::GenerateImage(GLuint max_order_of_derivatives, GLuint div_point_count, GLenum usage_flag) const
 {
+    CAGD_PROFILE_ZONE("LinearCombination3::GenerateImage");
+
     // homework
     if (div_point_count < 2)
     {
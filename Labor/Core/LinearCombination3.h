@@ -1,8 +1,11 @@
 #pragma once
 
+#include "BandedMatrices.h"
 #include "DCoordinates3.h"
 #include "GenericCurves3.h"
+#include "GPUResources.h"
 //#include "Matrices.h"
+#include <vector>
 
 namespace cagd
 {
@@ -24,16 +27,30 @@ namespace cagd
             // assignment operator
             Derivatives& operator =(const Derivatives& rhs);
 
+            // move constructor and move assignment operator
+            Derivatives(Derivatives&& d) noexcept;
+            Derivatives& operator =(Derivatives&& rhs) noexcept;
+
             // all inherited Descartes coordinates are set to the null vector
             GLvoid LoadNullVectors();
         };
 
     protected:
-        GLuint                      _vbo_data;
+        GPUResource                 *_vbo_data;     // vertex buffer object of the data (owned)
         GLenum                      _data_usage_flag;
         GLdouble                    _u_min, _u_max;
         ColumnMatrix<DCoordinate3>  _data;
 
+        // the LU decomposition of the collocation matrix of the last interpolation problem, it is reused
+        // by UpdateDataForInterpolation as long as the knot vector and the blending functions do not change
+        std::vector<GLdouble>       _collocation_knot_vector;
+        CollocationMatrix           _collocation_matrix;
+        GLboolean                   _collocation_matrix_is_valid;
+
+        // has to be called by derived classes whenever their blending functions change (e.g. by setting
+        // a shape parameter)
+        GLvoid _InvalidateCollocationMatrix();
+
     public:
         // special constructor
         LinearCombination3(
@@ -47,10 +64,17 @@ namespace cagd
         // assignment operator
         LinearCombination3& operator =(const LinearCombination3& rhs);
 
-        // vbo handling methods
-        virtual GLvoid DeleteVertexBufferObjectsOfData();
-        virtual GLboolean RenderData(GLenum render_mode = GL_LINE_STRIP) const;
-        virtual GLboolean UpdateVertexBufferObjectsOfData(GLenum usage_flag = GL_STATIC_DRAW);
+        // move constructor and move assignment operator, the vertex buffer object of the data is transferred
+        LinearCombination3(LinearCombination3&& lc) noexcept;
+        LinearCombination3& operator =(LinearCombination3&& rhs) noexcept;
+
+        // vbo handling methods, except for DeleteVertexBufferObjectsOfData they are implemented by the
+        // GPU-resource layer (GPU/LinearCombination3Rendering.cpp), i.e., they require the library cagd_gpu
+        // and a valid OpenGL rendering context (they are not virtual, otherwise the virtual method table of
+        // the class would refer to the GPU-resource layer)
+        GLvoid DeleteVertexBufferObjectsOfData();
+        GLboolean RenderData(GLenum render_mode = GL_LINE_STRIP) const;
+        GLboolean UpdateVertexBufferObjectsOfData(GLenum usage_flag = GL_STATIC_DRAW);
 
         // get data by value
         DCoordinate3 operator [](GLuint index) const;
@@ -78,7 +102,8 @@ namespace cagd
         // generate image/arc
         virtual GenericCurve3* GenerateImage(GLuint max_order_of_derivatives, GLuint div_point_count, GLenum usage_flag = GL_STATIC_DRAW) const;
 
-        // assure interpolation
+        // assure interpolation, if the knot vector equals the one of the previous call only the
+        // O(n^2) forward and backward substitutions are performed
         virtual GLboolean UpdateDataForInterpolation(const ColumnMatrix<GLdouble>& knot_vector, const ColumnMatrix<DCoordinate3>& data_points_to_interpolate);
 
         GLboolean SetData(const ColumnMatrix<DCoordinate3> &data);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iostream>
+#include <utility>
 #include <vector>
 #include <GL/glew.h>
 
@@ -58,6 +59,10 @@ namespace cagd
         // assignment operator
         Matrix& operator =(const Matrix& m);
 
+        // move constructor and move assignment operator, the moved-from matrix becomes empty (0 x 0)
+        Matrix(Matrix&& m) noexcept;
+        Matrix& operator =(Matrix&& m) noexcept;
+
         // get element by reference
         T& operator ()(GLuint row, GLuint column);
 
@@ -183,6 +188,33 @@ namespace cagd
         return *this;
     }
 
+    template <typename T>
+    inline Matrix<T>::Matrix(Matrix&& m) noexcept:
+        _row_count(m._row_count),
+        _column_count(m._column_count),
+        _data(std::move(m._data))
+    {
+        m._row_count = 0;
+        m._column_count = 0;
+        m._data.clear();
+    }
+
+    template <typename T>
+    inline Matrix<T>& Matrix<T>::operator =(Matrix<T>&& m) noexcept
+    {
+        if (this != &m)
+        {
+            this->_row_count = m._row_count;
+            this->_column_count = m._column_count;
+            this->_data = std::move(m._data);
+
+            m._row_count = 0;
+            m._column_count = 0;
+            m._data.clear();
+        }
+        return *this;
+    }
+
     template <typename T>
     inline T& Matrix<T>::operator ()(GLuint row, GLuint column)
     {
@@ -210,8 +242,16 @@ namespace cagd
     template<typename T>
     inline GLboolean Matrix<T>::ResizeRows(GLuint row_count)
     {
-        //REDO
-        _data.resize(row_count, std::vector<T>(_column_count));
+        // evaluators resize their output matrices on every call, the prototype row below would be
+        // allocated even if the row count remained the same
+        if (row_count == _row_count)
+            return GL_TRUE;
+
+        if (row_count < _row_count)
+            _data.resize(row_count);
+        else
+            _data.resize(row_count, std::vector<T>(_column_count));
+
         _row_count = row_count;
 
         return GL_TRUE;
@@ -220,7 +260,9 @@ namespace cagd
     template<typename T>
     inline GLboolean Matrix<T>::ResizeColumns(GLuint column_count)
     {
-        //REDO
+        if (column_count == _column_count)
+            return GL_TRUE;
+
         for (auto &i : _data)
         {
             i.resize(column_count);
@@ -378,6 +420,9 @@ namespace cagd
     template <typename T>
     inline GLboolean TriangularMatrix<T>::ResizeRows(GLuint row_count)
     {
+        if (row_count == _row_count)
+            return GL_TRUE;
+
         this->_data.resize(row_count);
 
         for (unsigned i = _row_count; i < row_count; i++)
@@ -0,0 +1,153 @@
+#include "MeshLoaders.h"
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <system_error>
+
+using namespace cagd;
+using namespace std;
+
+MeshLoader::Job::Job(GLuint id, const string& file_name, GLboolean translate_and_scale_to_unit_cube):
+        id(id), file_name(file_name), translate_and_scale_to_unit_cube(translate_and_scale_to_unit_cube)
+{
+}
+
+MeshLoader::LoadedMesh::LoadedMesh(): _next(nullptr), id(0), success(GL_FALSE), load_time(0.0)
+{
+}
+
+MeshLoader::MeshLoader(const vector<Job>& jobs, GLuint thread_count):
+        _job(jobs),
+        _next_job(0), _finished_job_count(0), _cancelled(false),
+        _loaded_mesh(nullptr)
+{
+    if (!thread_count)
+        thread_count = max(thread::hardware_concurrency(), 1u);
+
+    thread_count = min(thread_count, static_cast<GLuint>(_job.size()));
+
+    _worker.reserve(thread_count);
+
+    for (GLuint i = 0; i < thread_count; ++i)
+    {
+        try
+        {
+            _worker.push_back(thread(&MeshLoader::_Work, this));
+        }
+        catch (const system_error&)
+        {
+            break;
+        }
+    }
+
+    // the remaining jobs are executed by the calling thread if there are no workers at all
+    if (_worker.empty())
+        _Work();
+}
+
+GLvoid MeshLoader::_Work()
+{
+    while (!_cancelled.load(memory_order_relaxed))
+    {
+        GLuint j = _next_job.fetch_add(1, memory_order_relaxed);
+
+        if (j >= _job.size())
+            break;
+
+        const Job &job = _job[j];
+
+        LoadedMesh *loaded = new LoadedMesh();
+
+        loaded->id        = job.id;
+        loaded->file_name = job.file_name;
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+        // the file is read only once: the content hash, which is calculated here instead of on the thread that
+        // registers the mesh, belongs to the same bytes that are parsed
+        string content;
+
+        if (MeshRegistry::ReadFile(job.file_name, loaded->identity, content))
+        {
+            istringstream stream(content);
+            loaded->success = loaded->mesh.LoadFromOFF(stream, job.translate_and_scale_to_unit_cube);
+        }
+
+        loaded->load_time = chrono::duration<GLdouble>(chrono::steady_clock::now() - start).count();
+
+        // publishing the mesh, the release order makes its geometry visible to the consumer
+        LoadedMesh *head = _loaded_mesh.load(memory_order_relaxed);
+
+        do
+        {
+            loaded->_next = head;
+        }
+        while (!_loaded_mesh.compare_exchange_weak(head, loaded, memory_order_release, memory_order_relaxed));
+
+        _finished_job_count.fetch_add(1, memory_order_release);
+    }
+}
+
+GLuint MeshLoader::JobCount() const
+{
+    return static_cast<GLuint>(_job.size());
+}
+
+GLuint MeshLoader::ThreadCount() const
+{
+    return static_cast<GLuint>(_worker.size());
+}
+
+GLuint MeshLoader::FinishedJobCount() const
+{
+    return _finished_job_count.load(memory_order_acquire);
+}
+
+GLboolean MeshLoader::IsFinished() const
+{
+    return FinishedJobCount() == JobCount();
+}
+
+GLuint MeshLoader::TakeLoadedMeshes(vector<LoadedMesh*>& loaded_meshes)
+{
+    LoadedMesh *head = _loaded_mesh.exchange(nullptr, memory_order_acquire);
+
+    // the detached list is in reverse order of completion
+    size_t first = loaded_meshes.size();
+
+    for (LoadedMesh *loaded = head; loaded; loaded = loaded->_next)
+        loaded_meshes.push_back(loaded);
+
+    reverse(loaded_meshes.begin() + first, loaded_meshes.end());
+
+    for (size_t i = first; i < loaded_meshes.size(); ++i)
+        loaded_meshes[i]->_next = nullptr;
+
+    return static_cast<GLuint>(loaded_meshes.size() - first);
+}
+
+GLvoid MeshLoader::Wait()
+{
+    for (vector<thread>::iterator it = _worker.begin(); it != _worker.end(); ++it)
+    {
+        if (it->joinable())
+            it->join();
+    }
+}
+
+MeshLoader::~MeshLoader()
+{
+    _cancelled.store(true, memory_order_relaxed);
+
+    Wait();
+
+    LoadedMesh *loaded = _loaded_mesh.exchange(nullptr, memory_order_acquire);
+
+    while (loaded)
+    {
+        LoadedMesh *next = loaded->_next;
+        delete loaded;
+        loaded = next;
+    }
+}
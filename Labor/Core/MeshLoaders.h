@@ -0,0 +1,96 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "MeshRegistries.h"
+#include "TriangulatedMeshes3.h"
+
+namespace cagd
+{
+    //-----------------
+    // class MeshLoader
+    //-----------------
+    // Loads OFF files on a pool of worker threads. The workers parse the files (i.e. they build the
+    // host-side geometry of triangulated meshes) and publish each finished mesh through a lock-free list,
+    // from which the thread that owns the OpenGL rendering context takes them over, e.g. once per frame,
+    // in order to update their vertex buffer objects. Neither the workers nor the loader call OpenGL.
+    // The workers read each file only once and hash the same bytes that they parse, thus the loaded meshes
+    // can be registered by a MeshRegistry without reading their files again.
+    class MeshLoader
+    {
+    public:
+        // a file to be loaded, the identifier is chosen by the caller (e.g. the index of the mesh in the scene)
+        class Job
+        {
+        public:
+            GLuint      id;
+            std::string file_name;
+            GLboolean   translate_and_scale_to_unit_cube;
+
+            Job(GLuint id = 0, const std::string& file_name = "", GLboolean translate_and_scale_to_unit_cube = GL_FALSE);
+        };
+
+        // result of a job
+        class LoadedMesh
+        {
+            friend class MeshLoader;
+
+        private:
+            LoadedMesh        *_next;     // link of the lock-free list of the loader
+
+        public:
+            GLuint            id;
+            std::string       file_name;
+            GLboolean         success;    // the file has been read and parsed by TriangulatedMesh3::LoadFromOFF
+            GLdouble          load_time;  // in seconds, including the reading and the hashing of the file
+            TriangulatedMesh3 mesh;
+            MeshRegistry::FileIdentity identity;
+
+            LoadedMesh();
+        };
+
+    protected:
+        std::vector<Job>           _job;
+        std::vector<std::thread>   _worker;
+
+        std::atomic<GLuint>        _next_job;           // index of the first job that has not been started yet
+        std::atomic<GLuint>        _finished_job_count;
+        std::atomic<bool>          _cancelled;
+
+        // the workers push the loaded meshes onto the head of this list by compare-and-swap operations, while
+        // the consumer detaches the whole list at once, therefore the list is not exposed to the ABA problem
+        std::atomic<LoadedMesh*>   _loaded_mesh;
+
+        // executes jobs until each of them has been started or the loader has been cancelled
+        GLvoid _Work();
+
+        // loaders cannot be copied
+        MeshLoader(const MeshLoader&);
+        MeshLoader& operator =(const MeshLoader&);
+
+    public:
+        // starts loading the given files on thread_count worker threads (if thread_count is zero, the number
+        // of hardware threads is used); if no thread can be created, the files are loaded by the constructor
+        MeshLoader(const std::vector<Job>& jobs, GLuint thread_count = 0);
+
+        // query methods
+        GLuint    JobCount() const;
+        GLuint    ThreadCount() const;
+        GLuint    FinishedJobCount() const;
+        GLboolean IsFinished() const;
+
+        // appends the meshes loaded since the previous call to the given list in the order of their completion,
+        // returns the number of appended meshes; the caller takes over the ownership of the appended meshes
+        GLuint TakeLoadedMeshes(std::vector<LoadedMesh*>& loaded_meshes);
+
+        // blocks the calling thread until each job is finished
+        GLvoid Wait();
+
+        // jobs that have not been started yet are cancelled, the destructor waits for the running ones and
+        // deletes the meshes that have not been taken
+        ~MeshLoader();
+    };
+}
@@ -0,0 +1,305 @@
+#include "MeshRegistries.h"
+
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <sys/stat.h>
+#include <vector>
+
+using namespace cagd;
+using namespace std;
+
+bool MeshRegistry::Key::operator <(const Key& rhs) const
+{
+    if (hash != rhs.hash)
+        return hash < rhs.hash;
+
+    if (byte_size != rhs.byte_size)
+        return byte_size < rhs.byte_size;
+
+    return translate_and_scale_to_unit_cube < rhs.translate_and_scale_to_unit_cube;
+}
+
+MeshRegistry::FileIdentity::FileIdentity(): hash(0), byte_size(0), modification_time(0)
+{
+}
+
+MeshRegistry::MeshRegistry(size_t memory_budget): _memory_budget(memory_budget), _memory_usage(0)
+{
+}
+
+string MeshRegistry::_CanonicalFileName(const string& file_name)
+{
+    // different paths of the same file are mapped to the same canonical path
+#if defined(_WIN32)
+    char buffer[_MAX_PATH];
+    return _fullpath(buffer, file_name.c_str(), _MAX_PATH) ? buffer : file_name;
+#else
+    char buffer[PATH_MAX];
+    return realpath(file_name.c_str(), buffer) ? buffer : file_name;
+#endif
+}
+
+GLboolean MeshRegistry::ReadFile(const string& file_name, FileIdentity& identity, string& content)
+{
+    identity.canonical_file_name = _CanonicalFileName(file_name);
+
+    // the file is examined before reading, thus a file modified in between is read again by the next lookup
+    struct stat status;
+
+    if (stat(identity.canonical_file_name.c_str(), &status))
+        return GL_FALSE;
+
+    FILE *file = fopen(identity.canonical_file_name.c_str(), "rb");
+
+    if (!file)
+        return GL_FALSE;
+
+    content.clear();
+    content.reserve(static_cast<size_t>(status.st_size));
+
+    vector<char> chunk(1 << 16);
+
+    for (size_t count; (count = fread(&chunk[0], 1, chunk.size(), file)) > 0; )
+        content.append(&chunk[0], count);
+
+    GLboolean success = !ferror(file);
+
+    fclose(file);
+
+    if (!success)
+        return GL_FALSE;
+
+    // 64-bit FNV-1a hash of the content
+    unsigned long long hash = 14695981039346656037ull;
+
+    for (string::const_iterator it = content.begin(); it != content.end(); ++it)
+    {
+        hash ^= static_cast<unsigned char>(*it);
+        hash *= 1099511628211ull;
+    }
+
+    identity.hash              = hash;
+    identity.byte_size         = content.size();
+    identity.modification_time = status.st_mtime;
+
+    return GL_TRUE;
+}
+
+MeshRegistry::EntryMap::iterator MeshRegistry::_Find(
+        const FileIdentity& identity, GLboolean translate_and_scale_to_unit_cube, Key& key)
+{
+    _file_state[identity.canonical_file_name] = identity;
+
+    key.hash                             = identity.hash;
+    key.byte_size                        = identity.byte_size;
+    key.translate_and_scale_to_unit_cube = translate_and_scale_to_unit_cube ? GL_TRUE : GL_FALSE;
+
+    return _entry.find(key);
+}
+
+TriangulatedMesh3* MeshRegistry::_Reference(EntryMap::iterator it)
+{
+    if (!it->second.reference_count++)
+        _unreferenced.erase(it->second.lru_position);
+
+    _UpdateByteSize(it->second);
+
+    return it->second.mesh;
+}
+
+GLvoid MeshRegistry::_UpdateByteSize(Entry& entry)
+{
+    size_t byte_size = _ByteSize(*entry.mesh);
+
+    _memory_usage = _memory_usage - entry.byte_size + byte_size;
+    entry.byte_size = byte_size;
+}
+
+GLvoid MeshRegistry::_Evict(size_t memory_budget)
+{
+    while (!_unreferenced.empty() && (!memory_budget || _memory_usage > memory_budget))
+    {
+        EntryMap::iterator it = _entry.find(_unreferenced.front());
+
+        _unreferenced.pop_front();
+
+        _memory_usage -= it->second.byte_size;
+
+        _key_of_mesh.erase(it->second.mesh);
+        delete it->second.mesh;
+        _entry.erase(it);
+    }
+}
+
+size_t MeshRegistry::_ByteSize(const TriangulatedMesh3& mesh)
+{
+    size_t vertex_count = mesh.VertexCount(), face_count = mesh.FaceCount();
+
+    // host-side geometry
+    size_t byte_size = mesh.IsRenderOnly() ? 0 :
+                       vertex_count * (2 * sizeof(DCoordinate3) + sizeof(TCoordinate4)) +
+                       face_count * sizeof(TriangularFace);
+
+    // vertex buffer objects of single precision vertices, normals, texture coordinates and indices
+    if (mesh.HasVertexBufferObjects())
+        byte_size += vertex_count * (3 + 3 + 4) * sizeof(GLfloat) + face_count * 3 * sizeof(GLuint);
+
+    return byte_size;
+}
+
+TriangulatedMesh3* MeshRegistry::Acquire(const string& file_name, GLboolean translate_and_scale_to_unit_cube)
+{
+    TriangulatedMesh3 *mesh = AcquireIfRegistered(file_name, translate_and_scale_to_unit_cube);
+
+    if (mesh)
+        return mesh;
+
+    // the content of a file that has not been identified yet may be registered under another path
+    FileIdentity identity;
+    string       content;
+
+    if (!ReadFile(file_name, identity, content))
+        return nullptr;
+
+    Key key;
+    EntryMap::iterator it = _Find(identity, translate_and_scale_to_unit_cube, key);
+
+    if (it != _entry.end())
+        return _Reference(it);
+
+    // the hashed bytes are parsed, i.e., the file is not read again
+    TriangulatedMesh3 loaded_mesh;
+    istringstream     stream(content);
+
+    if (!loaded_mesh.LoadFromOFF(stream, translate_and_scale_to_unit_cube))
+        return nullptr;
+
+    return Register(identity, translate_and_scale_to_unit_cube, std::move(loaded_mesh));
+}
+
+TriangulatedMesh3* MeshRegistry::AcquireIfRegistered(const string& file_name, GLboolean translate_and_scale_to_unit_cube)
+{
+    FileStateMap::const_iterator cached = _file_state.find(_CanonicalFileName(file_name));
+
+    if (cached == _file_state.end())
+        return nullptr;
+
+    struct stat status;
+
+    if (stat(cached->first.c_str(), &status) ||
+        cached->second.byte_size != static_cast<unsigned long long>(status.st_size) ||
+        cached->second.modification_time != status.st_mtime)
+        return nullptr;
+
+    Key key;
+
+    key.hash                             = cached->second.hash;
+    key.byte_size                        = cached->second.byte_size;
+    key.translate_and_scale_to_unit_cube = translate_and_scale_to_unit_cube ? GL_TRUE : GL_FALSE;
+
+    EntryMap::iterator it = _entry.find(key);
+
+    return (it == _entry.end()) ? nullptr : _Reference(it);
+}
+
+TriangulatedMesh3* MeshRegistry::Register(
+        const FileIdentity& identity, GLboolean translate_and_scale_to_unit_cube, TriangulatedMesh3&& loaded_mesh)
+{
+    Key key;
+    EntryMap::iterator it = _Find(identity, translate_and_scale_to_unit_cube, key);
+
+    if (it != _entry.end())
+        return _Reference(it);
+
+    TriangulatedMesh3 *mesh = new TriangulatedMesh3(std::move(loaded_mesh));
+
+    Entry &entry = _entry[key];
+
+    entry.mesh            = mesh;
+    entry.reference_count = 1;
+    entry.byte_size       = 0;
+
+    _UpdateByteSize(entry);
+
+    _key_of_mesh[mesh] = key;
+
+    _Evict(_memory_budget);
+
+    return mesh;
+}
+
+GLboolean MeshRegistry::AddReference(const TriangulatedMesh3 *mesh)
+{
+    KeyMap::const_iterator key = _key_of_mesh.find(mesh);
+
+    if (key == _key_of_mesh.end())
+        return GL_FALSE;
+
+    _Reference(_entry.find(key->second));
+
+    return GL_TRUE;
+}
+
+GLboolean MeshRegistry::Release(const TriangulatedMesh3 *mesh)
+{
+    KeyMap::const_iterator key = _key_of_mesh.find(mesh);
+
+    if (key == _key_of_mesh.end())
+        return GL_FALSE;
+
+    Entry &entry = _entry.find(key->second)->second;
+
+    if (!entry.reference_count)
+        return GL_FALSE;
+
+    _UpdateByteSize(entry);
+
+    if (!--entry.reference_count)
+    {
+        entry.lru_position = _unreferenced.insert(_unreferenced.end(), key->second);
+        _Evict(_memory_budget);
+    }
+
+    return GL_TRUE;
+}
+
+GLuint MeshRegistry::MeshCount() const
+{
+    return static_cast<GLuint>(_entry.size());
+}
+
+GLuint MeshRegistry::ReferenceCount(const TriangulatedMesh3 *mesh) const
+{
+    KeyMap::const_iterator key = _key_of_mesh.find(mesh);
+
+    return (key == _key_of_mesh.end()) ? 0 : _entry.find(key->second)->second.reference_count;
+}
+
+size_t MeshRegistry::MemoryUsage() const
+{
+    return _memory_usage;
+}
+
+size_t MeshRegistry::MemoryBudget() const
+{
+    return _memory_budget;
+}
+
+GLvoid MeshRegistry::SetMemoryBudget(size_t memory_budget)
+{
+    _memory_budget = memory_budget;
+    _Evict(_memory_budget);
+}
+
+GLvoid MeshRegistry::Clear()
+{
+    _Evict(0);
+}
+
+MeshRegistry::~MeshRegistry()
+{
+    for (EntryMap::iterator it = _entry.begin(); it != _entry.end(); ++it)
+        delete it->second.mesh;
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <ctime>
+#include <list>
+#include <map>
+#include <string>
+#include "TriangulatedMeshes3.h"
+
+namespace cagd
+{
+    //-------------------
+    // class MeshRegistry
+    //-------------------
+    // Shares the triangulated meshes loaded from OFF files. The meshes are identified by the content of
+    // their files (i.e. by a 64-bit FNV-1a hash and the size of the file) and by the normalization flag of
+    // LoadFromOFF, therefore a file that is listed several times, or under different paths, or that is
+    // requested again after switching pages or scene variants, is parsed only once and the users of the
+    // mesh share its vertex buffer objects, too. The content hash of a file is cached by its canonical path,
+    // therefore AcquireIfRegistered does not read the file, it only compares the size and the modification
+    // time of the file with the cached ones. Files loaded elsewhere (e.g. by the workers of a MeshLoader) are
+    // read into memory by the static method ReadFile on the loading thread, which hashes the same bytes that
+    // are parsed afterwards, and they are registered by their precomputed identity.
+    //
+    // The meshes are reference counted. A mesh that is no longer referenced is not deleted immediately,
+    // it is kept in a least recently used list and it is deleted only if the estimated memory usage of the
+    // registered meshes (host-side geometry and vertex buffer objects) exceeds the memory budget. Note that
+    // referenced meshes are never evicted, i.e., the budget may be exceeded by them. The memory usage is a
+    // running total, the estimated size of a mesh is updated whenever its reference counter changes (e.g. its
+    // vertex buffer objects are usually created after its registration).
+    //
+    // The registry is not thread-safe. Since evicting a mesh deletes its vertex buffer objects, the methods
+    // Release, SetMemoryBudget, Clear and the destructor have to be called by the thread that owns the
+    // OpenGL rendering context (or before any vertex buffer object was created). Shared meshes should not be
+    // modified by their users.
+    class MeshRegistry
+    {
+    public:
+        // canonical path, size, modification time and content hash of a file
+        class FileIdentity
+        {
+        public:
+            std::string        canonical_file_name;
+            unsigned long long hash;
+            unsigned long long byte_size;
+            std::time_t        modification_time;
+
+            FileIdentity();
+        };
+
+    private:
+        class Key
+        {
+        public:
+            unsigned long long hash;
+            unsigned long long byte_size;
+            GLboolean          translate_and_scale_to_unit_cube;
+
+            bool operator <(const Key& rhs) const;
+        };
+
+        class Entry
+        {
+        public:
+            TriangulatedMesh3         *mesh;
+            GLuint                    reference_count;
+            size_t                    byte_size;    // estimated at the last change of the reference counter
+            std::list<Key>::iterator  lru_position; // valid only if the reference counter is zero
+        };
+
+        typedef std::map<Key, Entry>                        EntryMap;
+        typedef std::map<const TriangulatedMesh3*, Key>     KeyMap;
+        typedef std::map<std::string, FileIdentity>         FileStateMap;
+
+        EntryMap        _entry;
+        KeyMap          _key_of_mesh;
+        FileStateMap    _file_state;    // cached identities by canonical paths
+        std::list<Key>  _unreferenced;  // the least recently released mesh is the first one
+        size_t          _memory_budget; // in bytes
+        size_t          _memory_usage;  // sum of the estimated sizes of the entries
+
+        // canonical path of the given file, or the file name itself if it cannot be resolved
+        static std::string _CanonicalFileName(const std::string& file_name);
+
+        // caches the identity of a file and returns the entry of its content
+        EntryMap::iterator _Find(const FileIdentity& identity, GLboolean translate_and_scale_to_unit_cube, Key& key);
+
+        // increases the reference counter of the entry and removes it from the least recently used list
+        TriangulatedMesh3* _Reference(EntryMap::iterator it);
+
+        // estimates the size of the mesh of the entry again and updates the memory usage
+        GLvoid _UpdateByteSize(Entry& entry);
+
+        // deletes the least recently released meshes until the memory usage fits into the given budget
+        // (each unreferenced mesh is deleted if the budget is zero)
+        GLvoid _Evict(size_t memory_budget);
+
+        // estimated memory usage of a mesh
+        static size_t _ByteSize(const TriangulatedMesh3& mesh);
+
+        // registries cannot be copied
+        MeshRegistry(const MeshRegistry&);
+        MeshRegistry& operator =(const MeshRegistry&);
+
+    public:
+        // the default memory budget is 512 MB
+        MeshRegistry(size_t memory_budget = 512u << 20);
+
+        // reads the whole content of the given file and calculates its identity from the read bytes, GL_FALSE is
+        // returned if the file cannot be read; the method does not access any registry, thus it can be called by
+        // worker threads, too
+        static GLboolean ReadFile(const std::string& file_name, FileIdentity& identity, std::string& content);
+
+        // returns the shared mesh of the given file and increases its reference counter, the file is loaded
+        // only if its content has not been registered yet; returns a null pointer if the file cannot be loaded
+        TriangulatedMesh3* Acquire(const std::string& file_name, GLboolean translate_and_scale_to_unit_cube = GL_FALSE);
+
+        // similar to the previous method, but returns a null pointer instead of loading the file; the file is
+        // not read, i.e., only the cached identity of its canonical path is used if the size and the modification
+        // time of the file have not changed
+        TriangulatedMesh3* AcquireIfRegistered(const std::string& file_name, GLboolean translate_and_scale_to_unit_cube = GL_FALSE);
+
+        // registers a mesh that has been loaded elsewhere (e.g. by a MeshLoader) from the file of the given
+        // identity: if the content of the file is already registered, the given mesh is discarded and the
+        // registered one is acquired, otherwise the geometry of the given mesh is moved into a new entry
+        TriangulatedMesh3* Register(const FileIdentity& identity, GLboolean translate_and_scale_to_unit_cube,
+                                    TriangulatedMesh3&& loaded_mesh);
+
+        // increases the reference counter of a registered mesh
+        GLboolean AddReference(const TriangulatedMesh3 *mesh);
+
+        // decreases the reference counter of a registered mesh, unreferenced meshes may be evicted
+        GLboolean Release(const TriangulatedMesh3 *mesh);
+
+        // query methods
+        GLuint    MeshCount() const;
+        GLuint    ReferenceCount(const TriangulatedMesh3 *mesh) const;
+        size_t    MemoryUsage() const;
+        size_t    MemoryBudget() const;
+
+        // evicts unreferenced meshes if the new budget is smaller than the current memory usage
+        GLvoid SetMemoryBudget(size_t memory_budget);
+
+        // deletes every unreferenced mesh
+        GLvoid Clear();
+
+        // deletes every registered mesh, even the referenced ones
+        ~MeshRegistry();
+    };
+}
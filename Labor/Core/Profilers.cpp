@@ -0,0 +1,168 @@
+#include "Profilers.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+
+using namespace cagd;
+using namespace std;
+
+Profiler::Profiler(GLuint capacity): _next_event(0), _origin(Now())
+{
+    GLuint rounded_capacity = 1;
+
+    while (rounded_capacity < capacity)
+        rounded_capacity <<= 1;
+
+    vector<Slot> slot(rounded_capacity);
+    _slot.swap(slot);
+
+    for (vector<Slot>::iterator it = _slot.begin(); it != _slot.end(); ++it)
+        it->sequence.store(0, memory_order_relaxed);
+}
+
+Profiler& Profiler::Instance()
+{
+    // never deleted, since zones may be recorded by threads that outlive the static objects
+    static Profiler *profiler = new Profiler();
+
+    return *profiler;
+}
+
+unsigned long long Profiler::Now()
+{
+    return static_cast<unsigned long long>(
+            chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+GLuint Profiler::ThreadIndex()
+{
+    static atomic<GLuint> thread_count(0);
+    static thread_local GLuint thread_index = thread_count.fetch_add(1, memory_order_relaxed);
+
+    return thread_index;
+}
+
+GLuint Profiler::Capacity() const
+{
+    return static_cast<GLuint>(_slot.size());
+}
+
+GLvoid Profiler::Record(const char *zone, unsigned long long begin, unsigned long long end)
+{
+    unsigned long long event = _next_event.fetch_add(1, memory_order_relaxed);
+    Slot &slot = _slot[event & (_slot.size() - 1)];
+
+    // readers skip the slot until it is published again
+    slot.sequence.store(0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    slot.zone.store(zone, memory_order_relaxed);
+    slot.begin.store(begin, memory_order_relaxed);
+    slot.end.store(end, memory_order_relaxed);
+    slot.thread.store(ThreadIndex(), memory_order_relaxed);
+
+    slot.sequence.store(event + 1, memory_order_release);
+}
+
+GLvoid Profiler::_Snapshot(vector<Event>& events) const
+{
+    events.clear();
+    events.reserve(_slot.size());
+
+    unsigned long long last_event = _next_event.load(memory_order_acquire);
+    unsigned long long first_event = (last_event > _slot.size()) ? last_event - _slot.size() : 0;
+
+    for (unsigned long long event = first_event; event < last_event; ++event)
+    {
+        const Slot &slot = _slot[event & (_slot.size() - 1)];
+
+        if (slot.sequence.load(memory_order_acquire) != event + 1)
+            continue;
+
+        Event copy;
+
+        copy.zone   = slot.zone.load(memory_order_relaxed);
+        copy.begin  = slot.begin.load(memory_order_relaxed);
+        copy.end    = slot.end.load(memory_order_relaxed);
+        copy.thread = slot.thread.load(memory_order_relaxed);
+
+        // the slot may have been overwritten during the copy
+        atomic_thread_fence(memory_order_acquire);
+
+        if (slot.sequence.load(memory_order_relaxed) == event + 1)
+            events.push_back(copy);
+    }
+}
+
+GLvoid Profiler::CalculateStatistics(vector<ZoneStatistics>& statistics) const
+{
+    vector<Event> events;
+    _Snapshot(events);
+
+    // durations of each zone in milliseconds
+    map<string, vector<GLdouble> > durations;
+
+    for (vector<Event>::const_iterator it = events.begin(); it != events.end(); ++it)
+        durations[it->zone].push_back(1.0e-6 * static_cast<GLdouble>(it->end - it->begin));
+
+    statistics.clear();
+
+    for (map<string, vector<GLdouble> >::iterator it = durations.begin(); it != durations.end(); ++it)
+    {
+        vector<GLdouble> &duration = it->second;
+
+        ZoneStatistics zone;
+
+        zone.name         = it->first;
+        zone.sample_count = static_cast<GLuint>(duration.size());
+        zone.minimum      = *min_element(duration.begin(), duration.end());
+
+        GLdouble sum = 0.0;
+        for (vector<GLdouble>::const_iterator d = duration.begin(); d != duration.end(); ++d)
+            sum += *d;
+
+        zone.average = sum / duration.size();
+
+        vector<GLdouble>::iterator percentile = duration.begin() + (99 * (duration.size() - 1)) / 100;
+        nth_element(duration.begin(), percentile, duration.end());
+        zone.percentile_99 = *percentile;
+
+        statistics.push_back(zone);
+    }
+}
+
+GLboolean Profiler::ExportChromeTrace(const string& file_name) const
+{
+    FILE *file = fopen(file_name.c_str(), "w");
+
+    if (!file)
+        return GL_FALSE;
+
+    vector<Event> events;
+    _Snapshot(events);
+
+    // complete events ("ph": "X"), the timestamps and durations are measured in microseconds
+    fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [");
+
+    for (GLuint i = 0; i < events.size(); ++i)
+    {
+        const Event &event = events[i];
+
+        fprintf(file, "%s\n  {\"name\": \"%s\", \"cat\": \"cagd\", \"ph\": \"X\", \"pid\": 0, \"tid\": %u, \"ts\": %.3f, \"dur\": %.3f}",
+                i ? "," : "", event.zone, event.thread,
+                1.0e-3 * static_cast<GLdouble>(event.begin - min(event.begin, _origin)),
+                1.0e-3 * static_cast<GLdouble>(event.end - event.begin));
+    }
+
+    fprintf(file, "\n]}\n");
+
+    return fclose(file) == 0 ? GL_TRUE : GL_FALSE;
+}
+
+GLvoid Profiler::Clear()
+{
+    // the events are invalidated by advancing the counter past the whole ring buffer
+    _next_event.fetch_add(_slot.size(), memory_order_acq_rel);
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace cagd
+{
+    //---------------
+    // class Profiler
+    //---------------
+    // Records the CPU time intervals of named zones (see the macro CAGD_PROFILE_ZONE below) into a fixed-size
+    // ring buffer. Recording is lock-free and wait-free: each event claims a slot by an atomic counter and
+    // publishes it by a sequence number, therefore zones can be recorded by any thread (e.g. by the workers
+    // of a MeshLoader) while the rendering thread reads the statistics. Old events are overwritten, i.e., the
+    // statistics and the exported traces cover the last Capacity() events.
+    //
+    // The zone names have to be string literals (or other strings that live as long as the profiler), since
+    // only their addresses are recorded.
+    class Profiler
+    {
+    public:
+        // rolling statistics of a zone, measured in milliseconds
+        class ZoneStatistics
+        {
+        public:
+            std::string name;
+            GLuint      sample_count;
+            GLdouble    minimum, average, percentile_99;
+        };
+
+    private:
+        class Slot
+        {
+        public:
+            std::atomic<unsigned long long> sequence;   // index of the event + 1, 0 while it is being written
+            std::atomic<const char*>        zone;
+            std::atomic<unsigned long long> begin, end; // in nanoseconds
+            std::atomic<GLuint>             thread;
+        };
+
+        class Event
+        {
+        public:
+            const char          *zone;
+            unsigned long long  begin, end;
+            GLuint              thread;
+        };
+
+        std::vector<Slot>               _slot;
+        std::atomic<unsigned long long> _next_event;
+        unsigned long long              _origin;        // timestamp of the construction
+
+        // copies the consistent events of the ring buffer in recording order
+        GLvoid _Snapshot(std::vector<Event>& events) const;
+
+        // profilers cannot be copied
+        Profiler(const Profiler&);
+        Profiler& operator =(const Profiler&);
+
+    public:
+        // the capacity is rounded up to a power of two
+        explicit Profiler(GLuint capacity = 1u << 16);
+
+        // the profiler of the application
+        static Profiler& Instance();
+
+        // monotonic timestamp in nanoseconds
+        static unsigned long long Now();
+
+        // small integer identifier of the calling thread (in the order of the first recorded events)
+        static GLuint ThreadIndex();
+
+        GLuint Capacity() const;
+
+        GLvoid Record(const char *zone, unsigned long long begin, unsigned long long end);
+
+        // statistics of the recorded zones in alphabetical order
+        GLvoid CalculateStatistics(std::vector<ZoneStatistics>& statistics) const;
+
+        // writes the recorded events in the Chrome trace event format (it can be opened by chrome://tracing
+        // or by https://ui.perfetto.dev), returns GL_FALSE if the file cannot be written
+        GLboolean ExportChromeTrace(const std::string& file_name) const;
+
+        GLvoid Clear();
+    };
+
+    //------------------
+    // class ProfileZone
+    //------------------
+    // Records the lifetime of the object as an event of the given zone.
+    class ProfileZone
+    {
+    private:
+        const char          *_zone;
+        unsigned long long  _begin;
+
+        ProfileZone(const ProfileZone&);
+        ProfileZone& operator =(const ProfileZone&);
+
+    public:
+        explicit ProfileZone(const char *zone): _zone(zone), _begin(Profiler::Now())
+        {
+        }
+
+        ~ProfileZone()
+        {
+            Profiler::Instance().Record(_zone, _begin, Profiler::Now());
+        }
+    };
+}
+
+// The zones are compiled only if CAGD_PROFILING is defined (see cagd_core.pri: debug builds define it,
+// release builds define it only if they are configured with CONFIG+=cagd_profiling), otherwise they cost nothing.
+#define CAGD_PROFILE_CONCATENATE_IMPLEMENTATION(a, b) a##b
+#define CAGD_PROFILE_CONCATENATE(a, b) CAGD_PROFILE_CONCATENATE_IMPLEMENTATION(a, b)
+
+#if defined(CAGD_PROFILING)
+#define CAGD_PROFILE_ZONE(name) cagd::ProfileZone CAGD_PROFILE_CONCATENATE(_profile_zone_, __LINE__)(name)
+#else
+#define CAGD_PROFILE_ZONE(name)
+#endif
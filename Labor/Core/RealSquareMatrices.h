@@ -2,8 +2,10 @@
 
 #include <GL/glew.h>
 #include <limits>
+#include <algorithm>
 #include <cmath>
 #include "Matrices.h"
+#include "RowOperations.h"
 
 namespace cagd
 {
@@ -23,6 +25,10 @@ namespace cagd
         // homework: assignment operator
         RealSquareMatrix& operator =(const RealSquareMatrix& rhs);
 
+        // move constructor and move assignment operator
+        RealSquareMatrix(RealSquareMatrix&& m) noexcept;
+        RealSquareMatrix& operator =(RealSquareMatrix&& rhs) noexcept;
+
         // homework: square matrices have the same number of rows and columns!
         GLboolean ResizeRows(GLuint row_count);
         GLboolean ResizeColumns(GLuint column_count);
@@ -35,6 +41,8 @@ namespace cagd
         // Here matrix A corresponds to *this.
         // Advantage: T can be either GLdouble or DCoordinate, 
         // or any other type which has similar mathematical operators.
+        // The independent systems are distributed among OpenMP threads (if enabled); in case of column
+        // representation each thread updates whole row segments of RIGHT_HAND_SIDE_BLOCK_SIZE systems.
         template <class T>
         GLboolean SolveLinearSystem(const Matrix<T>& b, Matrix<T>& x, GLboolean represent_solutions_as_columns = GL_TRUE);
     };
@@ -58,6 +66,28 @@ namespace cagd
         return *this;
     }
 
+    inline RealSquareMatrix::RealSquareMatrix(RealSquareMatrix&& m) noexcept:
+        Matrix<GLdouble>(std::move(m)),
+        _lu_decomposition_is_done(m._lu_decomposition_is_done),
+        _row_permutation(std::move(m._row_permutation))
+    {
+        m._lu_decomposition_is_done = GL_FALSE;
+    }
+
+    inline RealSquareMatrix& RealSquareMatrix::operator =(RealSquareMatrix&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            Matrix<GLdouble>::operator=(std::move(rhs));
+            this->_lu_decomposition_is_done = rhs._lu_decomposition_is_done;
+            this->_row_permutation = std::move(rhs._row_permutation);
+
+            rhs._lu_decomposition_is_done = GL_FALSE;
+        }
+
+        return *this;
+    }
+
     inline GLboolean RealSquareMatrix::ResizeRows(GLuint row_count)
     {
         return Matrix<GLdouble>::ResizeRows(row_count) && Matrix<GLdouble>::ResizeColumns(row_count);
@@ -83,29 +113,37 @@ namespace cagd
 
             x = b;
 
-            for (GLuint k = 0; k < b.GetColumnCount(); ++k)
+            GLint rhs_count   = static_cast<GLint>(b.GetColumnCount());
+            GLint block_count = (rhs_count + RIGHT_HAND_SIDE_BLOCK_SIZE - 1) / RIGHT_HAND_SIDE_BLOCK_SIZE;
+
+            #pragma omp parallel for schedule(static) if (block_count > 1)
+            for (GLint block = 0; block < block_count; ++block)
             {
-                GLint ii = 0;
+                GLuint first = block * RIGHT_HAND_SIDE_BLOCK_SIZE;
+                GLuint count = std::min<GLuint>(RIGHT_HAND_SIDE_BLOCK_SIZE, rhs_count - first);
+
+                // forward substitution, the i-th row of the right-hand sides is accumulated while it
+                // stays in cache (the subtractions are performed in the same order as in the case of
+                // row representation)
                 for (GLint i = 0; i < size; ++i)
                 {
                     GLuint ip = _row_permutation[i];
-                    T sum = x(ip, k);
-                    x(ip, k) = x(i, k);
-                    if (ii != 0)
-                        for (GLint j = ii - 1; j < i; ++j)
-                            sum -= _data[i][j] * x(j, k);
-                    else
-                        if (sum != 0.0)
-                            ii = i + 1;
-                    x(i, k) = sum;
+                    if (ip != static_cast<GLuint>(i))
+                        std::swap_ranges(&x(i, first), &x(i, first) + count, &x(ip, first));
+
+                    for (GLint j = 0; j < i; ++j)
+                        if (_data[i][j] != 0.0)
+                            SubtractScaledRow(count, _data[i][j], &x(j, first), &x(i, first));
                 }
 
+                // backward substitution
                 for (GLint i = size - 1; i >= 0; --i)
                 {
-                    T sum = x(i, k);
                     for (GLint j = i + 1; j < size; ++j)
-                        sum -= _data[i][j] * x(j, k);
-                    x(i, k) = sum /= _data[i][i];
+                        if (_data[i][j] != 0.0)
+                            SubtractScaledRow(count, _data[i][j], &x(j, first), &x(i, first));
+
+                    DivideRow(count, _data[i][i], &x(i, first));
                 }
             }
         }
@@ -117,7 +155,10 @@ namespace cagd
 
             x = b;
 
-            for (GLuint k = 0; k < b.GetRowCount(); ++k)
+            GLint rhs_count = static_cast<GLint>(b.GetRowCount());
+
+            #pragma omp parallel for schedule(static) if (rhs_count > static_cast<GLint>(RIGHT_HAND_SIDE_BLOCK_SIZE))
+            for (GLint k = 0; k < rhs_count; ++k)
             {
                 GLint ii = 0;
                 for (GLint i = 0; i < size; ++i)
@@ -182,7 +223,7 @@ inline GLboolean RealSquareMatrix::PerformLUDecomposition()
         GLdouble big = 0.0;
         for (std::vector<GLdouble>::const_iterator itc = itr->begin(); itc < itr->end(); ++itc)
         {
-            GLdouble temp = abs(*itc);
+            GLdouble temp = std::abs(*itc);
             if (temp > big)
                     big = temp;
         }
@@ -205,7 +246,7 @@ inline GLboolean RealSquareMatrix::PerformLUDecomposition()
         GLdouble big = 0.0;
         for (GLuint i = k; i < size; ++i)
         {
-            GLdouble temp = implicit_scaling_of_each_row[i] * abs(_data[i][k]);
+            GLdouble temp = implicit_scaling_of_each_row[i] * std::abs(_data[i][k]);
             if (temp > big)
             {
                 big = temp;
@@ -0,0 +1,84 @@
+#include "RowOperations.h"
+
+// selecting the widest available instruction set at compile time
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define CAGD_ROW_OPERATIONS_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define CAGD_ROW_OPERATIONS_SSE2
+#endif
+
+using namespace cagd;
+using namespace std;
+
+static_assert(sizeof(DCoordinate3) == 3 * sizeof(GLdouble), "DCoordinate3 has to be a tightly packed triplet of doubles");
+
+namespace
+{
+    // flat update of n doubles, the products are not fused with the subtractions, thus the results
+    // coincide with the ones of the scalar loop
+    GLvoid subtractScaled(GLuint n, GLdouble factor, const GLdouble *source, GLdouble *destination)
+    {
+        GLuint k = 0;
+
+#if defined(CAGD_ROW_OPERATIONS_AVX)
+        __m256d f = _mm256_set1_pd(factor);
+
+        for (; k + 4 <= n; k += 4)
+            _mm256_storeu_pd(destination + k,
+                             _mm256_sub_pd(_mm256_loadu_pd(destination + k),
+                                           _mm256_mul_pd(f, _mm256_loadu_pd(source + k))));
+#elif defined(CAGD_ROW_OPERATIONS_SSE2)
+        __m128d f = _mm_set1_pd(factor);
+
+        for (; k + 2 <= n; k += 2)
+            _mm_storeu_pd(destination + k,
+                          _mm_sub_pd(_mm_loadu_pd(destination + k),
+                                     _mm_mul_pd(f, _mm_loadu_pd(source + k))));
+#endif
+
+        for (; k < n; ++k)
+            destination[k] -= factor * source[k];
+    }
+
+    GLvoid divide(GLuint n, GLdouble divisor, GLdouble *row)
+    {
+        GLuint k = 0;
+
+#if defined(CAGD_ROW_OPERATIONS_AVX)
+        __m256d d = _mm256_set1_pd(divisor);
+
+        for (; k + 4 <= n; k += 4)
+            _mm256_storeu_pd(row + k, _mm256_div_pd(_mm256_loadu_pd(row + k), d));
+#elif defined(CAGD_ROW_OPERATIONS_SSE2)
+        __m128d d = _mm_set1_pd(divisor);
+
+        for (; k + 2 <= n; k += 2)
+            _mm_storeu_pd(row + k, _mm_div_pd(_mm_loadu_pd(row + k), d));
+#endif
+
+        for (; k < n; ++k)
+            row[k] /= divisor;
+    }
+}
+
+GLvoid cagd::SubtractScaledRow(GLuint count, GLdouble factor, const GLdouble *source, GLdouble *destination)
+{
+    subtractScaled(count, factor, source, destination);
+}
+
+GLvoid cagd::SubtractScaledRow(GLuint count, GLdouble factor, const DCoordinate3 *source, DCoordinate3 *destination)
+{
+    subtractScaled(3 * count, factor, reinterpret_cast<const GLdouble*>(source), reinterpret_cast<GLdouble*>(destination));
+}
+
+GLvoid cagd::DivideRow(GLuint count, GLdouble divisor, GLdouble *row)
+{
+    divide(count, divisor, row);
+}
+
+GLvoid cagd::DivideRow(GLuint count, GLdouble divisor, DCoordinate3 *row)
+{
+    divide(3 * count, divisor, reinterpret_cast<GLdouble*>(row));
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <GL/glew.h>
+#include "DCoordinates3.h"
+
+namespace cagd
+{
+    // Row operations of the forward and backward substitutions of the LU solvers. If the solutions are
+    // represented as columns, a row of the right-hand side matrix stores the same unknown of several
+    // linear systems contiguously, thus a single row operation updates all of these systems at once.
+    // The overloads for doubles and Descartes coordinates are implemented by packed SSE2/AVX
+    // instructions, i.e., the x, y and z components of consecutive right-hand sides are processed as
+    // the lanes of a flat array of 3 * count doubles.
+
+    // number of right-hand sides the rows of which are updated together by a thread of the solvers
+    static const GLuint RIGHT_HAND_SIDE_BLOCK_SIZE = 32;
+
+    // destination[k] -= factor * source[k], k = 0, 1, ..., count - 1
+    GLvoid SubtractScaledRow(GLuint count, GLdouble factor, const GLdouble *source, GLdouble *destination);
+    GLvoid SubtractScaledRow(GLuint count, GLdouble factor, const DCoordinate3 *source, DCoordinate3 *destination);
+
+    // row[k] /= divisor, k = 0, 1, ..., count - 1
+    GLvoid DivideRow(GLuint count, GLdouble divisor, GLdouble *row);
+    GLvoid DivideRow(GLuint count, GLdouble divisor, DCoordinate3 *row);
+
+    // fallbacks for any other type that has similar mathematical operators
+    template <class T>
+    inline GLvoid SubtractScaledRow(GLuint count, GLdouble factor, const T *source, T *destination)
+    {
+        for (GLuint k = 0; k < count; ++k)
+            destination[k] -= factor * source[k];
+    }
+
+    template <class T>
+    inline GLvoid DivideRow(GLuint count, GLdouble divisor, T *row)
+    {
+        for (GLuint k = 0; k < count; ++k)
+            row[k] /= divisor;
+    }
+}
@@ -1,5 +1,6 @@
 #include "TensorProductSurfaces3.h"
-#include "RealSquareMatrices.h"
+#include "BandedMatrices.h"
+#include "Profilers.h"
 #include <algorithm>
 
 using namespace cagd;
@@ -28,6 +29,11 @@ TensorProductSurface3::TensorProductSurface3(
 
     _u_closed = u_closed;
     _v_closed = v_closed;
+
+    _vbo_data = nullptr;
+
+    _u_collocation_matrix_is_valid = GL_FALSE;
+    _v_collocation_matrix_is_valid = GL_FALSE;
 }
 
 TensorProductSurface3::TensorProductSurface3(const TensorProductSurface3& surface)
@@ -42,10 +48,23 @@ TensorProductSurface3::TensorProductSurface3(const TensorProductSurface3& surfac
 
     _u_closed = surface._u_closed;
     _v_closed = surface._v_closed;
+
+    _u_collocation_knot_vector = surface._u_collocation_knot_vector;
+    _v_collocation_knot_vector = surface._v_collocation_knot_vector;
+    _u_collocation_matrix = surface._u_collocation_matrix;
+    _v_collocation_matrix = surface._v_collocation_matrix;
+    _u_collocation_matrix_is_valid = surface._u_collocation_matrix_is_valid;
+    _v_collocation_matrix_is_valid = surface._v_collocation_matrix_is_valid;
+
+    // the vertex buffer object of the control net is duplicated on the GPU
+    _vbo_data = surface._vbo_data ? surface._vbo_data->Clone() : nullptr;
 }
 
 TensorProductSurface3& TensorProductSurface3::operator =(const TensorProductSurface3& surface)
 {
+    if (this == &surface)
+        return *this;
+
     _u_min = surface._u_min;
     _u_max = surface._u_max;
 
@@ -57,10 +76,67 @@ TensorProductSurface3& TensorProductSurface3::operator =(const TensorProductSurf
     _u_closed = surface._u_closed;
     _v_closed = surface._v_closed;
 
-    _vbo_data = 0;
+    _u_collocation_knot_vector = surface._u_collocation_knot_vector;
+    _v_collocation_knot_vector = surface._v_collocation_knot_vector;
+    _u_collocation_matrix = surface._u_collocation_matrix;
+    _v_collocation_matrix = surface._v_collocation_matrix;
+    _u_collocation_matrix_is_valid = surface._u_collocation_matrix_is_valid;
+    _v_collocation_matrix_is_valid = surface._v_collocation_matrix_is_valid;
+
+    DeleteVertexBufferObjectsOfData();
+
+    _vbo_data = surface._vbo_data ? surface._vbo_data->Clone() : nullptr;
+
+    return *this;
+}
+
+TensorProductSurface3::TensorProductSurface3(TensorProductSurface3&& surface) noexcept:
+    _u_closed(surface._u_closed), _v_closed(surface._v_closed),
+    _vbo_data(surface._vbo_data),
+    _u_min(surface._u_min), _u_max(surface._u_max),
+    _v_min(surface._v_min), _v_max(surface._v_max),
+    _data(std::move(surface._data)),
+    _u_collocation_knot_vector(std::move(surface._u_collocation_knot_vector)),
+    _v_collocation_knot_vector(std::move(surface._v_collocation_knot_vector)),
+    _u_collocation_matrix(std::move(surface._u_collocation_matrix)),
+    _v_collocation_matrix(std::move(surface._v_collocation_matrix)),
+    _u_collocation_matrix_is_valid(surface._u_collocation_matrix_is_valid),
+    _v_collocation_matrix_is_valid(surface._v_collocation_matrix_is_valid)
+{
+    surface._vbo_data = nullptr;
+    surface._u_collocation_matrix_is_valid = GL_FALSE;
+    surface._v_collocation_matrix_is_valid = GL_FALSE;
+}
+
+TensorProductSurface3& TensorProductSurface3::operator =(TensorProductSurface3&& surface) noexcept
+{
+    if (this == &surface)
+        return *this;
+
+    DeleteVertexBufferObjectsOfData();
+
+    _u_min = surface._u_min;
+    _u_max = surface._u_max;
+
+    _v_min = surface._v_min;
+    _v_max = surface._v_max;
+
+    _data = std::move(surface._data);
+
+    _u_closed = surface._u_closed;
+    _v_closed = surface._v_closed;
+
+    _u_collocation_knot_vector = std::move(surface._u_collocation_knot_vector);
+    _v_collocation_knot_vector = std::move(surface._v_collocation_knot_vector);
+    _u_collocation_matrix = std::move(surface._u_collocation_matrix);
+    _v_collocation_matrix = std::move(surface._v_collocation_matrix);
+    _u_collocation_matrix_is_valid = surface._u_collocation_matrix_is_valid;
+    _v_collocation_matrix_is_valid = surface._v_collocation_matrix_is_valid;
+    surface._u_collocation_matrix_is_valid = GL_FALSE;
+    surface._v_collocation_matrix_is_valid = GL_FALSE;
 
-    if (surface._vbo_data)
-     UpdateVertexBufferObjectsOfData();
+    _vbo_data = surface._vbo_data;
+    surface._vbo_data = nullptr;
 
     return *this;
 }
@@ -144,104 +220,11 @@ DCoordinate3& TensorProductSurface3::operator ()(GLuint row, GLuint column)
 }
 
 
-GLboolean TensorProductSurface3::RenderData(GLenum render_mode) const
-{
-    if(!_vbo_data)
-        return GL_FALSE;
-
-    glEnableClientState(GL_VERTEX_ARRAY);
-
-        glBindBuffer(GL_ARRAY_BUFFER, _vbo_data);
-
-        glVertexPointer(3, GL_FLOAT, 0, (const GLvoid*)0);
-          GLuint offset = 0;
-          for (GLuint r = 0; r < _data.GetRowCount(); ++r) {
-            glDrawArrays(render_mode, offset, _data.GetColumnCount());
-            offset += _data.GetColumnCount();
-          }
-
-          for (GLuint r = 0; r < _data.GetColumnCount(); ++r) {
-            glDrawArrays(render_mode, offset, _data.GetRowCount());
-            offset += _data.GetRowCount();
-          }
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glDisableClientState(GL_VERTEX_ARRAY);
-
-    return GL_TRUE;
-}
-GLboolean TensorProductSurface3::UpdateVertexBufferObjectsOfData(GLenum usage_flag)
-{
-    if (usage_flag != GL_STREAM_DRAW  && usage_flag != GL_STREAM_READ  && usage_flag != GL_STREAM_COPY
-     && usage_flag != GL_STATIC_DRAW  && usage_flag != GL_STATIC_READ  && usage_flag != GL_STATIC_COPY
-     && usage_flag != GL_DYNAMIC_DRAW && usage_flag != GL_DYNAMIC_READ && usage_flag != GL_DYNAMIC_COPY)
-        return GL_FALSE;
-
-    // deleting old vertex buffer objects
-    DeleteVertexBufferObjectsOfData();
-
-    // creating vertex buffer objects of mesh vertices, unit normal vectors, texture coordinates,
-    // and element indices
-    glGenBuffers(1, &_vbo_data);
-
-    if (!_vbo_data)
-        return GL_FALSE;
-
-    GLuint data_byte_size = 2 * _data.GetRowCount() * _data.GetColumnCount() * 3 * sizeof(GLfloat);
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo_data);
-    glBufferData(GL_ARRAY_BUFFER, data_byte_size, 0, usage_flag);
-
-    GLfloat *data_coordinate = (GLfloat*)glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
-
-    if (!data_coordinate)
-    {
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        DeleteVertexBufferObjectsOfData();
-        return GL_FALSE;
-    }
-    //Mutatta Agoston, hogy sobanfolytonosan es oszlopfolytonosan is fel kell tolteni a buffert
-    for (GLuint r = 0; r < _data.GetRowCount(); ++r) {
-        for (GLuint c = 0; c < _data.GetColumnCount(); ++c) {
-          for (GLuint j = 0; j < 3; ++j) {
-            *data_coordinate = (GLfloat)_data(r, c)[j];
-            ++data_coordinate;
-          }
-        }
-      }
-
-      for (GLuint c = 0; c < _data.GetColumnCount(); ++c) {
-        for (GLuint r = 0; r < _data.GetRowCount(); ++r) {
-          for (GLuint j = 0; j < 3; ++j) {
-            *data_coordinate = (GLfloat)_data(r, c)[j];
-            ++data_coordinate;
-          }
-        }
-      }
-
-      if (!glUnmapBuffer(GL_ARRAY_BUFFER)) {
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        DeleteVertexBufferObjectsOfData();
-        return GL_FALSE;
-      }
-
-      if (!glUnmapBuffer(GL_ARRAY_BUFFER)) {
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        DeleteVertexBufferObjectsOfData();
-        return GL_FALSE;
-      }
-
-      glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-    return GL_TRUE;
-}
-
+// the buffer object is released by the GPU-resource layer through the virtual destructor
 GLvoid TensorProductSurface3::DeleteVertexBufferObjectsOfData()
 {
-    if(_vbo_data)
-    {
-        glDeleteBuffers(1, &_vbo_data);
-        _vbo_data = 0;
-    }
+    delete _vbo_data;
+    _vbo_data = nullptr;
 }
 
 
@@ -249,21 +232,23 @@ GLvoid TensorProductSurface3::DeleteVertexBufferObjectsOfData()
 // generates the image (i.e., the approximating triangulated mesh) of the tensor product surface
 TriangulatedMesh3* TensorProductSurface3::GenerateImage(GLuint u_div_point_count, GLuint v_div_point_count, GLenum usage_flag) const
 {
+    CAGD_PROFILE_ZONE("TensorProductSurface3::GenerateImage");
+
     if (u_div_point_count <= 1 || v_div_point_count <= 1)
         return GL_FALSE;
 
     // calculating number of vertices, unit normal vectors and texture coordinates
     GLuint vertex_count = u_div_point_count * v_div_point_count;
 
-    // calculating number of triangular faces
-    GLuint face_count = 2 * (u_div_point_count - 1) * (v_div_point_count - 1);
-
     TriangulatedMesh3 *result = nullptr;
-    result = new TriangulatedMesh3(vertex_count, face_count, usage_flag);
+    result = new TriangulatedMesh3(vertex_count, 0, usage_flag);
 
     if (!result)
         return nullptr;
 
+    // the faces are shared by all grids of the same size
+    result->_SetGridTopology(u_div_point_count, v_div_point_count);
+
     // uniform subdivision grid in the definition domain
     GLdouble du = (_u_max - _u_min) / (u_div_point_count - 1);
     GLdouble dv = (_v_max - _v_min) / (v_div_point_count - 1);
@@ -272,9 +257,6 @@ TriangulatedMesh3* TensorProductSurface3::GenerateImage(GLuint u_div_point_count
     GLfloat sdu = 1.0f / (u_div_point_count - 1);
     GLfloat tdv = 1.0f / (v_div_point_count - 1);
 
-    // for face indexing
-    GLuint current_face = 0;
-
     // partial derivatives of order 0, 1, 2, and 3
     PartialDerivatives pd;
 
@@ -287,46 +269,22 @@ TriangulatedMesh3* TensorProductSurface3::GenerateImage(GLuint u_div_point_count
             GLdouble v = min(_v_min + j * dv, _v_max);
             GLfloat  t = min(j * tdv, 1.0f);
 
-            /*
-                3-2
-                |/|
-                0-1
-            */
-            GLuint index[4];
-
-            index[0] = i * v_div_point_count + j;
-            index[1] = index[0] + 1;
-            index[2] = index[1] + v_div_point_count;
-            index[3] = index[2] - 1;
+            GLuint index = i * v_div_point_count + j;
 
             // calculating all needed surface data
             CalculatePartialDerivatives(1, u, v, pd);
 
             // surface point
-            (*result)._vertex[index[0]] = pd(0, 0);
+            (*result)._vertex[index] = pd(0, 0);
 
             // unit surface normal
-            (*result)._normal[index[0]] = pd(1, 0);
-            (*result)._normal[index[0]] ^= pd(1, 1);
-            (*result)._normal[index[0]].normalize();
+            (*result)._normal[index] = pd(1, 0);
+            (*result)._normal[index] ^= pd(1, 1);
+            (*result)._normal[index].normalize();
 
             // texture coordinates
-            (*result)._tex[index[0]].s() = s;
-            (*result)._tex[index[0]].t() = t;
-
-            // faces
-            if (i < u_div_point_count - 1 && j < v_div_point_count - 1)
-            {
-                (*result)._face[current_face][0] = index[0];
-                (*result)._face[current_face][1] = index[1];
-                (*result)._face[current_face][2] = index[2];
-                ++current_face;
-
-                (*result)._face[current_face][0] = index[0];
-                (*result)._face[current_face][1] = index[2];
-                (*result)._face[current_face][2] = index[3];
-                ++current_face;
-            }
+            (*result)._tex[index].s() = s;
+            (*result)._tex[index].t() = t;
         }
     }
 
@@ -336,6 +294,8 @@ TriangulatedMesh3* TensorProductSurface3::GenerateImage(GLuint u_div_point_count
 // ensures interpolation, i.e. s(u_i, v_j) = d_{i,j}
 GLboolean TensorProductSurface3::UpdateDataForInterpolation(const RowMatrix<GLdouble>& u_knot_vector, const ColumnMatrix<GLdouble>& v_knot_vector, Matrix<DCoordinate3>& data_points_to_interpolate)
 {
+    CAGD_PROFILE_ZONE("TensorProductSurface3::UpdateDataForInterpolation");
+
     GLuint row_count = _data.GetRowCount();
     if (!row_count)
         return GL_FALSE;
@@ -347,36 +307,66 @@ GLboolean TensorProductSurface3::UpdateDataForInterpolation(const RowMatrix<GLdo
     if (u_knot_vector.GetColumnCount() != row_count || v_knot_vector.GetRowCount() != column_count || data_points_to_interpolate.GetRowCount() != row_count || data_points_to_interpolate.GetColumnCount() != column_count)
         return GL_FALSE;
 
-    // 1: calculate the u-collocation matrix and perfom LU-decomposition on it
-    RowMatrix<GLdouble> u_blending_values;
+    // 1: calculate the u-collocation matrix and perfom LU-decomposition on it, unless it is cached
+    GLboolean u_knot_vector_is_cached = _u_collocation_matrix_is_valid && _u_collocation_knot_vector.size() == row_count;
 
-    RealSquareMatrix u_collocation_matrix(row_count);
+    for (GLuint i = 0; u_knot_vector_is_cached && i < row_count; ++i)
+        u_knot_vector_is_cached = (_u_collocation_knot_vector[i] == u_knot_vector(i));
 
-    for (GLuint i = 0; i < row_count; ++i)
+    if (!u_knot_vector_is_cached)
     {
-        if (!UBlendingFunctionValues(u_knot_vector(i), u_blending_values))
+        _u_collocation_matrix_is_valid = GL_FALSE;
+        _u_collocation_matrix = CollocationMatrix(row_count);
+
+        RowMatrix<GLdouble> u_blending_values;
+
+        for (GLuint i = 0; i < row_count; ++i)
+        {
+            if (!UBlendingFunctionValues(u_knot_vector(i), u_blending_values))
+                return GL_FALSE;
+            _u_collocation_matrix.SetRow(i, u_blending_values);
+        }
+
+        if (!_u_collocation_matrix.PerformLUDecomposition())
             return GL_FALSE;
-        u_collocation_matrix.SetRow(i, u_blending_values);
-    }
 
-    if (!u_collocation_matrix.PerformLUDecomposition())
-        return GL_FALSE;
+        _u_collocation_knot_vector.resize(row_count);
+        for (GLuint i = 0; i < row_count; ++i)
+            _u_collocation_knot_vector[i] = u_knot_vector(i);
 
-    // 2: calculate the v-collocation matrix and perform LU-decomposition on it
-    RowMatrix<GLdouble> v_blending_values;
+        _u_collocation_matrix_is_valid = GL_TRUE;
+    }
 
-    RealSquareMatrix v_collocation_matrix(column_count);
+    // 2: calculate the v-collocation matrix and perform LU-decomposition on it, unless it is cached
+    GLboolean v_knot_vector_is_cached = _v_collocation_matrix_is_valid && _v_collocation_knot_vector.size() == column_count;
 
-    for (GLuint j = 0; j < column_count; ++j)
+    for (GLuint j = 0; v_knot_vector_is_cached && j < column_count; ++j)
+        v_knot_vector_is_cached = (_v_collocation_knot_vector[j] == v_knot_vector(j));
+
+    if (!v_knot_vector_is_cached)
     {
-        if (!VBlendingFunctionValues(v_knot_vector(j), v_blending_values))
-            return GL_FALSE;
-        v_collocation_matrix.SetRow(j, v_blending_values);
-    }
+        _v_collocation_matrix_is_valid = GL_FALSE;
+        _v_collocation_matrix = CollocationMatrix(column_count);
 
-    if (!v_collocation_matrix.PerformLUDecomposition())
+        RowMatrix<GLdouble> v_blending_values;
+
+        for (GLuint j = 0; j < column_count; ++j)
+        {
+            if (!VBlendingFunctionValues(v_knot_vector(j), v_blending_values))
+                return GL_FALSE;
+            _v_collocation_matrix.SetRow(j, v_blending_values);
+        }
+
+        if (!_v_collocation_matrix.PerformLUDecomposition())
             return GL_FALSE;
 
+        _v_collocation_knot_vector.resize(column_count);
+        for (GLuint j = 0; j < column_count; ++j)
+            _v_collocation_knot_vector[j] = v_knot_vector(j);
+
+        _v_collocation_matrix_is_valid = GL_TRUE;
+    }
+
     // 3:   for all fixed j in {0, 1,..., column_count} determine control points
     //
     //      a_k(v_j) = sum_{l=0}^{column_count} _data(l, j) G_l(v_j), k = 0, 1,..., row_count
@@ -387,7 +377,7 @@ GLboolean TensorProductSurface3::UpdateDataForInterpolation(const RowMatrix<GLdo
     //
     //      for all i = 0, 1,..., row_count.
     Matrix<DCoordinate3> a(row_count, column_count);
-    if (!u_collocation_matrix.SolveLinearSystem(data_points_to_interpolate, a))
+    if (!_u_collocation_matrix.SolveLinearSystem(data_points_to_interpolate, a))
         return GL_FALSE;
 
     // 4:   for all fixed i in {0, 1,..., row_count} determine control point
@@ -399,12 +389,36 @@ GLboolean TensorProductSurface3::UpdateDataForInterpolation(const RowMatrix<GLdo
     //      sum_{l=0}^{column_count} _data(i, l) G_l(v_j) = a_i(v_j)
     //
     //      for all j = 0, 1,..., column_count.
-    if (!v_collocation_matrix.SolveLinearSystem(a, _data, GL_FALSE))
+    //
+    //      These systems are solved on the transpose of a in column representation, since then the
+    //      substitutions update the same unknown of all systems by a single row operation.
+    Matrix<DCoordinate3> a_transposed(column_count, row_count), data_transposed;
+
+    for (GLuint i = 0; i < row_count; ++i)
+        for (GLuint j = 0; j < column_count; ++j)
+            a_transposed(j, i) = a(i, j);
+
+    if (!_v_collocation_matrix.SolveLinearSystem(a_transposed, data_transposed))
         return GL_FALSE;
 
+    for (GLuint i = 0; i < row_count; ++i)
+        for (GLuint j = 0; j < column_count; ++j)
+            _data(i, j) = data_transposed(j, i);
+
     return GL_TRUE;
 }
 
+// the cached LU decompositions of the collocation matrices are discarded
+GLvoid TensorProductSurface3::_InvalidateUCollocationMatrix()
+{
+    _u_collocation_matrix_is_valid = GL_FALSE;
+}
+
+GLvoid TensorProductSurface3::_InvalidateVCollocationMatrix()
+{
+    _v_collocation_matrix_is_valid = GL_FALSE;
+}
+
 
 TensorProductSurface3::~TensorProductSurface3()
 {
@@ -438,6 +452,8 @@ RowMatrix<GenericCurve3*>* TensorProductSurface3::GenerateUIsoparametricLines(
   GLdouble v_step = (_v_max - _v_min) / (iso_line_count - 1);
   GLdouble u_step = (_u_max - _u_min) / (div_point_count - 1);
 
+  PartialDerivatives pd(maximum_order_of_derivatives);
+
   for (GLuint i = 0; i < iso_line_count; i++) {
     (*result)[i] = new GenericCurve3(maximum_order_of_derivatives, div_point_count, usage_flag);
 
@@ -451,7 +467,6 @@ RowMatrix<GenericCurve3*>* TensorProductSurface3::GenerateUIsoparametricLines(
     GLdouble v = min(_v_min + i * v_step, _v_max);
 
     for (GLuint j = 0; j < div_point_count; j++) {
-      PartialDerivatives pd;
       GLdouble u = min(_u_min + j * u_step, _u_max);
 
       if (!CalculatePartialDerivatives(maximum_order_of_derivatives, u, v, pd)) {
@@ -486,6 +501,8 @@ RowMatrix<GenericCurve3*>* TensorProductSurface3::GenerateVIsoparametricLines(
   GLdouble u_step = (_u_max - _u_min) / (iso_line_count - 1);
   GLdouble v_step = (_v_max - _v_min) / (div_point_count - 1);
 
+  PartialDerivatives pd(maximum_order_of_derivatives);
+
   for (GLuint i = 0; i < iso_line_count; i++)
   {
     (*result)[i] = new GenericCurve3(maximum_order_of_derivatives, div_point_count, usage_flag);
@@ -503,7 +520,6 @@ RowMatrix<GenericCurve3*>* TensorProductSurface3::GenerateVIsoparametricLines(
 
     for (GLuint j = 0; j < div_point_count; j++)
     {
-      PartialDerivatives pd;
       GLdouble v = min(_v_min + j * v_step, _v_max);
 
       if (!CalculatePartialDerivatives(maximum_order_of_derivatives, u, v, pd))
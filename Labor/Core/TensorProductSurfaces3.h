@@ -1,11 +1,13 @@
 #pragma once
 
+#include "BandedMatrices.h"
 #include "DCoordinates3.h"
 #include <GL/glew.h>
 #include <iostream>
 #include "Matrices.h"
 #include "GenericCurves3.h"
 #include "TriangulatedMeshes3.h"
+#include "GPUResources.h"
 #include <vector>
 
 namespace cagd
@@ -27,11 +29,23 @@ namespace cagd
 
     protected:
         GLboolean            _u_closed, _v_closed; // is the surface closed in direction u or v
-        GLuint               _vbo_data;            // vertex buffer object of the control net
+        GPUResource          *_vbo_data;           // vertex buffer object of the control net (owned)
         GLdouble             _u_min, _u_max;       // definition domain in direction u
         GLdouble             _v_min, _v_max;       // definition domain in direction v
         Matrix<DCoordinate3> _data;                // the control net (usually stores position vectors)
 
+        // LU decompositions of the u- and v-collocation matrices of the last interpolation problem, they
+        // are reused by UpdateDataForInterpolation as long as the corresponding knot vectors and blending
+        // functions do not change
+        std::vector<GLdouble> _u_collocation_knot_vector, _v_collocation_knot_vector;
+        CollocationMatrix     _u_collocation_matrix, _v_collocation_matrix;
+        GLboolean             _u_collocation_matrix_is_valid, _v_collocation_matrix_is_valid;
+
+        // have to be called by derived classes whenever their blending functions in direction u or v
+        // change (e.g. by setting a shape parameter)
+        GLvoid _InvalidateUCollocationMatrix();
+        GLvoid _InvalidateVCollocationMatrix();
+
     public:
         // homework: special constructor
         TensorProductSurface3(
@@ -46,6 +60,10 @@ namespace cagd
         // homework: assignment operator
         TensorProductSurface3& operator =(const TensorProductSurface3& surface);
 
+        // move constructor and move assignment operator, the vertex buffer object of the control net is transferred
+        TensorProductSurface3(TensorProductSurface3&& surface) noexcept;
+        TensorProductSurface3& operator =(TensorProductSurface3&& surface) noexcept;
+
         // homework: set/get the definition domain of the surface
         GLvoid SetUInterval(GLdouble u_min, GLdouble u_max);
         GLvoid SetVInterval(GLdouble v_min, GLdouble v_max);
@@ -91,17 +109,29 @@ namespace cagd
                 GLuint u_div_point_count, GLuint v_div_point_count,
                 GLenum usage_flag = GL_STATIC_DRAW) const;
 
+        // generates a render-only image: the surface points, the unit normal vectors obtained from the
+        // analytic first order partial derivatives, the texture coordinates and the face indices are
+        // converted to single precision and written straight into mapped vertex buffer objects, i.e.,
+        // no double precision host-side copies are kept (requires a valid OpenGL rendering context); it is
+        // implemented by the GPU-resource layer (GPU/TensorProductSurfaces3Rendering.cpp)
+        TriangulatedMesh3* GenerateRenderOnlyImage(
+                GLuint u_div_point_count, GLuint v_div_point_count,
+                GLenum usage_flag = GL_STATIC_DRAW) const;
+
         // ensures interpolation, i.e., updates the control net $\left[\mathbf{p}_{i,j}\right]_{i=0,j=0}^{n,m}$ stored by
         // the matrix _data such that interpolation conditions $\mathbf{s}(u_k, v_l) = \mathbf{d}_{k,l}$ hold for
-        // all $k = 0,1,...,n$ and $l = 0,1,...,m$
+        // all $k = 0,1,...,n$ and $l = 0,1,...,m$; the collocation matrices are rebuilt and decomposed only
+        // if the knot vectors differ from the ones of the previous call
         GLboolean UpdateDataForInterpolation(
                 const RowMatrix<GLdouble>& u_knot_vector, const ColumnMatrix<GLdouble>& v_knot_vector,
                 Matrix<DCoordinate3>& data_points_to_interpolate);
 
-        // homework: VBO handling methods
-        virtual GLvoid    DeleteVertexBufferObjectsOfData();
-        virtual GLboolean RenderData(GLenum render_mode = GL_LINE_STRIP) const;
-        virtual GLboolean UpdateVertexBufferObjectsOfData(GLenum usage_flag = GL_STATIC_DRAW);
+        // homework: VBO handling methods, except DeleteVertexBufferObjectsOfData they are implemented by the
+        // GPU-resource layer (GPU/TensorProductSurfaces3Rendering.cpp) and are not virtual, otherwise the
+        // virtual method table of the class would refer to the library cagd_gpu
+        GLvoid    DeleteVertexBufferObjectsOfData();
+        GLboolean RenderData(GLenum render_mode = GL_LINE_STRIP) const;
+        GLboolean UpdateVertexBufferObjectsOfData(GLenum usage_flag = GL_STATIC_DRAW);
 
         // homework: generate u-directional isoparametric lines
         RowMatrix<GenericCurve3*>* GenerateUIsoparametricLines(GLuint iso_line_count,
@@ -1,16 +1,20 @@
 #include <algorithm>
-#include <cstring>
 #include <fstream>
 #include <limits>
 #include <algorithm>
 #include "TriangulatedMeshes3.h"
+#include "GridTopologies.h"
+#include "DCoordinate3Arrays.h"
+#include "Profilers.h"
 
 using namespace cagd;
 using namespace std;
 
 TriangulatedMesh3::TriangulatedMesh3(GLuint vertex_count, GLuint face_count, GLenum usage_flag):
 	_usage_flag(usage_flag),
-	_vbo_vertices(0), _vbo_normals(0), _vbo_tex_coordinates(0), _vbo_indices(0),
+	_vbo(nullptr),
+	_render_only(GL_FALSE), _render_only_vertex_count(0), _render_only_face_count(0),
+	_grid_u_div_point_count(0), _grid_v_div_point_count(0),
 	_vertex(vertex_count), _normal(vertex_count), _tex(vertex_count),
 	_face(face_count)
 {
@@ -18,15 +22,17 @@ TriangulatedMesh3::TriangulatedMesh3(GLuint vertex_count, GLuint face_count, GLe
 
 TriangulatedMesh3::TriangulatedMesh3(const TriangulatedMesh3 &mesh):
         _usage_flag(mesh._usage_flag),
-        _vbo_vertices(0), _vbo_normals(0), _vbo_tex_coordinates(0), _vbo_indices(0),
+        _vbo(mesh._vbo ? mesh._vbo->Clone() : nullptr),
+        _render_only(mesh._render_only),
+        _render_only_vertex_count(mesh._render_only_vertex_count), _render_only_face_count(mesh._render_only_face_count),
+        _grid_u_div_point_count(mesh._grid_u_div_point_count), _grid_v_div_point_count(mesh._grid_v_div_point_count),
         _leftmost_vertex(mesh._leftmost_vertex), _rightmost_vertex(mesh._rightmost_vertex),
         _vertex(mesh._vertex),
         _normal(mesh._normal),
         _tex(mesh._tex),
-        _face(mesh._face)
+        _face(mesh._face),
+        _grid_face(mesh._grid_face)
 {
-    if (mesh._vbo_vertices && mesh._vbo_normals && mesh._vbo_tex_coordinates && mesh._vbo_indices)
-        UpdateVertexBufferObjects(mesh._usage_flag);
 }
 
 TriangulatedMesh3& TriangulatedMesh3::operator =(const TriangulatedMesh3& rhs)
@@ -35,230 +41,106 @@ TriangulatedMesh3& TriangulatedMesh3::operator =(const TriangulatedMesh3& rhs)
     {
         DeleteVertexBufferObjects();
 
-        _usage_flag       = rhs._usage_flag;
-        _leftmost_vertex  = rhs._leftmost_vertex;
-        _rightmost_vertex = rhs._rightmost_vertex;
-        _vertex		  = rhs._vertex;
-        _normal		  = rhs._normal;
-        _tex              = rhs._tex;
-        _face             = rhs._face;
-
-        if (rhs._vbo_vertices && rhs._vbo_normals && rhs._vbo_tex_coordinates && rhs._vbo_indices)
-            UpdateVertexBufferObjects(_usage_flag);
+        _usage_flag               = rhs._usage_flag;
+        _vbo                      = rhs._vbo ? rhs._vbo->Clone() : nullptr;
+        _render_only              = rhs._render_only;
+        _render_only_vertex_count = rhs._render_only_vertex_count;
+        _render_only_face_count   = rhs._render_only_face_count;
+        _grid_u_div_point_count   = rhs._grid_u_div_point_count;
+        _grid_v_div_point_count   = rhs._grid_v_div_point_count;
+        _leftmost_vertex          = rhs._leftmost_vertex;
+        _rightmost_vertex         = rhs._rightmost_vertex;
+        _vertex                   = rhs._vertex;
+        _normal                   = rhs._normal;
+        _tex                      = rhs._tex;
+        _face                     = rhs._face;
+        _grid_face                = rhs._grid_face;
     }
 
     return *this;
 }
 
-GLvoid TriangulatedMesh3::DeleteVertexBufferObjects()
+TriangulatedMesh3::TriangulatedMesh3(TriangulatedMesh3&& mesh) noexcept:
+        _usage_flag(mesh._usage_flag),
+        _vbo(nullptr),
+        _render_only(GL_FALSE), _render_only_vertex_count(0), _render_only_face_count(0),
+        _grid_u_div_point_count(0), _grid_v_div_point_count(0),
+        _leftmost_vertex(mesh._leftmost_vertex), _rightmost_vertex(mesh._rightmost_vertex),
+        _vertex(std::move(mesh._vertex)),
+        _normal(std::move(mesh._normal)),
+        _tex(std::move(mesh._tex)),
+        _face(std::move(mesh._face)),
+        _grid_face(std::move(mesh._grid_face))
 {
-    if (_vbo_vertices)
-    {
-        glDeleteBuffers(1, &_vbo_vertices);
-        _vbo_vertices = 0;
-    }
+    _TakeOverVertexBufferObjects(mesh);
+}
 
-    // homework: delete vertex buffer objects of unit normal vectors, texture coordinates, and indices
-    if(_vbo_indices)
+TriangulatedMesh3& TriangulatedMesh3::operator =(TriangulatedMesh3&& rhs) noexcept
+{
+    if (this != &rhs)
     {
-        glDeleteBuffers(1, &_vbo_indices);
-        _vbo_indices = 0;
-    }
+        DeleteVertexBufferObjects();
 
-    if(_vbo_normals)
-    {
-        glDeleteBuffers(1, &_vbo_normals);
-        _vbo_normals = 0;
-    }
+        _usage_flag       = rhs._usage_flag;
+        _leftmost_vertex  = rhs._leftmost_vertex;
+        _rightmost_vertex = rhs._rightmost_vertex;
+        _vertex           = std::move(rhs._vertex);
+        _normal           = std::move(rhs._normal);
+        _tex              = std::move(rhs._tex);
+        _face             = std::move(rhs._face);
+        _grid_face        = std::move(rhs._grid_face);
 
-    if(_vbo_tex_coordinates)
-    {
-        glDeleteBuffers(1, &_vbo_tex_coordinates);
-        _vbo_tex_coordinates = 0;
+        _TakeOverVertexBufferObjects(rhs);
     }
+
+    return *this;
 }
 
-GLboolean TriangulatedMesh3::Render(GLenum render_mode) const
+GLvoid TriangulatedMesh3::_TakeOverVertexBufferObjects(TriangulatedMesh3& mesh)
 {
-    if (!_vbo_vertices || !_vbo_normals || !_vbo_tex_coordinates || !_vbo_indices)
-        return GL_FALSE;
-
-    if (render_mode != GL_TRIANGLES && render_mode != GL_POINTS)
-        return GL_FALSE;
-
-    // enable client states of vertex, normal and texture coordinate arrays
-    glEnableClientState(GL_VERTEX_ARRAY);
-    glEnableClientState(GL_NORMAL_ARRAY);
-    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-
-        // activate the VBO of texture coordinates
-        glBindBuffer(GL_ARRAY_BUFFER, _vbo_tex_coordinates);
-        // specify the location and data format of texture coordinates
-        glTexCoordPointer(4, GL_FLOAT, 0, nullptr);
-
-        // activate the VBO of normal vectors
-        glBindBuffer(GL_ARRAY_BUFFER, _vbo_normals);
-        // specify the location and data format of normal vectors
-        glNormalPointer(GL_FLOAT, 0, nullptr);
-
-        // activate the VBO of vertices
-        glBindBuffer(GL_ARRAY_BUFFER, _vbo_vertices);
-        // specify the location and data format of vertices
-        glVertexPointer(3, GL_FLOAT, 0, nullptr);
-
-        // activate the element array buffer for indexed vertices of triangular faces
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _vbo_indices);
-
-        // render primitives
-        glDrawElements(render_mode, static_cast<GLsizei>(3 * _face.size()), GL_UNSIGNED_INT, nullptr);
-
-    // disable individual client-side capabilities
-    glDisableClientState(GL_VERTEX_ARRAY);
-    glDisableClientState(GL_NORMAL_ARRAY);
-    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-
-    // unbind any buffer object previously bound and restore client memory usage
-    // for these buffer object targets
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-    return GL_TRUE;
+    _vbo                      = mesh._vbo;
+    _render_only              = mesh._render_only;
+    _render_only_vertex_count = mesh._render_only_vertex_count;
+    _render_only_face_count   = mesh._render_only_face_count;
+    _grid_u_div_point_count   = mesh._grid_u_div_point_count;
+    _grid_v_div_point_count   = mesh._grid_v_div_point_count;
+
+    // the reference count of a shared index buffer remains the same, since its user has changed only
+    mesh._vbo                      = nullptr;
+    mesh._render_only              = GL_FALSE;
+    mesh._render_only_vertex_count = 0;
+    mesh._render_only_face_count   = 0;
+    mesh._grid_u_div_point_count   = 0;
+    mesh._grid_v_div_point_count   = 0;
+
+    mesh._vertex.clear();
+    mesh._normal.clear();
+    mesh._tex.clear();
+    mesh._face.clear();
+    mesh._grid_face.reset();
 }
 
-GLboolean TriangulatedMesh3::UpdateVertexBufferObjects(GLenum usage_flag)
+// the buffer objects are released by the GPU-resource layer through the virtual destructor, a shared
+// index buffer object is deleted by the GridIndexBufferCache when its last user releases it
+GLvoid TriangulatedMesh3::DeleteVertexBufferObjects()
 {
-    if (usage_flag != GL_STREAM_DRAW  && usage_flag != GL_STREAM_READ  && usage_flag != GL_STREAM_COPY
-     && usage_flag != GL_STATIC_DRAW  && usage_flag != GL_STATIC_READ  && usage_flag != GL_STATIC_COPY
-     && usage_flag != GL_DYNAMIC_DRAW && usage_flag != GL_DYNAMIC_READ && usage_flag != GL_DYNAMIC_COPY)
-        return GL_FALSE;
-
-    // updating usage flag
-    _usage_flag = usage_flag;
-
-    // deleting old vertex buffer objects
-    DeleteVertexBufferObjects();
-
-    // creating vertex buffer objects of mesh vertices, unit normal vectors, texture coordinates,
-    // and element indices
-    glGenBuffers(1, &_vbo_vertices);
-
-    if (!_vbo_vertices)
-        return GL_FALSE;
-
-    glGenBuffers(1, &_vbo_normals);
-
-    if (!_vbo_normals)
-    {
-        glDeleteBuffers(1, &_vbo_vertices);
-        _vbo_vertices = 0;
-        return GL_FALSE;
-    }
-
-    glGenBuffers(1, &_vbo_tex_coordinates);
-    if (!_vbo_tex_coordinates)
-    {
-        glDeleteBuffers(1, &_vbo_vertices);
-        _vbo_vertices = 0;
-
-        glDeleteBuffers(1, &_vbo_normals);
-        _vbo_normals = 0;
-
-        return GL_FALSE;
-    }
-
-    glGenBuffers(1, &_vbo_indices);
-    if (!_vbo_indices)
-    {
-        glDeleteBuffers(1, &_vbo_vertices);
-        _vbo_vertices = 0;
-
-        glDeleteBuffers(1, &_vbo_normals);
-        _vbo_normals = 0;
-
-        glDeleteBuffers(1, &_vbo_tex_coordinates);
-        _vbo_tex_coordinates = 0;
-
-        return GL_FALSE;
-    }
-
-    // For efficiency reasons we convert all GLdouble coordinates
-    // to GLfloat coordinates: we will use auxiliar pointers for
-    // buffer data loading, by means of the functions glMapBuffer/glUnmapBuffer.
-
-    // Notice that multiple buffers can be mapped simultaneously.
-
-    size_t vertex_byte_size = 3 * _vertex.size() * sizeof(GLfloat);
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo_vertices);
-    glBufferData(GL_ARRAY_BUFFER, vertex_byte_size, nullptr, _usage_flag);
-
-    GLfloat *vertex_coordinate = (GLfloat*)glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo_normals);
-    glBufferData(GL_ARRAY_BUFFER, vertex_byte_size, nullptr, _usage_flag);
-
-    GLfloat *normal_coordinate = (GLfloat*)glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
-
-    for (vector<DCoordinate3>::const_iterator
-         vit = _vertex.begin(),
-         nit = _normal.begin(); vit != _vertex.end(); ++vit, ++nit)
-    {
-        for (GLint component = 0; component < 3; ++component)
-        {
-            *vertex_coordinate = (GLfloat)(*vit)[component];
-            ++vertex_coordinate;
-
-            *normal_coordinate = (GLfloat)(*nit)[component];
-            ++normal_coordinate;
-        }
-    }
-
-    size_t tex_byte_size = 4 * _tex.size() * sizeof(GLfloat);
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo_tex_coordinates);
-    glBufferData(GL_ARRAY_BUFFER, tex_byte_size, nullptr, _usage_flag);
-    GLfloat *tex_coordinate = (GLfloat*)glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
-    
-    memcpy(tex_coordinate, &_tex[0][0], tex_byte_size);
-
-    size_t index_byte_size = 3 * _face.size() * sizeof(GLuint);
-    
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _vbo_indices);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_byte_size, nullptr, _usage_flag);
-    GLuint *element = (GLuint*)glMapBuffer(GL_ELEMENT_ARRAY_BUFFER, GL_WRITE_ONLY);
-
-    for (vector<TriangularFace>::const_iterator fit = _face.begin(); fit != _face.end(); ++fit)
-    {
-        for (GLint node = 0; node < 3; ++node)
-        {
-            *element = (*fit)[node];
-            ++element;
-        }
-    }
-
-    // unmap all VBOs
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo_vertices);
-    if (!glUnmapBuffer(GL_ARRAY_BUFFER))
-        return GL_FALSE;
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo_normals);
-    if (!glUnmapBuffer(GL_ARRAY_BUFFER))
-        return GL_FALSE;
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo_tex_coordinates);
-    if (!glUnmapBuffer(GL_ARRAY_BUFFER))
-        return GL_FALSE;
+    delete _vbo;
+    _vbo = nullptr;
+}
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _vbo_indices);
-    if (!glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER))
-        return GL_FALSE;
+GLvoid TriangulatedMesh3::_SetGridTopology(GLuint u_div_point_count, GLuint v_div_point_count)
+{
+    _grid_u_div_point_count = u_div_point_count;
+    _grid_v_div_point_count = v_div_point_count;
 
-    // unbind any buffer object previously bound and restore client memory usage
-    // for these buffer object targets
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    // the own face list of the mesh is released, the faces of the grid are shared
+    vector<TriangularFace>().swap(_face);
+    _grid_face = GridTopologyCache::Faces(u_div_point_count, v_div_point_count);
+}
 
-    return GL_TRUE;
+const vector<TriangularFace>& TriangulatedMesh3::_Faces() const
+{
+    return _grid_face ? *_grid_face : _face;
 }
 
 GLboolean TriangulatedMesh3::LoadFromOFF(
@@ -269,6 +151,13 @@ GLboolean TriangulatedMesh3::LoadFromOFF(
     if (!f || !f.good())
         return GL_FALSE;
 
+    return LoadFromOFF(f, translate_and_scale_to_unit_cube);
+}
+
+GLboolean TriangulatedMesh3::LoadFromOFF(istream &f, GLboolean translate_and_scale_to_unit_cube)
+{
+    CAGD_PROFILE_ZONE("TriangulatedMesh3::LoadFromOFF");
+
     // loading the header
     string header;
 
@@ -282,35 +171,34 @@ GLboolean TriangulatedMesh3::LoadFromOFF(
 
     f >> vertex_count >> face_count >> edge_count;
 
-    // allocating memory for vertices, unit normal vectors, texture coordinates, and faces
-    _vertex.resize(vertex_count);
-    _normal.resize(vertex_count);
+    // the loaded geometry will be stored on the host side and it is not a regular grid
+    DeleteVertexBufferObjects();
+    _render_only = GL_FALSE;
+    _grid_u_div_point_count = _grid_v_div_point_count = 0;
+    _grid_face.reset();
+
+    // allocating memory for texture coordinates and faces, the vertices and the unit normal vectors are
+    // calculated on structures of arrays, i.e., by means of packed SIMD instructions, and they are
+    // copied into the arrays of structures only once at the end
     _tex.resize(vertex_count);
     _face.resize(face_count);
 
+    DCoordinate3Array position(vertex_count), normal(vertex_count);
+
+    // loading vertices
+    for (GLuint i = 0; i < vertex_count; ++i)
+    {
+        DCoordinate3 vertex;
+        f >> vertex;
+        position.Set(i, vertex);
+    }
+
     // initializing the leftmost and rightmost corners of the bounding box
     _leftmost_vertex.x() = _leftmost_vertex.y() = _leftmost_vertex.z() = numeric_limits<GLdouble>::max();
     _rightmost_vertex.x() = _rightmost_vertex.y() = _rightmost_vertex.z() = -numeric_limits<GLdouble>::max();
 
-    // loading vertices and correcting the leftmost and rightmost corners of the bounding box
-    for (vector<DCoordinate3>::iterator vit = _vertex.begin(); vit != _vertex.end(); ++vit)
-    {
-        f >> *vit;
-
-        if (vit->x() < _leftmost_vertex.x())
-            _leftmost_vertex.x() = vit->x();
-        if (vit->y() < _leftmost_vertex.y())
-            _leftmost_vertex.y() = vit->y();
-        if (vit->z() < _leftmost_vertex.z())
-            _leftmost_vertex.z() = vit->z();
-
-        if (vit->x() > _rightmost_vertex.x())
-            _rightmost_vertex.x() = vit->x();
-        if (vit->y() > _rightmost_vertex.y())
-            _rightmost_vertex.y() = vit->y();
-        if (vit->z() > _rightmost_vertex.z())
-            _rightmost_vertex.z() = vit->z();
-    }
+    // correcting the leftmost and rightmost corners of the bounding box
+    position.BoundingBox(_leftmost_vertex, _rightmost_vertex);
 
     // if we do not want to preserve the original positions and coordinates of vertices
     if (translate_and_scale_to_unit_cube)
@@ -322,36 +210,56 @@ GLboolean TriangulatedMesh3::LoadFromOFF(
         DCoordinate3 middle(_leftmost_vertex);
         middle += _rightmost_vertex;
         middle *= 0.5;
-        for (vector<DCoordinate3>::iterator vit = _vertex.begin(); vit != _vertex.end(); ++vit)
-        {
-            *vit -= middle;
-            *vit *= scale;
-        }
+
+        position.TranslateAndScale(-middle, scale);
     }
 
     // loading faces
     for (vector<TriangularFace>::iterator fit = _face.begin(); fit != _face.end(); ++fit)
         f >> *fit;
 
-    // calculating average unit normal vectors associated with vertices
-    for (vector<TriangularFace>::const_iterator fit = _face.begin(); fit != _face.end(); ++fit)
+    // calculating the normal vectors of the faces: the edge vectors are gathered, then they are
+    // multiplied in place
+    DCoordinate3Array edge(face_count), other_edge(face_count);
+
+    for (GLuint i = 0; i < face_count; ++i)
     {
-        DCoordinate3 n = _vertex[(*fit)[1]];
-        n -= _vertex[(*fit)[0]];
+        const TriangularFace &face = _face[i];
+
+        DCoordinate3 origin = position[face[0]];
+
+        DCoordinate3 n = position[face[1]];
+        n -= origin;
 
-        DCoordinate3 p = _vertex[(*fit)[2]];
-        p -= _vertex[(*fit)[0]];
+        DCoordinate3 p = position[face[2]];
+        p -= origin;
 
-        n ^= p;
+        edge.Set(i, n);
+        other_edge.Set(i, p);
+    }
+
+    DCoordinate3Array::Cross(edge, other_edge, edge);
 
+    // calculating average unit normal vectors associated with vertices
+    const GLdouble *ex = edge.X(), *ey = edge.Y(), *ez = edge.Z();
+    GLdouble       *nx = normal.X(), *ny = normal.Y(), *nz = normal.Z();
+
+    for (GLuint i = 0; i < face_count; ++i)
+    {
         for (GLint node = 0; node < 3; ++node)
-            _normal[(*fit)[node]] += n;
+        {
+            GLuint index = _face[i][node];
+
+            nx[index] += ex[i];
+            ny[index] += ey[i];
+            nz[index] += ez[i];
+        }
     }
 
-    for (vector<DCoordinate3>::iterator nit = _normal.begin(); nit != _normal.end(); ++nit)
-        nit->normalize();
+    normal.Normalize();
 
-    f.close();
+    position.CopyTo(_vertex);
+    normal.CopyTo(_normal);
 
     return GL_TRUE;
 }
@@ -377,86 +285,80 @@ GLboolean TriangulatedMesh3::SaveToOFF(const std::string& file_name) const
     }
 
     // loading faces
-    for (vector<TriangularFace>::const_iterator fit = _face.begin(); fit != _face.end(); ++fit)
+    const vector<TriangularFace> &face = _Faces();
+
+    for (vector<TriangularFace>::const_iterator fit = face.begin(); fit != face.end(); ++fit)
         f << *fit;
 
     f.close();
     return GL_TRUE;
 }
 
-GLfloat* TriangulatedMesh3::MapVertexBuffer(GLenum access_flag) const
-{
-    if (access_flag != GL_READ_ONLY && access_flag != GL_WRITE_ONLY && access_flag != GL_READ_WRITE)
-        return (GLfloat*)0;
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo_vertices);
-    GLfloat* result = (GLfloat*)glMapBuffer(GL_ARRAY_BUFFER, access_flag);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-    return result;
-}
-
 // homework
-GLfloat* TriangulatedMesh3::MapNormalBuffer(GLenum access_flag) const
+size_t TriangulatedMesh3::VertexCount() const
 {
-    if (access_flag != GL_READ_ONLY && access_flag != GL_WRITE_ONLY && access_flag != GL_READ_WRITE)
-        return (GLfloat*)0;
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo_normals);
-    GLfloat* result = (GLfloat*)glMapBuffer(GL_ARRAY_BUFFER, access_flag);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-    return result;
+    size_t size = _render_only ? _render_only_vertex_count : _vertex.size();
+    return size;
 }
 
 // homework
-GLfloat* TriangulatedMesh3::MapTextureBuffer(GLenum access_flag) const
+size_t TriangulatedMesh3::FaceCount() const
 {
-    if (access_flag != GL_READ_ONLY && access_flag != GL_WRITE_ONLY && access_flag != GL_READ_WRITE)
-        return (GLfloat*)0;
-
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo_tex_coordinates);
-    GLfloat* result = (GLfloat*)glMapBuffer(GL_ARRAY_BUFFER, access_flag);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-    return result;
+    size_t size = _render_only ? _render_only_face_count : _Faces().size();
+    return size;
 }
 
-GLvoid TriangulatedMesh3::UnmapVertexBuffer() const
+GLboolean TriangulatedMesh3::IsRenderOnly() const
 {
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo_vertices);
-    glUnmapBuffer(GL_ARRAY_BUFFER);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return _render_only;
 }
 
-// homework
-GLvoid TriangulatedMesh3::UnmapNormalBuffer() const
+GLboolean TriangulatedMesh3::HasVertexBufferObjects() const
 {
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo_normals);
-    glUnmapBuffer(GL_ARRAY_BUFFER);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return _vbo != nullptr;
 }
 
-// homework
-GLvoid TriangulatedMesh3::UnmapTextureBuffer() const
+const GPUResource* TriangulatedMesh3::VertexBufferObjects() const
 {
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo_tex_coordinates);
-    glUnmapBuffer(GL_ARRAY_BUFFER);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return _vbo;
 }
 
-// homework
-size_t TriangulatedMesh3::VertexCount() const
+GLboolean TriangulatedMesh3::HasIdenticalGeometry(const TriangulatedMesh3& mesh) const
 {
-    size_t size = _vertex.size();
-    return size;
-}
+    if (_render_only || mesh._render_only ||
+        _vertex.size() != mesh._vertex.size() || _normal.size() != mesh._normal.size() ||
+        _tex.size() != mesh._tex.size() || _Faces().size() != mesh._Faces().size())
+    {
+        return GL_FALSE;
+    }
 
-// homework
-size_t TriangulatedMesh3::FaceCount() const
-{
-    size_t size =_face.size();
-    return size;
+    for (size_t i = 0; i < _vertex.size(); ++i)
+        for (GLuint j = 0; j < 3; ++j)
+            if (_vertex[i][j] != mesh._vertex[i][j])
+                return GL_FALSE;
+
+    for (size_t i = 0; i < _normal.size(); ++i)
+        for (GLuint j = 0; j < 3; ++j)
+            if (_normal[i][j] != mesh._normal[i][j])
+                return GL_FALSE;
+
+    for (size_t i = 0; i < _tex.size(); ++i)
+        for (GLuint j = 0; j < 4; ++j)
+            if (_tex[i][j] != mesh._tex[i][j])
+                return GL_FALSE;
+
+    const vector<TriangularFace> &face = _Faces(), &mesh_face = mesh._Faces();
+
+    // the images of the same grid size share their face lists
+    if (&face == &mesh_face)
+        return GL_TRUE;
+
+    for (size_t i = 0; i < face.size(); ++i)
+        for (GLuint j = 0; j < 3; ++j)
+            if (face[i][j] != mesh_face[i][j])
+                return GL_FALSE;
+
+    return GL_TRUE;
 }
 
 TriangulatedMesh3::~TriangulatedMesh3()
@@ -491,7 +393,7 @@ std::ostream& cagd::operator <<(std::ostream& lhs, const TriangulatedMesh3& rhs)
         lhs << &it << " ";
     }
 
-    for(std::vector<TriangularFace>::const_iterator it = rhs._face.begin(); it != rhs._face.end(); it++)
+    for(std::vector<TriangularFace>::const_iterator it = rhs._Faces().begin(); it != rhs._Faces().end(); it++)
     {
         lhs << &it << " ";
     }
@@ -503,6 +405,9 @@ std::ostream& cagd::operator <<(std::ostream& lhs, const TriangulatedMesh3& rhs)
 std::istream& cagd::operator >>(std::istream& lhs, TriangulatedMesh3& rhs)
 {
     rhs.DeleteVertexBufferObjects();
+    rhs._render_only = GL_FALSE;
+    rhs._grid_u_div_point_count = rhs._grid_v_div_point_count = 0;
+    rhs._grid_face.reset();
 
     GLuint vcount;
     GLuint fcount;
@@ -537,7 +442,5 @@ std::istream& cagd::operator >>(std::istream& lhs, TriangulatedMesh3& rhs)
         lhs >> *it;
     }
 
-    rhs.UpdateVertexBufferObjects();
-
     return lhs;
 }
@@ -6,6 +6,8 @@
 #include <string>
 #include "TriangularFaces.h"
 #include "TCoordinates4.h"
+#include "GPUResources.h"
+#include <memory>
 #include <vector>
 
 namespace cagd
@@ -15,6 +17,12 @@ namespace cagd
         friend class ParametricSurface3;
         friend class TensorProductSurface3;
 
+        template <class F>
+        friend class ParametricSurface3T;
+
+        template <GLuint RowCount, GLuint ColumnCount, GLuint MaximumOrderOfPartialDerivatives>
+        friend class FixedTensorProductSurface3;
+
         // homework: output to stream:
         // vertex count, face count
         // list of vertices
@@ -23,16 +31,27 @@ namespace cagd
         // list of faces
         friend std::ostream& operator <<(std::ostream& lhs, const TriangulatedMesh3& rhs);
 
-        // homework: input from stream: inverse of the ostream operator
+        // homework: input from stream: inverse of the ostream operator (similarly to LoadFromOFF, the
+        // vertex buffer objects have to be updated by the caller)
         friend std::istream& operator >>(std::istream& lhs, TriangulatedMesh3& rhs);
 
     protected:
-        // vertex buffer object identifiers
+        // vertex buffer objects of the vertices, unit normal vectors, texture coordinates and indices
+        // (owned, they are created by the GPU-resource layer)
         GLenum                      _usage_flag;
-        GLuint                      _vbo_vertices;
-        GLuint                      _vbo_normals;
-        GLuint                      _vbo_tex_coordinates;
-        GLuint                      _vbo_indices;
+        GPUResource                 *_vbo;
+
+        // render-only meshes do not store host-side geometry, their vertex and face counts are
+        // known only by the vertex buffer objects
+        GLboolean                   _render_only;
+        GLuint                      _render_only_vertex_count;
+        GLuint                      _render_only_face_count;
+
+        // dimensions of the regular grid whose topology (i.e. face list and index buffer object)
+        // is shared through the GridTopologyCache and the GridIndexBufferCache, both of them are
+        // zero for irregular meshes
+        GLuint                      _grid_u_div_point_count;
+        GLuint                      _grid_v_div_point_count;
 
         // corners of bounding box
         DCoordinate3                 _leftmost_vertex;
@@ -44,29 +63,78 @@ namespace cagd
         std::vector<TCoordinate4>    _tex;
         std::vector<TriangularFace>  _face;
 
+        // the face list of a regular grid is not copied into _face, it is shared with the other images of
+        // the same grid size through the GridTopologyCache (it is null for irregular meshes)
+        std::shared_ptr<const std::vector<TriangularFace> > _grid_face;
+
+        // returns either the shared face list of the grid or the own faces of the mesh
+        const std::vector<TriangularFace>& _Faces() const;
+
+        // allocates the render-only vertex buffer objects, the index buffer object is shared if
+        // the grid dimensions are set
+        GLboolean _AllocateRenderOnlyVertexBufferObjects(GLuint vertex_count, GLuint face_count);
+
+        // marks the mesh as a regular grid and refers to the shared face list of the grid
+        GLvoid _SetGridTopology(GLuint u_div_point_count, GLuint v_div_point_count);
+
+        // takes over the vertex buffer objects and the properties of the given mesh (the geometry
+        // is moved by the caller), then resets the given mesh so that it does not own any buffer
+        GLvoid _TakeOverVertexBufferObjects(TriangulatedMesh3& mesh);
+
     public:
+        // Note that the methods that create, render or map vertex buffer objects (i.e. Render, *Bind*,
+        // DrawElements, UpdateVertexBufferObjects, AllocateRenderOnly*, Map*, Unmap* and HasSharedIndexBuffer) are
+        // implemented by the GPU-resource layer (GPU/TriangulatedMeshes3Rendering.cpp), therefore they
+        // require the library cagd_gpu and a valid OpenGL rendering context.
+
         // special and default constructor
         TriangulatedMesh3(GLuint vertex_count = 0, GLuint face_count = 0, GLenum usage_flag = GL_STATIC_DRAW);
 
-        // copy constructor
+        // copy constructor, the vertex buffer objects are duplicated on the GPU
         TriangulatedMesh3(const TriangulatedMesh3& mesh);
 
         // assignment operator
         TriangulatedMesh3& operator =(const TriangulatedMesh3& rhs);
 
+        // move constructor and move assignment operator: the geometry and the ownership of the vertex
+        // buffer objects (including the reference to a shared index buffer) are transferred without
+        // copying or re-uploading anything, the moved-from mesh becomes empty
+        TriangulatedMesh3(TriangulatedMesh3&& mesh) noexcept;
+        TriangulatedMesh3& operator =(TriangulatedMesh3&& rhs) noexcept;
+
         // deletes all vertex buffer objects
         GLvoid DeleteVertexBufferObjects();
 
         // renders the geometry
         GLboolean Render(GLenum render_mode = GL_TRIANGLES) const;
 
+        // the steps of Render: consecutive draws of the same mesh (e.g. by a render queue) can share a single
+        // binding of the vertex buffer objects; the vertex, normal and texture coordinate arrays remain enabled
+        // until UnbindVertexBufferObjects is called
+        GLboolean BindVertexBufferObjects() const;
+        GLboolean DrawElements(GLenum render_mode = GL_TRIANGLES) const;
+        static GLvoid UnbindVertexBufferObjects();
+
         // updates all vertex buffer objects
         GLboolean UpdateVertexBufferObjects(GLenum usage_flag = GL_STATIC_DRAW);
 
+        // deletes the host-side geometry and allocates uninitialized vertex buffer objects for the
+        // given number of vertices and faces; the buffers of such a render-only mesh have to be
+        // filled through the Map*Buffer methods, since UpdateVertexBufferObjects has nothing to upload
+        GLboolean AllocateRenderOnlyVertexBufferObjects(GLuint vertex_count, GLuint face_count, GLenum usage_flag = GL_STATIC_DRAW);
+
+        // similar to the previous method, but the mesh is a regular grid of u_div_point_count x v_div_point_count
+        // vertices, therefore its index buffer object is already filled and shared by the GridIndexBufferCache
+        GLboolean AllocateRenderOnlyGridVertexBufferObjects(GLuint u_div_point_count, GLuint v_div_point_count, GLenum usage_flag = GL_STATIC_DRAW);
+
         // loads the geometry (i.e. the array of vertices and faces) stored in an OFF file
         // at the same time calculates the unit normal vectors associated with vertices
         GLboolean LoadFromOFF(const std::string& file_name, GLboolean translate_and_scale_to_unit_cube = GL_FALSE);
 
+        // similar to the previous method, but the OFF content is read from the given stream (e.g. from a file
+        // that has already been read into memory)
+        GLboolean LoadFromOFF(std::istream& stream, GLboolean translate_and_scale_to_unit_cube = GL_FALSE);
+
         // homework: saves the geometry into an OFF file
         GLboolean SaveToOFF(const std::string& file_name) const;
 
@@ -74,15 +142,26 @@ namespace cagd
         GLfloat* MapVertexBuffer(GLenum access_flag = GL_READ_ONLY) const;
         GLfloat* MapNormalBuffer(GLenum access_flag = GL_READ_ONLY) const;  // homework
         GLfloat* MapTextureBuffer(GLenum access_flag = GL_READ_ONLY) const; // homework
+        GLuint*  MapIndexBuffer(GLenum access_flag = GL_READ_ONLY) const;
 
-        // unmapping vertex buffer objects
-        GLvoid UnmapVertexBuffer() const;
-        GLvoid UnmapNormalBuffer() const;   // homework
-        GLvoid UnmapTextureBuffer() const;  // homework
+        // unmapping vertex buffer objects, GL_FALSE means that the contents of the buffer became undefined
+        // while it was mapped (see glUnmapBuffer) or that the mesh has no vertex buffer objects
+        GLboolean UnmapVertexBuffer() const;
+        GLboolean UnmapNormalBuffer() const;    // homework
+        GLboolean UnmapTextureBuffer() const;   // homework
+        GLboolean UnmapIndexBuffer() const;
 
         // get properties of geometry
         size_t VertexCount() const; // homework
         size_t FaceCount() const;   // homework
+        GLboolean IsRenderOnly() const;
+        GLboolean HasVertexBufferObjects() const;
+        const GPUResource* VertexBufferObjects() const; // e.g. for the vertex pool of the GPU-resource layer
+        GLboolean HasSharedIndexBuffer() const;
+
+        // returns whether the host-side vertices, normals, texture coordinates and faces of the meshes are equal
+        // (e.g. for comparing image generators), render-only meshes do not have a host-side geometry
+        GLboolean HasIdenticalGeometry(const TriangulatedMesh3& mesh) const;
 
         // destructor
         virtual ~TriangulatedMesh3();
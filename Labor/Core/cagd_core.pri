@@ -0,0 +1,32 @@
+# Links the including project against the static library cagd_core (see cagd_core.pro), which has to be
+# built into the shadow build directory of this folder, e.g. by the subdirs project ../CAGD.pro.
+INCLUDEPATH += $$PWD/.. $$PWD/../Dependencies/Include
+DEPENDPATH  += $$PWD/..
+
+CAGD_CORE_DIRECTORY = $$shadowed($$PWD)
+
+win32 {
+    CONFIG(release, debug|release): CAGD_CORE_DIRECTORY = $$CAGD_CORE_DIRECTORY/release
+    else: CONFIG(debug, debug|release): CAGD_CORE_DIRECTORY = $$CAGD_CORE_DIRECTORY/debug
+}
+
+LIBS += -L$$CAGD_CORE_DIRECTORY -lcagd_core
+
+# the MeshLoader runs worker threads
+CONFIG += thread
+
+# the profiling zones are compiled only into debug builds and into release builds configured with
+# CONFIG+=cagd_profiling (the libraries have to be configured in the same way, see cagd_core.pro)
+CONFIG(debug, debug|release)|cagd_profiling: DEFINES += CAGD_PROFILING
+
+win32-msvc*: PRE_TARGETDEPS += $$CAGD_CORE_DIRECTORY/cagd_core.lib
+else:        PRE_TARGETDEPS += $$CAGD_CORE_DIRECTORY/libcagd_core.a
+
+unix: !mac {
+    QMAKE_CXXFLAGS += -fopenmp
+    LIBS += -fopenmp
+}
+
+msvc {
+    QMAKE_CXXFLAGS += -openmp
+}
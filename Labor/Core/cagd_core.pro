@@ -0,0 +1,82 @@
+# Static library of the geometric core: coordinates, matrices, linear systems, curves, surfaces and
+# triangulated meshes. It is pure CPU code, i.e., it neither calls OpenGL nor needs a rendering context;
+# <GL/glew.h> is included only for the types GLboolean, GLuint, GLdouble, ... that appear in the interfaces.
+# The vertex buffer objects of the geometric objects are created by the library cagd_gpu (see ../GPU).
+#
+# Applications include cagd_core.pri in order to link against this library.
+TEMPLATE = lib
+TARGET = cagd_core
+
+CONFIG += staticlib c++11 thread
+CONFIG -= qt
+
+INCLUDEPATH += $$PWD/.. $$PWD/../Dependencies/Include
+
+unix: !mac {
+    # the independent linear systems of interpolation problems are solved by OpenMP threads
+    QMAKE_CXXFLAGS += -fopenmp
+}
+
+# the profiling zones (see Profilers.h) are compiled into debug builds, and into release builds configured
+# with CONFIG+=cagd_profiling; the including projects define the same flag (see cagd_core.pri)
+CONFIG(debug, debug|release)|cagd_profiling: DEFINES += CAGD_PROFILING
+
+msvc {
+    QMAKE_CXXFLAGS += -openmp -arch:AVX
+    QMAKE_CXXFLAGS_RELEASE *= -O2
+}
+
+HEADERS += \
+    BandedMatrices.h \
+    Colors4.h \
+    Constants.h \
+    DCoordinate3Arrays.h \
+    DCoordinates3.h \
+    Exceptions.h \
+    FixedLinearCombinations3.h \
+    FixedTensorProductSurfaces3.h \
+    FloatConversions.h \
+    FourierTransforms.h \
+    GenericCurves3.h \
+    GPUResources.h \
+    GridTopologies.h \
+    HCoordinates3.h \
+    LinearCombination3.h \
+    Matrices.h \
+    MeshLoaders.h \
+    MeshRegistries.h \
+    Profilers.h \
+    RealSquareMatrices.h \
+    RowOperations.h \
+    TCoordinates4.h \
+    TensorProductSurfaces3.h \
+    TriangularFaces.h \
+    TriangulatedMeshes3.h \
+    ../Cyclic/CyclicCurves3.h \
+    ../Parametric/ParametricCurves3.h \
+    ../Parametric/ParametricSurfaces3.h \
+    ../Trigonometric/SecondOrderTrigonometricArc3.h \
+    ../Trigonometric/SecondOrderTrigonometricFunctions.h \
+    ../Trigonometric/SecondOrderTrigonometricPatch3.h
+
+SOURCES += \
+    BandedMatrices.cpp \
+    DCoordinate3Arrays.cpp \
+    FloatConversions.cpp \
+    FourierTransforms.cpp \
+    GenericCurves3.cpp \
+    GridTopologies.cpp \
+    LinearCombination3.cpp \
+    MeshLoaders.cpp \
+    MeshRegistries.cpp \
+    Profilers.cpp \
+    RealSquareMatrices.cpp \
+    RowOperations.cpp \
+    TensorProductSurfaces3.cpp \
+    TriangulatedMeshes3.cpp \
+    ../Cyclic/CyclicCurves3.cpp \
+    ../Parametric/ParametricCurves3.cpp \
+    ../Parametric/ParametricSurfaces3.cpp \
+    ../Trigonometric/SecondOrderTrigonometricArc3.cpp \
+    ../Trigonometric/SecondOrderTrigonometricFunctions.cpp \
+    ../Trigonometric/SecondOrderTrigonometricPatch3.cpp
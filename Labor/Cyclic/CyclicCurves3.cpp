@@ -1,7 +1,12 @@
 #include "CyclicCurves3.h"
 #include "../Core/Constants.h"
+#include "../Core/FourierTransforms.h"
+#include "../Core/Profilers.h"
+#include <algorithm>
 #include <iostream>
 #include <cmath>
+#include <complex>
+#include <vector>
 
 using namespace std;
 
@@ -84,7 +89,7 @@ namespace cagd
                     _bc (2 * _n, k) *
                     cos((_n - k) * (u - i * _lambda_n) + r * PI / 2.0);
                 }
-                d[r] += sum_k * _data[i];
+                Axpy(sum_k, _data[i], d[r]);
             }
 
             d[r] *= 2.0;
@@ -96,4 +101,142 @@ namespace cagd
 
         return GL_TRUE;
     }
+
+    GenericCurve3* CyclicCurve3::GenerateImageByFourierSynthesis(GLuint max_order_of_derivatives, GLuint div_point_count, GLenum usage_flag) const
+    {
+        CAGD_PROFILE_ZONE("CyclicCurve3::GenerateImageByFourierSynthesis");
+
+        // the samples of other definition domains do not form a uniform sampling of the period
+        if (div_point_count < 2 || fabs(_u_max - _u_min - TWO_PI) > EPS)
+        {
+            return 0;
+        }
+
+        GenericCurve3 *result = new GenericCurve3(max_order_of_derivatives, div_point_count, usage_flag);
+
+        if (!result)
+        {
+            return 0;
+        }
+
+        typedef FastFourierTransform::Complex Complex;
+
+        GLuint dimension = 2 * _n + 1;
+
+        // roots of unity exp(i k lambda_n)
+        vector<Complex> root(dimension);
+
+        for (GLuint k = 0; k < dimension; ++k)
+        {
+            root[k] = polar(1.0, k * _lambda_n);
+        }
+
+        // Expanding cos((n - k)(u - i lambda_n)) in the derivatives, the coefficient of exp(i j u) is
+        //   c_j = bc(2n, n - j) / ((2n + 1) bc(2n, n)) * sum_i data[i] exp(-i j i lambda_n),  j = 1, ..., n,
+        // while c_{-j} = conj(c_j) and c_0 is the centroid of the data; the coefficient of the
+        // coordinate c is stored at 3 * j + c, and the samples start at _u_min.
+        vector<Complex> coefficient(3 * (_n + 1), Complex(0.0, 0.0));
+
+        for (GLuint i = 0; i < dimension; ++i)
+        {
+            for (GLuint c = 0; c < 3; ++c)
+            {
+                coefficient[c] += _data[i][c];
+            }
+        }
+
+        for (GLuint c = 0; c < 3; ++c)
+        {
+            coefficient[c] /= static_cast<GLdouble>(dimension);
+        }
+
+        for (GLuint j = 1; j <= _n; ++j)
+        {
+            Complex factor = polar(_bc(2 * _n, _n - j) / (dimension * _bc(2 * _n, _n)), j * _u_min);
+
+            for (GLuint i = 0; i < dimension; ++i)
+            {
+                Complex weight = factor * conj(root[(j * i) % dimension]);
+
+                for (GLuint c = 0; c < 3; ++c)
+                {
+                    coefficient[3 * j + c] += weight * _data[i][c];
+                }
+            }
+        }
+
+        // The samples u_m = _u_min + 2 pi m / M (m = 0, ..., M - 1) of each coordinate of each derivative are
+        // real, thus two of them are synthesized by a single complex transform: the spectrum of the first one
+        // forms the real part, the one of the second forms the imaginary part. Frequencies beyond the Nyquist
+        // limit are aliased into the bins j mod M, which keeps the samples exact.
+        GLuint                  sample_count = div_point_count - 1;
+        GLuint                  signal_count = 3 * (max_order_of_derivatives + 1);
+        FastFourierTransform    fft(sample_count);
+        vector<Complex>         spectrum(sample_count);
+
+        // powers of the imaginary unit
+        const Complex rotation[] = {Complex(1.0, 0.0), Complex(0.0, 1.0), Complex(-1.0, 0.0), Complex(0.0, -1.0)};
+
+        for (GLuint first = 0; first < signal_count; first += 2)
+        {
+            fill(spectrum.begin(), spectrum.end(), Complex(0.0, 0.0));
+
+            for (GLuint s = first; s < min(first + 2, signal_count); ++s)
+            {
+                GLuint r = s / 3, c = s % 3;
+
+                // the factor i of the second signal
+                Complex part = (s == first) ? Complex(1.0, 0.0) : Complex(0.0, 1.0);
+
+                if (!r)
+                {
+                    spectrum[0] += part * coefficient[c];
+                }
+
+                for (GLuint j = 1; j <= _n; ++j)
+                {
+                    Complex value = pow(static_cast<GLdouble>(j), static_cast<GLint>(r)) * rotation[r % 4] * coefficient[3 * j + c];
+                    GLuint  bin   = j % sample_count;
+
+                    spectrum[bin]                                   += part * value;
+                    spectrum[(sample_count - bin) % sample_count]   += part * conj(value);
+                }
+            }
+
+            fft.Inverse(spectrum);
+
+            for (GLuint s = first; s < min(first + 2, signal_count); ++s)
+            {
+                GLuint r = s / 3, c = s % 3;
+
+                for (GLuint m = 0; m < sample_count; ++m)
+                {
+                    (*result)(r, m)[c] = (s == first) ? spectrum[m].real() : spectrum[m].imag();
+                }
+            }
+        }
+
+        // the image is closed
+        for (GLuint r = 0; r <= max_order_of_derivatives; ++r)
+        {
+            (*result)(r, sample_count) = (*result)(r, 0);
+        }
+
+        return result;
+    }
+
+    GenericCurve3* CyclicCurve3::GenerateImage(GLuint max_order_of_derivatives, GLuint div_point_count, GLenum usage_flag) const
+    {
+        if (_n >= FOURIER_SYNTHESIS_MINIMUM_ORDER)
+        {
+            GenericCurve3 *result = GenerateImageByFourierSynthesis(max_order_of_derivatives, div_point_count, usage_flag);
+
+            if (result)
+            {
+                return result;
+            }
+        }
+
+        return LinearCombination3::GenerateImage(max_order_of_derivatives, div_point_count, usage_flag);
+    }
 }
@@ -24,5 +24,20 @@ namespace cagd
             // redeclare and define inherited  pure virtual methods
             GLboolean BlendingFunctionValues(GLdouble u , RowMatrix<GLdouble> &values) const;
             GLboolean CalculateDerivatives(GLuint max_order_of_derivatives, GLdouble u , Derivatives &d) const;
+
+            // The curve is a trigonometric polynomial of degree n. If the image covers a full period (i.e., the
+            // length of the definition domain is 2 pi), its div_point_count - 1 distinct uniform samples are
+            // synthesized from the Fourier coefficients of the curve by inverse fast Fourier transforms (the
+            // coefficients of the derivatives are scaled by (i * k)^r), in O(n^2 + r * M log M) operations
+            // instead of the O(r * n^2 * M) operations of the inherited per-sample evaluation, where
+            // M = div_point_count and r = max_order_of_derivatives + 1. Otherwise a null pointer is returned.
+            GenericCurve3* GenerateImageByFourierSynthesis(GLuint max_order_of_derivatives, GLuint div_point_count, GLenum usage_flag = GL_STATIC_DRAW) const;
+
+            // uses the Fourier synthesis if it is possible and the order n of the curve is at least
+            // FOURIER_SYNTHESIS_MINIMUM_ORDER (the per-sample evaluation of first order curves is faster at any
+            // sample count), otherwise the inherited per-sample evaluation
+            static const GLuint FOURIER_SYNTHESIS_MINIMUM_ORDER = 2;
+
+            GenericCurve3* GenerateImage(GLuint max_order_of_derivatives, GLuint div_point_count, GLenum usage_flag = GL_STATIC_DRAW) const;
     };
 }
@@ -0,0 +1,173 @@
+#include "BufferObjects.h"
+#include "GridIndexBuffers.h"
+
+using namespace cagd;
+using namespace std;
+
+BufferObjects::BufferObjects(): _grid_u_div_point_count(0), _grid_v_div_point_count(0)
+{
+}
+
+GLboolean BufferObjects::Generate(GLuint count)
+{
+    // owned buffer objects precede the shared one
+    if (HasSharedGridIndexBuffer())
+        return GL_FALSE;
+
+    for (GLuint i = 0; i < count; ++i)
+    {
+        GLuint name = 0;
+
+        glGenBuffers(1, &name);
+
+        if (!name)
+            return GL_FALSE;
+
+        _name.push_back(name);
+    }
+
+    return GL_TRUE;
+}
+
+GLboolean BufferObjects::AppendSharedGridIndexBuffer(GLuint u_div_point_count, GLuint v_div_point_count)
+{
+    if (HasSharedGridIndexBuffer())
+        return GL_FALSE;
+
+    GLuint name = GridIndexBufferCache::AcquireIndexBuffer(u_div_point_count, v_div_point_count);
+
+    if (!name)
+        return GL_FALSE;
+
+    _name.push_back(name);
+
+    _grid_u_div_point_count = u_div_point_count;
+    _grid_v_div_point_count = v_div_point_count;
+
+    return GL_TRUE;
+}
+
+GLuint BufferObjects::GetCount() const
+{
+    return static_cast<GLuint>(_name.size());
+}
+
+GLuint BufferObjects::operator [](GLuint index) const
+{
+    return _name[index];
+}
+
+GLboolean BufferObjects::HasSharedGridIndexBuffer() const
+{
+    return _grid_u_div_point_count && _grid_v_div_point_count;
+}
+
+GLuint BufferObjects::VertexArray(GLuint index, GLboolean &is_new) const
+{
+    is_new = GL_FALSE;
+
+    if (index >= _vertex_array.size())
+        _vertex_array.resize(index + 1, 0);
+
+    if (!_vertex_array[index])
+    {
+        glGenVertexArrays(1, &_vertex_array[index]);
+        is_new = _vertex_array[index] ? GL_TRUE : GL_FALSE;
+    }
+
+    return _vertex_array[index];
+}
+
+const BufferObjects* BufferObjects::Of(const GPUResource *resource)
+{
+    return static_cast<const BufferObjects*>(resource);
+}
+
+GPUResource* BufferObjects::Clone() const
+{
+    BufferObjects *result = new BufferObjects();
+
+    GLuint owned_count = GetCount() - (HasSharedGridIndexBuffer() ? 1 : 0);
+
+    if (!result->Generate(owned_count))
+    {
+        delete result;
+        return nullptr;
+    }
+
+    // glCopyBufferSubData is part of the core profile since OpenGL 3.1
+    GLboolean copy_on_gpu = (GLEW_VERSION_3_1 || GLEW_ARB_copy_buffer);
+
+    for (GLuint i = 0; i < owned_count; ++i)
+    {
+        GLint byte_size = 0, usage_flag = GL_STATIC_DRAW;
+
+        glBindBuffer(GL_ARRAY_BUFFER, _name[i]);
+        glGetBufferParameteriv(GL_ARRAY_BUFFER, GL_BUFFER_SIZE, &byte_size);
+        glGetBufferParameteriv(GL_ARRAY_BUFFER, GL_BUFFER_USAGE, &usage_flag);
+
+        if (copy_on_gpu)
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, result->_name[i]);
+            glBufferData(GL_ARRAY_BUFFER, byte_size, nullptr, usage_flag);
+
+            glBindBuffer(GL_COPY_READ_BUFFER, _name[i]);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, result->_name[i]);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, byte_size);
+        }
+        else
+        {
+            const GLvoid *data = byte_size ? glMapBuffer(GL_ARRAY_BUFFER, GL_READ_ONLY) : nullptr;
+
+            if (byte_size && !data)
+            {
+                glBindBuffer(GL_ARRAY_BUFFER, 0);
+                delete result;
+                return nullptr;
+            }
+
+            glBindBuffer(GL_ARRAY_BUFFER, result->_name[i]);
+            glBufferData(GL_ARRAY_BUFFER, byte_size, data, usage_flag);
+
+            if (data)
+            {
+                glBindBuffer(GL_ARRAY_BUFFER, _name[i]);
+                glUnmapBuffer(GL_ARRAY_BUFFER);
+            }
+        }
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    if (copy_on_gpu)
+    {
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+
+    // a shared index buffer object does not have to be copied
+    if (HasSharedGridIndexBuffer() &&
+        !result->AppendSharedGridIndexBuffer(_grid_u_div_point_count, _grid_v_div_point_count))
+    {
+        delete result;
+        return nullptr;
+    }
+
+    return result;
+}
+
+BufferObjects::~BufferObjects()
+{
+    for (vector<GLuint>::const_iterator it = _vertex_array.begin(); it != _vertex_array.end(); ++it)
+        if (*it)
+            glDeleteVertexArrays(1, &(*it));
+
+    GLuint owned_count = GetCount() - (HasSharedGridIndexBuffer() ? 1 : 0);
+
+    if (owned_count)
+        glDeleteBuffers(owned_count, &_name[0]);
+
+    // shared index buffer objects are deleted by the GridIndexBufferCache when their last user releases them
+    if (HasSharedGridIndexBuffer())
+        GridIndexBufferCache::ReleaseIndexBuffer(_grid_u_div_point_count, _grid_v_div_point_count);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <vector>
+#include "../Core/GPUResources.h"
+
+namespace cagd
+{
+    //--------------------
+    // class BufferObjects
+    //--------------------
+    // Array of buffer objects that the GPU-resource layer attaches to a geometric object of the core
+    // library, e.g. the vertex buffer objects of the derivatives of a GenericCurve3, or the vertex, normal,
+    // texture coordinate and index buffers of a TriangulatedMesh3. The last element of the array may be the
+    // element array buffer of a regular grid that is shared through the GridIndexBufferCache: such a buffer
+    // object is neither copied nor deleted, only its reference counter is increased or decreased.
+    class BufferObjects: public GPUResource
+    {
+    protected:
+        std::vector<GLuint> _name;
+
+        // dimensions of the grid the shared index buffer of which is the last element of the array, both of
+        // them are zero if each buffer object is owned
+        GLuint              _grid_u_div_point_count, _grid_v_div_point_count;
+
+        // vertex array objects of the core profile rendering path (see RenderBackend), they are generated on
+        // demand by the rendering methods of the owner and they are deleted together with the buffer objects
+        mutable std::vector<GLuint> _vertex_array;
+
+        // buffer objects cannot be copied by value, use the method Clone instead
+        BufferObjects(const BufferObjects&);
+        BufferObjects& operator =(const BufferObjects&);
+
+    public:
+        // default constructor, the array is empty
+        BufferObjects();
+
+        // appends count new buffer objects to the array, returns GL_FALSE if any of them could not be generated
+        GLboolean Generate(GLuint count);
+
+        // appends the shared element array buffer of a regular grid of u_div_point_count x v_div_point_count
+        // vertices (its content is uploaded by the GridIndexBufferCache)
+        GLboolean AppendSharedGridIndexBuffer(GLuint u_div_point_count, GLuint v_div_point_count);
+
+        // query methods
+        GLuint    GetCount() const;
+        GLuint    operator [](GLuint index) const;
+        GLboolean HasSharedGridIndexBuffer() const;
+
+        // returns the index-th vertex array object (e.g. one per derivative order of a curve), is_new is set to
+        // GL_TRUE if it has just been generated, i.e., if its attributes have to be specified; returns 0 if the
+        // vertex array object could not be generated
+        GLuint    VertexArray(GLuint index, GLboolean &is_new) const;
+
+        // the GPU-resource layer attaches only buffer objects to the core objects, this method restores the
+        // type of such an attached resource (null pointers are preserved)
+        static const BufferObjects* Of(const GPUResource *resource);
+
+        // duplicates the owned buffer objects on the GPU (by glCopyBufferSubData if OpenGL 3.1 or the extension
+        // GL_ARB_copy_buffer is available, otherwise through mapped source buffers) and shares the shared one;
+        // the vertex array objects are not copied, the ones of the clone are generated on demand
+        GPUResource* Clone() const;
+
+        // deletes the vertex array objects and the owned buffer objects, and releases the shared one
+        ~BufferObjects();
+    };
+
+    // positions of the vertex buffer objects of a triangulated mesh in its array of buffer objects, the index
+    // buffer object is the last one, since it may be the shared element array buffer of a regular grid
+    enum MeshBufferObject
+    {
+        VERTEX_BUFFER = 0, NORMAL_BUFFER = 1, TEXTURE_BUFFER = 2, INDEX_BUFFER = 3, MESH_BUFFER_COUNT = 4
+    };
+}
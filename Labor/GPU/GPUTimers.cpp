@@ -0,0 +1,95 @@
+#include "GPUTimers.h"
+#include "../Core/Profilers.h"
+
+using namespace cagd;
+using namespace std;
+
+GPUTimer::GPUTimer(const char *zone): _zone(zone), _is_running(GL_FALSE)
+{
+}
+
+GLboolean GPUTimer::IsSupported()
+{
+    return (GLEW_VERSION_3_3 || GLEW_ARB_timer_query) ? GL_TRUE : GL_FALSE;
+}
+
+GLvoid GPUTimer::_Collect()
+{
+    while (!_pending.empty())
+    {
+        Measurement &measurement = _pending.front();
+
+        GLint available = GL_FALSE;
+        glGetQueryObjectiv(measurement.query, GL_QUERY_RESULT_AVAILABLE, &available);
+
+        // the results become available in the order of issue
+        if (!available)
+            break;
+
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(measurement.query, GL_QUERY_RESULT, &elapsed);
+
+        Profiler::Instance().Record(_zone, measurement.begin, measurement.begin + elapsed);
+
+        _idle_queries.push_back(measurement.query);
+        _pending.pop_front();
+    }
+}
+
+GLvoid GPUTimer::Begin()
+{
+    if (_is_running || !IsSupported())
+        return;
+
+    _Collect();
+
+    Measurement measurement;
+
+    if (_idle_queries.empty())
+    {
+        glGenQueries(1, &measurement.query);
+
+        if (!measurement.query)
+            return;
+    }
+    else
+    {
+        measurement.query = _idle_queries.front();
+        _idle_queries.pop_front();
+    }
+
+    measurement.begin = Profiler::Now();
+
+    glBeginQuery(GL_TIME_ELAPSED, measurement.query);
+
+    _pending.push_back(measurement);
+    _is_running = GL_TRUE;
+}
+
+GLvoid GPUTimer::End()
+{
+    if (!_is_running)
+        return;
+
+    glEndQuery(GL_TIME_ELAPSED);
+    _is_running = GL_FALSE;
+}
+
+GLvoid GPUTimer::DeleteQueries()
+{
+    End();
+
+    for (deque<Measurement>::iterator it = _pending.begin(); it != _pending.end(); ++it)
+        glDeleteQueries(1, &it->query);
+
+    for (deque<GLuint>::iterator it = _idle_queries.begin(); it != _idle_queries.end(); ++it)
+        glDeleteQueries(1, &(*it));
+
+    _pending.clear();
+    _idle_queries.clear();
+}
+
+GPUTimer::~GPUTimer()
+{
+    DeleteQueries();
+}
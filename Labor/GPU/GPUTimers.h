@@ -0,0 +1,55 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <deque>
+
+namespace cagd
+{
+    //---------------
+    // class GPUTimer
+    //---------------
+    // Measures the GPU time of the commands issued between Begin and End by GL_TIME_ELAPSED queries (these
+    // are available from OpenGL 3.3 or by the extension GL_ARB_timer_query) and records the results as
+    // events of the given zone of the Profiler. The results are read back without stalling the pipeline:
+    // each measurement owns its query object, and it is recorded only when its result has become available,
+    // typically a few frames later. Since the GPU and CPU clocks are not related, an event is placed at the
+    // CPU timestamp of the corresponding Begin. All methods require a valid OpenGL rendering context, and
+    // they do nothing if timer queries are not supported.
+    class GPUTimer
+    {
+    private:
+        class Measurement
+        {
+        public:
+            GLuint              query;
+            unsigned long long  begin;  // CPU timestamp in nanoseconds
+        };
+
+        const char              *_zone;
+        std::deque<Measurement> _pending;   // in the order of issue
+        std::deque<GLuint>      _idle_queries;
+        GLboolean               _is_running;
+
+        // records the available results of the pending measurements
+        GLvoid _Collect();
+
+        // timers cannot be copied
+        GPUTimer(const GPUTimer&);
+        GPUTimer& operator =(const GPUTimer&);
+
+    public:
+        // the zone name has to be a string literal (see Profiler)
+        explicit GPUTimer(const char *zone = "GPU frame");
+
+        static GLboolean IsSupported();
+
+        // time elapsed queries cannot be nested, i.e., at most one timer can be running at a time
+        GLvoid Begin();
+        GLvoid End();
+
+        // deletes the query objects, the pending measurements are discarded
+        GLvoid DeleteQueries();
+
+        ~GPUTimer();
+    };
+}
@@ -0,0 +1,203 @@
+#include "../Core/GenericCurves3.h"
+#include "../Core/FloatConversions.h"
+#include "../Core/Profilers.h"
+#include "BufferObjects.h"
+#include "RenderBackends.h"
+
+using namespace cagd;
+using namespace std;
+
+//-------------------------------------------------------------
+// vertex buffer object handling methods of class GenericCurve3
+//-------------------------------------------------------------
+
+GLboolean GenericCurve3::RenderDerivatives(GLuint order, GLenum render_mode) const
+{
+    const BufferObjects *vbo_derivative = BufferObjects::Of(_vbo_derivative);
+
+    GLuint max_order = _derivative.GetRowCount();
+    if (order >= max_order || !vbo_derivative)
+        return GL_FALSE;
+
+    GLuint point_count = _derivative.GetColumnCount();
+
+    // core profile path: each derivative order has its own vertex array object
+    if (order ? (render_mode == GL_LINES || render_mode == GL_POINTS) :
+                (render_mode == GL_LINE_STRIP || render_mode == GL_LINE_LOOP || render_mode == GL_POINTS))
+    {
+        if (RenderBackend::BeginDraw())
+        {
+            GLboolean is_new = GL_FALSE;
+            GLuint vertex_array = vbo_derivative->VertexArray(order, is_new);
+
+            if (vertex_array)
+            {
+                glBindVertexArray(vertex_array);
+
+                if (is_new)
+                {
+                    glBindBuffer(GL_ARRAY_BUFFER, (*vbo_derivative)[order]);
+                    glVertexAttribPointer(RenderBackend::POSITION_LOCATION, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+                    glEnableVertexAttribArray(RenderBackend::POSITION_LOCATION);
+                    glBindBuffer(GL_ARRAY_BUFFER, 0);
+                }
+
+                glDrawArrays(render_mode, 0, order ? 2 * point_count : point_count);
+                glBindVertexArray(0);
+            }
+
+            RenderBackend::EndDraw();
+
+            return vertex_array ? GL_TRUE : GL_FALSE;
+        }
+    }
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+        glBindBuffer(GL_ARRAY_BUFFER, (*vbo_derivative)[order]);
+            glVertexPointer(3, GL_FLOAT, 0, (const GLvoid *)0);
+
+            if (!order)
+            {
+                if (render_mode != GL_LINE_STRIP &&
+                    render_mode != GL_LINE_LOOP  &&
+                    render_mode != GL_POINTS)
+                {
+                    glBindBuffer(GL_ARRAY_BUFFER, 0);
+                    glDisableClientState(GL_VERTEX_ARRAY);
+                    return GL_FALSE;
+                }
+
+                glDrawArrays(render_mode, 0, point_count);
+            }
+            else
+            {
+                if (render_mode != GL_LINES && render_mode != GL_POINTS)
+                {
+                    glBindBuffer(GL_ARRAY_BUFFER, 0);
+                    glDisableClientState(GL_VERTEX_ARRAY);
+                    return GL_FALSE;
+                }
+
+                glDrawArrays(render_mode, 0, 2 * point_count);
+            }
+
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    return GL_TRUE;
+}
+
+GLboolean GenericCurve3::UpdateVertexBufferObjects(GLdouble derivative_scale, GLenum usage_flag)
+{
+    CAGD_PROFILE_ZONE("GenericCurve3::UpdateVertexBufferObjects");
+
+    if (usage_flag != GL_STREAM_DRAW  && usage_flag != GL_STREAM_READ  && usage_flag != GL_STREAM_COPY  &&
+        usage_flag != GL_DYNAMIC_DRAW && usage_flag != GL_DYNAMIC_READ && usage_flag != GL_DYNAMIC_COPY &&
+        usage_flag != GL_STATIC_DRAW  && usage_flag != GL_STATIC_READ  && usage_flag != GL_STATIC_COPY)
+        return GL_FALSE;
+
+    DeleteVertexBufferObjects();
+
+    _usage_flag = usage_flag;
+
+    BufferObjects *vbo_derivative = new BufferObjects();
+
+    // the buffer objects are owned by the curve from now on, i.e., they are deleted on failure
+    _vbo_derivative = vbo_derivative;
+
+    if (!vbo_derivative->Generate(_derivative.GetRowCount()))
+    {
+        DeleteVertexBufferObjects();
+        return GL_FALSE;
+    }
+
+    GLuint curve_point_count = _derivative.GetColumnCount();
+
+    GLfloat *coordinate = 0;
+
+    // curve points
+    GLuint curve_point_byte_size = 3 * curve_point_count * sizeof(GLfloat);
+
+    glBindBuffer(GL_ARRAY_BUFFER, (*vbo_derivative)[0]);
+    glBufferData(GL_ARRAY_BUFFER, curve_point_byte_size, 0, _usage_flag);
+
+    coordinate = (GLfloat*)glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
+
+    if (!coordinate)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        DeleteVertexBufferObjects();
+        return GL_FALSE;
+    }
+
+    // the rows of the matrix _derivative are contiguous arrays of points
+    ConvertToFloat(&_derivative(0, 0), curve_point_count, coordinate, GL_TRUE);
+
+    if (!glUnmapBuffer(GL_ARRAY_BUFFER))
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        DeleteVertexBufferObjects();
+        return GL_FALSE;
+    }
+
+    // higher order derivatives
+    GLuint higher_order_derivative_byte_size = 2 * curve_point_byte_size;
+
+    for (GLuint d = 1; d < _derivative.GetRowCount(); ++d)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, (*vbo_derivative)[d]);
+        glBufferData(GL_ARRAY_BUFFER, higher_order_derivative_byte_size, 0, _usage_flag);
+
+        coordinate = (GLfloat*)glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
+
+        if (!coordinate)
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            DeleteVertexBufferObjects();
+            return GL_FALSE;
+        }
+
+        // line segments [_derivative(0, i), _derivative(0, i) + derivative_scale * _derivative(d, i)]
+        ConvertDerivativeEndpointsToFloat(
+                    &_derivative(0, 0), &_derivative(d, 0), curve_point_count, derivative_scale,
+                    coordinate, GL_TRUE);
+
+        if (!glUnmapBuffer(GL_ARRAY_BUFFER))
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            DeleteVertexBufferObjects();
+            return GL_FALSE;
+        }
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return GL_TRUE;
+}
+
+GLfloat* GenericCurve3::MapDerivatives(GLuint order, GLenum access_mode) const
+{
+    const BufferObjects *vbo_derivative = BufferObjects::Of(_vbo_derivative);
+
+    if (order >= _derivative.GetRowCount() || !vbo_derivative)
+        return 0;
+
+    if (access_mode != GL_READ_ONLY && access_mode != GL_WRITE_ONLY && access_mode != GL_READ_WRITE)
+        return 0;
+
+    glBindBuffer(GL_ARRAY_BUFFER, (*vbo_derivative)[order]);
+
+    return (GLfloat*)glMapBuffer(GL_ARRAY_BUFFER, access_mode);
+}
+
+GLboolean GenericCurve3::UnmapDerivatives(GLuint order) const
+{
+    const BufferObjects *vbo_derivative = BufferObjects::Of(_vbo_derivative);
+
+    if (order >= _derivative.GetRowCount() || !vbo_derivative)
+        return GL_FALSE;
+
+    glBindBuffer(GL_ARRAY_BUFFER, (*vbo_derivative)[order]);
+
+    return glUnmapBuffer(GL_ARRAY_BUFFER);
+}
@@ -0,0 +1,75 @@
+#include "GridIndexBuffers.h"
+#include "../Core/GridTopologies.h"
+
+using namespace cagd;
+using namespace std;
+
+GridIndexBufferCache::EntryMap& GridIndexBufferCache::_Entries()
+{
+    static EntryMap entries;
+    return entries;
+}
+
+mutex& GridIndexBufferCache::_Mutex()
+{
+    static mutex m;
+    return m;
+}
+
+GLuint GridIndexBufferCache::AcquireIndexBuffer(GLuint u_div_point_count, GLuint v_div_point_count)
+{
+    lock_guard<mutex> lock(_Mutex());
+
+    Entry &entry = _Entries()[Key(u_div_point_count, v_div_point_count)];
+
+    if (!entry.vbo_indices)
+    {
+        // the face list is released after the upload unless a host-side mesh of the same size uses it
+        GridTopologyCache::FaceList faces = GridTopologyCache::Faces(u_div_point_count, v_div_point_count);
+        const vector<TriangularFace> &face = *faces;
+
+        if (face.empty())
+            return 0;
+
+        glGenBuffers(1, &entry.vbo_indices);
+
+        if (!entry.vbo_indices)
+            return 0;
+
+        // the nodes of a triangular face are stored contiguously (the only data member of the class
+        // TriangularFace is the array GLuint _node[3])
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, entry.vbo_indices);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, 3 * face.size() * sizeof(GLuint),
+                     reinterpret_cast<const GLuint*>(&face[0]), GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+
+    ++entry.reference_count;
+
+    return entry.vbo_indices;
+}
+
+GLvoid GridIndexBufferCache::ReleaseIndexBuffer(GLuint u_div_point_count, GLuint v_div_point_count)
+{
+    lock_guard<mutex> lock(_Mutex());
+
+    EntryMap::iterator it = _Entries().find(Key(u_div_point_count, v_div_point_count));
+
+    if (it == _Entries().end() || !it->second.reference_count)
+        return;
+
+    if (--it->second.reference_count == 0 && it->second.vbo_indices)
+    {
+        glDeleteBuffers(1, &it->second.vbo_indices);
+        it->second.vbo_indices = 0;
+    }
+}
+
+GLuint GridIndexBufferCache::IndexBufferReferenceCount(GLuint u_div_point_count, GLuint v_div_point_count)
+{
+    lock_guard<mutex> lock(_Mutex());
+
+    EntryMap::const_iterator it = _Entries().find(Key(u_div_point_count, v_div_point_count));
+
+    return (it == _Entries().end()) ? 0 : it->second.reference_count;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace cagd
+{
+    //---------------------------
+    // class GridIndexBufferCache
+    //---------------------------
+    // Every regular grid of the same size has the same face list (see the class GridTopologyCache of the
+    // core library), therefore the render-only images of such grids share a single element array buffer
+    // object. The buffer objects are reference counted: a buffer is uploaded when its first user acquires
+    // it and it is deleted when its last user releases it. All methods require a valid OpenGL rendering
+    // context.
+    class GridIndexBufferCache
+    {
+    private:
+        class Entry
+        {
+        public:
+            GLuint vbo_indices;
+            GLuint reference_count;
+
+            Entry(): vbo_indices(0), reference_count(0)
+            {
+            }
+        };
+
+        typedef std::pair<GLuint, GLuint>   Key;
+        typedef std::map<Key, Entry>        EntryMap;
+
+        static EntryMap&   _Entries();
+        static std::mutex& _Mutex();
+
+    public:
+        // returns the shared element array buffer object of the given grid and increases its
+        // reference counter
+        static GLuint AcquireIndexBuffer(GLuint u_div_point_count, GLuint v_div_point_count);
+
+        // decreases the reference counter of the shared element array buffer object of the given grid
+        // and deletes the buffer object if it is no longer used
+        static GLvoid ReleaseIndexBuffer(GLuint u_div_point_count, GLuint v_div_point_count);
+
+        // returns the number of meshes that currently share the index buffer of the given grid
+        static GLuint IndexBufferReferenceCount(GLuint u_div_point_count, GLuint v_div_point_count);
+    };
+}
@@ -1,4 +1,4 @@
-#include "Exceptions.h"
+#include "../Core/Exceptions.h"
 #include "Lights.h"
 
 // We are terribly sorry, but due to some mildly infuriating linker bugs, all contents of this source file have been moved to it's header file
@@ -35,6 +35,26 @@ void DirectionalLight::Disable()
     glDisable(_light_index);
 }
 
+const HCoordinate3& DirectionalLight::GetPosition() const
+{
+    return _position;
+}
+
+const Color4& DirectionalLight::GetAmbientIntensity() const
+{
+    return _ambient_intensity;
+}
+
+const Color4& DirectionalLight::GetDiffuseIntensity() const
+{
+    return _diffuse_intensity;
+}
+
+const Color4& DirectionalLight::GetSpecularIntensity() const
+{
+    return _specular_intensity;
+}
+
 // point light
 PointLight::PointLight(
     GLenum              light_index,
@@ -1,9 +1,9 @@
 #pragma once
 
-#include "Colors4.h"
-#include "HCoordinates3.h"
+#include "../Core/Colors4.h"
+#include "../Core/HCoordinates3.h"
 #include <GL/glew.h>
-#include "Exceptions.h"
+#include "../Core/Exceptions.h"
 
 namespace cagd
 {
@@ -24,6 +24,12 @@ namespace cagd
 
         void Enable();
         void Disable();
+
+        // the position is given in the coordinate system that was current when the light was created
+        const HCoordinate3& GetPosition() const;
+        const Color4&       GetAmbientIntensity() const;
+        const Color4&       GetDiffuseIntensity() const;
+        const Color4&       GetSpecularIntensity() const;
     };
 
     class PointLight: public DirectionalLight
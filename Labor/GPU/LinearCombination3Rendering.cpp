@@ -0,0 +1,111 @@
+#include "../Core/LinearCombination3.h"
+#include "../Core/FloatConversions.h"
+#include "BufferObjects.h"
+#include "RenderBackends.h"
+
+using namespace cagd;
+using namespace std;
+
+//------------------------------------------------------------------
+// vertex buffer object handling methods of class LinearCombination3
+//------------------------------------------------------------------
+
+GLboolean LinearCombination3::RenderData(GLenum render_mode) const
+{
+    const BufferObjects *vbo_data = BufferObjects::Of(_vbo_data);
+
+    if (!vbo_data)
+        return GL_FALSE;
+
+    if (render_mode != GL_LINE_STRIP && render_mode != GL_LINE_LOOP && render_mode != GL_POINTS)
+        return GL_FALSE;
+
+    // core profile path
+    if (RenderBackend::BeginDraw())
+    {
+        GLboolean is_new = GL_FALSE;
+        GLuint vertex_array = vbo_data->VertexArray(0, is_new);
+
+        if (vertex_array)
+        {
+            glBindVertexArray(vertex_array);
+
+            if (is_new)
+            {
+                glBindBuffer(GL_ARRAY_BUFFER, (*vbo_data)[0]);
+                glVertexAttribPointer(RenderBackend::POSITION_LOCATION, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+                glEnableVertexAttribArray(RenderBackend::POSITION_LOCATION);
+                glBindBuffer(GL_ARRAY_BUFFER, 0);
+            }
+
+            glDrawArrays(render_mode, 0, _data.GetRowCount());
+            glBindVertexArray(0);
+        }
+
+        RenderBackend::EndDraw();
+
+        return vertex_array ? GL_TRUE : GL_FALSE;
+    }
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+        glBindBuffer(GL_ARRAY_BUFFER, (*vbo_data)[0]);
+            glVertexPointer(3, GL_FLOAT, 0, nullptr);
+            glDrawArrays(render_mode, 0, _data.GetRowCount());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    return GL_TRUE;
+}
+
+GLboolean LinearCombination3::UpdateVertexBufferObjectsOfData(GLenum usage_flag)
+{
+    GLuint data_count = _data.GetRowCount();
+    if (!data_count)
+        return GL_FALSE;
+
+    if (usage_flag != GL_STREAM_DRAW  && usage_flag != GL_STREAM_READ  && usage_flag != GL_STREAM_COPY
+     && usage_flag != GL_DYNAMIC_DRAW && usage_flag != GL_DYNAMIC_READ && usage_flag != GL_DYNAMIC_COPY
+     && usage_flag != GL_STATIC_DRAW  && usage_flag != GL_STATIC_READ  && usage_flag != GL_STATIC_COPY)
+        return GL_FALSE;
+
+    _data_usage_flag = usage_flag;
+
+    DeleteVertexBufferObjectsOfData();
+
+    BufferObjects *vbo_data = new BufferObjects();
+
+    // the buffer object is owned by the linear combination from now on, i.e., it is deleted on failure
+    _vbo_data = vbo_data;
+
+    if (!vbo_data->Generate(1))
+    {
+        DeleteVertexBufferObjectsOfData();
+        return GL_FALSE;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, (*vbo_data)[0]);
+    glBufferData(GL_ARRAY_BUFFER, data_count * 3 * sizeof(GLfloat), nullptr, _data_usage_flag);
+
+    GLfloat *coordinate = (GLfloat*)glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
+    if (!coordinate)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        DeleteVertexBufferObjectsOfData();
+        return GL_FALSE;
+    }
+
+    // the rows of a column matrix are stored separately, thus the control points are converted one by one
+    for (GLuint i = 0; i < data_count; ++i, coordinate += 3)
+        ConvertToFloat(&_data[i], 1, coordinate);
+
+    if (!glUnmapBuffer(GL_ARRAY_BUFFER))
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        DeleteVertexBufferObjectsOfData();
+        return GL_FALSE;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return GL_TRUE;
+}
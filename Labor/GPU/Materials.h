@@ -1,6 +1,6 @@
 #pragma once
 
-#include "Colors4.h"
+#include "../Core/Colors4.h"
 #include <GL/glew.h>
 
 namespace cagd
@@ -50,6 +50,13 @@ namespace cagd
 
         GLvoid Apply();
 
+        // properties of the front face, e.g. for shaders that read the materials from buffer objects
+        const Color4& GetFrontAmbientColor() const;
+        const Color4& GetFrontDiffuseColor() const;
+        const Color4& GetFrontSpecularColor() const;
+        const Color4& GetFrontEmissiveColor() const;
+        GLfloat       GetFrontShininess() const;
+
         // homework
         GLboolean IsTransparent() const;
     };
@@ -182,6 +189,31 @@ namespace cagd
         _back_specular.a() = alpha;
     }
 
+    inline const Color4& Material::GetFrontAmbientColor() const
+    {
+        return _front_ambient;
+    }
+
+    inline const Color4& Material::GetFrontDiffuseColor() const
+    {
+        return _front_diffuse;
+    }
+
+    inline const Color4& Material::GetFrontSpecularColor() const
+    {
+        return _front_specular;
+    }
+
+    inline const Color4& Material::GetFrontEmissiveColor() const
+    {
+        return _front_emissive;
+    }
+
+    inline GLfloat Material::GetFrontShininess() const
+    {
+        return _front_shininess;
+    }
+
     inline GLboolean Material::IsTransparent() const
     {
         return (_front_ambient.a()  < 1 &&
@@ -0,0 +1,345 @@
+#include "RenderBackends.h"
+
+#include <cmath>
+#include <new>
+
+using namespace cagd;
+using namespace std;
+
+// inverse transpose of the upper-left 3 x 3 block of a column-major 4 x 4 matrix (the shader normalizes the
+// transformed normal vectors, thus a singular block results in the transposed cofactor matrix)
+static GLvoid NormalMatrix(const GLfloat model_view[16], GLfloat normal_matrix[9])
+{
+    GLfloat a[3][3];
+
+    for (GLuint r = 0; r < 3; ++r)
+        for (GLuint c = 0; c < 3; ++c)
+            a[r][c] = model_view[c * 4 + r];
+
+    GLfloat cofactor[3][3];
+
+    for (GLuint r = 0; r < 3; ++r)
+        for (GLuint c = 0; c < 3; ++c)
+            cofactor[r][c] = a[(r + 1) % 3][(c + 1) % 3] * a[(r + 2) % 3][(c + 2) % 3] -
+                             a[(r + 1) % 3][(c + 2) % 3] * a[(r + 2) % 3][(c + 1) % 3];
+
+    GLfloat determinant = a[0][0] * cofactor[0][0] + a[0][1] * cofactor[0][1] + a[0][2] * cofactor[0][2];
+    GLfloat scale = (fabs(determinant) > 0.0f) ? 1.0f / determinant : 1.0f;
+
+    for (GLuint r = 0; r < 3; ++r)
+        for (GLuint c = 0; c < 3; ++c)
+            normal_matrix[c * 3 + r] = scale * cofactor[r][c];
+}
+
+// the components of colors and homogeneous coordinates are returned by value
+static GLvoid Components(const Color4& color, GLfloat values[4])
+{
+    for (GLuint i = 0; i < 4; ++i)
+        values[i] = color[i];
+}
+
+static GLvoid Components(const HCoordinate3& coordinate, GLfloat values[4])
+{
+    for (GLuint i = 0; i < 4; ++i)
+        values[i] = coordinate[i];
+}
+
+RenderBackend::State::State():
+        type(FIXED_FUNCTION), adopts_fixed_function_state(GL_TRUE), batch_is_open(GL_FALSE), program(nullptr)
+{
+}
+
+RenderBackend::State& RenderBackend::_State()
+{
+    static State state;
+    return state;
+}
+
+GLboolean RenderBackend::IsCoreProfileSupported()
+{
+    return GLEW_VERSION_3_3 ? GL_TRUE : GL_FALSE;
+}
+
+GLboolean RenderBackend::Select(Type type, const string& shader_directory, const string& binary_cache_directory)
+{
+    Release();
+
+    if (type == FIXED_FUNCTION)
+        return GL_TRUE;
+
+    if (!IsCoreProfileSupported())
+        return GL_FALSE;
+
+    State &state = _State();
+
+    state.program = new (nothrow) ShaderProgram();
+
+    if (!state.program)
+        return GL_FALSE;
+
+    if (!binary_cache_directory.empty())
+        state.program->SetBinaryCacheDirectory(binary_cache_directory);
+
+    if (!state.program->InstallShaders(shader_directory + "/core_profile.vert", shader_directory + "/core_profile.frag"))
+    {
+        Release();
+        return GL_FALSE;
+    }
+
+    ShaderProgram &program = *state.program;
+
+    state.model_view_matrix     = program.GetUniform("model_view_matrix");
+    state.projection_matrix     = program.GetUniform("projection_matrix");
+    state.normal_matrix         = program.GetUniform("normal_matrix");
+    state.color                 = program.GetUniform("color");
+    state.lighting              = program.GetUniform("lighting");
+    state.light_position        = program.GetUniform("light_position");
+    state.light_ambient         = program.GetUniform("light_ambient");
+    state.light_diffuse         = program.GetUniform("light_diffuse");
+    state.light_specular        = program.GetUniform("light_specular");
+    state.global_ambient        = program.GetUniform("global_ambient");
+    state.material_ambient      = program.GetUniform("material_ambient");
+    state.material_diffuse      = program.GetUniform("material_diffuse");
+    state.material_specular     = program.GetUniform("material_specular");
+    state.material_emissive     = program.GetUniform("material_emissive");
+    state.material_shininess    = program.GetUniform("material_shininess");
+    state.texturing             = program.GetUniform("texturing");
+    state.texture_unit          = program.GetUniform("texture_unit");
+
+    program.SetUniformValue(state.texture_unit, 0);
+
+    // the fixed-function state can be queried only in compatibility contexts
+    GLint profile_mask = 0;
+    glGetIntegerv(GL_CONTEXT_PROFILE_MASK, &profile_mask);
+
+    state.adopts_fixed_function_state = (profile_mask & GL_CONTEXT_CORE_PROFILE_BIT) ? GL_FALSE : GL_TRUE;
+    state.type = CORE_PROFILE;
+
+    return GL_TRUE;
+}
+
+RenderBackend::Type RenderBackend::Selected()
+{
+    return _State().type;
+}
+
+GLvoid RenderBackend::SetFixedFunctionStateAdoption(GLboolean value)
+{
+    _State().adopts_fixed_function_state = value;
+}
+
+GLboolean RenderBackend::AdoptsFixedFunctionState()
+{
+    return _State().adopts_fixed_function_state;
+}
+
+GLvoid RenderBackend::SetProjectionMatrix(const GLfloat matrix[16])
+{
+    State &state = _State();
+
+    if (state.program)
+        state.program->SetUniformValues(state.projection_matrix, 1, matrix);
+}
+
+GLvoid RenderBackend::SetModelViewMatrix(const GLfloat matrix[16])
+{
+    State &state = _State();
+
+    if (!state.program)
+        return;
+
+    GLfloat normal_matrix[9];
+    NormalMatrix(matrix, normal_matrix);
+
+    state.program->SetUniformValues(state.model_view_matrix, 1, matrix);
+    state.program->SetUniformValues(state.normal_matrix, 1, normal_matrix);
+}
+
+GLvoid RenderBackend::SetColor(const Color4& color)
+{
+    State &state = _State();
+
+    if (!state.program)
+        return;
+
+    GLfloat values[4];
+
+    Components(color, values);
+    state.program->SetUniformValues(state.color, 1, values);
+}
+
+GLvoid RenderBackend::SetLighting(GLboolean value)
+{
+    State &state = _State();
+
+    if (state.program)
+        state.program->SetUniformValue(state.lighting, value ? 1 : 0);
+}
+
+GLvoid RenderBackend::SetLight(
+        const HCoordinate3& eye_position, const Color4& ambient, const Color4& diffuse,
+        const Color4& specular, const Color4& global_ambient)
+{
+    State &state = _State();
+
+    if (!state.program)
+        return;
+
+    GLfloat values[4];
+
+    Components(eye_position, values);
+    state.program->SetUniformValues(state.light_position, 1, values);
+    Components(ambient, values);
+    state.program->SetUniformValues(state.light_ambient, 1, values);
+    Components(diffuse, values);
+    state.program->SetUniformValues(state.light_diffuse, 1, values);
+    Components(specular, values);
+    state.program->SetUniformValues(state.light_specular, 1, values);
+    Components(global_ambient, values);
+    state.program->SetUniformValues(state.global_ambient, 1, values);
+}
+
+GLvoid RenderBackend::SetMaterial(const Material& material)
+{
+    State &state = _State();
+
+    if (!state.program)
+        return;
+
+    GLfloat values[4];
+
+    Components(material.GetFrontAmbientColor(), values);
+    state.program->SetUniformValues(state.material_ambient, 1, values);
+    Components(material.GetFrontDiffuseColor(), values);
+    state.program->SetUniformValues(state.material_diffuse, 1, values);
+    Components(material.GetFrontSpecularColor(), values);
+    state.program->SetUniformValues(state.material_specular, 1, values);
+    Components(material.GetFrontEmissiveColor(), values);
+    state.program->SetUniformValues(state.material_emissive, 1, values);
+    state.program->SetUniformValue(state.material_shininess, material.GetFrontShininess());
+}
+
+GLvoid RenderBackend::SetTexturing(GLboolean value)
+{
+    State &state = _State();
+
+    if (state.program)
+        state.program->SetUniformValue(state.texturing, value ? 1 : 0);
+}
+
+GLvoid RenderBackend::_AdoptFixedFunctionState(State& state)
+{
+    ShaderProgram &program = *state.program;
+
+    GLfloat matrix[16];
+
+    glGetFloatv(GL_PROJECTION_MATRIX, matrix);
+    program.SetUniformValues(state.projection_matrix, 1, matrix);
+
+    glGetFloatv(GL_MODELVIEW_MATRIX, matrix);
+    SetModelViewMatrix(matrix);
+
+    GLfloat values[4];
+
+    glGetFloatv(GL_CURRENT_COLOR, values);
+    program.SetUniformValues(state.color, 1, values);
+
+    GLboolean lighting = glIsEnabled(GL_LIGHTING) && glIsEnabled(GL_LIGHT0);
+    program.SetUniformValue(state.lighting, lighting ? 1 : 0);
+
+    if (lighting)
+    {
+        // the position of a light source is stored in eye coordinates
+        glGetLightfv(GL_LIGHT0, GL_POSITION, values);
+        program.SetUniformValues(state.light_position, 1, values);
+        glGetLightfv(GL_LIGHT0, GL_AMBIENT, values);
+        program.SetUniformValues(state.light_ambient, 1, values);
+        glGetLightfv(GL_LIGHT0, GL_DIFFUSE, values);
+        program.SetUniformValues(state.light_diffuse, 1, values);
+        glGetLightfv(GL_LIGHT0, GL_SPECULAR, values);
+        program.SetUniformValues(state.light_specular, 1, values);
+        glGetFloatv(GL_LIGHT_MODEL_AMBIENT, values);
+        program.SetUniformValues(state.global_ambient, 1, values);
+
+        glGetMaterialfv(GL_FRONT, GL_AMBIENT, values);
+        program.SetUniformValues(state.material_ambient, 1, values);
+        glGetMaterialfv(GL_FRONT, GL_DIFFUSE, values);
+        program.SetUniformValues(state.material_diffuse, 1, values);
+        glGetMaterialfv(GL_FRONT, GL_SPECULAR, values);
+        program.SetUniformValues(state.material_specular, 1, values);
+        glGetMaterialfv(GL_FRONT, GL_EMISSION, values);
+        program.SetUniformValues(state.material_emissive, 1, values);
+        glGetMaterialfv(GL_FRONT, GL_SHININESS, values);
+        program.SetUniformValue(state.material_shininess, values[0]);
+    }
+
+    // the application uses only the texture unit 0, a disabled or unbound unit does not modulate the color
+    GLint texture = 0;
+
+    if (glIsEnabled(GL_TEXTURE_2D))
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, &texture);
+
+    program.SetUniformValue(state.texturing, texture ? 1 : 0);
+}
+
+GLboolean RenderBackend::BeginDraw()
+{
+    State &state = _State();
+
+    if (state.type != CORE_PROFILE)
+        return GL_FALSE;
+
+    const ShaderProgram *in_use = ShaderProgram::InUse();
+
+    if (in_use && in_use != state.program)
+        return GL_FALSE;
+
+    if (state.adopts_fixed_function_state)
+        _AdoptFixedFunctionState(state);
+
+    if (in_use)
+        state.program->UpdateUniforms();
+    else
+        state.program->Enable();
+
+    return GL_TRUE;
+}
+
+GLvoid RenderBackend::EndDraw()
+{
+    State &state = _State();
+
+    if (state.program && !state.batch_is_open)
+        state.program->Disable();
+}
+
+GLvoid RenderBackend::BeginBatch()
+{
+    _State().batch_is_open = GL_TRUE;
+}
+
+GLvoid RenderBackend::EndBatch()
+{
+    State &state = _State();
+
+    state.batch_is_open = GL_FALSE;
+
+    if (state.program && ShaderProgram::InUse() == state.program)
+        state.program->Disable();
+}
+
+GLvoid RenderBackend::Release()
+{
+    State &state = _State();
+
+    if (state.program)
+    {
+        if (ShaderProgram::InUse() == state.program)
+            state.program->Disable();
+
+        delete state.program; state.program = nullptr;
+    }
+
+    state.type = FIXED_FUNCTION;
+    state.batch_is_open = GL_FALSE;
+}
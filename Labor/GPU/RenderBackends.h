@@ -0,0 +1,112 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <string>
+#include "../Core/Colors4.h"
+#include "../Core/HCoordinates3.h"
+#include "Materials.h"
+#include "ShaderPrograms.h"
+
+namespace cagd
+{
+    //--------------------
+    // class RenderBackend
+    //--------------------
+    // Selects how the rendering methods of the geometric objects (TriangulatedMesh3::Render,
+    // GenericCurve3::RenderDerivatives, LinearCombination3::RenderData and TensorProductSurface3::RenderData)
+    // submit their vertex buffer objects:
+    //   - FIXED_FUNCTION: client-side vertex, normal and texture coordinate arrays, the matrices, lighting and
+    //     material states of the fixed-function pipeline (the compatibility fallback);
+    //   - CORE_PROFILE: a vertex array object per buffer object (its attributes have the explicit locations of
+    //     AttributeLocation) and a GLSL 3.30 core program (see Shaders/core_profile.vert and .frag) that gets
+    //     the matrices, the color, the directional light and the material as uniform variables.
+    //
+    // The backend is selected once at startup, after the rendering context has been created. The state of the
+    // core profile path should be set explicitly by the methods Set* with the adoption disabled. Otherwise the
+    // core profile path adopts the state of the fixed-function pipeline (model-view and projection matrices,
+    // current color, light source 0, front material and 2D texturing) at each draw, i.e., it reads back about
+    // 17 states per draw, which is meant only for code that still specifies its transformations by the matrix
+    // stack of a compatibility context. The adoption is disabled automatically in core profile contexts, where
+    // the fixed-function state does not exist. The staged uniform values are uploaded only if they change.
+    //
+    // Draws issued while a user program is in use (e.g. the toon or reflection lines shaders of the application,
+    // which read the built-in vertex attributes) take the fixed-function path; the program in use is tracked by
+    // ShaderProgram::InUse, it is not queried. All methods require a valid OpenGL rendering context.
+    class RenderBackend
+    {
+    public:
+        enum Type
+        {
+            FIXED_FUNCTION = 0, CORE_PROFILE = 1
+        };
+
+        enum AttributeLocation
+        {
+            POSITION_LOCATION = 0, NORMAL_LOCATION = 1, TEXTURE_COORDINATE_LOCATION = 2
+        };
+
+    private:
+        class State
+        {
+        public:
+            Type                    type;
+            GLboolean               adopts_fixed_function_state;
+            GLboolean               batch_is_open;      // the core program is not disabled by EndDraw
+            ShaderProgram           *program;
+
+            ShaderProgram::Uniform  model_view_matrix, projection_matrix, normal_matrix, color;
+            ShaderProgram::Uniform  lighting, light_position, light_ambient, light_diffuse, light_specular, global_ambient;
+            ShaderProgram::Uniform  material_ambient, material_diffuse, material_specular, material_emissive, material_shininess;
+            ShaderProgram::Uniform  texturing, texture_unit;
+
+            State();
+        };
+
+        static State& _State();
+
+        // stages the fixed-function state as uniform values of the core program
+        static GLvoid _AdoptFixedFunctionState(State& state);
+
+    public:
+        // the core profile path needs OpenGL 3.3
+        static GLboolean IsCoreProfileSupported();
+
+        // if the core profile path is not supported, or its program cannot be installed, the fixed-function path
+        // remains selected and GL_FALSE is returned; program binaries are cached in the given directory, if it
+        // is not empty (see ShaderProgram::SetBinaryCacheDirectory)
+        static GLboolean Select(Type type, const std::string& shader_directory = "../Shaders",
+                                const std::string& binary_cache_directory = "");
+
+        static Type Selected();
+
+        static GLvoid    SetFixedFunctionStateAdoption(GLboolean value);
+        static GLboolean AdoptsFixedFunctionState();
+
+        // explicit state of the core profile path, the matrices are given in column-major order, the normal
+        // matrix is derived from the model-view matrix
+        static GLvoid SetProjectionMatrix(const GLfloat matrix[16]);
+        static GLvoid SetModelViewMatrix(const GLfloat matrix[16]);
+        static GLvoid SetColor(const Color4& color);
+        static GLvoid SetLighting(GLboolean value);
+        static GLvoid SetLight(const HCoordinate3& eye_position, const Color4& ambient, const Color4& diffuse,
+                               const Color4& specular, const Color4& global_ambient = Color4(0.2f, 0.2f, 0.2f, 1.0f));
+        static GLvoid SetMaterial(const Material& material);
+        static GLvoid SetTexturing(GLboolean value);
+
+        // if the core profile path is selected and no other program is in use, the core program is enabled
+        // with the current state and GL_TRUE is returned, otherwise the caller has to take the fixed-function
+        // path; a successful call has to be followed by EndDraw
+        static GLboolean BeginDraw();
+        static GLvoid    EndDraw();
+
+        // the core program remains in use from the first successful BeginDraw of a batch to EndBatch, i.e., the
+        // draws of a batch only flush the changed uniform values, the program is neither installed nor validated
+        // again; fixed-function draws (e.g. glBegin/glEnd) must not be issued within a batch
+        static GLvoid BeginBatch();
+        static GLvoid EndBatch();
+
+        // deletes the core program and selects the fixed-function path, it has to be called before the
+        // rendering context is destroyed
+        static GLvoid Release();
+    };
+}
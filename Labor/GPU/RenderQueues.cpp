@@ -0,0 +1,449 @@
+#include "RenderQueues.h"
+
+#include <algorithm>
+#include <functional>
+
+using namespace cagd;
+using namespace std;
+
+RenderQueue::Statistics::Statistics():
+        item_count(0), shader_changes(0), lighting_changes(0), material_changes(0), color_changes(0),
+        mesh_changes(0), draw_calls(0), unsorted_state_changes(0)
+{
+}
+
+GLuint RenderQueue::Statistics::StateChanges() const
+{
+    return shader_changes + lighting_changes + material_changes + color_changes + mesh_changes;
+}
+
+bool RenderQueue::Statistics::operator ==(const Statistics& rhs) const
+{
+    return item_count == rhs.item_count && shader_changes == rhs.shader_changes &&
+           lighting_changes == rhs.lighting_changes && material_changes == rhs.material_changes &&
+           color_changes == rhs.color_changes && mesh_changes == rhs.mesh_changes &&
+           draw_calls == rhs.draw_calls && unsorted_state_changes == rhs.unsorted_state_changes;
+}
+
+bool RenderQueue::Statistics::operator !=(const Statistics& rhs) const
+{
+    return !(*this == rhs);
+}
+
+bool RenderQueue::Precedes::operator ()(GLuint lhs, GLuint rhs) const
+{
+    const Item &a = _item[lhs], &b = _item[rhs];
+
+    // unrelated pointers are compared by std::less, since their built-in ordering is unspecified
+    less<const void*> address_precedes;
+
+    if (a.shader != b.shader)
+        return address_precedes(a.shader, b.shader);
+
+    if (a.material != b.material)
+        return address_precedes(a.material, b.material);
+
+    if (a.mesh != b.mesh)
+        return address_precedes(a.mesh, b.mesh);
+
+    return a.depth < b.depth;
+}
+
+// inverse transpose of the upper left 3 x 3 block of a column-major 4 x 4 matrix, stored as a column-major
+// 4 x 4 matrix; singular blocks result in their (unscaled) cofactor matrices
+static GLvoid NormalMatrix(const GLdouble model_view[16], GLfloat normal_matrix[16])
+{
+    fill(normal_matrix, normal_matrix + 16, 0.0f);
+    normal_matrix[15] = 1.0f;
+
+    GLdouble cofactor[3][3];
+
+    for (GLuint r = 0; r < 3; r++)
+    {
+        GLuint r1 = (r + 1) % 3, r2 = (r + 2) % 3;
+
+        for (GLuint c = 0; c < 3; c++)
+        {
+            GLuint c1 = (c + 1) % 3, c2 = (c + 2) % 3;
+
+            cofactor[r][c] = model_view[c1 * 4 + r1] * model_view[c2 * 4 + r2] -
+                             model_view[c2 * 4 + r1] * model_view[c1 * 4 + r2];
+        }
+    }
+
+    GLdouble determinant = model_view[0] * cofactor[0][0] + model_view[4] * cofactor[0][1] + model_view[8] * cofactor[0][2];
+    GLdouble scale = (determinant != 0.0) ? 1.0 / determinant : 1.0;
+
+    for (GLuint r = 0; r < 3; r++)
+        for (GLuint c = 0; c < 3; c++)
+            normal_matrix[c * 4 + r] = static_cast<GLfloat>(scale * cofactor[r][c]);
+}
+
+RenderQueue::RenderQueue():
+        _draw_buffer(0), _material_buffer(0), _command_buffer(0), _draw_id_buffer(0), _draw_id_count(0)
+{
+}
+
+GLboolean RenderQueue::IsMultiDrawSupported()
+{
+    return VertexPool::IsSupported() &&
+           (GLEW_VERSION_4_3 ||
+            (GLEW_ARB_multi_draw_indirect && GLEW_ARB_shader_storage_buffer_object && GLEW_ARB_base_instance));
+}
+
+GLvoid RenderQueue::Clear()
+{
+    _item.clear();
+}
+
+GLvoid RenderQueue::Push(const TriangulatedMesh3 *mesh, const GLdouble model_view[16], Material *material,
+                         const Color4 &color, const ShaderProgram *shader)
+{
+    // meshes without vertex buffer objects of their own may be contained by the pool given to Flush
+    if (!mesh || !model_view)
+        return;
+
+    _item.resize(_item.size() + 1);
+
+    Item &item = _item.back();
+
+    item.mesh     = mesh;
+    item.shader   = shader;
+    item.material = material;
+    item.color    = color;
+
+    copy(model_view, model_view + 16, item.model_view);
+
+    // the eye looks into the direction -z, i.e., closer objects have greater z coordinates
+    item.depth = -model_view[14];
+}
+
+const RenderQueue::Statistics& RenderQueue::Flush(const ShaderProgram *current_shader, const VertexPool *pool,
+                                                  const ShaderProgram *multi_draw_shader)
+{
+    _statistics = Statistics();
+
+    // items that have neither pooled nor own buffers are ignored
+    _order.clear();
+
+    for (GLuint i = 0; i < _item.size(); i++)
+        if (_Buffers(_item[i], pool))
+            _order.push_back(i);
+
+    _statistics.item_count = static_cast<GLuint>(_order.size());
+
+    if (_order.empty())
+    {
+        _item.clear();
+        return _statistics;
+    }
+
+    // the state changes of the items in submission order are counted without rendering them
+    StateTracker unsorted(current_shader);
+    Statistics   unsorted_statistics;
+
+    for (vector<GLuint>::const_iterator it = _order.begin(); it != _order.end(); ++it)
+        unsorted.Update(_item[*it], _Buffers(_item[*it], pool), unsorted_statistics);
+
+    // the items themselves are not moved, since they are relatively large
+    sort(_order.begin(), _order.end(), Precedes(_item));
+
+    _statistics.unsorted_state_changes = unsorted_statistics.StateChanges();
+
+    glPushMatrix();
+
+    if (!pool || !multi_draw_shader || current_shader || !_FlushMultiDraw(current_shader, *pool, *multi_draw_shader))
+        _FlushSorted(current_shader, pool);
+
+    glPopMatrix();
+
+    _item.clear();
+
+    return _statistics;
+}
+
+RenderQueue::StateTracker::StateTracker(const ShaderProgram *current_shader):
+        shader(current_shader), material(nullptr), bound(nullptr),
+        lighting(GL_FALSE), lighting_is_known(GL_FALSE), color_is_known(GL_FALSE)
+{
+}
+
+GLuint RenderQueue::StateTracker::Update(const Item &item, const void *buffers, Statistics &statistics)
+{
+    GLuint changes = 0;
+
+    if (item.shader != shader)
+    {
+        shader = item.shader;
+        changes |= SHADER;
+        statistics.shader_changes++;
+    }
+
+    GLboolean lit = (item.material != nullptr);
+
+    if (!lighting_is_known || lit != lighting)
+    {
+        lighting = lit;
+        lighting_is_known = GL_TRUE;
+        changes |= LIGHTING;
+        statistics.lighting_changes++;
+    }
+
+    if (lit && item.material != material)
+    {
+        material = item.material;
+        changes |= MATERIAL;
+        statistics.material_changes++;
+    }
+
+    if (!color_is_known || item.color.r() != color.r() || item.color.g() != color.g() ||
+        item.color.b() != color.b() || item.color.a() != color.a())
+    {
+        color = item.color;
+        color_is_known = GL_TRUE;
+        changes |= COLOR;
+        statistics.color_changes++;
+    }
+
+    if (buffers != bound)
+    {
+        bound = buffers;
+        changes |= BUFFERS;
+        statistics.mesh_changes++;
+    }
+
+    return changes;
+}
+
+const void* RenderQueue::_Buffers(const Item &item, const VertexPool *pool)
+{
+    // pooled meshes share the binding of the pool
+    if (pool && VertexPool::IsSupported() && pool->Find(item.mesh))
+        return pool;
+
+    return item.mesh->HasVertexBufferObjects() ? item.mesh : nullptr;
+}
+
+GLvoid RenderQueue::_FlushSorted(const ShaderProgram *current_shader, const VertexPool *pool)
+{
+    StateTracker state(current_shader);
+
+    for (vector<GLuint>::const_iterator it = _order.begin(); it != _order.end(); ++it)
+    {
+        const Item          &item     = _item[*it];
+        const ShaderProgram *previous = state.shader;
+        const void          *buffers  = _Buffers(item, pool);
+        GLboolean           pooled    = (buffers == pool);
+        GLuint              changes   = state.Update(item, buffers, _statistics);
+
+        if (changes & StateTracker::SHADER)
+        {
+            if (item.shader)
+                item.shader->Enable();
+            else
+                previous->Disable();
+        }
+
+        if (changes & StateTracker::LIGHTING)
+        {
+            if (state.lighting)
+                glEnable(GL_LIGHTING);
+            else
+                glDisable(GL_LIGHTING);
+        }
+
+        if (changes & StateTracker::MATERIAL)
+            item.material->Apply();
+
+        if (changes & StateTracker::COLOR)
+            glColor4f(item.color.r(), item.color.g(), item.color.b(), item.color.a());
+
+        if (changes & StateTracker::BUFFERS)
+        {
+            if (pooled)
+                pool->Bind();
+            else
+                item.mesh->BindVertexBufferObjects();
+        }
+
+        glLoadMatrixd(item.model_view);
+
+        if (pooled)
+            pool->Draw(item.mesh);
+        else
+            item.mesh->DrawElements();
+
+        _statistics.draw_calls++;
+    }
+
+    if (state.bound)
+        TriangulatedMesh3::UnbindVertexBufferObjects();
+
+    if (state.lighting)
+        glDisable(GL_LIGHTING);
+
+    if (state.shader != current_shader)
+    {
+        if (current_shader)
+            current_shader->Enable();
+        else
+            state.shader->Disable();
+    }
+}
+
+GLboolean RenderQueue::_FlushMultiDraw(const ShaderProgram *current_shader, const VertexPool &pool,
+                                       const ShaderProgram &multi_draw_shader)
+{
+    if (!IsMultiDrawSupported())
+        return GL_FALSE;
+
+    // the materials are indexed in the order of their first appearance
+    vector<const Material*> materials;
+
+    _draw_data.resize(40 * _order.size());
+    _command_data.resize(5 * _order.size());
+    _material_data.clear();
+
+    for (GLuint i = 0; i < _order.size(); i++)
+    {
+        const Item &item = _item[_order[i]];
+        const VertexPool::Allocation *allocation = pool.Find(item.mesh);
+
+        if (!allocation || item.shader)
+            return GL_FALSE;
+
+        GLint material_index = -1;
+
+        if (item.material)
+        {
+            material_index = static_cast<GLint>(find(materials.begin(), materials.end(), item.material) - materials.begin());
+
+            if (material_index == static_cast<GLint>(materials.size()))
+            {
+                materials.push_back(item.material);
+
+                const Color4 *colors[4] = {&item.material->GetFrontAmbientColor(), &item.material->GetFrontDiffuseColor(),
+                                           &item.material->GetFrontSpecularColor(), &item.material->GetFrontEmissiveColor()};
+
+                for (GLuint c = 0; c < 4; c++)
+                    for (GLuint k = 0; k < 4; k++)
+                        _material_data.push_back((*colors[c])[k]);
+
+                _material_data.push_back(item.material->GetFrontShininess());
+                _material_data.insert(_material_data.end(), 3, 0.0f);
+            }
+        }
+
+        // layout of the struct Draw of the shaders (std430): model-view matrix, normal matrix, color, parameters
+        GLfloat *draw = &_draw_data[40 * i];
+
+        for (GLuint k = 0; k < 16; k++)
+            draw[k] = static_cast<GLfloat>(item.model_view[k]);
+
+        NormalMatrix(item.model_view, draw + 16);
+
+        for (GLuint k = 0; k < 4; k++)
+            draw[32 + k] = item.color[k];
+
+        draw[36] = static_cast<GLfloat>(material_index);
+        draw[37] = draw[38] = draw[39] = 0.0f;
+
+        // count, instance count, first index, base vertex and base instance, i.e., the index of the draw
+        GLuint *command = &_command_data[5 * i];
+
+        command[0] = allocation->index_count;
+        command[1] = 1;
+        command[2] = allocation->first_index;
+        command[3] = allocation->first_vertex;
+        command[4] = i;
+    }
+
+    if (!_draw_buffer)
+    {
+        GLuint buffer[4];
+        glGenBuffers(4, buffer);
+
+        _draw_buffer     = buffer[0];
+        _material_buffer = buffer[1];
+        _command_buffer  = buffer[2];
+        _draw_id_buffer  = buffer[3];
+    }
+
+    // the draw indices are constant, they are uploaded only if the queue has grown
+    if (_draw_id_count < _order.size())
+    {
+        _draw_id_count = static_cast<GLuint>(_order.size());
+
+        vector<GLuint> draw_id(_draw_id_count);
+
+        for (GLuint i = 0; i < _draw_id_count; i++)
+            draw_id[i] = i;
+
+        glBindBuffer(GL_ARRAY_BUFFER, _draw_id_buffer);
+        glBufferData(GL_ARRAY_BUFFER, _draw_id_count * sizeof(GLuint), &draw_id[0], GL_STATIC_DRAW);
+    }
+
+    // the per-frame data is uploaded into orphaned buffers
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _draw_buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, _draw_data.size() * sizeof(GLfloat), &_draw_data[0], GL_STREAM_DRAW);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, _draw_buffer);
+
+    // the buffer cannot be empty, even if each item is unlit
+    if (_material_data.empty())
+        _material_data.resize(20, 0.0f);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _material_buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, _material_data.size() * sizeof(GLfloat), &_material_data[0], GL_STREAM_DRAW);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, _material_buffer);
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _command_buffer);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, _command_data.size() * sizeof(GLuint), &_command_data[0], GL_STREAM_DRAW);
+
+    multi_draw_shader.Enable();
+    _statistics.shader_changes++;
+
+    pool.Bind();
+    _statistics.mesh_changes++;
+
+    // the attribute draw_id (location 1) advances once per instance, starting at the base instance
+    glBindBuffer(GL_ARRAY_BUFFER, _draw_id_buffer);
+    glVertexAttribIPointer(1, 1, GL_UNSIGNED_INT, 0, nullptr);
+    glVertexAttribDivisor(1, 1);
+    glEnableVertexAttribArray(1);
+
+    glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, static_cast<GLsizei>(_order.size()), 0);
+    _statistics.draw_calls++;
+
+    glDisableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 0);
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    VertexPool::Unbind();
+
+    if (current_shader)
+        current_shader->Enable();
+    else
+        multi_draw_shader.Disable();
+
+    return GL_TRUE;
+}
+
+GLuint RenderQueue::ItemCount() const
+{
+    return static_cast<GLuint>(_item.size());
+}
+
+const RenderQueue::Statistics& RenderQueue::LastStatistics() const
+{
+    return _statistics;
+}
+
+RenderQueue::~RenderQueue()
+{
+    if (_draw_buffer)
+    {
+        GLuint buffer[4] = {_draw_buffer, _material_buffer, _command_buffer, _draw_id_buffer};
+        glDeleteBuffers(4, buffer);
+    }
+}
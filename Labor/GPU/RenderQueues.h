@@ -0,0 +1,158 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <vector>
+#include "../Core/Colors4.h"
+#include "../Core/TriangulatedMeshes3.h"
+#include "Materials.h"
+#include "ShaderPrograms.h"
+#include "VertexPools.h"
+
+namespace cagd
+{
+    //------------------
+    // class RenderQueue
+    //------------------
+    // Collects the draw items of a frame and renders them sorted by their state, i.e., by shader program,
+    // by material (unlit items first), by mesh and finally front-to-back by their depth. Redundant state
+    // changes are skipped: GL_LIGHTING is toggled, materials are applied, colors are set and the vertex
+    // buffer objects of a mesh are bound only if they differ from the ones of the previous item. Each item
+    // is drawn with its own model-view matrix, the matrix stack of the caller is preserved.
+    //
+    // If the meshes are contained by a VertexPool, the pool is bound only once and the items are drawn by
+    // glDrawElementsBaseVertex. Moreover, if a multi-draw shader program is given (see
+    // ../../Shaders/race_multi_draw.vert) and OpenGL 4.3 is available, the whole queue is submitted by a single
+    // glMultiDrawElementsIndirect call: the model-view matrices, colors and materials of the items are read by
+    // the shader from shader storage buffer objects, therefore the CPU cost of the submission hardly depends
+    // on the number of items.
+    //
+    // The queue does not own the meshes, materials and shader programs, they have to be valid until the
+    // queue is flushed. The directional lights have to be enabled by the caller.
+    class RenderQueue
+    {
+    public:
+        // number of items and state changes of a flushed frame
+        class Statistics
+        {
+        public:
+            GLuint item_count;
+            GLuint shader_changes;
+            GLuint lighting_changes;
+            GLuint material_changes;
+            GLuint color_changes;
+            GLuint mesh_changes;
+            GLuint draw_calls;
+
+            // number of state changes that the same items would cost in submission order, i.e., without sorting
+            // (counted by the same redundancy checks as the sorted ones, but without rendering)
+            GLuint unsorted_state_changes;
+
+            Statistics();
+
+            GLuint StateChanges() const;
+
+            bool operator ==(const Statistics& rhs) const;
+            bool operator !=(const Statistics& rhs) const;
+        };
+
+    private:
+        class Item
+        {
+        public:
+            const TriangulatedMesh3 *mesh;
+            const ShaderProgram     *shader;    // nullptr denotes the fixed-function pipeline
+            Material                *material;  // nullptr denotes unlit items
+            Color4                  color;
+            GLdouble                model_view[16];
+            GLdouble                depth;      // distance from the eye along the viewing direction
+        };
+
+        // tracks the current state of the sorted rendering, i.e., it decides which state changes are redundant
+        class StateTracker
+        {
+        public:
+            enum Change {SHADER = 1, LIGHTING = 2, MATERIAL = 4, COLOR = 8, BUFFERS = 16};
+
+            const ShaderProgram *shader;
+            const Material      *material;
+            const void          *bound;     // the pool or a mesh
+            GLboolean           lighting, lighting_is_known, color_is_known;
+            Color4              color;
+
+            StateTracker(const ShaderProgram *current_shader);
+
+            // returns the bitwise or of the changes required by the given item drawn from the given buffers,
+            // updates the tracked state and increases the corresponding counters of the statistics
+            GLuint Update(const Item &item, const void *buffers, Statistics &statistics);
+        };
+
+        std::vector<Item>   _item;
+        std::vector<GLuint> _order;
+        Statistics          _statistics;
+
+        // buffer objects of the multi-draw path: per-draw data and materials (shader storage buffers),
+        // indirect draw commands and the instanced draw indices
+        GLuint              _draw_buffer, _material_buffer, _command_buffer, _draw_id_buffer;
+        GLuint              _draw_id_count;
+        std::vector<GLfloat> _draw_data, _material_data;
+        std::vector<GLuint> _command_data;
+
+        // the pool, if the mesh of the given item is contained by it, the mesh if it has vertex buffer objects,
+        // nullptr otherwise
+        static const void* _Buffers(const Item &item, const VertexPool *pool);
+
+        // renders the sorted items one by one
+        GLvoid _FlushSorted(const ShaderProgram *current_shader, const VertexPool *pool);
+
+        // renders the items by a single indirect multi-draw call, returns GL_FALSE if the path cannot be used
+        GLboolean _FlushMultiDraw(const ShaderProgram *current_shader, const VertexPool &pool,
+                                  const ShaderProgram &multi_draw_shader);
+
+        // queues cannot be copied
+        RenderQueue(const RenderQueue&);
+        RenderQueue& operator =(const RenderQueue&);
+
+        // sort criterion of the item indices
+        class Precedes
+        {
+        private:
+            const std::vector<Item> &_item;
+
+        public:
+            Precedes(const std::vector<Item> &item): _item(item) {}
+
+            bool operator ()(GLuint lhs, GLuint rhs) const;
+        };
+
+    public:
+        RenderQueue();
+
+        // requires OpenGL 4.3, or the extensions GL_ARB_multi_draw_indirect, GL_ARB_shader_storage_buffer_object
+        // and GL_ARB_base_instance (and the vertex pool)
+        static GLboolean IsMultiDrawSupported();
+
+        // removes every collected item
+        GLvoid Clear();
+
+        // collects a draw item, the model-view matrix is stored in column-major order (e.g. as it is returned
+        // by glGetDoublev(GL_MODELVIEW_MATRIX, ...)); items whose meshes are neither contained by the pool given
+        // to Flush nor have vertex buffer objects of their own are ignored by Flush
+        GLvoid Push(const TriangulatedMesh3 *mesh, const GLdouble model_view[16], Material *material,
+                    const Color4 &color, const ShaderProgram *shader = nullptr);
+
+        // sorts and renders the collected items, then clears the queue; the given shader program is assumed to
+        // be in use before the call and it is in use after the call as well; GL_LIGHTING is disabled afterwards;
+        // the multi-draw path is used only if the fixed-function pipeline is current (i.e. current_shader is
+        // nullptr), the multi-draw shader is given and each mesh is contained by the pool
+        const Statistics& Flush(const ShaderProgram *current_shader = nullptr, const VertexPool *pool = nullptr,
+                                const ShaderProgram *multi_draw_shader = nullptr);
+
+        GLuint ItemCount() const;
+
+        // statistics of the last flushed frame
+        const Statistics& LastStatistics() const;
+
+        // deletes the buffer objects of the multi-draw path
+        ~RenderQueue();
+    };
+}
@@ -1,5 +1,8 @@
-#include "Exceptions.h"
+#include "../Core/Exceptions.h"
+#include <algorithm>
+#include <cstdio>
 #include <fstream>
+#include <sstream>
 #include "ShaderPrograms.h"
 
 using namespace cagd;
@@ -9,10 +12,143 @@ ShaderProgram::ShaderProgram():
         _vertex_shader(0), _fragment_shader(0), _program(0),
         _vertex_shader_file_name(""), _fragment_shader_file_name(""),
         _vertex_shader_source(""), _fragment_shader_source(""),
-        _vertex_shader_compiled(0), _fragment_shader_compiled(0), _linked(0)
+        _vertex_shader_compiled(0), _fragment_shader_compiled(0), _linked(0),
+        _binary_cache_directory(""), _uniforms_are_dirty(GL_FALSE)
 {
 }
 
+GLvoid ShaderProgram::SetBinaryCacheDirectory(const string &directory)
+{
+    _binary_cache_directory = directory;
+}
+
+GLboolean ShaderProgram::_ReadSource(const string &file_name, string &source)
+{
+    ifstream file(file_name.c_str(), ios_base::in | ios_base::binary);
+
+    if (!file || !file.good())
+        return GL_FALSE;
+
+    ostringstream content;
+    content << file.rdbuf();
+    source = content.str();
+
+    return GL_TRUE;
+}
+
+string ShaderProgram::_BinaryCacheFileName() const
+{
+    string key = _vertex_shader_source;
+    key += '\0';
+    key += _fragment_shader_source;
+
+    const GLenum names[] = {GL_VENDOR, GL_RENDERER, GL_VERSION};
+
+    for (GLuint i = 0; i < 3; i++)
+    {
+        const GLubyte *value = glGetString(names[i]);
+
+        key += '\0';
+        if (value)
+            key += reinterpret_cast<const char*>(value);
+    }
+
+    // 64-bit FNV-1a hash
+    unsigned long long hash = 14695981039346656037ull;
+
+    for (string::const_iterator it = key.begin(); it != key.end(); ++it)
+    {
+        hash ^= static_cast<unsigned char>(*it);
+        hash *= 1099511628211ull;
+    }
+
+    char hexadecimal_hash[17];
+    sprintf(hexadecimal_hash, "%016llx", hash);
+
+    // e.g. <directory>/toon.vert.0123456789abcdef.bin
+    string::size_type separator = _vertex_shader_file_name.find_last_of("/\\");
+    string            base_name = (separator == string::npos) ? _vertex_shader_file_name : _vertex_shader_file_name.substr(separator + 1);
+
+    return _binary_cache_directory + "/" + base_name + "." + hexadecimal_hash + ".bin";
+}
+
+GLboolean ShaderProgram::_LoadProgramBinary(const string &file_name, GLboolean logging_is_enabled, ostream &output)
+{
+    ifstream file(file_name.c_str(), ios_base::in | ios_base::binary);
+
+    if (!file || !file.good())
+        return GL_FALSE;
+
+    GLenum format = 0;
+    GLint  length = 0;
+
+    file.read(reinterpret_cast<char*>(&format), sizeof(format));
+    file.read(reinterpret_cast<char*>(&length), sizeof(length));
+
+    if (!file || length <= 0)
+        return GL_FALSE;
+
+    vector<char> binary(length);
+    file.read(&binary[0], length);
+
+    if (!file)
+        return GL_FALSE;
+
+    _program = glCreateProgram();
+    glProgramBinary(_program, format, &binary[0], length);
+    glGetProgramiv(_program, GL_LINK_STATUS, &_linked);
+
+    if (!_linked)
+    {
+        // e.g. the driver has been updated without changing its version string
+        if (logging_is_enabled)
+            output << "The program binary " << file_name << " was rejected by the driver." << endl << endl;
+
+        glDeleteProgram(_program);
+        _program = 0;
+
+        return GL_FALSE;
+    }
+
+    // Enable checks the compilation status values, too
+    _vertex_shader_compiled = _fragment_shader_compiled = GL_TRUE;
+
+    if (logging_is_enabled)
+        output << "The program binary " << file_name << " was loaded." << endl << endl;
+
+    return GL_TRUE;
+}
+
+GLvoid ShaderProgram::_SaveProgramBinary(const string &file_name, GLboolean logging_is_enabled, ostream &output) const
+{
+    GLint length = 0;
+    glGetProgramiv(_program, GL_PROGRAM_BINARY_LENGTH, &length);
+
+    if (length <= 0)
+        return;
+
+    vector<char> binary(length);
+    GLenum       format = 0;
+
+    glGetProgramBinary(_program, length, &length, &format, &binary[0]);
+
+    if (length <= 0)
+        return;
+
+    ofstream file(file_name.c_str(), ios_base::out | ios_base::binary | ios_base::trunc);
+
+    // the cache is only an optimization, therefore failed writes are not considered as errors
+    if (!file || !file.good())
+        return;
+
+    file.write(reinterpret_cast<const char*>(&format), sizeof(format));
+    file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    file.write(&binary[0], length);
+
+    if (logging_is_enabled)
+        output << "The program binary was stored into " << file_name << "." << endl << endl;
+}
+
 // returns GL_TRUE if an OpenGL error occurred, GL_FALSE otherwise.
 GLboolean ShaderProgram::_ListOpenGLErrors(const char *file_name, GLint line, ostream& output) const
 {
@@ -139,9 +275,106 @@ GLvoid ShaderProgram::_ListValidateInfoLog(ostream& output) const
     _ListOpenGLErrors(__FILE__, __LINE__, output);
 }
 
+GLint ShaderProgram::_ComponentCount(GLenum type, GLboolean &is_integer)
+{
+    is_integer = GL_FALSE;
+
+    switch (type)
+    {
+    case GL_FLOAT:              return 1;
+    case GL_FLOAT_VEC2:         return 2;
+    case GL_FLOAT_VEC3:         return 3;
+    case GL_FLOAT_VEC4:         return 4;
+    case GL_FLOAT_MAT2:         return 4;
+    case GL_FLOAT_MAT3:         return 9;
+    case GL_FLOAT_MAT4:         return 16;
+    case GL_FLOAT_MAT2x3:       return 6;
+    case GL_FLOAT_MAT3x2:       return 6;
+    case GL_FLOAT_MAT2x4:       return 8;
+    case GL_FLOAT_MAT4x2:       return 8;
+    case GL_FLOAT_MAT3x4:       return 12;
+    case GL_FLOAT_MAT4x3:       return 12;
+
+    case GL_INT_VEC2:
+    case GL_BOOL_VEC2:          is_integer = GL_TRUE; return 2;
+    case GL_INT_VEC3:
+    case GL_BOOL_VEC3:          is_integer = GL_TRUE; return 3;
+    case GL_INT_VEC4:
+    case GL_BOOL_VEC4:          is_integer = GL_TRUE; return 4;
+
+    // scalar integers, booleans and samplers
+    default:                    is_integer = GL_TRUE; return 1;
+    }
+}
+
+GLvoid ShaderProgram::_ReflectUniforms()
+{
+    _uniform.clear();
+    _uniform_index.clear();
+    _uniforms_are_dirty = GL_FALSE;
+
+    GLint uniform_count = 0, max_name_length = 0;
+
+    glGetProgramiv(_program, GL_ACTIVE_UNIFORMS, &uniform_count);
+    glGetProgramiv(_program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_name_length);
+
+    vector<GLchar> name(max_name_length + 1);
+
+    for (GLint i = 0; i < uniform_count; i++)
+    {
+        GLsizei         name_length = 0;
+        UniformVariable variable;
+
+        glGetActiveUniform(_program, i, static_cast<GLsizei>(name.size()), &name_length, &variable.size, &variable.type, &name[0]);
+
+        variable.name.assign(&name[0], name_length);
+
+        // built-in variables (e.g. gl_ModelViewMatrix) cannot be set
+        if (variable.name.compare(0, 3, "gl_") == 0)
+            continue;
+
+        variable.location        = glGetUniformLocation(_program, variable.name.c_str());
+        variable.component_count = _ComponentCount(variable.type, variable.is_integer);
+        variable.is_dirty        = GL_FALSE;
+
+        if (variable.location == -1)
+            continue;
+
+        GLuint index = static_cast<GLuint>(_uniform.size());
+
+        // arrays are reported as name[0], but they can be referenced by their names, too
+        string::size_type bracket = variable.name.rfind("[0]");
+
+        if (bracket != string::npos && bracket + 3 == variable.name.size())
+            _uniform_index[variable.name.substr(0, bracket)] = index;
+
+        _uniform_index[variable.name] = index;
+        _uniform.push_back(variable);
+    }
+}
+
 GLint ShaderProgram::GetUniformVariableLocation(const GLchar *name, GLboolean logging_is_enabled, ostream& output) const
 {
-    GLint loc = glGetUniformLocation(_program, name);
+    unordered_map<string, GLuint>::const_iterator reflected = _uniform_index.find(name);
+
+    if (reflected != _uniform_index.end())
+        return _uniform[reflected->second].location;
+
+    // e.g. elements of arrays, their locations are queried only once
+    UniformVariable variable;
+
+    variable.name            = name;
+    variable.location        = glGetUniformLocation(_program, name);
+    variable.type            = GL_NONE;
+    variable.size            = 0;
+    variable.is_integer      = GL_FALSE;
+    variable.component_count = 0;
+    variable.is_dirty        = GL_FALSE;
+
+    _uniform_index[variable.name] = static_cast<GLuint>(_uniform.size());
+    _uniform.push_back(variable);
+
+    GLint loc = variable.location;
 
     if (loc == -1)
     {
@@ -156,70 +389,224 @@ GLint ShaderProgram::GetUniformVariableLocation(const GLchar *name, GLboolean lo
     return loc;
 }
 
+ShaderProgram::Uniform ShaderProgram::GetUniform(const GLchar *name) const
+{
+    Uniform uniform;
+
+    unordered_map<string, GLuint>::const_iterator reflected = _uniform_index.find(name);
+
+    if (reflected != _uniform_index.end() && _uniform[reflected->second].type != GL_NONE)
+    {
+        uniform._index = static_cast<GLint>(reflected->second);
+        uniform._type  = _uniform[reflected->second].type;
+    }
+
+    return uniform;
+}
+
+GLboolean ShaderProgram::SetUniformValues(const Uniform &uniform, GLint count, const GLfloat *values)
+{
+    if (!uniform.IsValid() || uniform._index >= static_cast<GLint>(_uniform.size()) || count < 1 || !values)
+        return GL_FALSE;
+
+    UniformVariable &variable = _uniform[uniform._index];
+
+    if (variable.is_integer || count > variable.size)
+        return GL_FALSE;
+
+    GLint value_count = count * variable.component_count;
+
+    if (static_cast<GLint>(variable.float_values.size()) == value_count &&
+        equal(values, values + value_count, variable.float_values.begin()))
+        return GL_TRUE;
+
+    variable.float_values.assign(values, values + value_count);
+    variable.is_dirty = _uniforms_are_dirty = GL_TRUE;
+
+    return GL_TRUE;
+}
+
+GLboolean ShaderProgram::SetUniformValues(const Uniform &uniform, GLint count, const GLint *values)
+{
+    if (!uniform.IsValid() || uniform._index >= static_cast<GLint>(_uniform.size()) || count < 1 || !values)
+        return GL_FALSE;
+
+    UniformVariable &variable = _uniform[uniform._index];
+
+    if (!variable.is_integer || count > variable.size)
+        return GL_FALSE;
+
+    GLint value_count = count * variable.component_count;
+
+    if (static_cast<GLint>(variable.integer_values.size()) == value_count &&
+        equal(values, values + value_count, variable.integer_values.begin()))
+        return GL_TRUE;
+
+    variable.integer_values.assign(values, values + value_count);
+    variable.is_dirty = _uniforms_are_dirty = GL_TRUE;
+
+    return GL_TRUE;
+}
+
+GLboolean ShaderProgram::SetUniformValue(const Uniform &uniform, GLfloat value)
+{
+    return SetUniformValues(uniform, 1, &value);
+}
+
+GLboolean ShaderProgram::SetUniformValue(const Uniform &uniform, GLint value)
+{
+    return SetUniformValues(uniform, 1, &value);
+}
+
+GLvoid ShaderProgram::_FlushUniforms() const
+{
+    for (vector<UniformVariable>::iterator it = _uniform.begin(); it != _uniform.end(); ++it)
+    {
+        UniformVariable &variable = *it;
+
+        if (!variable.is_dirty)
+            continue;
+
+        variable.is_dirty = GL_FALSE;
+
+        if (variable.is_integer)
+        {
+            GLsizei count = static_cast<GLsizei>(variable.integer_values.size()) / variable.component_count;
+            const GLint *values = &variable.integer_values[0];
+
+            switch (variable.component_count)
+            {
+            case 1: glUniform1iv(variable.location, count, values); break;
+            case 2: glUniform2iv(variable.location, count, values); break;
+            case 3: glUniform3iv(variable.location, count, values); break;
+            case 4: glUniform4iv(variable.location, count, values); break;
+            }
+
+            continue;
+        }
+
+        GLsizei count = static_cast<GLsizei>(variable.float_values.size()) / variable.component_count;
+        const GLfloat *values = &variable.float_values[0];
+
+        switch (variable.type)
+        {
+        case GL_FLOAT:          glUniform1fv(variable.location, count, values); break;
+        case GL_FLOAT_VEC2:     glUniform2fv(variable.location, count, values); break;
+        case GL_FLOAT_VEC3:     glUniform3fv(variable.location, count, values); break;
+        case GL_FLOAT_VEC4:     glUniform4fv(variable.location, count, values); break;
+        case GL_FLOAT_MAT2:     glUniformMatrix2fv(variable.location, count, GL_FALSE, values); break;
+        case GL_FLOAT_MAT3:     glUniformMatrix3fv(variable.location, count, GL_FALSE, values); break;
+        case GL_FLOAT_MAT4:     glUniformMatrix4fv(variable.location, count, GL_FALSE, values); break;
+        case GL_FLOAT_MAT2x3:   glUniformMatrix2x3fv(variable.location, count, GL_FALSE, values); break;
+        case GL_FLOAT_MAT3x2:   glUniformMatrix3x2fv(variable.location, count, GL_FALSE, values); break;
+        case GL_FLOAT_MAT2x4:   glUniformMatrix2x4fv(variable.location, count, GL_FALSE, values); break;
+        case GL_FLOAT_MAT4x2:   glUniformMatrix4x2fv(variable.location, count, GL_FALSE, values); break;
+        case GL_FLOAT_MAT3x4:   glUniformMatrix3x4fv(variable.location, count, GL_FALSE, values); break;
+        case GL_FLOAT_MAT4x3:   glUniformMatrix4x3fv(variable.location, count, GL_FALSE, values); break;
+        }
+    }
+
+    _uniforms_are_dirty = GL_FALSE;
+}
+
+GLvoid ShaderProgram::_InvalidateStagedValues(const string &name) const
+{
+    unordered_map<string, GLuint>::const_iterator reflected = _uniform_index.find(name);
+
+    if (reflected == _uniform_index.end())
+        return;
+
+    UniformVariable &variable = _uniform[reflected->second];
+
+    variable.float_values.clear();
+    variable.integer_values.clear();
+    variable.is_dirty = GL_FALSE;
+}
+
+GLint ShaderProgram::_DirectlyWrittenUniformLocation(const GLchar *name) const
+{
+    GLint location = GetUniformVariableLocation(name);
+
+    if (location == -1)
+        return location;
+
+    // an element of an array invalidates the staged values of the whole array
+    string variable_name = name;
+    string::size_type bracket = variable_name.find('[');
+
+    _InvalidateStagedValues(variable_name);
+
+    if (bracket != string::npos)
+        _InvalidateStagedValues(variable_name.substr(0, bracket));
+
+    return location;
+}
+
 GLboolean ShaderProgram::InstallShaders(const string &vertex_shader_file_name, const string &fragment_shader_file_name, GLboolean logging_is_enabled, std::ostream &output)
 {
     // loading source codes into shader objects
     _vertex_shader_file_name = vertex_shader_file_name;
     _fragment_shader_file_name = fragment_shader_file_name;
 
-    fstream vertex_shader_file(vertex_shader_file_name.c_str(), ios_base::in);
+    _uniform.clear();
+    _uniform_index.clear();
+    _uniforms_are_dirty = GL_FALSE;
 
-    if (!vertex_shader_file || !vertex_shader_file.good())
+    if (!_ReadSource(vertex_shader_file_name, _vertex_shader_source))
     {
         return GL_FALSE;
     }
 
-    _vertex_shader_source = "";
-    string aux;
-
     if (logging_is_enabled)
     {
         output << "Source of vertex shader" << endl;
         output << "-----------------------" << endl;
-    }
 
-    while (!vertex_shader_file.eof())
-    {
-        getline(vertex_shader_file, aux, '\n');
-        _vertex_shader_source += aux + '\n';
-
-        if (logging_is_enabled)
+        istringstream lines(_vertex_shader_source);
+        for (string aux; getline(lines, aux, '\n'); )
             output << "\t" << aux << endl;
-    }
 
-    vertex_shader_file.close();
-
-    if (logging_is_enabled)
         output << endl;
+    }
 
-    fstream fragment_shader_file(fragment_shader_file_name.c_str(), ios_base::in);
-
-    if (!fragment_shader_file || !fragment_shader_file.good())
+    if (!_ReadSource(fragment_shader_file_name, _fragment_shader_source))
     {
         return GL_FALSE;
     }
 
-    _fragment_shader_source = "";
-
     if (logging_is_enabled)
     {
         output << "Source of fragment shader" << endl;
         output << "-------------------------" << endl;
+
+        istringstream lines(_fragment_shader_source);
+        for (string aux; getline(lines, aux, '\n'); )
+            output << "\t" << aux << endl;
+
+        output << endl;
     }
 
-    while (!fragment_shader_file.eof())
-    {
-            getline(fragment_shader_file, aux, '\n');
-            _fragment_shader_source += aux + '\n';
+    // 0) trying to load the program binary of a previous run
+    GLboolean   binary_is_supported = (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary);
+    string      binary_cache_file_name;
 
-            if (logging_is_enabled)
-                output << "\t" << aux << endl;
+    if (binary_is_supported)
+    {
+        GLint format_count = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+        binary_is_supported = (format_count > 0);
     }
 
-    fragment_shader_file.close();
+    if (binary_is_supported && !_binary_cache_directory.empty())
+    {
+        binary_cache_file_name = _BinaryCacheFileName();
 
-    if (logging_is_enabled)
-        output << endl;
+        if (_LoadProgramBinary(binary_cache_file_name, logging_is_enabled, output))
+        {
+            _ReflectUniforms();
+            return GL_TRUE;
+        }
+    }
 
     // 1) creating two empty shader objects
     {
@@ -328,6 +715,9 @@ GLboolean ShaderProgram::InstallShaders(const string &vertex_shader_file_name, c
         glAttachShader(_program, _vertex_shader);
         glAttachShader(_program, _fragment_shader);
 
+        if (binary_is_supported)
+            glProgramParameteri(_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
         // check for OpenGL errors
         if (logging_is_enabled)
         {
@@ -371,6 +761,14 @@ GLboolean ShaderProgram::InstallShaders(const string &vertex_shader_file_name, c
         output << "Done." << endl << endl;
     }
 
+    _ReflectUniforms();
+
+    // 7) storing the program binary for the next run
+    if (!binary_cache_file_name.empty())
+    {
+        _SaveProgramBinary(binary_cache_file_name, logging_is_enabled, output);
+    }
+
     return GL_TRUE;
 }
 
@@ -379,7 +777,7 @@ GLboolean ShaderProgram::SetUniformVariable1i(const GLchar *name, GLint paramete
     if (!_program)
         return GL_FALSE;
 
-    GLint location = GetUniformVariableLocation(name);
+    GLint location = _DirectlyWrittenUniformLocation(name);
     if (location == -1)
         return GL_FALSE;
 
@@ -393,7 +791,7 @@ GLboolean ShaderProgram::SetUniformVariable2i(const GLchar *name, GLint paramete
     if (!_program)
         return GL_FALSE;
 
-    GLint location = GetUniformVariableLocation(name);
+    GLint location = _DirectlyWrittenUniformLocation(name);
     if (location == -1)
             return GL_FALSE;
 
@@ -407,7 +805,7 @@ GLboolean ShaderProgram::SetUniformVariable3i(const GLchar *name, GLint paramete
     if (!_program)
         return GL_FALSE;
 
-    GLint location = GetUniformVariableLocation(name);
+    GLint location = _DirectlyWrittenUniformLocation(name);
     if (location == -1)
             return GL_FALSE;
 
@@ -421,7 +819,7 @@ GLboolean ShaderProgram::SetUniformVariable4i(const GLchar *name, GLint paramete
     if (!_program)
         return GL_FALSE;
 
-    GLint location = GetUniformVariableLocation(name);
+    GLint location = _DirectlyWrittenUniformLocation(name);
     if (location == -1)
             return GL_FALSE;
 
@@ -435,7 +833,7 @@ GLboolean ShaderProgram::SetUniformVariable1f(const GLchar *name, GLfloat parame
     if (!_program)
         return GL_FALSE;
 
-    GLint location = GetUniformVariableLocation(name);
+    GLint location = _DirectlyWrittenUniformLocation(name);
     if (location == -1)
         return GL_FALSE;
 
@@ -450,7 +848,7 @@ GLboolean ShaderProgram::SetUniformVariable2f(const GLchar *name, GLfloat parame
     if (!_program)
         return GL_FALSE;
 
-    GLint location = GetUniformVariableLocation(name);
+    GLint location = _DirectlyWrittenUniformLocation(name);
     if (location == -1)
             return GL_FALSE;
 
@@ -464,7 +862,7 @@ GLboolean ShaderProgram::SetUniformVariable3f(const GLchar *name, GLfloat parame
     if (!_program)
         return GL_FALSE;
 
-    GLint location = GetUniformVariableLocation(name);
+    GLint location = _DirectlyWrittenUniformLocation(name);
     if (location == -1)
             return GL_FALSE;
 
@@ -478,7 +876,7 @@ GLboolean ShaderProgram::SetUniformVariable4f(const GLchar *name, GLfloat parame
     if (!_program)
         return GL_FALSE;
 
-    GLint location = GetUniformVariableLocation(name);
+    GLint location = _DirectlyWrittenUniformLocation(name);
     if (location == -1)
             return GL_FALSE;
 
@@ -497,7 +895,7 @@ GLboolean ShaderProgram::SetUniformVariable1fv(const GLchar *name, GLint count,
     if (!_program)
         return GL_FALSE;
 
-    GLint location = GetUniformVariableLocation(name);
+    GLint location = _DirectlyWrittenUniformLocation(name);
     if (location == -1)
             return GL_FALSE;
 
@@ -513,7 +911,7 @@ GLboolean ShaderProgram::SetUniformVariable2fv(const GLchar *name, GLint count,
     if (!_program)
         return GL_FALSE;
 
-    GLint location = GetUniformVariableLocation(name);
+    GLint location = _DirectlyWrittenUniformLocation(name);
     if (location == -1)
             return GL_FALSE;
 
@@ -530,7 +928,7 @@ GLboolean ShaderProgram::SetUniformVariable3fv(const GLchar *name, GLint count,
     if (!_program)
         return GL_FALSE;
 
-    GLint location = GetUniformVariableLocation(name);
+    GLint location = _DirectlyWrittenUniformLocation(name);
     if (location == -1)
             return GL_FALSE;
 
@@ -546,7 +944,7 @@ GLboolean ShaderProgram::SetUniformVariable4fv(const GLchar *name, GLint count,
     if (!_program)
         return GL_FALSE;
 
-    GLint location = GetUniformVariableLocation(name);
+    GLint location = _DirectlyWrittenUniformLocation(name);
     if (location == -1)
             return GL_FALSE;
 
@@ -562,7 +960,7 @@ GLboolean ShaderProgram::SetUniformVariable1iv(const GLchar *name, GLint count,
     if (!_program)
         return GL_FALSE;
 
-    GLint location = GetUniformVariableLocation(name);
+    GLint location = _DirectlyWrittenUniformLocation(name);
     if (location == -1)
             return GL_FALSE;
 
@@ -578,7 +976,7 @@ GLboolean ShaderProgram::SetUniformVariable2iv(const GLchar *name, GLint count,
     if (!_program)
         return GL_FALSE;
 
-    GLint location = GetUniformVariableLocation(name);
+    GLint location = _DirectlyWrittenUniformLocation(name);
     if (location == -1)
             return GL_FALSE;
 
@@ -594,7 +992,7 @@ GLboolean ShaderProgram::SetUniformVariable3iv(const GLchar *name, GLint count,
     if (!_program)
         return GL_FALSE;
 
-    GLint location = GetUniformVariableLocation(name);
+    GLint location = _DirectlyWrittenUniformLocation(name);
     if (location == -1)
             return GL_FALSE;
 
@@ -610,7 +1008,7 @@ GLboolean ShaderProgram::SetUniformVariable4iv(const GLchar *name, GLint count,
     if (!_program)
         return GL_FALSE;
 
-    GLint location = GetUniformVariableLocation(name);
+    GLint location = _DirectlyWrittenUniformLocation(name);
     if (location == -1)
             return GL_FALSE;
 
@@ -626,7 +1024,7 @@ GLboolean ShaderProgram::SetUniformMatrix2fv(const GLchar *name, GLint count, GL
     if (!_program)
         return GL_FALSE;
 
-    GLint location = GetUniformVariableLocation(name);
+    GLint location = _DirectlyWrittenUniformLocation(name);
     if (location == -1)
             return GL_FALSE;
 
@@ -643,7 +1041,7 @@ GLboolean ShaderProgram::SetUniformMatrix3fv(const GLchar *name, GLint count, GL
     if (!_program)
         return GL_FALSE;
 
-    GLint location = GetUniformVariableLocation(name);
+    GLint location = _DirectlyWrittenUniformLocation(name);
     if (location == -1)
             return GL_FALSE;
 
@@ -659,7 +1057,7 @@ GLboolean ShaderProgram::SetUniformMatrix4fv(const GLchar *name, GLint count, GL
     if (!_program)
         return GL_FALSE;
 
-    GLint location = GetUniformVariableLocation(name);
+    GLint location = _DirectlyWrittenUniformLocation(name);
     if (location == -1)
             return GL_FALSE;
 
@@ -675,7 +1073,7 @@ GLboolean ShaderProgram::SetUniformMatrix2x3fv(const GLchar *name, GLint count,
     if (!_program)
         return GL_FALSE;
 
-    GLint location = GetUniformVariableLocation(name);
+    GLint location = _DirectlyWrittenUniformLocation(name);
     if (location == -1)
             return GL_FALSE;
 
@@ -691,7 +1089,7 @@ GLboolean ShaderProgram::SetUniformMatrix3x2fv(const GLchar *name, GLint count,
     if (!_program)
         return GL_FALSE;
 
-    GLint location = GetUniformVariableLocation(name);
+    GLint location = _DirectlyWrittenUniformLocation(name);
     if (location == -1)
             return GL_FALSE;
 
@@ -707,7 +1105,7 @@ GLboolean ShaderProgram::SetUniformMatrix2x4fv(const GLchar *name, GLint count,
     if (!_program)
         return GL_FALSE;
 
-    GLint location = GetUniformVariableLocation(name);
+    GLint location = _DirectlyWrittenUniformLocation(name);
     if (location == -1)
             return GL_FALSE;
 
@@ -723,7 +1121,7 @@ GLboolean ShaderProgram::SetUniformMatrix4x2fv(const GLchar *name, GLint count,
     if (!_program)
         return GL_FALSE;
 
-    GLint location = GetUniformVariableLocation(name);
+    GLint location = _DirectlyWrittenUniformLocation(name);
     if (location == -1)
             return GL_FALSE;
 
@@ -739,7 +1137,7 @@ GLboolean ShaderProgram::SetUniformMatrix3x4fv(const GLchar *name, GLint count,
     if (!_program)
         return GL_FALSE;
 
-    GLint location = GetUniformVariableLocation(name);
+    GLint location = _DirectlyWrittenUniformLocation(name);
     if (location == -1)
             return GL_FALSE;
 
@@ -755,7 +1153,7 @@ GLboolean ShaderProgram::SetUniformMatrix4x3fv(const GLchar *name, GLint count,
     if (!_program)
         return GL_FALSE;
 
-    GLint location = GetUniformVariableLocation(name);
+    GLint location = _DirectlyWrittenUniformLocation(name);
     if (location == -1)
             return GL_FALSE;
 
@@ -763,9 +1161,21 @@ GLboolean ShaderProgram::SetUniformMatrix4x3fv(const GLchar *name, GLint count,
     return GL_TRUE;
 }
 
+const ShaderProgram*& ShaderProgram::_InUse()
+{
+    static const ShaderProgram *program = nullptr;
+    return program;
+}
+
+const ShaderProgram* ShaderProgram::InUse()
+{
+    return _InUse();
+}
+
 GLvoid ShaderProgram::Disable() const
 {
     glUseProgram(0);
+    _InUse() = nullptr;
 }
 
 GLvoid ShaderProgram::Enable(GLboolean logging_is_enabled, ostream& output) const
@@ -773,6 +1183,11 @@ GLvoid ShaderProgram::Enable(GLboolean logging_is_enabled, ostream& output) cons
     if (_vertex_shader_compiled && _fragment_shader_compiled && _linked)
     {
         glUseProgram(_program);
+        _InUse() = this;
+
+        if (_uniforms_are_dirty)
+            _FlushUniforms();
+
         glValidateProgram(_program);
 
         if (logging_is_enabled)
@@ -780,6 +1195,12 @@ GLvoid ShaderProgram::Enable(GLboolean logging_is_enabled, ostream& output) cons
     }
 }
 
+GLvoid ShaderProgram::UpdateUniforms() const
+{
+    if (_InUse() == this && _uniforms_are_dirty)
+        _FlushUniforms();
+}
+
 ShaderProgram::~ShaderProgram()
 {
     // all the attached shader objects will be automatically detached, and,
@@ -787,4 +1208,7 @@ ShaderProgram::~ShaderProgram()
     // at that time as well
     if (_program)
         glDeleteProgram(_program);
+
+    if (_InUse() == this)
+        _InUse() = nullptr;
 }
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+#include <string>
+
+namespace cagd
+{
+    class ShaderProgram
+    {
+    public:
+        // handle of an active uniform variable, see GetUniform and SetUniformValues
+        class Uniform
+        {
+            friend class ShaderProgram;
+
+        private:
+            GLint   _index; // position in the reflected uniform list
+            GLenum  _type;  // e.g. GL_FLOAT_VEC4
+
+        public:
+            Uniform(): _index(-1), _type(GL_NONE) {}
+
+            GLboolean IsValid() const { return _index >= 0; }
+            GLenum    Type() const { return _type; }
+        };
+
+    protected:
+        // active uniform variable of the linked program with the values that are staged for the next flush
+        class UniformVariable
+        {
+        public:
+            std::string             name;
+            GLint                   location;
+            GLenum                  type;           // GL_NONE, if the variable was not reflected (e.g. an array element)
+            GLint                   size;           // array length
+            GLboolean               is_integer;     // integer, boolean and sampler variables are set by glUniform*i
+            GLint                   component_count;
+
+            std::vector<GLfloat>    float_values;
+            std::vector<GLint>      integer_values;
+            GLboolean               is_dirty;
+        };
+
+        // handles of objects
+        GLuint      _vertex_shader;
+        GLuint      _fragment_shader;
+        GLuint      _program;
+
+        // file names of sources
+        std::string _vertex_shader_file_name;
+        std::string _fragment_shader_file_name;
+
+        // sources
+        std::string _vertex_shader_source;
+        std::string _fragment_shader_source;
+
+        // status values
+        GLint       _vertex_shader_compiled;
+        GLint       _fragment_shader_compiled;
+        GLint       _linked;
+
+        // directory of the program binaries (caching is disabled if it is empty)
+        std::string _binary_cache_directory;
+
+        // the active uniform variables are reflected once after linking (or loading the program binary);
+        // names that are not reflected are looked up only once, too (missing variables get the location -1)
+        mutable std::vector<UniformVariable>                 _uniform;
+        mutable std::unordered_map<std::string, GLuint>      _uniform_index;
+        mutable GLboolean                                    _uniforms_are_dirty;
+
+        GLvoid       _ReflectUniforms();
+        static GLint _ComponentCount(GLenum type, GLboolean &is_integer);
+
+        // uploads the staged values of the dirty uniform variables, the program has to be in use
+        GLvoid       _FlushUniforms() const;
+
+        // the program installed by the last call of Enable, or nullptr after Disable
+        static const ShaderProgram*& _InUse();
+
+        // the methods SetUniformVariable* and SetUniformMatrix* write the uniform variables of the program in use
+        // directly, therefore they discard the staged values of the written variables: otherwise a pending staged
+        // value would overwrite the written one at the next flush, and staging the value that preceded the
+        // direct write would be considered redundant
+        GLvoid       _InvalidateStagedValues(const std::string &name) const;
+        GLint        _DirectlyWrittenUniformLocation(const GLchar *name) const;
+
+        // reads the whole content of a text file
+        static GLboolean _ReadSource(const std::string &file_name, std::string &source);
+
+        // the name of the cache file depends on the hash of the sources and on the vendor, renderer and version
+        // strings of the driver, i.e., editing a shader or updating the driver results in a new program binary
+        std::string _BinaryCacheFileName() const;
+
+        // the loaded binary may be rejected by the driver, in this case GL_FALSE is returned
+        GLboolean   _LoadProgramBinary(const std::string &file_name, GLboolean logging_is_enabled, std::ostream &output);
+        GLvoid      _SaveProgramBinary(const std::string &file_name, GLboolean logging_is_enabled, std::ostream &output) const;
+
+        // log
+        GLboolean   _ListOpenGLErrors(const char *file_name, GLint line, std::ostream& output = std::cout) const;  // returns GL_TRUE if an OpenGL error occurred, GL_FALSE otherwise
+        GLvoid      _ListVertexShaderInfoLog(std::ostream& output = std::cout) const;
+        GLvoid      _ListFragmentShaderInfoLog(std::ostream& output = std::cout) const;
+        GLvoid      _ListProgramInfoLog(std::ostream& output = std::cout) const;
+        GLvoid      _ListValidateInfoLog(std::ostream& output = std::cout) const;
+
+    public:
+        // default constructor
+        ShaderProgram();
+
+        // if the directory is not empty, InstallShaders tries to load the program binary that was stored into it
+        // during a previous run and it compiles the sources only if there is no valid binary; the directory has to
+        // exist, program binaries are used only if the driver supports GL_ARB_get_program_binary
+        GLvoid    SetBinaryCacheDirectory(const std::string &directory);
+
+        GLboolean InstallShaders(const std::string &vertex_shader_file_name, const std::string &fragment_shader_file_name, GLboolean logging_is_enabled = GL_FALSE, std::ostream &output = std::cout);
+
+//        GLboolean SetUniformVariable1i(const GLchar *name, GLint parameter) const;
+//        GLboolean SetUniformVariable1f(const GLchar *name, GLfloat parameter) const;
+//        GLboolean SetUniformVariable2f(const GLchar *name, GLfloat parameter_1, GLfloat parameter_2) const;
+//        GLboolean SetUniformVariable3f(const GLchar *name, GLfloat parameter_1, GLfloat parameter_2, GLfloat parameter_3) const;
+        // homework: declare and define the remained uniform variable handling methods
+        //           for more details see page 54 of Lecture 7
+        GLboolean SetUniformVariable1f(const GLchar *name, GLfloat parameter) const;
+        GLboolean SetUniformVariable2f(const GLchar *name, GLfloat parameter_1, GLfloat parameter_2) const;
+        GLboolean SetUniformVariable3f(const GLchar *name, GLfloat parameter_1, GLfloat parameter_2, GLfloat parameter_3) const;
+        GLboolean SetUniformVariable4f(const GLchar *name, GLfloat parameter_1, GLfloat parameter_2, GLfloat parameter_3, GLfloat parameter_4) const;
+
+        GLboolean SetUniformVariable1i(const GLchar *name, GLint parameter) const;
+        GLboolean SetUniformVariable2i(const GLchar *name, GLint parameter_1, GLint parameter_2) const;
+        GLboolean SetUniformVariable3i(const GLchar *name, GLint parameter_1, GLint parameter_2, GLint parameter_3) const;
+        GLboolean SetUniformVariable4i(const GLchar *name, GLint parameter_1, GLint parameter_2, GLint parameter_3, GLint paramter_4) const;
+
+        GLboolean SetUniformVariable1fv(const GLchar *name, GLint count, GLfloat *values) const;
+        GLboolean SetUniformVariable2fv(const GLchar *name, GLint count, GLfloat *values) const;
+        GLboolean SetUniformVariable3fv(const GLchar *name, GLint count, GLfloat *values) const;
+        GLboolean SetUniformVariable4fv(const GLchar *name, GLint count, GLfloat *values) const;
+
+        GLboolean SetUniformVariable1iv(const GLchar *name, GLint count, GLint *values) const;
+        GLboolean SetUniformVariable2iv(const GLchar *name, GLint count, GLint *values) const;
+        GLboolean SetUniformVariable3iv(const GLchar *name, GLint count, GLint *values) const;
+        GLboolean SetUniformVariable4iv(const GLchar *name, GLint count, GLint *values) const;
+
+        GLboolean SetUniformMatrix2fv  (const GLchar *name, GLint count, GLboolean transpose, GLfloat *values) const;
+        GLboolean SetUniformMatrix3fv  (const GLchar *name, GLint count, GLboolean transpose, GLfloat *values) const;
+        GLboolean SetUniformMatrix4fv  (const GLchar *name, GLint count, GLboolean transpose, GLfloat *values) const;
+        GLboolean SetUniformMatrix2x3fv(const GLchar *name, GLint count, GLboolean transpose, GLfloat *values) const;
+        GLboolean SetUniformMatrix3x2fv(const GLchar *name, GLint count, GLboolean transpose, GLfloat *values) const;
+        GLboolean SetUniformMatrix2x4fv(const GLchar *name, GLint count, GLboolean transpose, GLfloat *values) const;
+        GLboolean SetUniformMatrix4x2fv(const GLchar *name, GLint count, GLboolean transpose, GLfloat *values) const;
+        GLboolean SetUniformMatrix3x4fv(const GLchar *name, GLint count, GLboolean transpose, GLfloat *values) const;
+        GLboolean SetUniformMatrix4x3fv(const GLchar *name, GLint count, GLboolean transpose, GLfloat *values) const;
+
+        // the locations are reflected after linking, i.e., glGetUniformLocation is not called at rendering time
+        GLint GetUniformVariableLocation(const GLchar *name, GLboolean logging_is_enabled = GL_FALSE, std::ostream& output = std::cout) const;
+
+        // returns an invalid handle if the program has no active uniform variable of the given name
+        Uniform   GetUniform(const GLchar *name) const;
+
+        // the values are staged and they are uploaded together by the next call of Enable, i.e., the program does
+        // not have to be in use; values of unchanged variables are not uploaded again; the number of values has to
+        // be the number of components of the variable's type (e.g. 4 for vec4, 9 for mat3) multiplied by count,
+        // where count cannot exceed the array length of the variable
+        GLboolean SetUniformValues(const Uniform &uniform, GLint count, const GLfloat *values);
+        GLboolean SetUniformValues(const Uniform &uniform, GLint count, const GLint *values);
+
+        GLboolean SetUniformValue(const Uniform &uniform, GLfloat value);
+        GLboolean SetUniformValue(const Uniform &uniform, GLint value);
+
+        GLvoid Disable() const;
+
+        // uses the program and flushes the staged uniform values
+        GLvoid Enable(GLboolean logging_is_enabled = GL_FALSE, std::ostream& output = std::cout) const;
+
+        // flushes the staged uniform values if the program is in use, it is neither installed nor validated again
+        GLvoid UpdateUniforms() const;
+
+        // programs are installed only by Enable and Disable, therefore the program in use is known without
+        // querying GL_CURRENT_PROGRAM; nullptr is returned if the fixed-function pipeline is in use
+        static const ShaderProgram* InUse();
+
+        virtual ~ShaderProgram();
+    };
+}
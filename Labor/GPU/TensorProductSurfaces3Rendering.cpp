@@ -0,0 +1,222 @@
+#include "../Core/TensorProductSurfaces3.h"
+#include "../Core/FloatConversions.h"
+#include "BufferObjects.h"
+#include "RenderBackends.h"
+#include <algorithm>
+
+using namespace cagd;
+using namespace std;
+
+//---------------------------------------------------------------------
+// vertex buffer object handling methods of class TensorProductSurface3
+//---------------------------------------------------------------------
+
+GLboolean TensorProductSurface3::RenderData(GLenum render_mode) const
+{
+    const BufferObjects *vbo_data = BufferObjects::Of(_vbo_data);
+
+    if(!vbo_data)
+        return GL_FALSE;
+
+    // core profile path: the same polylines of the u- and v-directional control nets are drawn from the
+    // vertex array object of the data
+    if (RenderBackend::BeginDraw())
+    {
+        GLboolean is_new = GL_FALSE;
+        GLuint vertex_array = vbo_data->VertexArray(0, is_new);
+
+        if (vertex_array)
+        {
+            glBindVertexArray(vertex_array);
+
+            if (is_new)
+            {
+                glBindBuffer(GL_ARRAY_BUFFER, (*vbo_data)[0]);
+                glVertexAttribPointer(RenderBackend::POSITION_LOCATION, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+                glEnableVertexAttribArray(RenderBackend::POSITION_LOCATION);
+                glBindBuffer(GL_ARRAY_BUFFER, 0);
+            }
+
+            GLuint offset = 0;
+            for (GLuint r = 0; r < _data.GetRowCount(); ++r, offset += _data.GetColumnCount())
+                glDrawArrays(render_mode, offset, _data.GetColumnCount());
+
+            for (GLuint c = 0; c < _data.GetColumnCount(); ++c, offset += _data.GetRowCount())
+                glDrawArrays(render_mode, offset, _data.GetRowCount());
+
+            glBindVertexArray(0);
+        }
+
+        RenderBackend::EndDraw();
+
+        return vertex_array ? GL_TRUE : GL_FALSE;
+    }
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+
+        glBindBuffer(GL_ARRAY_BUFFER, (*vbo_data)[0]);
+
+        glVertexPointer(3, GL_FLOAT, 0, (const GLvoid*)0);
+          GLuint offset = 0;
+          for (GLuint r = 0; r < _data.GetRowCount(); ++r) {
+            glDrawArrays(render_mode, offset, _data.GetColumnCount());
+            offset += _data.GetColumnCount();
+          }
+
+          for (GLuint r = 0; r < _data.GetColumnCount(); ++r) {
+            glDrawArrays(render_mode, offset, _data.GetRowCount());
+            offset += _data.GetRowCount();
+          }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    return GL_TRUE;
+}
+
+GLboolean TensorProductSurface3::UpdateVertexBufferObjectsOfData(GLenum usage_flag)
+{
+    if (usage_flag != GL_STREAM_DRAW  && usage_flag != GL_STREAM_READ  && usage_flag != GL_STREAM_COPY
+     && usage_flag != GL_STATIC_DRAW  && usage_flag != GL_STATIC_READ  && usage_flag != GL_STATIC_COPY
+     && usage_flag != GL_DYNAMIC_DRAW && usage_flag != GL_DYNAMIC_READ && usage_flag != GL_DYNAMIC_COPY)
+        return GL_FALSE;
+
+    // deleting old vertex buffer objects
+    DeleteVertexBufferObjectsOfData();
+
+    // creating vertex buffer objects of mesh vertices, unit normal vectors, texture coordinates,
+    // and element indices
+    BufferObjects *vbo_data = new BufferObjects();
+
+    // the buffer object is owned by the surface from now on, i.e., it is deleted on failure
+    _vbo_data = vbo_data;
+
+    if (!vbo_data->Generate(1))
+    {
+        DeleteVertexBufferObjectsOfData();
+        return GL_FALSE;
+    }
+
+    GLuint data_byte_size = 2 * _data.GetRowCount() * _data.GetColumnCount() * 3 * sizeof(GLfloat);
+
+    glBindBuffer(GL_ARRAY_BUFFER, (*vbo_data)[0]);
+    glBufferData(GL_ARRAY_BUFFER, data_byte_size, 0, usage_flag);
+
+    GLfloat *data_coordinate = (GLfloat*)glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
+
+    if (!data_coordinate)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        DeleteVertexBufferObjectsOfData();
+        return GL_FALSE;
+    }
+    //Mutatta Agoston, hogy sobanfolytonosan es oszlopfolytonosan is fel kell tolteni a buffert
+    GLuint row_count = _data.GetRowCount(), column_count = _data.GetColumnCount();
+
+    // the rows of the control net are contiguous arrays of points
+    for (GLuint r = 0; r < row_count; ++r, data_coordinate += 3 * column_count)
+        ConvertToFloat(&_data(r, 0), column_count, data_coordinate);
+
+    for (GLuint c = 0; c < column_count; ++c)
+        for (GLuint r = 0; r < row_count; ++r, data_coordinate += 3)
+            ConvertToFloat(&_data(r, c), 1, data_coordinate);
+
+    if (!glUnmapBuffer(GL_ARRAY_BUFFER))
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        DeleteVertexBufferObjectsOfData();
+        return GL_FALSE;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return GL_TRUE;
+}
+
+// generates the render-only image of the tensor product surface
+TriangulatedMesh3* TensorProductSurface3::GenerateRenderOnlyImage(GLuint u_div_point_count, GLuint v_div_point_count, GLenum usage_flag) const
+{
+    if (u_div_point_count <= 1 || v_div_point_count <= 1)
+        return nullptr;
+
+    TriangulatedMesh3 *result = new (nothrow) TriangulatedMesh3(0, 0, usage_flag);
+
+    if (!result)
+        return nullptr;
+
+    // the index buffer object is shared by all grids of the same size
+    if (!result->AllocateRenderOnlyGridVertexBufferObjects(u_div_point_count, v_div_point_count, usage_flag))
+    {
+        delete result;
+        return nullptr;
+    }
+
+    // multiple buffers can be mapped simultaneously
+    GLfloat *vertex_coordinate = result->MapVertexBuffer(GL_WRITE_ONLY);
+    GLfloat *normal_coordinate = result->MapNormalBuffer(GL_WRITE_ONLY);
+    GLfloat *tex_coordinate    = result->MapTextureBuffer(GL_WRITE_ONLY);
+
+    GLboolean success = (vertex_coordinate && normal_coordinate && tex_coordinate);
+
+    // uniform subdivision grid in the definition domain
+    GLdouble du = (_u_max - _u_min) / (u_div_point_count - 1);
+    GLdouble dv = (_v_max - _v_min) / (v_div_point_count - 1);
+
+    // uniform subdivision grid in the unit square
+    GLfloat sdu = 1.0f / (u_div_point_count - 1);
+    GLfloat tdv = 1.0f / (v_div_point_count - 1);
+
+    PartialDerivatives pd;
+
+    for (GLuint i = 0; success && i < u_div_point_count; ++i)
+    {
+        GLdouble u = min(_u_min + i * du, _u_max);
+        GLfloat  s = min(i * sdu, 1.0f);
+
+        for (GLuint j = 0; success && j < v_div_point_count; ++j)
+        {
+            GLdouble v = min(_v_min + j * dv, _v_max);
+            GLfloat  t = min(j * tdv, 1.0f);
+
+            if (!CalculatePartialDerivatives(1, u, v, pd))
+            {
+                success = GL_FALSE;
+                break;
+            }
+
+            // unit surface normal
+            DCoordinate3 normal = pd(1, 0);
+            normal ^= pd(1, 1);
+            normal.normalize();
+
+            for (GLuint component = 0; component < 3; ++component)
+            {
+                *vertex_coordinate++ = static_cast<GLfloat>(pd(0, 0)[component]);
+                *normal_coordinate++ = static_cast<GLfloat>(normal[component]);
+            }
+
+            // texture coordinates
+            *tex_coordinate++ = s;
+            *tex_coordinate++ = t;
+            *tex_coordinate++ = 0.0f;
+            *tex_coordinate++ = 1.0f;
+        }
+    }
+
+    // only the mapped buffers are unmapped, if an unmapping fails the contents of the buffer are undefined
+    if (vertex_coordinate && !result->UnmapVertexBuffer())
+        success = GL_FALSE;
+
+    if (normal_coordinate && !result->UnmapNormalBuffer())
+        success = GL_FALSE;
+
+    if (tex_coordinate && !result->UnmapTextureBuffer())
+        success = GL_FALSE;
+
+    if (!success)
+    {
+        delete result;
+        return nullptr;
+    }
+
+    return result;
+}
@@ -0,0 +1,472 @@
+#include "../Core/TriangulatedMeshes3.h"
+#include "../Core/FloatConversions.h"
+#include "../Core/Profilers.h"
+#include "BufferObjects.h"
+#include "RenderBackends.h"
+#include <cstring>
+
+using namespace cagd;
+using namespace std;
+
+//-----------------------------------------------------------------
+// vertex buffer object handling methods of class TriangulatedMesh3
+//-----------------------------------------------------------------
+
+// binds the vertex array object of the core profile rendering path, its attributes are specified when it
+// is bound for the first time (the element array buffer binding is part of its state, too)
+static GLboolean BindMeshVertexArray(const BufferObjects *vbo)
+{
+    if (!vbo || vbo->GetCount() != MESH_BUFFER_COUNT)
+        return GL_FALSE;
+
+    GLboolean is_new = GL_FALSE;
+    GLuint vertex_array = vbo->VertexArray(0, is_new);
+
+    if (!vertex_array)
+        return GL_FALSE;
+
+    glBindVertexArray(vertex_array);
+
+    if (is_new)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, (*vbo)[VERTEX_BUFFER]);
+        glVertexAttribPointer(RenderBackend::POSITION_LOCATION, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+        glEnableVertexAttribArray(RenderBackend::POSITION_LOCATION);
+
+        glBindBuffer(GL_ARRAY_BUFFER, (*vbo)[NORMAL_BUFFER]);
+        glVertexAttribPointer(RenderBackend::NORMAL_LOCATION, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+        glEnableVertexAttribArray(RenderBackend::NORMAL_LOCATION);
+
+        glBindBuffer(GL_ARRAY_BUFFER, (*vbo)[TEXTURE_BUFFER]);
+        glVertexAttribPointer(RenderBackend::TEXTURE_COORDINATE_LOCATION, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
+        glEnableVertexAttribArray(RenderBackend::TEXTURE_COORDINATE_LOCATION);
+
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, (*vbo)[INDEX_BUFFER]);
+    }
+
+    return GL_TRUE;
+}
+
+GLboolean TriangulatedMesh3::Render(GLenum render_mode) const
+{
+    if (render_mode != GL_TRIANGLES && render_mode != GL_POINTS)
+        return GL_FALSE;
+
+    if (RenderBackend::BeginDraw())
+    {
+        GLboolean bound = BindMeshVertexArray(BufferObjects::Of(_vbo));
+
+        if (bound)
+        {
+            DrawElements(render_mode);
+            glBindVertexArray(0);
+        }
+
+        RenderBackend::EndDraw();
+
+        return bound;
+    }
+
+    if (!BindVertexBufferObjects())
+        return GL_FALSE;
+
+    DrawElements(render_mode);
+    UnbindVertexBufferObjects();
+
+    return GL_TRUE;
+}
+
+GLboolean TriangulatedMesh3::BindVertexBufferObjects() const
+{
+    const BufferObjects *vbo = BufferObjects::Of(_vbo);
+
+    if (!vbo || vbo->GetCount() != MESH_BUFFER_COUNT)
+        return GL_FALSE;
+
+    // enable client states of vertex, normal and texture coordinate arrays
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+
+        // activate the VBO of texture coordinates
+        glBindBuffer(GL_ARRAY_BUFFER, (*vbo)[TEXTURE_BUFFER]);
+        // specify the location and data format of texture coordinates
+        glTexCoordPointer(4, GL_FLOAT, 0, nullptr);
+
+        // activate the VBO of normal vectors
+        glBindBuffer(GL_ARRAY_BUFFER, (*vbo)[NORMAL_BUFFER]);
+        // specify the location and data format of normal vectors
+        glNormalPointer(GL_FLOAT, 0, nullptr);
+
+        // activate the VBO of vertices
+        glBindBuffer(GL_ARRAY_BUFFER, (*vbo)[VERTEX_BUFFER]);
+        // specify the location and data format of vertices
+        glVertexPointer(3, GL_FLOAT, 0, nullptr);
+
+        // activate the element array buffer for indexed vertices of triangular faces
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, (*vbo)[INDEX_BUFFER]);
+
+    return GL_TRUE;
+}
+
+GLboolean TriangulatedMesh3::DrawElements(GLenum render_mode) const
+{
+    if (render_mode != GL_TRIANGLES && render_mode != GL_POINTS)
+        return GL_FALSE;
+
+    // render primitives
+    glDrawElements(render_mode, static_cast<GLsizei>(3 * FaceCount()), GL_UNSIGNED_INT, nullptr);
+
+    return GL_TRUE;
+}
+
+GLvoid TriangulatedMesh3::UnbindVertexBufferObjects()
+{
+    // disable individual client-side capabilities
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+
+    // unbind any buffer object previously bound and restore client memory usage
+    // for these buffer object targets
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+GLboolean TriangulatedMesh3::UpdateVertexBufferObjects(GLenum usage_flag)
+{
+    CAGD_PROFILE_ZONE("TriangulatedMesh3::UpdateVertexBufferObjects");
+
+    if (usage_flag != GL_STREAM_DRAW  && usage_flag != GL_STREAM_READ  && usage_flag != GL_STREAM_COPY
+     && usage_flag != GL_STATIC_DRAW  && usage_flag != GL_STATIC_READ  && usage_flag != GL_STATIC_COPY
+     && usage_flag != GL_DYNAMIC_DRAW && usage_flag != GL_DYNAMIC_READ && usage_flag != GL_DYNAMIC_COPY)
+        return GL_FALSE;
+
+    // the buffers of a render-only mesh cannot be rebuilt, since there is no host-side geometry
+    if (_render_only)
+        return GL_FALSE;
+
+    // updating usage flag
+    _usage_flag = usage_flag;
+
+    // deleting old vertex buffer objects
+    DeleteVertexBufferObjects();
+
+    // creating vertex buffer objects of mesh vertices, unit normal vectors, texture coordinates,
+    // and element indices, regular grids share the index buffer object of their topology
+    BufferObjects *vbo = new BufferObjects();
+
+    // the buffer objects are owned by the mesh from now on, i.e., they are deleted on failure
+    _vbo = vbo;
+
+    GLboolean generated = vbo->Generate(INDEX_BUFFER) &&
+                          ((_grid_u_div_point_count && _grid_v_div_point_count) ?
+                               vbo->AppendSharedGridIndexBuffer(_grid_u_div_point_count, _grid_v_div_point_count) :
+                               vbo->Generate(1));
+
+    if (!generated)
+    {
+        DeleteVertexBufferObjects();
+        return GL_FALSE;
+    }
+
+    GLboolean shared_index_buffer = vbo->HasSharedGridIndexBuffer();
+
+    // For efficiency reasons we convert all GLdouble coordinates
+    // to GLfloat coordinates: we will use auxiliar pointers for
+    // buffer data loading, by means of the functions glMapBuffer/glUnmapBuffer.
+
+    // Notice that multiple buffers can be mapped simultaneously.
+
+    size_t vertex_byte_size = 3 * _vertex.size() * sizeof(GLfloat);
+
+    glBindBuffer(GL_ARRAY_BUFFER, (*vbo)[VERTEX_BUFFER]);
+    glBufferData(GL_ARRAY_BUFFER, vertex_byte_size, nullptr, _usage_flag);
+
+    GLfloat *vertex_coordinate = (GLfloat*)glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
+
+    glBindBuffer(GL_ARRAY_BUFFER, (*vbo)[NORMAL_BUFFER]);
+    glBufferData(GL_ARRAY_BUFFER, vertex_byte_size, nullptr, _usage_flag);
+
+    GLfloat *normal_coordinate = (GLfloat*)glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
+
+    // the mapped buffers are not read by the CPU, therefore non-temporal stores can be used
+    if (!_vertex.empty())
+    {
+        ConvertToFloat(&_vertex[0], static_cast<GLuint>(_vertex.size()), vertex_coordinate, GL_TRUE);
+        ConvertToFloat(&_normal[0], static_cast<GLuint>(_normal.size()), normal_coordinate, GL_TRUE);
+    }
+
+    size_t tex_byte_size = 4 * _tex.size() * sizeof(GLfloat);
+
+    glBindBuffer(GL_ARRAY_BUFFER, (*vbo)[TEXTURE_BUFFER]);
+    glBufferData(GL_ARRAY_BUFFER, tex_byte_size, nullptr, _usage_flag);
+    GLfloat *tex_coordinate = (GLfloat*)glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
+
+    memcpy(tex_coordinate, &_tex[0][0], tex_byte_size);
+
+    // the content of a shared index buffer object is uploaded by the GridIndexBufferCache
+    if (!shared_index_buffer)
+    {
+        const vector<TriangularFace> &face = _Faces();
+
+        size_t index_byte_size = 3 * face.size() * sizeof(GLuint);
+
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, (*vbo)[INDEX_BUFFER]);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_byte_size, nullptr, _usage_flag);
+        GLuint *element = (GLuint*)glMapBuffer(GL_ELEMENT_ARRAY_BUFFER, GL_WRITE_ONLY);
+
+        for (vector<TriangularFace>::const_iterator fit = face.begin(); fit != face.end(); ++fit)
+        {
+            for (GLint node = 0; node < 3; ++node)
+            {
+                *element = (*fit)[node];
+                ++element;
+            }
+        }
+    }
+
+    // unmap all VBOs
+    glBindBuffer(GL_ARRAY_BUFFER, (*vbo)[VERTEX_BUFFER]);
+    if (!glUnmapBuffer(GL_ARRAY_BUFFER))
+        return GL_FALSE;
+
+    glBindBuffer(GL_ARRAY_BUFFER, (*vbo)[NORMAL_BUFFER]);
+    if (!glUnmapBuffer(GL_ARRAY_BUFFER))
+        return GL_FALSE;
+
+    glBindBuffer(GL_ARRAY_BUFFER, (*vbo)[TEXTURE_BUFFER]);
+    if (!glUnmapBuffer(GL_ARRAY_BUFFER))
+        return GL_FALSE;
+
+    if (!shared_index_buffer)
+    {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, (*vbo)[INDEX_BUFFER]);
+        if (!glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER))
+            return GL_FALSE;
+    }
+
+    // unbind any buffer object previously bound and restore client memory usage
+    // for these buffer object targets
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    return GL_TRUE;
+}
+
+GLboolean TriangulatedMesh3::AllocateRenderOnlyVertexBufferObjects(GLuint vertex_count, GLuint face_count, GLenum usage_flag)
+{
+    if (usage_flag != GL_STREAM_DRAW  && usage_flag != GL_STREAM_READ  && usage_flag != GL_STREAM_COPY
+     && usage_flag != GL_STATIC_DRAW  && usage_flag != GL_STATIC_READ  && usage_flag != GL_STATIC_COPY
+     && usage_flag != GL_DYNAMIC_DRAW && usage_flag != GL_DYNAMIC_READ && usage_flag != GL_DYNAMIC_COPY)
+        return GL_FALSE;
+
+    DeleteVertexBufferObjects();
+
+    _usage_flag             = usage_flag;
+    _grid_u_div_point_count = 0;
+    _grid_v_div_point_count = 0;
+
+    return _AllocateRenderOnlyVertexBufferObjects(vertex_count, face_count);
+}
+
+GLboolean TriangulatedMesh3::AllocateRenderOnlyGridVertexBufferObjects(GLuint u_div_point_count, GLuint v_div_point_count, GLenum usage_flag)
+{
+    if (usage_flag != GL_STREAM_DRAW  && usage_flag != GL_STREAM_READ  && usage_flag != GL_STREAM_COPY
+     && usage_flag != GL_STATIC_DRAW  && usage_flag != GL_STATIC_READ  && usage_flag != GL_STATIC_COPY
+     && usage_flag != GL_DYNAMIC_DRAW && usage_flag != GL_DYNAMIC_READ && usage_flag != GL_DYNAMIC_COPY)
+        return GL_FALSE;
+
+    if (u_div_point_count < 2 || v_div_point_count < 2)
+        return GL_FALSE;
+
+    DeleteVertexBufferObjects();
+
+    _usage_flag             = usage_flag;
+    _grid_u_div_point_count = u_div_point_count;
+    _grid_v_div_point_count = v_div_point_count;
+
+    return _AllocateRenderOnlyVertexBufferObjects(
+                u_div_point_count * v_div_point_count,
+                2 * (u_div_point_count - 1) * (v_div_point_count - 1));
+}
+
+GLboolean TriangulatedMesh3::_AllocateRenderOnlyVertexBufferObjects(GLuint vertex_count, GLuint face_count)
+{
+    // releasing the host-side geometry
+    vector<DCoordinate3>().swap(_vertex);
+    vector<DCoordinate3>().swap(_normal);
+    vector<TCoordinate4>().swap(_tex);
+    vector<TriangularFace>().swap(_face);
+    _grid_face.reset();
+
+    _render_only              = GL_TRUE;
+    _render_only_vertex_count = vertex_count;
+    _render_only_face_count   = face_count;
+
+    BufferObjects *vbo = new BufferObjects();
+
+    _vbo = vbo;
+
+    GLboolean generated = vbo->Generate(INDEX_BUFFER) &&
+                          ((_grid_u_div_point_count && _grid_v_div_point_count) ?
+                               vbo->AppendSharedGridIndexBuffer(_grid_u_div_point_count, _grid_v_div_point_count) :
+                               vbo->Generate(1));
+
+    if (!generated)
+    {
+        DeleteVertexBufferObjects();
+        _render_only_vertex_count = _render_only_face_count = 0;
+        return GL_FALSE;
+    }
+
+    size_t vertex_byte_size = 3 * vertex_count * sizeof(GLfloat);
+
+    glBindBuffer(GL_ARRAY_BUFFER, (*vbo)[VERTEX_BUFFER]);
+    glBufferData(GL_ARRAY_BUFFER, vertex_byte_size, nullptr, _usage_flag);
+
+    glBindBuffer(GL_ARRAY_BUFFER, (*vbo)[NORMAL_BUFFER]);
+    glBufferData(GL_ARRAY_BUFFER, vertex_byte_size, nullptr, _usage_flag);
+
+    glBindBuffer(GL_ARRAY_BUFFER, (*vbo)[TEXTURE_BUFFER]);
+    glBufferData(GL_ARRAY_BUFFER, 4 * vertex_count * sizeof(GLfloat), nullptr, _usage_flag);
+
+    if (!vbo->HasSharedGridIndexBuffer())
+    {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, (*vbo)[INDEX_BUFFER]);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, 3 * face_count * sizeof(GLuint), nullptr, _usage_flag);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    return GL_TRUE;
+}
+
+GLfloat* TriangulatedMesh3::MapVertexBuffer(GLenum access_flag) const
+{
+    const BufferObjects *vbo = BufferObjects::Of(_vbo);
+
+    if (!vbo || (access_flag != GL_READ_ONLY && access_flag != GL_WRITE_ONLY && access_flag != GL_READ_WRITE))
+        return (GLfloat*)0;
+
+    glBindBuffer(GL_ARRAY_BUFFER, (*vbo)[VERTEX_BUFFER]);
+    GLfloat* result = (GLfloat*)glMapBuffer(GL_ARRAY_BUFFER, access_flag);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return result;
+}
+
+// homework
+GLfloat* TriangulatedMesh3::MapNormalBuffer(GLenum access_flag) const
+{
+    const BufferObjects *vbo = BufferObjects::Of(_vbo);
+
+    if (!vbo || (access_flag != GL_READ_ONLY && access_flag != GL_WRITE_ONLY && access_flag != GL_READ_WRITE))
+        return (GLfloat*)0;
+
+    glBindBuffer(GL_ARRAY_BUFFER, (*vbo)[NORMAL_BUFFER]);
+    GLfloat* result = (GLfloat*)glMapBuffer(GL_ARRAY_BUFFER, access_flag);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return result;
+}
+
+// homework
+GLfloat* TriangulatedMesh3::MapTextureBuffer(GLenum access_flag) const
+{
+    const BufferObjects *vbo = BufferObjects::Of(_vbo);
+
+    if (!vbo || (access_flag != GL_READ_ONLY && access_flag != GL_WRITE_ONLY && access_flag != GL_READ_WRITE))
+        return (GLfloat*)0;
+
+    glBindBuffer(GL_ARRAY_BUFFER, (*vbo)[TEXTURE_BUFFER]);
+    GLfloat* result = (GLfloat*)glMapBuffer(GL_ARRAY_BUFFER, access_flag);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return result;
+}
+
+GLuint* TriangulatedMesh3::MapIndexBuffer(GLenum access_flag) const
+{
+    const BufferObjects *vbo = BufferObjects::Of(_vbo);
+
+    if (!vbo || (access_flag != GL_READ_ONLY && access_flag != GL_WRITE_ONLY && access_flag != GL_READ_WRITE))
+        return (GLuint*)0;
+
+    // a shared index buffer object is also used by other meshes
+    if (vbo->HasSharedGridIndexBuffer() && access_flag != GL_READ_ONLY)
+        return (GLuint*)0;
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, (*vbo)[INDEX_BUFFER]);
+    GLuint* result = (GLuint*)glMapBuffer(GL_ELEMENT_ARRAY_BUFFER, access_flag);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    return result;
+}
+
+GLboolean TriangulatedMesh3::UnmapVertexBuffer() const
+{
+    const BufferObjects *vbo = BufferObjects::Of(_vbo);
+
+    if (!vbo)
+        return GL_FALSE;
+
+    glBindBuffer(GL_ARRAY_BUFFER, (*vbo)[VERTEX_BUFFER]);
+    GLboolean result = glUnmapBuffer(GL_ARRAY_BUFFER);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return result;
+}
+
+// homework
+GLboolean TriangulatedMesh3::UnmapNormalBuffer() const
+{
+    const BufferObjects *vbo = BufferObjects::Of(_vbo);
+
+    if (!vbo)
+        return GL_FALSE;
+
+    glBindBuffer(GL_ARRAY_BUFFER, (*vbo)[NORMAL_BUFFER]);
+    GLboolean result = glUnmapBuffer(GL_ARRAY_BUFFER);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return result;
+}
+
+// homework
+GLboolean TriangulatedMesh3::UnmapTextureBuffer() const
+{
+    const BufferObjects *vbo = BufferObjects::Of(_vbo);
+
+    if (!vbo)
+        return GL_FALSE;
+
+    glBindBuffer(GL_ARRAY_BUFFER, (*vbo)[TEXTURE_BUFFER]);
+    GLboolean result = glUnmapBuffer(GL_ARRAY_BUFFER);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return result;
+}
+
+GLboolean TriangulatedMesh3::UnmapIndexBuffer() const
+{
+    const BufferObjects *vbo = BufferObjects::Of(_vbo);
+
+    if (!vbo)
+        return GL_FALSE;
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, (*vbo)[INDEX_BUFFER]);
+    GLboolean result = glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    return result;
+}
+
+GLboolean TriangulatedMesh3::HasSharedIndexBuffer() const
+{
+    const BufferObjects *vbo = BufferObjects::Of(_vbo);
+
+    return vbo && vbo->HasSharedGridIndexBuffer();
+}
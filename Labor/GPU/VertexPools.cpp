@@ -0,0 +1,374 @@
+#include "VertexPools.h"
+
+#include <algorithm>
+
+using namespace cagd;
+using namespace std;
+
+// sizes of the elements of the pooled buffers: 3 vertex coordinates, 3 normal coordinates, 4 texture
+// coordinates and a single index
+static const GLsizeiptr element_byte_size[MESH_BUFFER_COUNT] =
+{
+    3 * sizeof(GLfloat), 3 * sizeof(GLfloat), 4 * sizeof(GLfloat), sizeof(GLuint)
+};
+
+VertexPool::VertexPool(GLuint vertex_capacity, GLuint index_capacity):
+        _vertex_capacity(max(vertex_capacity, 1u)), _index_capacity(max(index_capacity, 1u))
+{
+    fill(_buffer, _buffer + MESH_BUFFER_COUNT, 0);
+}
+
+GLboolean VertexPool::IsSupported()
+{
+    return GLEW_VERSION_3_2 || (GLEW_ARB_copy_buffer && GLEW_ARB_draw_elements_base_vertex && GLEW_ARB_map_buffer_range);
+}
+
+GLboolean VertexPool::_Allocate(FreeRangeMap &free_ranges, GLuint count, GLuint &first)
+{
+    if (!count)
+    {
+        first = 0;
+        return GL_TRUE;
+    }
+
+    for (FreeRangeMap::iterator it = free_ranges.begin(); it != free_ranges.end(); ++it)
+    {
+        if (it->second < count)
+            continue;
+
+        first = it->first;
+
+        if (it->second > count)
+            free_ranges[first + count] = it->second - count;
+
+        free_ranges.erase(it);
+
+        return GL_TRUE;
+    }
+
+    return GL_FALSE;
+}
+
+GLvoid VertexPool::_Free(FreeRangeMap &free_ranges, GLuint first, GLuint count)
+{
+    if (!count)
+        return;
+
+    FreeRangeMap::iterator next = free_ranges.lower_bound(first);
+
+    // merging with the following free range
+    if (next != free_ranges.end() && first + count == next->first)
+    {
+        count += next->second;
+        next = free_ranges.erase(next);
+    }
+
+    // merging with the preceding free range
+    if (next != free_ranges.begin())
+    {
+        FreeRangeMap::iterator previous = next;
+        --previous;
+
+        if (previous->first + previous->second == first)
+        {
+            previous->second += count;
+            return;
+        }
+    }
+
+    free_ranges[first] = count;
+}
+
+GLboolean VertexPool::_Grow(GLuint vertex_capacity, GLuint index_capacity)
+{
+    GLuint old_capacity[MESH_BUFFER_COUNT] = {_vertex_capacity, _vertex_capacity, _vertex_capacity, _index_capacity};
+    GLuint new_capacity[MESH_BUFFER_COUNT] = {vertex_capacity, vertex_capacity, vertex_capacity, index_capacity};
+    GLboolean initial_allocation = (_buffer[0] == 0);
+
+    GLuint buffer[MESH_BUFFER_COUNT];
+    glGenBuffers(MESH_BUFFER_COUNT, buffer);
+
+    for (GLuint i = 0; i < MESH_BUFFER_COUNT; i++)
+    {
+        if (!buffer[i])
+        {
+            glDeleteBuffers(MESH_BUFFER_COUNT, buffer);
+            return GL_FALSE;
+        }
+    }
+
+    // the copy targets do not disturb the bindings of the vertex and element arrays
+    for (GLuint i = 0; i < MESH_BUFFER_COUNT; i++)
+    {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer[i]);
+        glBufferData(GL_COPY_WRITE_BUFFER, new_capacity[i] * element_byte_size[i], nullptr, GL_DYNAMIC_DRAW);
+
+        if (!initial_allocation)
+        {
+            glBindBuffer(GL_COPY_READ_BUFFER, _buffer[i]);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, old_capacity[i] * element_byte_size[i]);
+        }
+    }
+
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    if (initial_allocation)
+    {
+        _Free(_free_vertices, 0, vertex_capacity);
+        _Free(_free_indices, 0, index_capacity);
+    }
+    else
+    {
+        glDeleteBuffers(MESH_BUFFER_COUNT, _buffer);
+
+        _Free(_free_vertices, _vertex_capacity, vertex_capacity - _vertex_capacity);
+        _Free(_free_indices, _index_capacity, index_capacity - _index_capacity);
+    }
+
+    copy(buffer, buffer + MESH_BUFFER_COUNT, _buffer);
+
+    _vertex_capacity = vertex_capacity;
+    _index_capacity  = index_capacity;
+
+    return GL_TRUE;
+}
+
+GLboolean VertexPool::_Copy(const TriangulatedMesh3 &mesh, const Allocation &allocation, GLboolean copy_indices) const
+{
+    const BufferObjects *vbo = BufferObjects::Of(mesh.VertexBufferObjects());
+
+    if (!vbo || vbo->GetCount() != MESH_BUFFER_COUNT)
+        return GL_FALSE;
+
+    GLuint first[MESH_BUFFER_COUNT] = {allocation.first_vertex, allocation.first_vertex, allocation.first_vertex, allocation.first_index};
+    GLuint count[MESH_BUFFER_COUNT] = {allocation.vertex_count, allocation.vertex_count, allocation.vertex_count, allocation.index_count};
+
+    for (GLuint i = 0; i < (copy_indices ? MESH_BUFFER_COUNT : INDEX_BUFFER); i++)
+    {
+        if (!count[i])
+            continue;
+
+        glBindBuffer(GL_COPY_READ_BUFFER, (*vbo)[i]);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, _buffer[i]);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+                            0, first[i] * element_byte_size[i], count[i] * element_byte_size[i]);
+    }
+
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    return GL_TRUE;
+}
+
+GLvoid* VertexPool::_MapRange(const TriangulatedMesh3 *mesh, GLuint buffer_index, GLenum access_flag) const
+{
+    const Allocation *allocation = Find(mesh);
+
+    if (!allocation || !allocation->vertex_count)
+        return nullptr;
+
+    GLbitfield access;
+
+    switch (access_flag)
+    {
+    case GL_READ_ONLY:  access = GL_MAP_READ_BIT; break;
+    case GL_WRITE_ONLY: access = GL_MAP_WRITE_BIT; break;
+    case GL_READ_WRITE: access = GL_MAP_READ_BIT | GL_MAP_WRITE_BIT; break;
+    default:            return nullptr;
+    }
+
+    // the copy target does not disturb the bindings of the vertex arrays
+    glBindBuffer(GL_COPY_WRITE_BUFFER, _buffer[buffer_index]);
+    GLvoid *result = glMapBufferRange(GL_COPY_WRITE_BUFFER,
+                                      allocation->first_vertex * element_byte_size[buffer_index],
+                                      allocation->vertex_count * element_byte_size[buffer_index], access);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    return result;
+}
+
+GLboolean VertexPool::_Unmap(GLuint buffer_index) const
+{
+    if (!_buffer[buffer_index])
+        return GL_FALSE;
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, _buffer[buffer_index]);
+    GLboolean result = glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    return result;
+}
+
+GLboolean VertexPool::Add(const TriangulatedMesh3 &mesh)
+{
+    if (!IsSupported() || !mesh.HasVertexBufferObjects())
+        return GL_FALSE;
+
+    // the size of a contained mesh may have been changed
+    Remove(&mesh);
+
+    if (!_buffer[0] && !_Grow(_vertex_capacity, _index_capacity))
+        return GL_FALSE;
+
+    Allocation allocation;
+
+    allocation.vertex_count = static_cast<GLuint>(mesh.VertexCount());
+    allocation.index_count  = static_cast<GLuint>(3 * mesh.FaceCount());
+
+    // the capacities are doubled at least, so that a series of additions costs linear time
+    while (!_Allocate(_free_vertices, allocation.vertex_count, allocation.first_vertex))
+    {
+        if (!_Grow(max(2 * _vertex_capacity, _vertex_capacity + allocation.vertex_count), _index_capacity))
+            return GL_FALSE;
+    }
+
+    while (!_Allocate(_free_indices, allocation.index_count, allocation.first_index))
+    {
+        if (!_Grow(_vertex_capacity, max(2 * _index_capacity, _index_capacity + allocation.index_count)))
+        {
+            _Free(_free_vertices, allocation.first_vertex, allocation.vertex_count);
+            return GL_FALSE;
+        }
+    }
+
+    if (!_Copy(mesh, allocation, GL_TRUE))
+    {
+        _Free(_free_vertices, allocation.first_vertex, allocation.vertex_count);
+        _Free(_free_indices, allocation.first_index, allocation.index_count);
+        return GL_FALSE;
+    }
+
+    _allocation[&mesh] = allocation;
+
+    return GL_TRUE;
+}
+
+GLboolean VertexPool::Update(const TriangulatedMesh3 &mesh)
+{
+    AllocationMap::const_iterator it = _allocation.find(&mesh);
+
+    if (it == _allocation.end() || it->second.vertex_count != mesh.VertexCount())
+        return GL_FALSE;
+
+    return _Copy(mesh, it->second, GL_FALSE);
+}
+
+GLfloat* VertexPool::MapVertexRange(const TriangulatedMesh3 *mesh, GLenum access_flag) const
+{
+    return static_cast<GLfloat*>(_MapRange(mesh, VERTEX_BUFFER, access_flag));
+}
+
+GLfloat* VertexPool::MapNormalRange(const TriangulatedMesh3 *mesh, GLenum access_flag) const
+{
+    return static_cast<GLfloat*>(_MapRange(mesh, NORMAL_BUFFER, access_flag));
+}
+
+GLboolean VertexPool::UnmapVertexBuffer() const
+{
+    return _Unmap(VERTEX_BUFFER);
+}
+
+GLboolean VertexPool::UnmapNormalBuffer() const
+{
+    return _Unmap(NORMAL_BUFFER);
+}
+
+GLboolean VertexPool::Remove(const TriangulatedMesh3 *mesh)
+{
+    AllocationMap::iterator it = _allocation.find(mesh);
+
+    if (it == _allocation.end())
+        return GL_FALSE;
+
+    _Free(_free_vertices, it->second.first_vertex, it->second.vertex_count);
+    _Free(_free_indices, it->second.first_index, it->second.index_count);
+
+    _allocation.erase(it);
+
+    return GL_TRUE;
+}
+
+GLvoid VertexPool::Clear()
+{
+    _allocation.clear();
+    _free_vertices.clear();
+    _free_indices.clear();
+
+    // the buffers are kept for the next additions
+    if (_buffer[0])
+    {
+        _Free(_free_vertices, 0, _vertex_capacity);
+        _Free(_free_indices, 0, _index_capacity);
+    }
+}
+
+const VertexPool::Allocation* VertexPool::Find(const TriangulatedMesh3 *mesh) const
+{
+    AllocationMap::const_iterator it = _allocation.find(mesh);
+
+    return (it == _allocation.end()) ? nullptr : &it->second;
+}
+
+GLboolean VertexPool::Bind() const
+{
+    if (!_buffer[0])
+        return GL_FALSE;
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+
+        glBindBuffer(GL_ARRAY_BUFFER, _buffer[TEXTURE_BUFFER]);
+        glTexCoordPointer(4, GL_FLOAT, 0, nullptr);
+
+        glBindBuffer(GL_ARRAY_BUFFER, _buffer[NORMAL_BUFFER]);
+        glNormalPointer(GL_FLOAT, 0, nullptr);
+
+        glBindBuffer(GL_ARRAY_BUFFER, _buffer[VERTEX_BUFFER]);
+        glVertexPointer(3, GL_FLOAT, 0, nullptr);
+
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffer[INDEX_BUFFER]);
+
+    return GL_TRUE;
+}
+
+GLvoid VertexPool::Unbind()
+{
+    TriangulatedMesh3::UnbindVertexBufferObjects();
+}
+
+GLboolean VertexPool::Draw(const TriangulatedMesh3 *mesh, GLenum render_mode) const
+{
+    const Allocation *allocation = Find(mesh);
+
+    if (!allocation)
+        return GL_FALSE;
+
+    glDrawElementsBaseVertex(render_mode, static_cast<GLsizei>(allocation->index_count), GL_UNSIGNED_INT,
+                             reinterpret_cast<GLvoid*>(allocation->first_index * sizeof(GLuint)),
+                             static_cast<GLint>(allocation->first_vertex));
+
+    return GL_TRUE;
+}
+
+GLuint VertexPool::MeshCount() const
+{
+    return static_cast<GLuint>(_allocation.size());
+}
+
+GLuint VertexPool::VertexCapacity() const
+{
+    return _vertex_capacity;
+}
+
+GLuint VertexPool::IndexCapacity() const
+{
+    return _index_capacity;
+}
+
+VertexPool::~VertexPool()
+{
+    if (_buffer[0])
+        glDeleteBuffers(MESH_BUFFER_COUNT, _buffer);
+}
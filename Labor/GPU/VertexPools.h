@@ -0,0 +1,114 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <map>
+#include "BufferObjects.h"
+#include "../Core/TriangulatedMeshes3.h"
+
+namespace cagd
+{
+    //-----------------
+    // class VertexPool
+    //-----------------
+    // A single set of vertex, normal, texture coordinate and index buffer objects into which the buffers of
+    // several triangulated meshes are suballocated (the ranges are managed by first-fit free lists and the
+    // buffers grow on demand). The content of the meshes is copied on the GPU by glCopyBufferSubData, the
+    // local indices of a mesh are preserved, therefore its draws use its first vertex as base vertex. Since
+    // the pool has to be bound only once, the meshes of a scene can be drawn one after the other without
+    // rebinding buffers, or by a single multi-draw indirect call (see RenderQueue).
+    //
+    // The pool does not own the meshes: a mesh has to be removed before it is deleted (or the pool has to
+    // be cleared), and Update has to be called if its vertex buffer objects are modified (e.g. through the
+    // methods Map*Buffer). Once a mesh is added, its own vertex buffer objects can be deleted (see
+    // TriangulatedMesh3::DeleteVertexBufferObjects), so that its geometry is not stored twice on the GPU;
+    // such a mesh can only be drawn through the pool, and it can be modified only through the Map*Range
+    // methods. All methods require a valid OpenGL rendering context.
+    class VertexPool
+    {
+    public:
+        // the range of a mesh in the pool, measured in vertices and indices, respectively
+        class Allocation
+        {
+        public:
+            GLuint first_vertex, vertex_count;
+            GLuint first_index, index_count;
+        };
+
+    private:
+        typedef std::map<GLuint, GLuint>                            FreeRangeMap; // first element -> count
+        typedef std::map<const TriangulatedMesh3*, Allocation>      AllocationMap;
+
+        GLuint          _buffer[MESH_BUFFER_COUNT];
+        GLuint          _vertex_capacity, _index_capacity;
+        FreeRangeMap    _free_vertices, _free_indices;
+        AllocationMap   _allocation;
+
+        // first-fit allocation of count consecutive elements, returns GL_FALSE if the free list has no such range
+        static GLboolean _Allocate(FreeRangeMap &free_ranges, GLuint count, GLuint &first);
+
+        // returns the range to the free list and merges it with its free neighbours
+        static GLvoid    _Free(FreeRangeMap &free_ranges, GLuint first, GLuint count);
+
+        // reallocates the buffers with the given capacities and copies their content
+        GLboolean _Grow(GLuint vertex_capacity, GLuint index_capacity);
+
+        // copies the buffers of the mesh into its range
+        GLboolean _Copy(const TriangulatedMesh3 &mesh, const Allocation &allocation, GLboolean copy_indices) const;
+
+        // maps the range of a contained mesh in the given buffer, and unmaps the given buffer, respectively
+        GLvoid*   _MapRange(const TriangulatedMesh3 *mesh, GLuint buffer_index, GLenum access_flag) const;
+        GLboolean _Unmap(GLuint buffer_index) const;
+
+        // pools cannot be copied
+        VertexPool(const VertexPool&);
+        VertexPool& operator =(const VertexPool&);
+
+    public:
+        // the buffers are allocated lazily with the given initial capacities
+        VertexPool(GLuint vertex_capacity = 1u << 18, GLuint index_capacity = 3u << 18);
+
+        // the pool requires OpenGL 3.2, or the extensions GL_ARB_copy_buffer, GL_ARB_draw_elements_base_vertex
+        // and GL_ARB_map_buffer_range
+        static GLboolean IsSupported();
+
+        // copies the vertex buffer objects of the mesh into the pool, meshes that are already contained are
+        // updated; returns GL_FALSE if the mesh has no vertex buffer objects or the pool is not supported
+        GLboolean Add(const TriangulatedMesh3 &mesh);
+
+        // copies the vertices, normals and texture coordinates of a contained mesh again, returns GL_FALSE if
+        // the mesh does not have vertex buffer objects anymore
+        GLboolean Update(const TriangulatedMesh3 &mesh);
+
+        // map the range of a contained mesh in the vertex or normal buffer of the pool (the access flags are
+        // the ones of glMapBuffer), i.e., pooled meshes without vertex buffer objects of their own can be
+        // modified in place; each mapped buffer has to be unmapped before the next draw
+        GLfloat*  MapVertexRange(const TriangulatedMesh3 *mesh, GLenum access_flag = GL_READ_ONLY) const;
+        GLfloat*  MapNormalRange(const TriangulatedMesh3 *mesh, GLenum access_flag = GL_READ_ONLY) const;
+
+        // the results are the ones of glUnmapBuffer
+        GLboolean UnmapVertexBuffer() const;
+        GLboolean UnmapNormalBuffer() const;
+
+        GLboolean Remove(const TriangulatedMesh3 *mesh);
+        GLvoid    Clear();
+
+        // returns nullptr if the mesh is not contained
+        const Allocation* Find(const TriangulatedMesh3 *mesh) const;
+
+        // the vertex, normal and texture coordinate arrays are enabled and the index buffer is bound, each
+        // draw has to use the first vertex of its allocation as base vertex and the first index as offset
+        GLboolean Bind() const;
+        static GLvoid Unbind();
+
+        // draws a contained mesh by glDrawElementsBaseVertex, the pool has to be bound
+        GLboolean Draw(const TriangulatedMesh3 *mesh, GLenum render_mode = GL_TRIANGLES) const;
+
+        // query methods
+        GLuint MeshCount() const;
+        GLuint VertexCapacity() const;
+        GLuint IndexCapacity() const;
+
+        // deletes the buffer objects
+        ~VertexPool();
+    };
+}
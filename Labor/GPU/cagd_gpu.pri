@@ -0,0 +1,17 @@
+# Links the including project against the static library cagd_gpu (see cagd_gpu.pro), which has to be
+# built into the shadow build directory of this folder, e.g. by the subdirs project ../CAGD.pro. The
+# library refers to GLEW and OpenGL, these have to be linked by the including project, too.
+INCLUDEPATH += $$PWD/.. $$PWD/../Dependencies/Include
+DEPENDPATH  += $$PWD/..
+
+CAGD_GPU_DIRECTORY = $$shadowed($$PWD)
+
+win32 {
+    CONFIG(release, debug|release): CAGD_GPU_DIRECTORY = $$CAGD_GPU_DIRECTORY/release
+    else: CONFIG(debug, debug|release): CAGD_GPU_DIRECTORY = $$CAGD_GPU_DIRECTORY/debug
+}
+
+LIBS += -L$$CAGD_GPU_DIRECTORY -lcagd_gpu
+
+win32-msvc*: PRE_TARGETDEPS += $$CAGD_GPU_DIRECTORY/cagd_gpu.lib
+else:        PRE_TARGETDEPS += $$CAGD_GPU_DIRECTORY/libcagd_gpu.a
@@ -0,0 +1,47 @@
+# Static library of the GPU-resource layer: it owns the buffer objects of the geometric objects of the
+# library cagd_core (i.e. it implements their rendering, vertex buffer object updating and mapping methods),
+# and it contains the OpenGL state wrappers (lights, materials and shader programs). Each of its functions
+# requires a valid OpenGL rendering context.
+#
+# Applications include cagd_gpu.pri and ../Core/cagd_core.pri (in this order) in order to link against it.
+TEMPLATE = lib
+TARGET = cagd_gpu
+
+CONFIG += staticlib c++11
+CONFIG -= qt
+
+INCLUDEPATH += $$PWD/.. $$PWD/../Dependencies/Include
+
+# see ../Core/cagd_core.pro
+CONFIG(debug, debug|release)|cagd_profiling: DEFINES += CAGD_PROFILING
+
+msvc {
+    QMAKE_CXXFLAGS += -arch:AVX
+    QMAKE_CXXFLAGS_RELEASE *= -O2
+}
+
+HEADERS += \
+    BufferObjects.h \
+    GPUTimers.h \
+    GridIndexBuffers.h \
+    Lights.h \
+    Materials.h \
+    RenderBackends.h \
+    RenderQueues.h \
+    ShaderPrograms.h \
+    VertexPools.h
+
+SOURCES += \
+    BufferObjects.cpp \
+    GenericCurves3Rendering.cpp \
+    GPUTimers.cpp \
+    GridIndexBuffers.cpp \
+    Lights.cpp \
+    LinearCombination3Rendering.cpp \
+    Materials.cpp \
+    RenderBackends.cpp \
+    RenderQueues.cpp \
+    ShaderPrograms.cpp \
+    TensorProductSurfaces3Rendering.cpp \
+    TriangulatedMeshes3Rendering.cpp \
+    VertexPools.cpp
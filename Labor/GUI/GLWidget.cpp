@@ -4,6 +4,7 @@
 #include <GL/glu.h>
 #endif
 
+#include <cmath>
 #include <iostream>
 #include <fstream>
 using namespace std;
@@ -13,8 +14,173 @@ using namespace std;
 #include <Core/Matrices.h>
 #include <Test/TestFunctions.h>
 #include <Core/Constants.h>
+#include <QDir>
+#include <QPainter>
+#include <QStandardPaths>
 #include <QTimer>
 
+namespace
+{
+    // column-major 4 x 4 matrices of the core profile render backend, the functions reproduce the matrix stack
+    // calls of the fixed-function pipeline (e.g. multiplyMatrix(m, b) replaces m by m * b like glMultMatrixd)
+    void identityMatrix(double m[16])
+    {
+        for (int i = 0; i < 16; i++)
+        {
+            m[i] = (i % 5 == 0) ? 1.0 : 0.0;
+        }
+    }
+
+    void multiplyMatrix(double m[16], const double b[16])
+    {
+        double product[16];
+
+        for (int c = 0; c < 4; c++)
+        {
+            for (int r = 0; r < 4; r++)
+            {
+                product[c * 4 + r] = m[r] * b[c * 4] + m[4 + r] * b[c * 4 + 1] + m[8 + r] * b[c * 4 + 2] + m[12 + r] * b[c * 4 + 3];
+            }
+        }
+
+        for (int i = 0; i < 16; i++)
+        {
+            m[i] = product[i];
+        }
+    }
+
+    // the angle is given in degrees, the axis is normalized
+    void rotateMatrix(double m[16], double angle, double x, double y, double z)
+    {
+        double length = sqrt(x * x + y * y + z * z);
+
+        if (length == 0.0)
+        {
+            return;
+        }
+
+        x /= length; y /= length; z /= length;
+
+        double c = cos(angle * cagd::DEG_TO_RADIAN), s = sin(angle * cagd::DEG_TO_RADIAN), d = 1.0 - c;
+
+        double rotation[16] = {x * x * d + c,     y * x * d + z * s, x * z * d - y * s, 0.0,
+                               x * y * d - z * s, y * y * d + c,     y * z * d + x * s, 0.0,
+                               x * z * d + y * s, y * z * d - x * s, z * z * d + c,     0.0,
+                               0.0,               0.0,               0.0,               1.0};
+
+        multiplyMatrix(m, rotation);
+    }
+
+    void translateMatrix(double m[16], double x, double y, double z)
+    {
+        for (int r = 0; r < 4; r++)
+        {
+            m[12 + r] += m[r] * x + m[4 + r] * y + m[8 + r] * z;
+        }
+    }
+
+    void scaleMatrix(double m[16], double x, double y, double z)
+    {
+        for (int r = 0; r < 4; r++)
+        {
+            m[r] *= x; m[4 + r] *= y; m[8 + r] *= z;
+        }
+    }
+
+    // the same matrices as the ones of gluPerspective and gluLookAt
+    void perspectiveMatrix(double fovy, double aspect, double z_near, double z_far, double m[16])
+    {
+        double f = 1.0 / tan(0.5 * fovy * cagd::DEG_TO_RADIAN);
+
+        identityMatrix(m);
+
+        m[0]  = f / aspect;
+        m[5]  = f;
+        m[10] = (z_far + z_near) / (z_near - z_far);
+        m[11] = -1.0;
+        m[14] = 2.0 * z_far * z_near / (z_near - z_far);
+        m[15] = 0.0;
+    }
+
+    void lookAtMatrix(const double eye[3], const double center[3], const double up[3], double m[16])
+    {
+        cagd::DCoordinate3 f(center[0] - eye[0], center[1] - eye[1], center[2] - eye[2]);
+        f.normalize();
+
+        cagd::DCoordinate3 s = f ^ cagd::DCoordinate3(up[0], up[1], up[2]);
+        s.normalize();
+
+        cagd::DCoordinate3 u = s ^ f;
+
+        identityMatrix(m);
+
+        for (int i = 0; i < 3; i++)
+        {
+            m[i * 4]     = s[i];
+            m[i * 4 + 1] = u[i];
+            m[i * 4 + 2] = -f[i];
+        }
+
+        translateMatrix(m, -eye[0], -eye[1], -eye[2]);
+    }
+
+    void setProjectionMatrix(const double m[16])
+    {
+        GLfloat matrix[16];
+
+        for (int i = 0; i < 16; i++)
+        {
+            matrix[i] = static_cast<GLfloat>(m[i]);
+        }
+
+        cagd::RenderBackend::SetProjectionMatrix(matrix);
+    }
+
+    void setModelViewMatrix(const double m[16])
+    {
+        GLfloat matrix[16];
+
+        for (int i = 0; i < 16; i++)
+        {
+            matrix[i] = static_cast<GLfloat>(m[i]);
+        }
+
+        cagd::RenderBackend::SetModelViewMatrix(matrix);
+    }
+
+    // the current color of the fixed-function pipeline and the color of the core profile backend
+    void setColor(GLfloat r, GLfloat g, GLfloat b)
+    {
+        glColor3f(r, g, b);
+        cagd::RenderBackend::SetColor(cagd::Color4(r, g, b));
+    }
+
+    // the material of the fixed-function pipeline and the material of the core profile backend
+    void setMaterial(cagd::Material &material)
+    {
+        material.Apply();
+        cagd::RenderBackend::SetMaterial(material);
+    }
+
+    // the position of the light source is transformed into eye coordinates by the view matrix, which was the
+    // model-view matrix when the light source was created
+    void setLight(const cagd::DirectionalLight &light, const double view[16])
+    {
+        const cagd::HCoordinate3 &position = light.GetPosition();
+
+        GLfloat eye_position[4];
+
+        for (int r = 0; r < 4; r++)
+        {
+            eye_position[r] = static_cast<GLfloat>(view[r] * position.x() + view[4 + r] * position.y() +
+                                                   view[8 + r] * position.z() + view[12 + r] * position.w());
+        }
+
+        cagd::RenderBackend::SetLight(cagd::HCoordinate3(eye_position[0], eye_position[1], eye_position[2], eye_position[3]),
+                                      light.GetAmbientIntensity(), light.GetDiffuseIntensity(), light.GetSpecularIntensity());
+    }
+}
+
 namespace cagd
 {
     //--------------------------------
@@ -57,6 +223,14 @@ namespace cagd
     //--------------------------------------------------------------------------------------
     void GLWidget::initializeGL()
     {
+        // the time to the first frame and to the complete race scene are measured from here
+        _race_loading_clock.start();
+
+#if defined(CAGD_PROFILING)
+        _profiler_overlay_is_visible = !qEnvironmentVariableIsEmpty("CAGD_PROFILER_OVERLAY");
+        _profiler_overlay_clock.start();
+#endif
+
         // creating a perspective projection matrix
         glMatrixMode(GL_PROJECTION);
 
@@ -68,6 +242,7 @@ namespace cagd
         _fovy = 45.0;
 
         gluPerspective(_fovy, _aspect, _z_near, _z_far);
+        perspectiveMatrix(_fovy, _aspect, _z_near, _z_far, _projection_matrix);
 
         // setting the model view matrix
         glMatrixMode(GL_MODELVIEW);
@@ -80,6 +255,7 @@ namespace cagd
         _up[1] = 1.0;
 
         gluLookAt(_eye[0], _eye[1], _eye[2], _center[0], _center[1], _center[2], _up[0], _up[1], _up[2]);
+        lookAtMatrix(_eye, _center, _up, _view_matrix);
 
         // enabling the depth test
         glEnable(GL_DEPTH_TEST);
@@ -108,6 +284,22 @@ namespace cagd
                                 "Try to update your driver or buy a new graphics adapter!");
             }
 
+            // the geometric objects are rendered by vertex array objects and a core profile program if OpenGL 3.3
+            // is available, paintGL passes the matrices, light source and materials to it explicitly (except on the
+            // race page); the fixed-function path can be requested by CAGD_RENDER_BACKEND=fixed_function
+            QString render_backend_cache_directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/shaders";
+
+            if (qgetenv("CAGD_RENDER_BACKEND") == "fixed_function" ||
+                !RenderBackend::Select(RenderBackend::CORE_PROFILE, "../Shaders",
+                                       QDir().mkpath(render_backend_cache_directory) ?
+                                       render_backend_cache_directory.toStdString() : std::string()))
+            {
+                RenderBackend::Select(RenderBackend::FIXED_FUNCTION);
+            }
+
+            cout << "Render backend: "
+                 << (RenderBackend::Selected() == RenderBackend::CORE_PROFILE ? "core profile" : "fixed-function") << endl;
+
             // create and store your geometry in display lists or vertex buffer objects
 
             // Parametric curves
@@ -233,6 +425,15 @@ namespace cagd
     //-----------------------
     void GLWidget::paintGL()
     {
+        CAGD_PROFILE_ZONE("GLWidget::paintGL");
+
+#if defined(CAGD_PROFILING)
+        _profiler_gpu_frame_timer.Begin();
+#endif
+
+        // models that have been loaded since the previous frame
+        _uploadLoadedModels();
+
         // clears the color and depth buffers
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -246,6 +447,34 @@ namespace cagd
         glTranslated(_trans_x, _trans_y, _trans_z);
         glScaled(_zoom, _zoom, _zoom);
 
+        // the pages except the race specify the state of the core profile render backend explicitly, i.e., the
+        // backend reads back neither the matrix stacks nor the lighting state at its draws, and its program remains
+        // in use for the whole page; the race page draws immediate-mode points, thus its state is still adopted
+        GLboolean explicit_render_state = (RenderBackend::Selected() == RenderBackend::CORE_PROFILE && _selected_page != 1);
+        GLboolean adopts_fixed_function_state = RenderBackend::AdoptsFixedFunctionState();
+        double    camera[16];
+
+        if (explicit_render_state)
+        {
+            for (int i = 0; i < 16; i++)
+            {
+                camera[i] = _view_matrix[i];
+            }
+
+            rotateMatrix(camera, _angle_x, 1.0, 0.0, 0.0);
+            rotateMatrix(camera, _angle_y, 0.0, 1.0, 0.0);
+            rotateMatrix(camera, _angle_z, 0.0, 0.0, 1.0);
+            translateMatrix(camera, _trans_x, _trans_y, _trans_z);
+            scaleMatrix(camera, _zoom, _zoom, _zoom);
+
+            RenderBackend::SetFixedFunctionStateAdoption(GL_FALSE);
+            setProjectionMatrix(_projection_matrix);
+            setModelViewMatrix(camera);
+            RenderBackend::SetLighting(GL_FALSE);
+            RenderBackend::SetTexturing(GL_FALSE);
+            RenderBackend::BeginBatch();
+        }
+
         // render your geometry (this is oldest OpenGL rendering technique, later we will use some advanced methods)
         if (_shader_do_shader)
         {
@@ -264,10 +493,10 @@ namespace cagd
             if (_pc_image_of_pcs[_pc_selected_curve_index])
             {
                 glPushMatrix();
-                glColor3f(1.0f, 1.0f, 1.0f);
+                setColor(1.0f, 1.0f, 1.0f);
                 if (_pc_zeroth_derivative)
                 {
-                    glColor3f(1.0f, 0.0f, 0.0f);
+                    setColor(1.0f, 0.0f, 0.0f);
                     _pc_image_of_pcs[_pc_selected_curve_index]->RenderDerivatives(0, GL_LINE_STRIP);
                 }
 
@@ -275,20 +504,20 @@ namespace cagd
 
                 if (_pc_first_derivative)
                 {
-                    glColor3f(0.0f, 1.0f, 0.0f);
+                    setColor(0.0f, 1.0f, 0.0f);
                     _pc_image_of_pcs[_pc_selected_curve_index]->RenderDerivatives(1, GL_LINES);
                     _pc_image_of_pcs[_pc_selected_curve_index]->RenderDerivatives(1, GL_POINTS);
                 }
 
                 if (_pc_second_derivative)
                 {
-                    glColor3f(0.0f, 0.0f, 1.0f);
+                    setColor(0.0f, 0.0f, 1.0f);
                     _pc_image_of_pcs[_pc_selected_curve_index]->RenderDerivatives(2, GL_LINES);
                     _pc_image_of_pcs[_pc_selected_curve_index]->RenderDerivatives(2, GL_POINTS);
                 }
 
                 glPointSize(1.0f);
-                glColor3f(1.0f, 1.0f, 1.0f);
+                setColor(1.0f, 1.0f, 1.0f);
                 glPopMatrix();
             }
             break;
@@ -296,132 +525,30 @@ namespace cagd
             // Race
             glPushMatrix();
                 glEnable(GL_NORMALIZE);
-                for (GLuint i = 0; i < _static_object_count; i++)
+                if (_dirLightRace)
                 {
-                    if (_dirLightRace)
+                    for (GLuint i = 0; i < _static_object_count; i++)
                     {
                         const ModelProperties &static_object = _race_static_scene[i];
-                        glPushMatrix();
-                            if (static_object.material_id >= 0)
-                            {
-                                glEnable(GL_LIGHTING);
-                            }
-                            _dirLightRace->Enable();
-
-                            glRotated(static_object.angle1[0], 1.0, 0.0, 0.0);
-                            glRotated(static_object.angle1[1], 0.0, 1.0, 0.0);
-                            glRotated(static_object.angle1[2], 0.0, 0.0, 1.0);
-
-                            glTranslated(static_object.position[0], static_object.position[1], static_object.position[2]);
-
-                            glRotated(static_object.angle2[0], 1.0, 0.0, 0.0);
-                            glRotated(static_object.angle2[1], 0.0, 1.0, 0.0);
-                            glRotated(static_object.angle2[2], 0.0, 0.0, 1.0);
-
-                            glScaled(static_object.scale[0], static_object.scale[1], static_object.scale[2]);
-
-                            glColor3f(static_object.color[0], static_object.color[1], static_object.color[2]);
-
-                            if (static_object.material_id >= 0)
-                            {
-                                _race_object_materials[static_object.material_id].Apply();
-                            }
-
-                            _race_static_models[static_object.id].Render();
-
-                            _dirLightRace->Disable();
-                            if (static_object.material_id >= 0)
-                            {
-                                glDisable(GL_LIGHTING);
-                            }
-                        glPopMatrix();
+                        _queueRaceObject(static_object, _race_static_models[static_object.id], nullptr);
                     }
-                }
 
-                for (GLuint i = 0; i < 2 * _moving_object_count; i = i + 2)
-                {
-                    if (_dirLightRace)
+                    for (GLuint i = 0; i < 2 * _moving_object_count; i = i + 2)
                     {
-                        const ModelProperties &moving_object_vehicle = _race_moving_scene[i];
-                        const ModelProperties &moving_object_passanger = _race_moving_scene[i + 1];
-
                         // Vehicle
-                        glPushMatrix();
-                            if (moving_object_vehicle.material_id >= 0)
-                            {
-                                glEnable(GL_LIGHTING);
-                            }
-                            _dirLightRace->Enable();
-
-                            glMultMatrixd(_transformation[i / 2]);
-
-                            glRotated(moving_object_vehicle.angle1[0], 1.0, 0.0, 0.0);
-                            glRotated(moving_object_vehicle.angle1[1], 0.0, 1.0, 0.0);
-                            glRotated(moving_object_vehicle.angle1[2], 0.0, 0.0, 1.0);
-
-                            glTranslated(moving_object_vehicle.position[0], moving_object_vehicle.position[1], moving_object_vehicle.position[2]);
-
-                            glRotated(moving_object_vehicle.angle2[0], 1.0, 0.0, 0.0);
-                            glRotated(moving_object_vehicle.angle2[1], 0.0, 1.0, 0.0);
-                            glRotated(moving_object_vehicle.angle2[2], 0.0, 0.0, 1.0);
-
-                            glScaled(moving_object_vehicle.scale[0], moving_object_vehicle.scale[1], moving_object_vehicle.scale[2]);
-
-                            glColor3f(moving_object_vehicle.color[0], moving_object_vehicle.color[1], moving_object_vehicle.color[2]);
-
-                            if (moving_object_vehicle.material_id >= 0)
-                            {
-                                _race_object_materials[moving_object_vehicle.material_id].Apply();
-                            }
-
-                            _race_moving_models[moving_object_vehicle.id].Render();
-
-                            _dirLightRace->Disable();
-                            if (moving_object_vehicle.material_id >= 0)
-                            {
-                                glDisable(GL_LIGHTING);
-                            }
-                        glPopMatrix();
-
+                        const ModelProperties &moving_object_vehicle = _race_moving_scene[i];
+                        _queueRaceObject(moving_object_vehicle, _race_moving_models[moving_object_vehicle.id], _transformation[i / 2]);
 
                         // Passanger
-                        glPushMatrix();
-                            if (moving_object_passanger.material_id >= 0)
-                            {
-                                glEnable(GL_LIGHTING);
-                            }
-                            _dirLightRace->Enable();
-
-                            glMultMatrixd(_transformation[i / 2]);
-
-                            glRotated(moving_object_passanger.angle1[0], 1.0, 0.0, 0.0);
-                            glRotated(moving_object_passanger.angle1[1], 0.0, 1.0, 0.0);
-                            glRotated(moving_object_passanger.angle1[2], 0.0, 0.0, 1.0);
-
-                            glTranslated(moving_object_passanger.position[0], moving_object_passanger.position[1], moving_object_passanger.position[2]);
-
-                            glRotated(moving_object_passanger.angle2[0], 1.0, 0.0, 0.0);
-                            glRotated(moving_object_passanger.angle2[1], 0.0, 1.0, 0.0);
-                            glRotated(moving_object_passanger.angle2[2], 0.0, 0.0, 1.0);
-
-                            glScaled(moving_object_passanger.scale[0], moving_object_passanger.scale[1], moving_object_passanger.scale[2]);
-
-                            glColor3f(moving_object_passanger.color[0], moving_object_passanger.color[1], moving_object_passanger.color[2]);
-
-                            if (moving_object_passanger.material_id >= 0)
-                            {
-                                _race_object_materials[moving_object_passanger.material_id].Apply();
-                            }
-
-                            _race_moving_models[moving_object_passanger.id].Render();
-
-                            _dirLightRace->Disable();
-                            if (moving_object_passanger.material_id >= 0)
-                            {
-                                glDisable(GL_LIGHTING);
-                            }
-                        glPopMatrix();
+                        const ModelProperties &moving_object_passanger = _race_moving_scene[i + 1];
+                        _queueRaceObject(moving_object_passanger, _race_moving_models[moving_object_passanger.id], _transformation[i / 2]);
                     }
+
+                    // the light source is enabled once for the whole queue
+                    _dirLightRace->Enable();
+                    _race_render_queue.Flush(_shader_do_shader ? &_shaders[_shader_index] : nullptr,
+                                             &_race_vertex_pool, _race_multi_draw_is_enabled ? &_race_multi_draw_shader : nullptr);
+                    _dirLightRace->Disable();
                 }
                 _renderCyclicCurves();
                 _renderAllExistingInterpolatingCyclicCurves();
@@ -441,9 +568,14 @@ namespace cagd
                     glEnable(GL_TEXTURE_2D);
                     _dirLightSurface->Enable();
 
+                    // the directional lights share GL_LIGHT0, which keeps the parameters of the light source
+                    // created last, i.e., the ones of the patch light
+                    RenderBackend::SetLighting(GL_TRUE);
+                    setLight(*_dirLightPatch, _view_matrix);
+
                     // Surface
                     glPushMatrix();
-                        _surface_materials[_surface_selected_material[_ps_selected_surface_index]].Apply();
+                        setMaterial(_surface_materials[_surface_selected_material[_ps_selected_surface_index]]);
 
                         if (_ps_do_texture)
                         {
@@ -453,6 +585,7 @@ namespace cagd
                         {
                             _surface_textures[_surface_selected_texture[_ps_selected_surface_index]]->release();
                         }
+                        RenderBackend::SetTexturing(_ps_do_texture);
 
                         _ps_image_of_pss[_ps_selected_surface_index]->Render(GL_TRIANGLES);
                     glPopMatrix();
@@ -461,6 +594,8 @@ namespace cagd
 
                     glDisable(GL_TEXTURE_2D);
                     glDisable(GL_LIGHTING);
+                    RenderBackend::SetTexturing(GL_FALSE);
+                    RenderBackend::SetLighting(GL_FALSE);
                 }
                 glPopMatrix();
             }
@@ -468,7 +603,7 @@ namespace cagd
             {
                 // Parametric surface curves
                 glPushMatrix();
-                    glColor3f(1.0f, 0.0f, 0.0f);
+                    setColor(1.0f, 0.0f, 0.0f);
                     _ps_image_of_pscs[_ps_selected_surface_index]->RenderDerivatives(0, GL_LINE_STRIP);
                 glPopMatrix();
 
@@ -476,13 +611,36 @@ namespace cagd
                 glPushMatrix();
                     glEnable(GL_LIGHTING);
                     _dirLightSurface->Enable();
-                    MatFBRuby.Apply();
+                    RenderBackend::SetLighting(GL_TRUE);
+                    setLight(*_dirLightPatch, _view_matrix);
+                    setMaterial(MatFBRuby);
                     glMultMatrixd(_ps_transformation);
                     glTranslated(0.0f, 0.45f, 0.0f);
                     glScaled(1.0f, 1.0f, 1.0f);
-                    _surface_rat_model.Render();
+                    if (explicit_render_state)
+                    {
+                        double model_view[16];
+
+                        for (int i = 0; i < 16; i++)
+                        {
+                            model_view[i] = camera[i];
+                        }
+
+                        multiplyMatrix(model_view, _ps_transformation);
+                        translateMatrix(model_view, 0.0, 0.45, 0.0);
+                        setModelViewMatrix(model_view);
+                    }
+                    if (_surface_rat_model)
+                    {
+                        _surface_rat_model->Render();
+                    }
+                    if (explicit_render_state)
+                    {
+                        setModelViewMatrix(camera);
+                    }
                     _dirLightSurface->Disable();
                     glDisable(GL_LIGHTING);
+                    RenderBackend::SetLighting(GL_FALSE);
                 glPopMatrix();
             }
             break;
@@ -492,10 +650,12 @@ namespace cagd
                 glEnable(GL_NORMALIZE);
                 glEnable(GL_LIGHTING);
                 _dirLightPatch->Enable();
+                RenderBackend::SetLighting(GL_TRUE);
+                setLight(*_dirLightPatch, _view_matrix);
                 glPushMatrix();
                     if (_patch_before_interpolation && _patch_do_before)
                     {
-                        MatFBRuby.Apply();
+                        setMaterial(MatFBRuby);
                         _patch_before_interpolation->Render();
                     }
 
@@ -504,7 +664,7 @@ namespace cagd
                         glEnable(GL_BLEND);
                         glDepthMask(GL_FALSE);
                         glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-                            MatFBTurquoise.Apply();
+                            setMaterial(MatFBTurquoise);
                             _patch_after_interpolation->Render();
                         glDepthMask(GL_TRUE);
                         glDisable(GL_BLEND);
@@ -513,6 +673,7 @@ namespace cagd
                 _dirLightPatch->Disable();
                 glDisable(GL_LIGHTING);
                 glDisable(GL_NORMALIZE);
+                RenderBackend::SetLighting(GL_FALSE);
 
                 // Isoparametric lines
                 glPushMatrix();
@@ -526,15 +687,15 @@ namespace cagd
                             {
                                 if (_patch_do_uip_0)
                                 {
-                                    glColor3f(1.0f, 0.0f, 1.0f);
+                                    setColor(1.0f, 0.0f, 1.0f);
                                     curve->RenderDerivatives(0, GL_LINE_STRIP);
                                 }
 
                                 if (_patch_do_uip_1)
                                 {
-                                    glColor3f(1.0f, 1.0f, 0.0f);
+                                    setColor(1.0f, 1.0f, 0.0f);
                                     curve->RenderDerivatives(1, GL_LINES);
-                                    glColor3f(1.0f, 0.0f, 0.0f);
+                                    setColor(1.0f, 0.0f, 0.0f);
                                     glPointSize(2.0f);
                                     curve->RenderDerivatives(1, GL_POINTS);
                                     glPointSize(1.0f);
@@ -542,9 +703,9 @@ namespace cagd
 
                                 if (_patch_do_uip_2)
                                 {
-                                    glColor3f(1.0f, 1.0f, 1.0f);
+                                    setColor(1.0f, 1.0f, 1.0f);
                                     curve->RenderDerivatives(2, GL_LINES);
-                                    glColor3f(0.0f, 1.0f, 0.0f);
+                                    setColor(0.0f, 1.0f, 0.0f);
                                     glPointSize(2.0f);
                                     curve->RenderDerivatives(2, GL_POINTS);
                                     glPointSize(1.0f);
@@ -561,15 +722,15 @@ namespace cagd
                             {
                                 if (_patch_do_vip_0)
                                 {
-                                    glColor3f(1.0f, 0.0f, 1.0f);
+                                    setColor(1.0f, 0.0f, 1.0f);
                                     curve->RenderDerivatives(0, GL_LINE_STRIP);
                                 }
 
                                 if (_patch_do_vip_1)
                                 {
-                                    glColor3f(1.0f, 1.0f, 0.0f);
+                                    setColor(1.0f, 1.0f, 0.0f);
                                     curve->RenderDerivatives(1, GL_LINES);
-                                    glColor3f(1.0f, 0.0f, 0.0f);
+                                    setColor(1.0f, 0.0f, 0.0f);
                                     glPointSize(2.0f);
                                     curve->RenderDerivatives(1, GL_POINTS);
                                     glPointSize(1.0f);
@@ -577,9 +738,9 @@ namespace cagd
 
                                 if (_patch_do_vip_2)
                                 {
-                                    glColor3f(1.0f, 1.0f, 1.0f);
+                                    setColor(1.0f, 1.0f, 1.0f);
                                     curve->RenderDerivatives(2, GL_LINES);
-                                    glColor3f(0.0f, 1.0f, 0.0f);
+                                    setColor(0.0f, 1.0f, 0.0f);
                                     glPointSize(2.0f);
                                     curve->RenderDerivatives(2, GL_POINTS);
                                     glPointSize(1.0f);
@@ -598,15 +759,15 @@ namespace cagd
                             {
                                 if (_patch_do_uip_0)
                                 {
-                                    glColor3f(1.0f, 0.0f, 1.0f);
+                                    setColor(1.0f, 0.0f, 1.0f);
                                     curve->RenderDerivatives(0, GL_LINE_STRIP);
                                 }
 
                                 if (_patch_do_uip_1)
                                 {
-                                    glColor3f(1.0f, 1.0f, 0.0f);
+                                    setColor(1.0f, 1.0f, 0.0f);
                                     curve->RenderDerivatives(1, GL_LINES);
-                                    glColor3f(1.0f, 0.0f, 0.0f);
+                                    setColor(1.0f, 0.0f, 0.0f);
                                     glPointSize(2.0f);
                                     curve->RenderDerivatives(1, GL_POINTS);
                                     glPointSize(1.0f);
@@ -614,9 +775,9 @@ namespace cagd
 
                                 if (_patch_do_uip_2)
                                 {
-                                    glColor3f(1.0f, 1.0f, 1.0f);
+                                    setColor(1.0f, 1.0f, 1.0f);
                                     curve->RenderDerivatives(2, GL_LINES);
-                                    glColor3f(0.0f, 1.0f, 0.0f);
+                                    setColor(0.0f, 1.0f, 0.0f);
                                     glPointSize(2.0f);
                                     curve->RenderDerivatives(2, GL_POINTS);
                                     glPointSize(1.0f);
@@ -633,15 +794,15 @@ namespace cagd
                             {
                                 if (_patch_do_vip_0)
                                 {
-                                    glColor3f(1.0f, 0.0f, 1.0f);
+                                    setColor(1.0f, 0.0f, 1.0f);
                                     curve->RenderDerivatives(0, GL_LINE_STRIP);
                                 }
 
                                 if (_patch_do_vip_1)
                                 {
-                                    glColor3f(1.0f, 1.0f, 0.0f);
+                                    setColor(1.0f, 1.0f, 0.0f);
                                     curve->RenderDerivatives(1, GL_LINES);
-                                    glColor3f(1.0f, 0.0f, 0.0f);
+                                    setColor(1.0f, 0.0f, 0.0f);
                                     glPointSize(2.0f);
                                     curve->RenderDerivatives(1, GL_POINTS);
                                     glPointSize(1.0f);
@@ -649,9 +810,9 @@ namespace cagd
 
                                 if (_patch_do_vip_2)
                                 {
-                                    glColor3f(1.0f, 1.0f, 1.0f);
+                                    setColor(1.0f, 1.0f, 1.0f);
                                     curve->RenderDerivatives(2, GL_LINES);
-                                    glColor3f(0.0f, 1.0f, 0.0f);
+                                    setColor(0.0f, 1.0f, 0.0f);
                                     glPointSize(2.0f);
                                     curve->RenderDerivatives(2, GL_POINTS);
                                     glPointSize(1.0f);
@@ -668,7 +829,7 @@ namespace cagd
             // Arc
                 if(_arc && _arc_do_arc)
                 {
-                    glColor3f(1.0f, 0.0f, 0.0f);
+                    setColor(1.0f, 0.0f, 0.0f);
                     _arc->RenderData(GL_LINE_STRIP);
                     glPointSize(10.0f);
                     _arc->RenderData(GL_POINTS);
@@ -679,20 +840,20 @@ namespace cagd
                 {
                     if (_arc_do_arc_0)
                     {
-                        glColor3f(0.0f, 1.0f, 1.0f);
+                        setColor(0.0f, 1.0f, 1.0f);
                         _arc_image_of_arc->RenderDerivatives(0, GL_LINE_STRIP);
                     }
 
                     if (_arc_do_arc_1)
                     {
-                        glColor3f(1.0f, 0.0f, 1.0f);
+                        setColor(1.0f, 0.0f, 1.0f);
                         _arc_image_of_arc->RenderDerivatives(1, GL_LINES);
                         _arc_image_of_arc->RenderDerivatives(1, GL_POINTS);
                     }
 
                     if (_arc_do_arc_2)
                     {
-                        glColor3f(1.0f, 1.0f, 1.0f);
+                        setColor(1.0f, 1.0f, 1.0f);
                         _arc_image_of_arc->RenderDerivatives(2, GL_LINES);
                         _arc_image_of_arc->RenderDerivatives(2, GL_POINTS);
                     }
@@ -700,6 +861,13 @@ namespace cagd
             glPopMatrix();
             break;
         }
+
+        if (explicit_render_state)
+        {
+            RenderBackend::EndBatch();
+            RenderBackend::SetFixedFunctionStateAdoption(adopts_fixed_function_state);
+        }
+
         if (_shader_do_shader)
         {
             if (_shader_index == 2 && _shader_intensity < 1.0f)
@@ -713,6 +881,24 @@ namespace cagd
         // pops the current matrix stack, replacing the current matrix with the one below it on the stack,
         // i.e., the original model view matrix is restored
         glPopMatrix();
+
+        if (!_race_first_frame_reported)
+        {
+            cout << "First frame rendered in " << _race_loading_clock.elapsed() << " ms ("
+                 << (_race_model_loader ? _race_model_loader->FinishedJobCount() : _moving_model_count + _static_model_count)
+                 << " of " << _moving_model_count + _static_model_count << " models loaded)" << endl;
+
+            _race_first_frame_reported = true;
+        }
+
+#if defined(CAGD_PROFILING)
+        _profiler_gpu_frame_timer.End();
+
+        if (_profiler_overlay_is_visible)
+        {
+            _renderProfilerOverlay();
+        }
+#endif
     }
 
     //----------------------------------------------------------------------------
@@ -731,6 +917,7 @@ namespace cagd
         _aspect = static_cast<double>(w) / static_cast<double>(h);
 
         gluPerspective(_fovy, _aspect, _z_near, _z_far);
+        perspectiveMatrix(_fovy, _aspect, _z_near, _z_far, _projection_matrix);
 
         // switching back to the model view matrix
         glMatrixMode(GL_MODELVIEW);
@@ -744,6 +931,8 @@ namespace cagd
     // Race
     void GLWidget::_animate0()
     {
+        CAGD_PROFILE_ZONE("GLWidget::_animate0");
+
         GLuint selected_object_index = 0;
         DCoordinate3 _t;
         DCoordinate3 der1;
@@ -826,6 +1015,8 @@ namespace cagd
 
     void GLWidget::_animate1()
     {
+        CAGD_PROFILE_ZONE("GLWidget::_animate1");
+
         GLuint selected_object_index = 1;
         DCoordinate3 _t;
         DCoordinate3 der1;
@@ -908,6 +1099,8 @@ namespace cagd
 
     void GLWidget::_animate2()
     {
+        CAGD_PROFILE_ZONE("GLWidget::_animate2");
+
         GLuint selected_object_index = 2;
         DCoordinate3 _t;
         DCoordinate3 der1;
@@ -990,6 +1183,8 @@ namespace cagd
 
     void GLWidget::_animate3()
     {
+        CAGD_PROFILE_ZONE("GLWidget::_animate3");
+
         GLuint selected_object_index = 3;
         DCoordinate3 _t;
         DCoordinate3 der1;
@@ -1072,96 +1267,96 @@ namespace cagd
 
     void GLWidget::_animatePassanger0()
     {
+        CAGD_PROFILE_ZONE("GLWidget::_animatePassanger0");
+
         GLuint selected_object_index = 0;
         GLuint model_index = _race_moving_scene[selected_object_index].id + 1;
 
-        GLfloat *vertex = _race_moving_models[model_index].MapVertexBuffer(GL_READ_WRITE);
-        GLfloat *normal = _race_moving_models[model_index].MapNormalBuffer(GL_READ_ONLY);
+        // the model may not be loaded yet
+        TriangulatedMesh3 *model = _race_moving_models[model_index];
+        if (!model)
+        {
+            update();
+            return;
+        }
 
         _angles[selected_object_index] += DEG_TO_RADIAN;
         if (_angles[selected_object_index] >= TWO_PI)
                 _angles[selected_object_index] -= TWO_PI;
 
-        GLfloat scale = sin(_angles[selected_object_index]) / 3000.0;
-        for (GLuint i = 0; i < _race_moving_models[model_index].VertexCount(); ++i)
-        {
-            for (GLuint coordinate = 0; coordinate < 3; ++coordinate, ++vertex, ++normal)
-                *vertex += scale * (*normal);
-        }
-        _race_moving_models[model_index].UnmapVertexBuffer();
-        _race_moving_models[model_index].UnmapNormalBuffer();
+        _displaceRaceModel(model, sin(_angles[selected_object_index]) / 3000.0);
 
         update();
     }
 
     void GLWidget::_animatePassanger1()
     {
+        CAGD_PROFILE_ZONE("GLWidget::_animatePassanger1");
+
         GLuint selected_object_index = 1;
         GLuint model_index = _race_moving_scene[selected_object_index].id + 1;
 
-        GLfloat *vertex = _race_moving_models[model_index].MapVertexBuffer(GL_READ_WRITE);
-        GLfloat *normal = _race_moving_models[model_index].MapNormalBuffer(GL_READ_ONLY);
+        // the model may not be loaded yet
+        TriangulatedMesh3 *model = _race_moving_models[model_index];
+        if (!model)
+        {
+            update();
+            return;
+        }
 
         _angles[selected_object_index] += DEG_TO_RADIAN;
         if (_angles[selected_object_index] >= TWO_PI)
                 _angles[selected_object_index] -= TWO_PI;
 
-        GLfloat scale = sin(_angles[selected_object_index]) / 3000.0;
-        for (GLuint i = 0; i < _race_moving_models[model_index].VertexCount(); ++i)
-        {
-            for (GLuint coordinate = 0; coordinate < 3; ++coordinate, ++vertex, ++normal)
-                *vertex += scale * (*normal);
-        }
-        _race_moving_models[model_index].UnmapVertexBuffer();
-        _race_moving_models[model_index].UnmapNormalBuffer();
+        _displaceRaceModel(model, sin(_angles[selected_object_index]) / 3000.0);
 
         update();
     }
 
     void GLWidget::_animatePassanger2()
     {
+        CAGD_PROFILE_ZONE("GLWidget::_animatePassanger2");
+
         GLuint selected_object_index = 2;
         GLuint model_index = _race_moving_scene[selected_object_index].id + 1;
 
-        GLfloat *vertex = _race_moving_models[model_index].MapVertexBuffer(GL_READ_WRITE);
-        GLfloat *normal = _race_moving_models[model_index].MapNormalBuffer(GL_READ_ONLY);
+        // the model may not be loaded yet
+        TriangulatedMesh3 *model = _race_moving_models[model_index];
+        if (!model)
+        {
+            update();
+            return;
+        }
 
         _angles[selected_object_index] += DEG_TO_RADIAN;
         if (_angles[selected_object_index] >= TWO_PI)
                 _angles[selected_object_index] -= TWO_PI;
 
-        GLfloat scale = sin(_angles[selected_object_index]) / 3000.0;
-        for (GLuint i = 0; i < _race_moving_models[model_index].VertexCount(); ++i)
-        {
-            for (GLuint coordinate = 0; coordinate < 3; ++coordinate, ++vertex, ++normal)
-                *vertex += scale * (*normal);
-        }
-        _race_moving_models[model_index].UnmapVertexBuffer();
-        _race_moving_models[model_index].UnmapNormalBuffer();
+        _displaceRaceModel(model, sin(_angles[selected_object_index]) / 3000.0);
 
         update();
     }
 
     void GLWidget::_animatePassanger3()
     {
+        CAGD_PROFILE_ZONE("GLWidget::_animatePassanger3");
+
         GLuint selected_object_index = 3;
         GLuint model_index = _race_moving_scene[selected_object_index].id + 1;
 
-        GLfloat *vertex = _race_moving_models[model_index].MapVertexBuffer(GL_READ_WRITE);
-        GLfloat *normal = _race_moving_models[model_index].MapNormalBuffer(GL_READ_ONLY);
+        // the model may not be loaded yet
+        TriangulatedMesh3 *model = _race_moving_models[model_index];
+        if (!model)
+        {
+            update();
+            return;
+        }
 
         _angles[selected_object_index] += DEG_TO_RADIAN;
         if (_angles[selected_object_index] >= TWO_PI)
                 _angles[selected_object_index] -= TWO_PI;
 
-        GLfloat scale = sin(_angles[selected_object_index]) / 3000.0;
-        for (GLuint i = 0; i < _race_moving_models[model_index].VertexCount(); ++i)
-        {
-            for (GLuint coordinate = 0; coordinate < 3; ++coordinate, ++vertex, ++normal)
-                *vertex += scale * (*normal);
-        }
-        _race_moving_models[model_index].UnmapVertexBuffer();
-        _race_moving_models[model_index].UnmapNormalBuffer();
+        _displaceRaceModel(model, sin(_angles[selected_object_index]) / 3000.0);
 
         update();
     }
@@ -1169,6 +1364,8 @@ namespace cagd
     // Surface
     void GLWidget::_animateSurface()
     {
+        CAGD_PROFILE_ZONE("GLWidget::_animateSurface");
+
         if (_ps_selected_surface_index < _psc_count)
         {
             DCoordinate3 point;
@@ -1656,19 +1853,8 @@ namespace cagd
     {
         if (_shader_intensity != value)
         {
-            _shaders[_shader_index].Enable();
             _shader_intensity = value;
-            if (_shader_index == 2)
-            {
-                _shaders[_shader_index].SetUniformVariable4f("default_outline_color", _shader_scale, _shader_shading, _shader_smoothing, _shader_intensity);
-            }
-            if (_shader_index == 3)
-            {
-                _shaders[_shader_index].SetUniformVariable1f("scale_factor", _shader_scale);
-                _shaders[_shader_index].SetUniformVariable1f("smoothing", _shader_smoothing);
-                _shaders[_shader_index].SetUniformVariable1f("shading", _shader_shading);
-            }
-            _shaders[_shader_index].Disable();
+            _updateShaderUniforms();
             update();
         }
     }
@@ -1677,19 +1863,8 @@ namespace cagd
     {
         if (_shader_scale != value)
         {
-            _shaders[_shader_index].Enable();
             _shader_scale = value;
-            if (_shader_index == 2)
-            {
-                _shaders[_shader_index].SetUniformVariable4f("default_outline_color", _shader_scale, _shader_shading, _shader_smoothing, _shader_intensity);
-            }
-            if (_shader_index == 3)
-            {
-                _shaders[_shader_index].SetUniformVariable1f("scale_factor", _shader_scale);
-                _shaders[_shader_index].SetUniformVariable1f("smoothing", _shader_smoothing);
-                _shaders[_shader_index].SetUniformVariable1f("shading", _shader_shading);
-            }
-            _shaders[_shader_index].Disable();
+            _updateShaderUniforms();
             update();
         }
     }
@@ -1698,19 +1873,8 @@ namespace cagd
     {
         if (_shader_shading != value)
         {
-            _shaders[_shader_index].Enable();
             _shader_shading = value;
-            if (_shader_index == 2)
-            {
-                _shaders[_shader_index].SetUniformVariable4f("default_outline_color", _shader_scale, _shader_shading, _shader_smoothing, _shader_intensity);
-            }
-            if (_shader_index == 3)
-            {
-                _shaders[_shader_index].SetUniformVariable1f("scale_factor", _shader_scale);
-                _shaders[_shader_index].SetUniformVariable1f("smoothing", _shader_smoothing);
-                _shaders[_shader_index].SetUniformVariable1f("shading", _shader_shading);
-            }
-            _shaders[_shader_index].Disable();
+            _updateShaderUniforms();
             update();
         }
     }
@@ -1719,19 +1883,8 @@ namespace cagd
     {
         if (_shader_smoothing != value)
         {
-            _shaders[_shader_index].Enable();
             _shader_smoothing = value;
-            if (_shader_index == 2)
-            {
-                _shaders[_shader_index].SetUniformVariable4f("default_outline_color", _shader_scale, _shader_shading, _shader_smoothing, _shader_intensity);
-            }
-            if (_shader_index == 3)
-            {
-                _shaders[_shader_index].SetUniformVariable1f("scale_factor", _shader_scale);
-                _shaders[_shader_index].SetUniformVariable1f("smoothing", _shader_smoothing);
-                _shaders[_shader_index].SetUniformVariable1f("shading", _shader_shading);
-            }
-            _shaders[_shader_index].Disable();
+            _updateShaderUniforms();
             update();
         }
     }
@@ -2276,38 +2429,291 @@ namespace cagd
         _race_moving_scene.ResizeColumns(_moving_object_count);
     }
 
+    // the model-view matrix of the object is the current one multiplied by the optional transformation of its
+    // vehicle and by the transformations of its scene file entry
+    void GLWidget::_queueRaceObject(const ModelProperties &object, const TriangulatedMesh3 *model, const GLdouble *transformation)
+    {
+        if (!model)
+        {
+            return;
+        }
+
+        GLdouble model_view[16];
+
+        glPushMatrix();
+            if (transformation)
+            {
+                glMultMatrixd(transformation);
+            }
+
+            glRotated(object.angle1[0], 1.0, 0.0, 0.0);
+            glRotated(object.angle1[1], 0.0, 1.0, 0.0);
+            glRotated(object.angle1[2], 0.0, 0.0, 1.0);
+
+            glTranslated(object.position[0], object.position[1], object.position[2]);
+
+            glRotated(object.angle2[0], 1.0, 0.0, 0.0);
+            glRotated(object.angle2[1], 0.0, 1.0, 0.0);
+            glRotated(object.angle2[2], 0.0, 0.0, 1.0);
+
+            glScaled(object.scale[0], object.scale[1], object.scale[2]);
+
+            glGetDoublev(GL_MODELVIEW_MATRIX, model_view);
+        glPopMatrix();
+
+        Material *material = (object.material_id >= 0) ? &_race_object_materials[object.material_id] : nullptr;
+
+        _race_render_queue.Push(model, model_view, material, Color4(object.color[0], object.color[1], object.color[2]),
+                                _shader_do_shader ? &_shaders[_shader_index] : nullptr);
+    }
+
     bool GLWidget::_getModels()
     {
+        _releaseModels();
+
         _moving_model_count = (GLuint)_moving_model_paths.size();
         _static_model_count = (GLuint)_static_model_paths.size();
         _race_moving_models.ResizeColumns(_moving_model_count);
         _race_static_models.ResizeColumns(_static_model_count);
 
-        for (GLuint i = 0; i < _moving_model_count; i++)
+        // the indices of the static models follow the ones of the moving models; models that are already
+        // registered (e.g. by a previous scene variant) are reused at once, while each of the other files
+        // is loaded by a single job, even if it is listed several times
+        std::vector<MeshLoader::Job> jobs;
+        std::map<std::string, GLuint> job_of_path;
+
+        for (GLuint i = 0; i < _moving_model_count + _static_model_count; i++)
         {
-            if (_race_moving_models[i].LoadFromOFF(_moving_model_paths[i], GL_TRUE))
+            const std::string &path = (i < _moving_model_count) ?
+                                      _moving_model_paths[i] : _static_model_paths[i - _moving_model_count];
+
+            TriangulatedMesh3 *model = _mesh_registry.AcquireIfRegistered(path, GL_TRUE);
+
+            if (model)
             {
-                if(!_race_moving_models[i].UpdateVertexBufferObjects())
+                if (!model->HasVertexBufferObjects() && !model->UpdateVertexBufferObjects())
                 {
-                    throw Exception("Exception: Could not load moving model");
+                    _mesh_registry.Release(model);
+                    throw Exception("Exception: Could not load model");
                     return GL_FALSE;
                 }
+
+                _setRaceModel(i, model);
+                continue;
             }
+
+            std::map<std::string, GLuint>::iterator job = job_of_path.find(path);
+
+            if (job == job_of_path.end())
+            {
+                job = job_of_path.insert(std::make_pair(path, (GLuint)jobs.size())).first;
+                jobs.push_back(MeshLoader::Job((GLuint)jobs.size(), path, GL_TRUE));
+                _race_model_slots.push_back(std::vector<GLuint>());
+            }
+
+            _race_model_slots[job->second].push_back(i);
         }
 
-        for (GLuint i = 0; i < _static_model_count; i++)
+        // meshes that are not loaded yet are not rendered
+        _race_model_loader = new (nothrow) MeshLoader(jobs);
+
+        if (!_race_model_loader)
+        {
+            throw Exception("Exception: Could not create model loader");
+            return GL_FALSE;
+        }
+
+        return GL_TRUE;
+    }
+
+    void GLWidget::_uploadLoadedModels()
+    {
+        if (!_race_model_loader)
+        {
+            return;
+        }
+
+        // the state is queried before taking the meshes, otherwise a mesh published in between could be lost
+        bool loading_finished = _race_model_loader->IsFinished();
+
+        _race_model_loader->TakeLoadedMeshes(_race_loaded_models);
+
+        // at least one model is uploaded per frame
+        QElapsedTimer frame_clock;
+        frame_clock.start();
+
+        GLuint uploaded_count = 0;
+
+        while (uploaded_count < _race_loaded_models.size() &&
+               (!uploaded_count || frame_clock.nsecsElapsed() < 1.0e6 * _race_model_upload_budget))
         {
-            if (_race_static_models[i].LoadFromOFF(_static_model_paths[i], GL_TRUE))
+            MeshLoader::LoadedMesh *loaded = _race_loaded_models[uploaded_count++];
+
+            // the registry returns the already registered mesh if another file has the same content
+            TriangulatedMesh3 *model = loaded->success ?
+                                       _mesh_registry.Register(loaded->identity, GL_TRUE, std::move(loaded->mesh)) :
+                                       nullptr;
+
+            // a mesh that is already pooled by another slot does not need its own buffers
+            if (model && !model->HasVertexBufferObjects() && !_race_vertex_pool.Find(model) &&
+                !model->UpdateVertexBufferObjects())
+            {
+                cout << "Exception: Could not update the vertex buffer objects of " << loaded->file_name << endl;
+            }
+
+            const std::vector<GLuint> &slots = _race_model_slots[loaded->id];
+
+            for (GLuint j = 0; model && j < slots.size(); j++)
             {
-                if(!_race_static_models[i].UpdateVertexBufferObjects())
+                // the registration has already acquired the first reference
+                if (j)
                 {
-                    throw Exception("Exception: Could not load static model");
-                    return GL_FALSE;
+                    _mesh_registry.AddReference(model);
                 }
+
+                _setRaceModel(slots[j], model);
             }
+
+            delete loaded;
         }
 
-        return GL_TRUE;
+        _race_loaded_models.erase(_race_loaded_models.begin(), _race_loaded_models.begin() + uploaded_count);
+
+        if (loading_finished && _race_loaded_models.empty())
+        {
+            cout << "Race scene completed in " << _race_loading_clock.elapsed() << " ms ("
+                 << _race_model_loader->JobCount() << " models loaded by "
+                 << _race_model_loader->ThreadCount() << " threads, "
+                 << _mesh_registry.MeshCount() << " distinct meshes, "
+                 << (_mesh_registry.MemoryUsage() >> 20) << " MB)" << endl;
+
+            _destroyModelLoader();
+        }
+        else
+        {
+            // the next frame continues uploading even if nothing else is animated
+            update();
+        }
+    }
+
+    // The given model is a referenced mesh of the registry. The static models share it, while the moving models
+    // are animated in place by _animatePassanger*, therefore each of them gets a private copy (including its
+    // vertex buffer objects) and the reference is released at once. Both kinds of models are pooled at once.
+    void GLWidget::_setRaceModel(GLuint index, TriangulatedMesh3 *model)
+    {
+        if (index >= _moving_model_count)
+        {
+            _race_static_models[index - _moving_model_count] = model;
+            _poolRaceModel(model);
+            return;
+        }
+
+        TriangulatedMesh3 *copy = new (nothrow) TriangulatedMesh3(*model);
+        // the source has no buffers if it is a static model pooled by another slot, the copy needs its own ones
+        bool copy_failed = !copy || (!copy->HasVertexBufferObjects() && !copy->UpdateVertexBufferObjects());
+
+        // the released mesh may be evicted, i.e., it must not be accessed afterwards
+        _mesh_registry.Release(model);
+
+        if (copy_failed)
+        {
+            delete copy;
+            cout << "Exception: Could not copy the moving model " << index << endl;
+            return;
+        }
+
+        _race_moving_models[index] = copy;
+        _poolRaceModel(copy);
+    }
+
+    // The model is copied into the vertex pool, then its own vertex buffer objects are deleted, i.e., its
+    // geometry is stored only once on the GPU. (A static mesh keeps only its host-side geometry in the registry,
+    // its buffers are updated again if a later scene acquires it.) If the pool is not supported, the model keeps
+    // its vertex buffer objects and it is drawn by them.
+    void GLWidget::_poolRaceModel(TriangulatedMesh3 *model)
+    {
+        if (!VertexPool::IsSupported())
+        {
+            return;
+        }
+
+        // a shared static model may have been pooled by another slot
+        if (_race_vertex_pool.Find(model) || _race_vertex_pool.Add(*model))
+        {
+            model->DeleteVertexBufferObjects();
+        }
+    }
+
+    // the vertices of a moving model are displaced along its unit normal vectors, pooled models do not have
+    // vertex buffer objects of their own, therefore their ranges are mapped in the pool
+    void GLWidget::_displaceRaceModel(const TriangulatedMesh3 *model, GLfloat scale)
+    {
+        bool pooled = (_race_vertex_pool.Find(model) != nullptr);
+
+        GLfloat *vertex = pooled ? _race_vertex_pool.MapVertexRange(model, GL_READ_WRITE) : model->MapVertexBuffer(GL_READ_WRITE);
+        GLfloat *normal = pooled ? _race_vertex_pool.MapNormalRange(model, GL_READ_ONLY) : model->MapNormalBuffer(GL_READ_ONLY);
+
+        if (vertex && normal)
+        {
+            for (GLuint i = 0; i < model->VertexCount(); ++i)
+            {
+                for (GLuint coordinate = 0; coordinate < 3; ++coordinate, ++vertex, ++normal)
+                    *vertex += scale * (*normal);
+            }
+        }
+
+        if (pooled)
+        {
+            if (vertex) _race_vertex_pool.UnmapVertexBuffer();
+            if (normal) _race_vertex_pool.UnmapNormalBuffer();
+        }
+        else
+        {
+            if (vertex) model->UnmapVertexBuffer();
+            if (normal) model->UnmapNormalBuffer();
+        }
+    }
+
+    void GLWidget::_destroyModelLoader()
+    {
+        if (_race_model_loader)
+        {
+            delete _race_model_loader; _race_model_loader = nullptr;
+        }
+
+        for (GLuint i = 0; i < _race_loaded_models.size(); i++)
+        {
+            delete _race_loaded_models[i];
+        }
+        _race_loaded_models.clear();
+        _race_model_slots.clear();
+    }
+
+    void GLWidget::_releaseModels()
+    {
+        _destroyModelLoader();
+
+        // the pooled ranges are not valid after releasing the models (the released static models keep only their
+        // host-side geometry, their vertex buffer objects have been deleted by _poolRaceModel)
+        _race_vertex_pool.Clear();
+
+        // the private copies of the moving models are deleted, while the released static models remain cached by
+        // the registry as long as its memory budget allows
+        for (GLuint i = 0; i < _race_moving_models.GetColumnCount(); i++)
+        {
+            if (_race_moving_models[i])
+            {
+                delete _race_moving_models[i]; _race_moving_models[i] = nullptr;
+            }
+        }
+
+        for (GLuint i = 0; i < _race_static_models.GetColumnCount(); i++)
+        {
+            if (_race_static_models[i])
+            {
+                _mesh_registry.Release(_race_static_models[i]); _race_static_models[i] = nullptr;
+            }
+        }
     }
 
     bool GLWidget::_getScene()
@@ -2409,6 +2815,49 @@ namespace cagd
         return GL_TRUE;
     }
 
+    void GLWidget::set_animation_timers_enabled(bool value)
+    {
+        QTimer *timers[] = {_timer0, _timer1, _timer2, _timer3, _timer4, _timer5, _timer6, _timer7, _surfaceTimer};
+
+        for (GLuint i = 0; i < sizeof(timers) / sizeof(timers[0]); i++)
+        {
+            if (value)
+            {
+                timers[i]->start();
+            }
+            else
+            {
+                timers[i]->stop();
+            }
+        }
+    }
+
+    // the passanger animations modify vertex buffer objects, i.e., the rendering context has to be current
+    void GLWidget::advance_animations()
+    {
+        _animate0();
+        _animate1();
+        _animate2();
+        _animate3();
+
+        _animatePassanger0();
+        _animatePassanger1();
+        _animatePassanger2();
+        _animatePassanger3();
+
+        _animateSurface();
+    }
+
+    bool GLWidget::is_race_scene_loaded() const
+    {
+        return !_race_model_loader;
+    }
+
+    const RenderQueue::Statistics& GLWidget::get_race_render_statistics() const
+    {
+        return _race_render_queue.LastStatistics();
+    }
+
 
     //-----------
     // Surfaces
@@ -2440,6 +2889,9 @@ namespace cagd
 
         GLdouble tmp_umin = 0, tmp_umax = 0, tmp_vmin = 0, tmp_vmax = 0;
 
+        // the fused evaluators calculate the point and the partial derivatives in a single call
+        ParametricSurface3::FusedPartialDerivatives tmp_fused = nullptr;
+
         GLuint ps_iter = 0;
         while (ps_iter < _ps_count)
         {
@@ -2453,6 +2905,7 @@ namespace cagd
                 _ps_derivatives[ps_iter](0, 0) = torusSurface::d00;
                 _ps_derivatives[ps_iter](1, 0) = torusSurface::d10;
                 _ps_derivatives[ps_iter](1, 1) = torusSurface::d01;
+                tmp_fused = torusSurface::fused;
                 break;
             case 1:
                 tmp_umin = sphere::u_min;
@@ -2462,6 +2915,7 @@ namespace cagd
                 _ps_derivatives[ps_iter](0, 0) = sphere::d00;
                 _ps_derivatives[ps_iter](1, 0) = sphere::d10;
                 _ps_derivatives[ps_iter](1, 1) = sphere::d01;
+                tmp_fused = sphere::fused;
                 break;
             case 2:
                 tmp_umin = hyperboloid::u_min;
@@ -2471,6 +2925,7 @@ namespace cagd
                 _ps_derivatives[ps_iter](0, 0) = hyperboloid::d00;
                 _ps_derivatives[ps_iter](1, 0) = hyperboloid::d10;
                 _ps_derivatives[ps_iter](1, 1) = hyperboloid::d01;
+                tmp_fused = hyperboloid::fused;
                 break;
             case 3:
                 tmp_umin = plane::u_min;
@@ -2480,6 +2935,7 @@ namespace cagd
                 _ps_derivatives[ps_iter](0, 0) = plane::d00;
                 _ps_derivatives[ps_iter](1, 0) = plane::d10;
                 _ps_derivatives[ps_iter](1, 1) = plane::d01;
+                tmp_fused = plane::fused;
                 break;
             case 4:
                 tmp_umin = cone::u_min;
@@ -2489,6 +2945,7 @@ namespace cagd
                 _ps_derivatives[ps_iter](0, 0) = cone::d00;
                 _ps_derivatives[ps_iter](1, 0) = cone::d10;
                 _ps_derivatives[ps_iter](1, 1) = cone::d01;
+                tmp_fused = cone::fused;
                 break;
             case 5:
                 tmp_umin = cylinder::u_min;
@@ -2498,6 +2955,7 @@ namespace cagd
                 _ps_derivatives[ps_iter](0, 0) = cylinder::d00;
                 _ps_derivatives[ps_iter](1, 0) = cylinder::d10;
                 _ps_derivatives[ps_iter](1, 1) = cylinder::d01;
+                tmp_fused = cylinder::fused;
                 break;
             }
 
@@ -2505,7 +2963,7 @@ namespace cagd
             _ps_umaxs[ps_iter] = tmp_umax;
             _ps_vmins[ps_iter] = tmp_vmin;
             _ps_vmaxs[ps_iter] = tmp_vmax;
-            _pss[ps_iter] = new (nothrow) ParametricSurface3(_ps_derivatives[ps_iter], tmp_umin, tmp_umax, tmp_vmin, tmp_vmax);
+            _pss[ps_iter] = new (nothrow) ParametricSurface3(_ps_derivatives[ps_iter], tmp_umin, tmp_umax, tmp_vmin, tmp_vmax, tmp_fused);
 
             if (!_pss[ps_iter])
             {
@@ -2519,10 +2977,18 @@ namespace cagd
             }
         }
 
-        // Loading da rat
-        if (_surface_rat_model.LoadFromOFF("../Models/Characters/mouse.off", GL_TRUE))
+        // Loading da rat (it is also a moving model of the race, but the race animates private copies of its
+        // moving models, therefore the shared mesh is not deformed)
+        if (_surface_rat_model)
+        {
+            _mesh_registry.Release(_surface_rat_model); _surface_rat_model = nullptr;
+        }
+
+        _surface_rat_model = _mesh_registry.Acquire("../Models/Characters/mouse.off", GL_TRUE);
+
+        if (_surface_rat_model && !_surface_rat_model->HasVertexBufferObjects())
         {
-            if(!_surface_rat_model.UpdateVertexBufferObjects())
+            if(!_surface_rat_model->UpdateVertexBufferObjects())
             {
                 throw Exception("Exception: Could not load da rat model");
                 return;
@@ -2707,10 +3173,8 @@ namespace cagd
             for (GLuint j = 0; j < 4; j++)
                 _patch.SetData(i, j, _patch_data[i][j][0], _patch_data[i][j][1], _patch_data[i][j][2]);
 
-        _patch_before_interpolation = _patch.GenerateImage(_patch_udiv_point_count, _patch_vdiv_point_count, _patch_usage_flag);
-
-        if (_patch_before_interpolation)
-            _patch_before_interpolation->UpdateVertexBufferObjects();
+        // the patch images are only rendered, thus their data is written directly into the vertex buffer objects
+        _patch_before_interpolation = _patch.GenerateRenderOnlyImage(_patch_udiv_point_count, _patch_vdiv_point_count, _patch_usage_flag);
 
         // Define interpolation problem
         // 1: create knot-vector in dir. u
@@ -2762,10 +3226,7 @@ namespace cagd
         // 4: solve the problem, generate mesh of interpolating patch
         if (_patch.UpdateDataForInterpolation(u_knot_vector, v_knot_vector, data_points_to_interpolate))
         {
-            _patch_after_interpolation = _patch.GenerateImage(_patch_udiv_point_count, _patch_vdiv_point_count, _patch_usage_flag);
-
-            if (_patch_after_interpolation)
-                _patch_after_interpolation->UpdateVertexBufferObjects();
+            _patch_after_interpolation = _patch.GenerateRenderOnlyImage(_patch_udiv_point_count, _patch_vdiv_point_count, _patch_usage_flag);
         }
 
         // After interpolation
@@ -2836,6 +3297,17 @@ namespace cagd
     {
         _shaders.ResizeColumns(4);
 
+        // the linked programs are cached per user, the sources are compiled only if they (or the driver) change
+        QString binary_cache_directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/shaders";
+
+        if (QDir().mkpath(binary_cache_directory))
+        {
+            for (GLuint i = 0; i < _shaders.GetColumnCount(); i++)
+            {
+                _shaders[i].SetBinaryCacheDirectory(binary_cache_directory.toStdString());
+            }
+        }
+
         try
         {
             if (!_shaders[0].InstallShaders("../Shaders/directional_light.vert", "../Shaders/directional_light.frag", GL_TRUE))
@@ -2850,32 +3322,141 @@ namespace cagd
             {
                 throw Exception("Could not install shaders");
             } else {
-                _shaders[2].Enable();
-                _shaders[2].SetUniformVariable4f("default_outline_color", _shader_scale, _shader_smoothing, _shader_shading, _shader_intensity);
-                _shaders[2].Disable();
+                _shader_outline_color = _shaders[2].GetUniform("default_outline_color");
             }
             if (!_shaders[3].InstallShaders("../Shaders/reflection_lines.vert", "../Shaders/reflection_lines.frag", GL_TRUE))
             {
                 throw Exception("Could not install shaders");
             } else {
-                _shaders[3].Enable();
-                _shaders[3].SetUniformVariable1f("scale_factor", _shader_scale);
-                _shaders[3].SetUniformVariable1f("smoothing", _shader_smoothing);
-                _shaders[3].SetUniformVariable1f("shading", _shader_shading);
-                _shaders[3].Disable();
+                _shader_scale_factor     = _shaders[3].GetUniform("scale_factor");
+                _shader_smoothing_factor = _shaders[3].GetUniform("smoothing");
+                _shader_shading_factor   = _shaders[3].GetUniform("shading");
             }
+
+            _updateShaderUniforms();
         }
         catch (Exception &e)
         {
             cerr << e << endl;
         }
+
+        // the race scene is submitted by a single indirect multi-draw call if the fixed-function pipeline is
+        // selected and OpenGL 4.3 is available, otherwise its pooled meshes are drawn one by one
+        _race_multi_draw_shader.SetBinaryCacheDirectory(binary_cache_directory.toStdString());
+        _race_multi_draw_is_enabled = RenderQueue::IsMultiDrawSupported() &&
+                                      _race_multi_draw_shader.InstallShaders("../Shaders/race_multi_draw.vert",
+                                                                             "../Shaders/race_multi_draw.frag");
+
+        cout << "Race scene rendering: " << (_race_multi_draw_is_enabled ? "multi-draw indirect" :
+                                             (VertexPool::IsSupported() ? "vertex pool" : "separate vertex buffer objects"))
+             << endl;
+    }
+
+    // the values are staged by both programs (independently of the selected one) and they are uploaded
+    // in a single batch when the program is enabled by paintGL for the next time
+    void GLWidget::_updateShaderUniforms()
+    {
+        if (_shaders.GetColumnCount() < 4)
+        {
+            return;
+        }
+
+        GLfloat outline_color[4] = {_shader_scale, _shader_shading, _shader_smoothing, _shader_intensity};
+
+        _shaders[2].SetUniformValues(_shader_outline_color, 1, outline_color);
+
+        _shaders[3].SetUniformValue(_shader_scale_factor, _shader_scale);
+        _shaders[3].SetUniformValue(_shader_smoothing_factor, _shader_smoothing);
+        _shaders[3].SetUniformValue(_shader_shading_factor, _shader_shading);
     }
 
+#if defined(CAGD_PROFILING)
+    // the statistics are refreshed twice per second, the text is drawn by a QPainter over the rendered frame
+    void GLWidget::_renderProfilerOverlay()
+    {
+        if (_profiler_statistics.empty() || _profiler_overlay_clock.elapsed() >= 500)
+        {
+            Profiler::Instance().CalculateStatistics(_profiler_statistics);
+            _profiler_overlay_clock.restart();
+        }
+
+        QString text = QString("%1 %2 %3 %4 %5\n")
+                .arg("zone", -48).arg("count", 6).arg("min [ms]", 10).arg("avg [ms]", 10).arg("p99 [ms]", 10);
+
+        for (GLuint i = 0; i < _profiler_statistics.size(); i++)
+        {
+            const Profiler::ZoneStatistics &zone = _profiler_statistics[i];
+
+            text += QString("%1 %2 %3 %4 %5\n")
+                    .arg(QString::fromStdString(zone.name), -48).arg(zone.sample_count, 6)
+                    .arg(zone.minimum, 10, 'f', 3).arg(zone.average, 10, 'f', 3).arg(zone.percentile_99, 10, 'f', 3);
+        }
+
+        // the painter modifies the OpenGL state, which is expected unchanged by the next frame
+        glPushAttrib(GL_ALL_ATTRIB_BITS);
+        glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS);
+
+        QPainter painter(this);
+
+        QFont font("Monospace", 9);
+        font.setStyleHint(QFont::TypeWriter);
+
+        painter.setFont(font);
+
+        QRect bounds = painter.boundingRect(rect().adjusted(8, 8, -8, -8), Qt::AlignLeft | Qt::AlignTop, text);
+
+        painter.fillRect(bounds.adjusted(-4, -4, 4, 4), QColor(0, 0, 0, 160));
+        painter.setPen(Qt::white);
+        painter.drawText(bounds, Qt::AlignLeft | Qt::AlignTop, text);
+        painter.end();
+
+        glPopClientAttrib();
+        glPopAttrib();
+    }
+
+    // the trace is written to the file given by the environment variable CAGD_PROFILER_TRACE, or into the
+    // cache directory of the application; it can be opened by chrome://tracing or by https://ui.perfetto.dev
+    void GLWidget::_exportProfilerTrace()
+    {
+        QString file_name = QString::fromLocal8Bit(qgetenv("CAGD_PROFILER_TRACE"));
+
+        if (file_name.isEmpty())
+        {
+            QString directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+
+            if (!QDir().mkpath(directory))
+            {
+                return;
+            }
+
+            file_name = directory + "/trace.json";
+        }
+
+        if (Profiler::Instance().ExportChromeTrace(file_name.toStdString()))
+        {
+            cout << "Profiler trace exported to " << file_name.toStdString() << endl;
+        }
+        else
+        {
+            cerr << "Could not export the profiler trace to " << file_name.toStdString() << endl;
+        }
+    }
+#endif
+
     //-----------
     // destructor
     //-----------
     GLWidget::~GLWidget()
     {
+#if defined(CAGD_PROFILING)
+        _exportProfilerTrace();
+#endif
+
+        _releaseModels();
+        if (_surface_rat_model)
+        {
+            _mesh_registry.Release(_surface_rat_model); _surface_rat_model = nullptr;
+        }
         _destroyAllExistingParametricCurves();
         _destroyAllExistingParametricCurvesImages();
         _destroyAllExistingObjects();
@@ -2915,5 +3496,6 @@ namespace cagd
         {
             delete _patch_after_interpolation, _patch_after_interpolation = nullptr;
         }
+        RenderBackend::Release();
     }
 }
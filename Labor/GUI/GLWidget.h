@@ -3,14 +3,22 @@
 #include <GL/glew.h>
 #include <QOpenGLWidget>
 #include <QOpenGLTexture>
+#include <QElapsedTimer>
 #include <Parametric/ParametricCurves3.h>
 #include <Parametric/ParametricSurfaces3.h>
 #include <Cyclic/CyclicCurves3.h>
 #include <Core/GenericCurves3.h>
 #include <Core/TriangulatedMeshes3.h>
-#include <Core/Materials.h>
-#include <Core/Lights.h>
-#include <Core/ShaderPrograms.h>
+#include <Core/MeshLoaders.h>
+#include <Core/MeshRegistries.h>
+#include <Core/Profilers.h>
+#include <GPU/GPUTimers.h>
+#include <GPU/Materials.h>
+#include <GPU/RenderBackends.h>
+#include <GPU/RenderQueues.h>
+#include <GPU/VertexPools.h>
+#include <GPU/Lights.h>
+#include <GPU/ShaderPrograms.h>
 #include <Trigonometric/SecondOrderTrigonometricPatch3.h>
 #include <Trigonometric/SecondOrderTrigonometricArc3.h>
 
@@ -63,6 +71,10 @@ namespace cagd
         // variables defining the model-view matrix
         double       _eye[3], _center[3], _up[3];
 
+        // column-major copies of the projection matrix and of the view matrix (the model-view matrix of gluLookAt),
+        // the core profile render backend gets the transformations from these instead of reading back the stack
+        double       _projection_matrix[16], _view_matrix[16];
+
         // variables needed by transformations
         int         _angle_x, _angle_y, _angle_z;
         double      _zoom;
@@ -71,6 +83,9 @@ namespace cagd
         // your other declarations
         GLuint      _selected_page = 0;
 
+        // the triangulated meshes loaded from OFF files are shared by the pages and by the scene variants
+        MeshRegistry    _mesh_registry;
+
         QTimer          *_timer0;
         QTimer          *_timer1;
         QTimer          *_timer2;
@@ -131,9 +146,9 @@ namespace cagd
             DirectionalLight                        *_dirLightRace = nullptr;
             Material                                _race_object_materials[6]{MatFBBrass, MatFBSilver, MatFBGold,
                                                                               MatFBEmerald, MatFBPearl, MatFBTurquoise};
-            RowMatrix<TriangulatedMesh3>            _race_static_models;
+            RowMatrix<TriangulatedMesh3*>           _race_static_models;   // shared by the _mesh_registry
             RowMatrix<ModelProperties>              _race_static_scene;
-            RowMatrix<TriangulatedMesh3>            _race_moving_models;
+            RowMatrix<TriangulatedMesh3*>           _race_moving_models;   // private copies, animated in place
             RowMatrix<ModelProperties>              _race_moving_scene;
             GLuint                                  _static_model_count = 0;
             GLuint                                  _static_object_count = 0;
@@ -185,10 +200,35 @@ namespace cagd
             void _destroyAllExistingInterpolatingCyclicCurves();
             void _destroyAllExistingInterpolatingCyclicCurvesImages();
 
+            // the models are parsed by the worker threads of the loader, while their vertex buffer objects are
+            // updated by paintGL within a time budget per frame, i.e., the scene is filled in progressively
+            MeshLoader                              *_race_model_loader = nullptr;
+            std::vector<MeshLoader::LoadedMesh*>    _race_loaded_models;                // not uploaded yet
+            std::vector<std::vector<GLuint> >       _race_model_slots;                  // model indices of each job
+            GLdouble                                _race_model_upload_budget = 4.0;    // in milliseconds
+            QElapsedTimer                           _race_loading_clock;
+            bool                                    _race_first_frame_reported = false;
+
+            // the objects of the race are rendered sorted by their states, the statistics of the last
+            // frame are returned by get_race_render_statistics
+            RenderQueue                             _race_render_queue;
+
+            // the meshes of the race share a single set of buffer objects, they do not keep their own ones
+            VertexPool                              _race_vertex_pool;
+            ShaderProgram                           _race_multi_draw_shader;
+            bool                                    _race_multi_draw_is_enabled = false;
+
             void _createRaceObjects();
             void _destroyAllExistingObjects();
             bool _getModels();
             bool _getScene();
+            void _queueRaceObject(const ModelProperties &object, const TriangulatedMesh3 *model, const GLdouble *transformation);
+            void _uploadLoadedModels();
+            void _setRaceModel(GLuint index, TriangulatedMesh3 *model);
+            void _poolRaceModel(TriangulatedMesh3 *model);
+            void _displaceRaceModel(const TriangulatedMesh3 *model, GLfloat scale);
+            void _destroyModelLoader();
+            void _releaseModels();
 
 
         // Surfaces;
@@ -204,7 +244,7 @@ namespace cagd
             RowMatrix<GLuint>           _surface_selected_texture;
             RowMatrix<QString>          _surface_texture_paths;
             RowMatrix<QOpenGLTexture*>  _surface_textures;
-            TriangulatedMesh3           _surface_rat_model;
+            TriangulatedMesh3           *_surface_rat_model = nullptr;  // shared by the _mesh_registry
 
             RowMatrix<TriangularMatrix<ParametricSurface3::PartialDerivative>>      _ps_derivatives;
             bool                                                                    _ps_do_texture = true;
@@ -325,7 +365,28 @@ namespace cagd
             GLfloat                     _shader_smoothing   = 1.0f;
             GLfloat                     _shader_shading     = 1.0f;
 
+            // handles of the uniform variables of the toon and reflection lines shaders
+            ShaderProgram::Uniform      _shader_outline_color;
+            ShaderProgram::Uniform      _shader_scale_factor;
+            ShaderProgram::Uniform      _shader_smoothing_factor;
+            ShaderProgram::Uniform      _shader_shading_factor;
+
             void                _getShaders();
+            void                _updateShaderUniforms();
+
+#if defined(CAGD_PROFILING)
+        // Profiler
+            // the GPU time of the frames is measured by timer queries, the rolling statistics of the zones
+            // are shown by an overlay if the environment variable CAGD_PROFILER_OVERLAY is set, and the
+            // recorded events are exported as a Chrome trace by the destructor
+            GPUTimer                                _profiler_gpu_frame_timer;
+            bool                                    _profiler_overlay_is_visible = false;
+            QElapsedTimer                           _profiler_overlay_clock;
+            std::vector<Profiler::ZoneStatistics>   _profiler_statistics;
+
+            void                _renderProfilerOverlay();
+            void                _exportProfilerTrace();
+#endif
 
     public:
         // special and default constructor
@@ -343,6 +404,13 @@ namespace cagd
         GLuint get_cc_count();
         GLuint get_ps_count();
 
+        // offscreen rendering (see ../RenderBenchmarks): if the animation timers are disabled, the animations
+        // are advanced only by explicit steps, i.e., the rendered frames depend only on the number of steps
+        void set_animation_timers_enabled(bool value);
+        void advance_animations();
+        bool is_race_scene_loaded() const;
+        const RenderQueue::Statistics& get_race_render_statistics() const;
+
         // destructor
         ~GLWidget();
 
@@ -25,6 +25,8 @@ DCoordinate3 ParametricCurve3::operator()(GLuint order, GLdouble u) const
 // generate image of the parametric curve
 GenericCurve3 *ParametricCurve3::GenerateImage(GLuint div_point_count, GLenum usage_flag) const
 {
+    CAGD_PROFILE_ZONE("ParametricCurve3::GenerateImage");
+
     GenericCurve3 *result = nullptr;
 
     result = new GenericCurve3(_derivatives.GetColumnCount() - 1, div_point_count, usage_flag);
@@ -3,6 +3,8 @@
 #include "../Core/DCoordinates3.h"
 #include "../Core/GenericCurves3.h"
 #include "../Core/Matrices.h"
+#include "../Core/Profilers.h"
+#include <algorithm>
 
 namespace cagd
 {
@@ -38,4 +40,107 @@ namespace cagd
         // set derivatives
         GLvoid SetDerivatives(const RowMatrix<Derivative>& derivatives);
     };
+
+    //---------------------------------
+    // template class ParametricCurve3T
+    //---------------------------------
+    // Functor-based variant of ParametricCurve3. The callable F has to provide the method
+    //
+    //     GLvoid operator ()(GLdouble u, DCoordinate3& d0, DCoordinate3& d1, DCoordinate3& d2) const;
+    //
+    // that evaluates the curve point and its first and second order derivatives in a single call.
+    // Since the type of the callable is known at compile time, its body can be inlined into the
+    // sampling loop and the subexpressions shared by the derivatives (e.g. sin(u), cos(u)) are
+    // calculated only once.
+    template <class F>
+    class ParametricCurve3T
+    {
+    protected:
+        // callable that evaluates the zeroth, first and second order derivatives
+        F        _f;
+
+        // definition domain
+        GLdouble _u_min, _u_max;
+
+    public:
+        // special constructor
+        ParametricCurve3T(const F& f, GLdouble u_min, GLdouble u_max);
+
+        // calculate derivative at the parameter value u
+        DCoordinate3 operator ()(GLuint order, GLdouble u) const;
+
+        // generate image/arc, the maximum order of derivatives is 2
+        GenericCurve3* GenerateImage(GLuint div_point_count, GLenum usage_flag = GL_STATIC_DRAW) const;
+
+        // set/get definition domain
+        GLvoid SetDefinitionDomain(GLdouble u_min, GLdouble u_max);
+        GLvoid GetDefinitionDomain(GLdouble& u_min, GLdouble& u_max) const;
+
+        // get the callable
+        const F& GetFunctor() const;
+    };
+
+    //---------------------------------------------------
+    // implementation of template class ParametricCurve3T
+    //---------------------------------------------------
+    template <class F>
+    ParametricCurve3T<F>::ParametricCurve3T(const F& f, GLdouble u_min, GLdouble u_max):
+        _f(f), _u_min(u_min), _u_max(u_max)
+    {
+    }
+
+    template <class F>
+    inline DCoordinate3 ParametricCurve3T<F>::operator ()(GLuint order, GLdouble u) const
+    {
+        DCoordinate3 d[3];
+
+        _f(u, d[0], d[1], d[2]);
+
+        return (order < 3) ? d[order] : DCoordinate3();
+    }
+
+    template <class F>
+    GenericCurve3* ParametricCurve3T<F>::GenerateImage(GLuint div_point_count, GLenum usage_flag) const
+    {
+        CAGD_PROFILE_ZONE("ParametricCurve3::GenerateImage");
+
+        if (div_point_count < 2)
+            return nullptr;
+
+        GenericCurve3 *result = new (std::nothrow) GenericCurve3(2, div_point_count, usage_flag);
+
+        if (!result)
+            return nullptr;
+
+        GLdouble u_step = (_u_max - _u_min) / (div_point_count - 1);
+
+        for (GLuint i = 0; i < div_point_count; ++i)
+        {
+            GLdouble u = std::min(_u_min + i * u_step, _u_max);
+
+            _f(u, (*result)(0, i), (*result)(1, i), (*result)(2, i));
+        }
+
+        return result;
+    }
+
+    template <class F>
+    inline GLvoid ParametricCurve3T<F>::SetDefinitionDomain(GLdouble u_min, GLdouble u_max)
+    {
+        _u_min = u_min;
+        _u_max = u_max;
+    }
+
+    template <class F>
+    inline GLvoid ParametricCurve3T<F>::GetDefinitionDomain(GLdouble& u_min, GLdouble& u_max) const
+    {
+        u_min = _u_min;
+        u_max = _u_max;
+    }
+
+    template <class F>
+    inline const F& ParametricCurve3T<F>::GetFunctor() const
+    {
+        return _f;
+    }
 }
@@ -13,20 +13,36 @@ namespace cagd
     ParametricSurface3::ParametricSurface3(
             const TriangularMatrix<PartialDerivative> &pd,
             GLdouble u_min, GLdouble u_max,
-            GLdouble v_min, GLdouble v_max):
+            GLdouble v_min, GLdouble v_max,
+            FusedPartialDerivatives fused_pd):
         _pd(pd),
+        _fused_pd(fused_pd),
         _u_min(u_min), _u_max(u_max),
         _v_min(v_min), _v_max(v_max)
     {
     }
 
+    // set/get the fused evaluator
+    GLvoid ParametricSurface3::SetFusedPartialDerivatives(FusedPartialDerivatives fused_pd)
+    {
+        _fused_pd = fused_pd;
+    }
+
+    ParametricSurface3::FusedPartialDerivatives ParametricSurface3::GetFusedPartialDerivatives() const
+    {
+        return _fused_pd;
+    }
+
     // generates the approximated tesselated image of the parametric surface
     TriangulatedMesh3* ParametricSurface3::GenerateImage(
         GLuint u_div_point_count,
         GLuint v_div_point_count,
         GLenum usage_flag) const
     {
-        if (_pd.GetRowCount() < 2 ||    // i.e., if we cannot evaluate the points and normal vectors of the surface
+        CAGD_PROFILE_ZONE("ParametricSurface3::GenerateImage");
+
+        if ((!_fused_pd &&
+             _pd.GetRowCount() < 2) ||  // i.e., if we cannot evaluate the points and normal vectors of the surface
             u_div_point_count < 2 ||    // i.e., if the number of u-directional subdivion points is too small
             v_div_point_count < 2)      // i.e., if the number of v-directional subdivion points is too small
         {
@@ -37,7 +53,7 @@ namespace cagd
 
         result = new (nothrow) TriangulatedMesh3(
                 u_div_point_count * v_div_point_count,                  // number of unique vertices
-                2 * (u_div_point_count - 1) * (v_div_point_count - 1),  // number of triangular faces
+                0,                                                      // the faces are shared by the grid topology
                 usage_flag);
 
         if (!result)
@@ -45,6 +61,9 @@ namespace cagd
             return nullptr;
         }
 
+        // connectivity information is the same for all grids of the given size
+        result->_SetGridTopology(u_div_point_count, v_div_point_count);
+
         // distance between consecutive subdivision points
         GLdouble du = (_u_max - _u_min) / (u_div_point_count - 1);
         GLdouble dv = (_v_max - _v_min) / (v_div_point_count - 1);
@@ -53,8 +72,8 @@ namespace cagd
         GLfloat ds = 1.0f / (u_div_point_count - 1);
         GLfloat dt = 1.0f / (v_div_point_count - 1);
 
-        // current triangular face counter
-        GLuint current_face = 0;
+        // output of the fused evaluator
+        PartialDerivatives pd(2);
 
         for (GLuint i = 0; i < u_div_point_count; ++i)
         {
@@ -66,45 +85,35 @@ namespace cagd
                 GLdouble v = min(_v_min + j * dv, _v_max);
                 GLfloat  t = min(j * dt, 1.0f);
 
-                /*
-                    3-2
-                    |/|
-                    0-1
-                */
+                // unique vertex identifier
+                GLuint index = i * v_div_point_count + j;
 
-                // unique vertex identifiers
-                GLuint index[4];
+                if (_fused_pd)
+                {
+                    _fused_pd(u, v, pd);
+
+                    // surface point
+                    (*result)._vertex[index] =  pd(0, 0);
 
-                index[0] = i * v_div_point_count + j;
-                index[1] = index[0] + 1;
-                index[2] = index[1] + v_div_point_count;
-                index[3] = index[2] - 1;
+                    // the surface normal is obtained as the cross product of the first order partial derivatives
+                    (*result)._normal[index] =  pd(1, 0);
+                    (*result)._normal[index] ^= pd(1, 1);
+                }
+                else
+                {
+                    // surface point
+                    (*result)._vertex[index] =  _pd(0, 0)(u, v);
 
-                // surface point
-                (*result)._vertex[index[0]] =  _pd(0, 0)(u, v);
+                    // the surface normal is obtained as the cross product of the first order partial derivatives
+                    (*result)._normal[index] =  _pd(1, 0)(u, v);
+                    (*result)._normal[index] ^= _pd(1, 1)(u, v);
+                }
 
-                // the surface normal is obtained as the cross product of the first order partial derivatives
-                (*result)._normal[index[0]] =  _pd(1, 0)(u, v);
-                (*result)._normal[index[0]] ^= _pd(1, 1)(u, v);
-                (*result)._normal[index[0]].normalize();
+                (*result)._normal[index].normalize();
 
                 // texture coordinates
-                (*result)._tex[index[0]].s() = s;
-                (*result)._tex[index[0]].t() = t;
-
-                // connectivity information
-                if (i < u_div_point_count - 1 && j < v_div_point_count - 1)
-                {
-                    (*result)._face[current_face][0] = index[0];
-                    (*result)._face[current_face][1] = index[1];
-                    (*result)._face[current_face][2] = index[2];
-                    ++current_face;
-
-                    (*result)._face[current_face][0] = index[0];
-                    (*result)._face[current_face][1] = index[2];
-                    (*result)._face[current_face][2] = index[3];
-                    ++current_face;
-                }
+                (*result)._tex[index].s() = s;
+                (*result)._tex[index].t() = t;
             }
         }
 
@@ -3,7 +3,10 @@
 #include <GL/glew.h>
 #include "../Core/DCoordinates3.h"
 #include "../Core/Matrices.h"
+#include "../Core/Profilers.h"
 #include "../Core/TriangulatedMeshes3.h"
+#include <algorithm>
+#include <new>
 
 namespace cagd
 {
@@ -14,8 +17,18 @@ namespace cagd
         // of the parametric surface
         typedef DCoordinate3 (*PartialDerivative)(GLdouble, GLdouble);
 
+        // partial derivatives of the surface at a given parameter pair: pd(r, c) stores the
+        // (r - c, c)-th order partial derivative (in directions u and v, respectively)
+        typedef TriangularMatrix<DCoordinate3> PartialDerivatives;
+
+        // function pointer definition to a fused evaluator that fills (at least) the zeroth and
+        // first order partial derivatives in a single call, i.e., the subexpressions shared by
+        // them have to be calculated only once
+        typedef GLvoid (*FusedPartialDerivatives)(GLdouble, GLdouble, PartialDerivatives&);
+
     protected:
         TriangularMatrix<PartialDerivative> _pd;    // function pointers
+        FusedPartialDerivatives  _fused_pd;         // preferred over _pd if it is not a null pointer
         GLdouble _u_min, _u_max;                    // definition domain in direction u
         GLdouble _v_min, _v_max;                    // definition domain in direction v
 
@@ -24,12 +37,142 @@ namespace cagd
         ParametricSurface3(
                 const TriangularMatrix<PartialDerivative> &pd,
                 GLdouble u_min, GLdouble u_max,
+                GLdouble v_min, GLdouble v_max,
+                FusedPartialDerivatives fused_pd = nullptr);
+
+        // set/get the fused evaluator
+        GLvoid SetFusedPartialDerivatives(FusedPartialDerivatives fused_pd);
+        FusedPartialDerivatives GetFusedPartialDerivatives() const;
+
+        // generates the approximated tesselated image of the parametric surface
+        TriangulatedMesh3* GenerateImage(
+                GLuint u_div_point_count,           // number of subdivision points in direction u
+                GLuint v_div_point_count,           // number of subdivision points in direction v
+                GLenum usage_flag = GL_STATIC_DRAW) const;
+    };
+
+    //-----------------------------------
+    // template class ParametricSurface3T
+    //-----------------------------------
+    // Functor-based variant of ParametricSurface3. The callable F has to provide the method
+    //
+    //     GLvoid operator ()(GLdouble u, GLdouble v, DCoordinate3& d00, DCoordinate3& d10, DCoordinate3& d01) const;
+    //
+    // that evaluates the surface point and its first order partial derivatives in a single call.
+    // Contrary to the function pointers of ParametricSurface3 the body of the callable can be inlined
+    // into the sampling loop, therefore the subexpressions shared by the partial derivatives
+    // (e.g. sin(u), cos(v)) are calculated only once per vertex.
+    template <class F>
+    class ParametricSurface3T
+    {
+    protected:
+        F        _f;                    // callable that evaluates the point and the first order partial derivatives
+        GLdouble _u_min, _u_max;        // definition domain in direction u
+        GLdouble _v_min, _v_max;        // definition domain in direction v
+
+    public:
+        // special constructor
+        ParametricSurface3T(
+                const F& f,
+                GLdouble u_min, GLdouble u_max,
                 GLdouble v_min, GLdouble v_max);
 
+        // evaluates the surface point and the first order partial derivatives at (u, v)
+        GLvoid operator ()(GLdouble u, GLdouble v, DCoordinate3& d00, DCoordinate3& d10, DCoordinate3& d01) const;
+
         // generates the approximated tesselated image of the parametric surface
         TriangulatedMesh3* GenerateImage(
                 GLuint u_div_point_count,           // number of subdivision points in direction u
                 GLuint v_div_point_count,           // number of subdivision points in direction v
                 GLenum usage_flag = GL_STATIC_DRAW) const;
+
+        // get the callable
+        const F& GetFunctor() const;
     };
+
+    //-----------------------------------------------------
+    // implementation of template class ParametricSurface3T
+    //-----------------------------------------------------
+    template <class F>
+    ParametricSurface3T<F>::ParametricSurface3T(
+            const F& f,
+            GLdouble u_min, GLdouble u_max,
+            GLdouble v_min, GLdouble v_max):
+        _f(f),
+        _u_min(u_min), _u_max(u_max),
+        _v_min(v_min), _v_max(v_max)
+    {
+    }
+
+    template <class F>
+    inline GLvoid ParametricSurface3T<F>::operator ()(
+            GLdouble u, GLdouble v, DCoordinate3& d00, DCoordinate3& d10, DCoordinate3& d01) const
+    {
+        _f(u, v, d00, d10, d01);
+    }
+
+    template <class F>
+    TriangulatedMesh3* ParametricSurface3T<F>::GenerateImage(
+            GLuint u_div_point_count,
+            GLuint v_div_point_count,
+            GLenum usage_flag) const
+    {
+        CAGD_PROFILE_ZONE("ParametricSurface3::GenerateImage");
+
+        if (u_div_point_count < 2 || v_div_point_count < 2)
+            return nullptr;
+
+        TriangulatedMesh3 *result = new (std::nothrow) TriangulatedMesh3(
+                u_div_point_count * v_div_point_count, 0, usage_flag);
+
+        if (!result)
+            return nullptr;
+
+        // connectivity information is the same for all grids of the given size
+        result->_SetGridTopology(u_div_point_count, v_div_point_count);
+
+        // distance between consecutive subdivision points
+        GLdouble du = (_u_max - _u_min) / (u_div_point_count - 1);
+        GLdouble dv = (_v_max - _v_min) / (v_div_point_count - 1);
+
+        // distance between consecutive subdivision points for texture coordinates
+        GLfloat ds = 1.0f / (u_div_point_count - 1);
+        GLfloat dt = 1.0f / (v_div_point_count - 1);
+
+        DCoordinate3 *vertex = &result->_vertex[0];
+        DCoordinate3 *normal = &result->_normal[0];
+        TCoordinate4 *tex    = &result->_tex[0];
+
+        DCoordinate3 d10;
+
+        for (GLuint i = 0; i < u_div_point_count; ++i)
+        {
+            GLdouble u = std::min(_u_min + i * du, _u_max);
+            GLfloat  s = std::min(i * ds, 1.0f);
+
+            for (GLuint j = 0; j < v_div_point_count; ++j, ++vertex, ++normal, ++tex)
+            {
+                GLdouble v = std::min(_v_min + j * dv, _v_max);
+                GLfloat  t = std::min(j * dt, 1.0f);
+
+                // the surface point and the partial derivative in direction v are written in place,
+                // the latter is overwritten by the unit normal vector s_u x s_v
+                _f(u, v, *vertex, d10, *normal);
+
+                *normal = d10 ^ *normal;
+                normal->normalize();
+
+                tex->s() = s;
+                tex->t() = t;
+            }
+        }
+
+        return result;
+    }
+
+    template <class F>
+    inline const F& ParametricSurface3T<F>::GetFunctor() const
+    {
+        return _f;
+    }
 }
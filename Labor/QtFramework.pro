@@ -49,6 +49,10 @@ unix: !mac {
 
     # for GLEW installed into /usr/lib/libGLEW.so or /usr/lib/glew.lib
     LIBS += -lGLEW -lGLU
+
+    # the independent linear systems of interpolation problems are solved by OpenMP threads
+    QMAKE_CXXFLAGS += -fopenmp
+    LIBS += -fopenmp
 }
 
 mac {
@@ -65,55 +69,24 @@ mac {
 }
 
 
+# the geometric core and the GPU-resource layer are static libraries (see CAGD.pro), the GPU-resource
+# layer refers to the core, therefore it precedes the core in the list of libraries
+include(GPU/cagd_gpu.pri)
+include(Core/cagd_core.pri)
+
 FORMS += \
     GUI/MainWindow.ui \
     GUI/SideWidget.ui
 
 HEADERS += \
-    Core/Colors4.h \
-    Core/Constants.h \
-    Core/DCoordinates3.h \
-    Core/Exceptions.h \
-    Core/GenericCurves3.h \
-    Core/HCoordinates3.h \
-    Core/Lights.h \
-    Core/LinearCombination3.h \
-    Core/Materials.h \
-    Core/Matrices.h \
-    Core/RealSquareMatrices.h \
-    Core/ShaderPrograms.h \
-    Core/TCoordinates4.h \
-    Core/TensorProductSurfaces3.h \
-    Core/TriangularFaces.h \
-    Core/TriangulatedMeshes3.h \
-    Cyclic/CyclicCurves3.h \
     GUI/GLWidget.h \
     GUI/MainWindow.h \
     GUI/SideWidget.h \
-    Parametric/ParametricCurves3.h \
-    Parametric/ParametricSurfaces3.h \
-    Test/TestFunctions.h \
-    Trigonometric/SecondOrderTrigonometricArc3.h \
-    Trigonometric/SecondOrderTrigonometricFunctions.h \
-    Trigonometric/SecondOrderTrigonometricPatch3.h
+    Test/TestFunctions.h
 
 SOURCES += \
-    Core/GenericCurves3.cpp \
-    Core/Lights.cpp \
-    Core/LinearCombination3.cpp \
-    Core/Materials.cpp \
-    Core/RealSquareMatrices.cpp \
-    Core/ShaderPrograms.cpp \
-    Core/TensorProductSurfaces3.cpp \
-    Core/TriangulatedMeshes3.cpp \
-    Cyclic/CyclicCurves3.cpp \
     GUI/GLWidget.cpp \
     GUI/MainWindow.cpp \
     GUI/SideWidget.cpp \
-    Parametric/ParametricCurves3.cpp \
-    Parametric/ParametricSurfaces3.cpp \
     Test/TestFunctions.cpp \
-    Trigonometric/SecondOrderTrigonometricArc3.cpp \
-    Trigonometric/SecondOrderTrigonometricFunctions.cpp \
-    Trigonometric/SecondOrderTrigonometricPatch3.cpp \
     main.cpp
@@ -0,0 +1,58 @@
+# Console application that renders the race and surface pages offscreen by the same GLWidget as the
+# application, along a fixed camera path and with explicitly stepped animations, and reports frame times,
+# draw calls and state changes (and optionally the checksums of the rendered images).
+#
+# It does not need a display: unless QT_QPA_PLATFORM is set, the EGL based platform plugin minimalegl is
+# used, e.g.
+#   EGL_PLATFORM=surfaceless LIBGL_ALWAYS_SOFTWARE=1 RenderBenchmarks --frames=600 --checksums=frames.txt
+# renders by Mesa's llvmpipe without a GPU; see main.cpp for the other options.
+TEMPLATE = app
+
+QT += core gui widgets
+
+greaterThan(QT_MAJOR_VERSION, 5){
+    QT += openglwidgets
+}
+
+CONFIG += console c++11
+CONFIG -= app_bundle
+
+win32 {
+    INCLUDEPATH += $$PWD/../Dependencies/Include
+    LIBS += -lopengl32 -lglu32
+
+    contains(QT_ARCH, i386): LIBS += -L"$$PWD/../Dependencies/Lib/GL/x86/" -lglew32
+    else:                    LIBS += -L"$$PWD/../Dependencies/Lib/GL/x64/" -lglew32
+
+    msvc {
+        QMAKE_CXXFLAGS += -arch:AVX
+        QMAKE_CXXFLAGS_RELEASE *= -O2
+    }
+}
+
+unix: !mac {
+    LIBS += -lGLEW -lGLU
+}
+
+mac {
+    # see ../QtFramework.pro
+    INCLUDEPATH += "/usr/local/Cellar/glew/x.y.z/include/"
+    LIBS += -L"/usr/local/Cellar/glew/x.y.z/lib/" -lGLEW
+    LIBS += -framework OpenGL
+}
+
+include(../GPU/cagd_gpu.pri)
+include(../Core/cagd_core.pri)
+
+# the models, shaders and textures are opened by GLWidget relative to this directory (can be overridden by
+# --working-directory=<directory>)
+DEFINES += CAGD_WORKING_DIRECTORY=\\\"$$PWD/..\\\"
+
+HEADERS += \
+    ../GUI/GLWidget.h \
+    ../Test/TestFunctions.h
+
+SOURCES += \
+    ../GUI/GLWidget.cpp \
+    ../Test/TestFunctions.cpp \
+    main.cpp
@@ -0,0 +1,273 @@
+#include <GL/glew.h>
+#include <QApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "../GUI/GLWidget.h"
+
+using namespace cagd;
+using namespace std;
+
+namespace
+{
+    // default working directory of GLWidget (qmake defines the absolute path of the source tree)
+#ifdef CAGD_WORKING_DIRECTORY
+    const char *default_working_directory = CAGD_WORKING_DIRECTORY;
+#else
+    const char *default_working_directory = ".";
+#endif
+
+    class Page
+    {
+    public:
+        const char *name;
+        int        index;   // see GLWidget::paintGL
+    };
+
+    const Page pages[] = {{"race", 1}, {"surface", 2}};
+
+    class Options
+    {
+    public:
+        GLuint              frame_count         = 300;
+        GLuint              width               = 1280;
+        GLuint              height              = 720;
+        GLdouble            loading_timeout     = 60.0;     // in seconds
+        std::string         page_filter;                    // e.g. "race", every page is rendered if empty
+        std::string         checksum_file_name;             // the checksums are not calculated if empty
+        std::string         working_directory   = default_working_directory;
+        std::string         backend;                        // fixed_function or core_profile, see GLWidget::initializeGL
+    };
+
+    GLboolean ParseOptions(int argc, char **argv, Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            string argument = argv[i];
+            string::size_type separator = argument.find('=');
+            string name  = argument.substr(0, separator);
+            string value = (separator == string::npos) ? string() : argument.substr(separator + 1);
+
+            if (name == "--frames" && !value.empty())
+                options.frame_count = max(1, atoi(value.c_str()));
+            else if (name == "--width" && !value.empty())
+                options.width = max(1, atoi(value.c_str()));
+            else if (name == "--height" && !value.empty())
+                options.height = max(1, atoi(value.c_str()));
+            else if (name == "--loading-timeout" && !value.empty())
+                options.loading_timeout = atof(value.c_str());
+            else if (name == "--page")
+                options.page_filter = value;
+            else if (name == "--checksums")
+                options.checksum_file_name = value;
+            else if (name == "--working-directory" && !value.empty())
+                options.working_directory = value;
+            else if (name == "--backend" && (value == "fixed_function" || value == "core_profile"))
+                options.backend = value;
+            else
+            {
+                fprintf(stderr, "unknown argument: %s\n"
+                                "usage: %s [--frames=<count>] [--width=<pixels>] [--height=<pixels>] [--page=race|surface]\n"
+                                "       [--checksums=<file>] [--loading-timeout=<seconds>] [--working-directory=<directory>]\n"
+                                "       [--backend=fixed_function|core_profile]\n",
+                        argv[i], argv[0]);
+                return GL_FALSE;
+            }
+        }
+
+        return GL_TRUE;
+    }
+
+    // 64-bit FNV-1a hash of the pixels of the current read framebuffer
+    unsigned long long FramebufferChecksum(vector<unsigned char>& pixels)
+    {
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+
+        pixels.resize(4 * static_cast<size_t>(viewport[2]) * static_cast<size_t>(viewport[3]));
+
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(viewport[0], viewport[1], viewport[2], viewport[3], GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]);
+
+        unsigned long long hash = 14695981039346656037ull;
+
+        for (size_t i = 0; i < pixels.size(); ++i)
+        {
+            hash ^= pixels[i];
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    // Each frame of the camera path turns the scene by 360 / frame_count degrees around the y-axis, while
+    // the animations are advanced by a single step. The frame time is measured from the beginning of paintGL
+    // to the completion of its commands (glFinish), the read-back of the checksums is not included.
+    GLboolean RenderPage(GLWidget& widget, const Page& page, const Options& options, FILE *checksum_file)
+    {
+        widget.set_selected_page(page.index);
+        widget.set_angle_x(20);
+        widget.set_angle_y(0);
+        widget.set_angle_z(0);
+
+        // the models of the race are loaded progressively, the measurement starts with the complete scene
+        QElapsedTimer loading_clock;
+        loading_clock.start();
+
+        while (!widget.is_race_scene_loaded())
+        {
+            if (loading_clock.elapsed() > 1000.0 * options.loading_timeout)
+            {
+                fprintf(stderr, "the race scene has not been loaded in %g s\n", options.loading_timeout);
+                return GL_FALSE;
+            }
+
+            widget.makeCurrent();
+            widget.paintGL();
+            widget.doneCurrent();
+        }
+
+        vector<GLdouble>        frame_time(options.frame_count);    // in milliseconds
+        vector<unsigned char>   pixels;
+        QElapsedTimer           frame_clock;
+
+        for (GLuint frame = 0; frame < options.frame_count; ++frame)
+        {
+            widget.set_angle_y(static_cast<int>((360 * frame) / options.frame_count));
+
+            widget.makeCurrent();
+            widget.advance_animations();
+
+            frame_clock.start();
+            widget.paintGL();
+            glFinish();
+            frame_time[frame] = 1.0e-6 * frame_clock.nsecsElapsed();
+
+            if (checksum_file)
+            {
+                fprintf(checksum_file, "%s %u %016llx\n", page.name, frame, FramebufferChecksum(pixels));
+            }
+
+            widget.doneCurrent();
+        }
+
+        vector<GLdouble> sorted_frame_time(frame_time);
+        sort(sorted_frame_time.begin(), sorted_frame_time.end());
+
+        GLdouble sum = 0.0;
+        for (GLuint frame = 0; frame < options.frame_count; ++frame)
+        {
+            sum += frame_time[frame];
+        }
+
+        GLdouble average = sum / options.frame_count;
+
+        printf("%-8s %6u frames  min %8.3f ms  avg %8.3f ms  p99 %8.3f ms  max %8.3f ms  (%.1f fps)\n",
+               page.name, options.frame_count, sorted_frame_time.front(), average,
+               sorted_frame_time[(99 * (options.frame_count - 1)) / 100], sorted_frame_time.back(), 1000.0 / average);
+
+        if (page.index == 1)
+        {
+            const RenderQueue::Statistics &statistics = widget.get_race_render_statistics();
+
+            printf("%-8s %6u items  %u draw calls  %u state changes (unsorted: %u; %u shader, %u lighting, "
+                   "%u material, %u color, %u mesh)\n",
+                   page.name, statistics.item_count, statistics.draw_calls, statistics.StateChanges(),
+                   statistics.unsorted_state_changes, statistics.shader_changes, statistics.lighting_changes,
+                   statistics.material_changes, statistics.color_changes, statistics.mesh_changes);
+        }
+
+        return GL_TRUE;
+    }
+}
+
+// Renders the selected pages of GLWidget offscreen for a fixed number of frames. The exit code is non-zero
+// if the rendering context cannot be created or the race scene cannot be loaded.
+int main(int argc, char **argv)
+{
+    // the platform plugin minimalegl renders into EGL pbuffers, i.e., neither a display nor a window system
+    // is needed; another plugin can be selected by the environment variable QT_QPA_PLATFORM
+    if (qgetenv("QT_QPA_PLATFORM").isEmpty())
+    {
+        qputenv("QT_QPA_PLATFORM", "minimalegl");
+    }
+
+    QApplication::setAttribute(Qt::AA_UseDesktopOpenGL, true);
+
+    QApplication app(argc, argv);
+
+    Options options;
+
+    if (!ParseOptions(argc, argv, options))
+    {
+        return 2;
+    }
+
+    if (!QDir::setCurrent(QString::fromStdString(options.working_directory)))
+    {
+        fprintf(stderr, "could not change the working directory to %s\n", options.working_directory.c_str());
+        return 2;
+    }
+
+    FILE *checksum_file = nullptr;
+
+    if (!options.checksum_file_name.empty() && !(checksum_file = fopen(options.checksum_file_name.c_str(), "w")))
+    {
+        fprintf(stderr, "could not open %s\n", options.checksum_file_name.c_str());
+        return 2;
+    }
+
+    // the render backend is selected by the widget at its initialization
+    if (!options.backend.empty())
+    {
+        qputenv("CAGD_RENDER_BACKEND", options.backend.c_str());
+    }
+
+    GLWidget widget;
+    widget.resize(options.width, options.height);
+
+    // the widget is not shown: the first grab creates its context and framebuffer object, and initializes it
+    widget.grabFramebuffer();
+
+    if (!widget.isValid())
+    {
+        fprintf(stderr, "could not create an OpenGL rendering context\n");
+
+        if (checksum_file)
+        {
+            fclose(checksum_file);
+        }
+
+        return 1;
+    }
+
+    widget.set_animation_timers_enabled(false);
+
+    widget.makeCurrent();
+    printf("renderer: %s, OpenGL %s, %s backend\n", reinterpret_cast<const char*>(glGetString(GL_RENDERER)),
+           reinterpret_cast<const char*>(glGetString(GL_VERSION)),
+           RenderBackend::Selected() == RenderBackend::CORE_PROFILE ? "core profile" : "fixed-function");
+    widget.doneCurrent();
+
+    GLboolean success = GL_TRUE;
+
+    for (GLuint i = 0; i < sizeof(pages) / sizeof(pages[0]); ++i)
+    {
+        if (options.page_filter.empty() || options.page_filter == pages[i].name)
+        {
+            success &= RenderPage(widget, pages[i], options, checksum_file);
+        }
+    }
+
+    if (checksum_file)
+    {
+        fclose(checksum_file);
+    }
+
+    return success ? 0 : 1;
+}
@@ -249,6 +249,11 @@ DCoordinate3 torusSurface::d01(GLdouble u, GLdouble v)
     return DCoordinate3(-p * cos(u) * sin(v), -p * sin(u) * sin(v), p * cos(v));
 }
 
+GLvoid torusSurface::fused(GLdouble u, GLdouble v, TriangularMatrix<DCoordinate3>& pd)
+{
+    Derivatives()(u, v, pd(0, 0), pd(1, 0), pd(1, 1));
+}
+
 
 // Sphere
 GLdouble sphere::u_min = 0;
@@ -289,6 +294,11 @@ DCoordinate3 sphere::d01(GLdouble u, GLdouble v)
     return DCoordinate3(-r*sin(u)*sin(v), r*sin(u)*cos(v), 0);
 }
 
+GLvoid sphere::fused(GLdouble u, GLdouble v, TriangularMatrix<DCoordinate3>& pd)
+{
+    Derivatives()(u, v, pd(0, 0), pd(1, 0), pd(1, 1));
+}
+
 // Hyperboloid
 GLdouble hyperboloid::u_min = -3.0 * PI;
 GLdouble hyperboloid::u_max = 3.0 * PI;
@@ -333,6 +343,11 @@ DCoordinate3 hyperboloid::d01(GLdouble u, GLdouble v)
     return DCoordinate3(-a * sqrt(u * u + 1.0) * sin(v), a * sqrt(u * u + 1.0) * cos(v), 0.0);
 }
 
+GLvoid hyperboloid::fused(GLdouble u, GLdouble v, TriangularMatrix<DCoordinate3>& pd)
+{
+    Derivatives()(u, v, pd(0, 0), pd(1, 0), pd(1, 1));
+}
+
 // Plane
 GLdouble plane::u_min = -3.0 * PI;;
 GLdouble plane::u_max = 3.0 * PI;
@@ -358,6 +373,11 @@ DCoordinate3 plane::d01(GLdouble u, GLdouble v)
     return DCoordinate3(0 * u * v, 1 , -b / c);
 }
 
+GLvoid plane::fused(GLdouble u, GLdouble v, TriangularMatrix<DCoordinate3>& pd)
+{
+    Derivatives()(u, v, pd(0, 0), pd(1, 0), pd(1, 1));
+}
+
 // Cone
 GLdouble cone::u_min = 0;
 GLdouble cone::u_max = 2.0 * PI;
@@ -381,6 +401,11 @@ DCoordinate3 cone::d01(GLdouble u, GLdouble v)
     return DCoordinate3(-u * sin(v), u * cos(v), 0);
 }
 
+GLvoid cone::fused(GLdouble u, GLdouble v, TriangularMatrix<DCoordinate3>& pd)
+{
+    Derivatives()(u, v, pd(0, 0), pd(1, 0), pd(1, 1));
+}
+
 // Cylinder
 GLdouble cylinder::u_min = 0;
 GLdouble cylinder::u_max = 2.0 * PI;
@@ -403,3 +428,8 @@ DCoordinate3 cylinder::d01(GLdouble u, GLdouble v)
 {
     return DCoordinate3(0, 0 * u * v, 1);
 }
+
+GLvoid cylinder::fused(GLdouble u, GLdouble v, TriangularMatrix<DCoordinate3>& pd)
+{
+    Derivatives()(u, v, pd(0, 0), pd(1, 0), pd(1, 1));
+}
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "../Core/DCoordinates3.h"
+#include "../Core/Matrices.h"
+#include <cmath>
+#include <string>
 #include <vector>
 
 namespace cagd
@@ -19,6 +22,20 @@ namespace cagd
         DCoordinate3 d0(GLdouble);
         DCoordinate3 d1(GLdouble);
         DCoordinate3 d2(GLdouble);
+
+        // evaluates the zeroth, first and second order derivatives in a single call
+        class Derivatives
+        {
+        public:
+            inline GLvoid operator ()(GLdouble u, DCoordinate3& d0, DCoordinate3& d1, DCoordinate3& d2) const
+            {
+                GLdouble c = std::cos(u), s = std::sin(u);
+
+                d0 = DCoordinate3(u * c, u * s, u);
+                d1 = DCoordinate3(c - u * s, s + u * c, 1.0);
+                d2 = DCoordinate3(-2.0 * s - u * c, 2.0 * c - u * s, 0.0);
+            }
+        };
     }
 
     namespace torus_knot
@@ -28,6 +45,25 @@ namespace cagd
         DCoordinate3 d0(GLdouble);
         DCoordinate3 d1(GLdouble);
         DCoordinate3 d2(GLdouble);
+
+        // evaluates the zeroth, first and second order derivatives in a single call
+        class Derivatives
+        {
+        public:
+            inline GLvoid operator ()(GLdouble u, DCoordinate3& d0, DCoordinate3& d1, DCoordinate3& d2) const
+            {
+                GLdouble c  = std::cos(2.0 * u / 3.0), s  = std::sin(2.0 * u / 3.0);
+                GLdouble cu = std::cos(u),             su = std::sin(u);
+
+                d0 = DCoordinate3((2.0 + c) * cu, (2.0 + c) * su, s);
+                d1 = DCoordinate3(-(c + 2.0) * su - (2.0 * s * cu / 3.0),
+                                   (c + 2.0) * cu - (2.0 * s * su / 3.0),
+                                   2.0 * c / 3.0);
+                d2 = DCoordinate3( (12.0 * s * su + (-13.0 * c - 18.0) * cu) / 9.0,
+                                  -((13.0 * c + 18.0) * su + 12.0 * s * cu) / 9.0,
+                                  -4.0 * s / 9.0);
+            }
+        };
     }
 
     namespace rose
@@ -37,6 +73,20 @@ namespace cagd
         DCoordinate3 d0(GLdouble);
         DCoordinate3 d1(GLdouble);
         DCoordinate3 d2(GLdouble);
+
+        // evaluates the zeroth, first and second order derivatives in a single call
+        class Derivatives
+        {
+        public:
+            inline GLvoid operator ()(GLdouble u, DCoordinate3& d0, DCoordinate3& d1, DCoordinate3& d2) const
+            {
+                GLdouble r = std::cos(4.0 / 5.0 * u), c = std::cos(u), s = std::sin(u);
+
+                d0 = DCoordinate3(r * c, r * s, r);
+                d1 = DCoordinate3(-r * s, r * c, 0.0);
+                d2 = DCoordinate3(-r * c, -r * s, 0.0);
+            }
+        };
     }
 
     namespace spherical_spiral
@@ -46,6 +96,19 @@ namespace cagd
         DCoordinate3 d0(GLdouble);
         DCoordinate3 d1(GLdouble);
         DCoordinate3 d2(GLdouble);
+
+        // evaluates the zeroth, first and second order derivatives in a single call
+        class Derivatives
+        {
+        public:
+            inline GLvoid operator ()(GLdouble u, DCoordinate3& d0, DCoordinate3& d1, DCoordinate3& d2) const
+            {
+                // the expressions are too long to be duplicated
+                d0 = spherical_spiral::d0(u);
+                d1 = spherical_spiral::d1(u);
+                d2 = spherical_spiral::d2(u);
+            }
+        };
     }
 
     namespace helix
@@ -55,6 +118,20 @@ namespace cagd
         DCoordinate3 d0(GLdouble);
         DCoordinate3 d1(GLdouble);
         DCoordinate3 d2(GLdouble);
+
+        // evaluates the zeroth, first and second order derivatives in a single call
+        class Derivatives
+        {
+        public:
+            inline GLvoid operator ()(GLdouble u, DCoordinate3& d0, DCoordinate3& d1, DCoordinate3& d2) const
+            {
+                GLdouble cu = std::cos(u), su = std::sin(u);
+
+                d0 = DCoordinate3(r * cu, r * su, c * u);
+                d1 = DCoordinate3(-r * su, r * cu, c);
+                d2 = DCoordinate3(-r * cu, -r * su, 0.0);
+            }
+        };
     }
 
     namespace butterfly
@@ -64,6 +141,19 @@ namespace cagd
         DCoordinate3 d0(GLdouble);
         DCoordinate3 d1(GLdouble);
         DCoordinate3 d2(GLdouble);
+
+        // evaluates the zeroth, first and second order derivatives in a single call
+        class Derivatives
+        {
+        public:
+            inline GLvoid operator ()(GLdouble u, DCoordinate3& d0, DCoordinate3& d1, DCoordinate3& d2) const
+            {
+                // the expressions are too long to be duplicated
+                d0 = butterfly::d0(u);
+                d1 = butterfly::d1(u);
+                d2 = butterfly::d2(u);
+            }
+        };
     }
 
     namespace test
@@ -73,6 +163,20 @@ namespace cagd
         DCoordinate3 d0(GLdouble);
         DCoordinate3 d1(GLdouble);
         DCoordinate3 d2(GLdouble);
+
+        // evaluates the zeroth, first and second order derivatives in a single call
+        class Derivatives
+        {
+        public:
+            inline GLvoid operator ()(GLdouble u, DCoordinate3& d0, DCoordinate3& d1, DCoordinate3& d2) const
+            {
+                GLdouble c = std::cos(u), s = std::sin(u);
+
+                d0 = DCoordinate3(r * c, r * s, a * r * r * u * u);
+                d1 = DCoordinate3(-r * s, r * c, 2.0 * a * r * r * u);
+                d2 = DCoordinate3(-r * c, -r * s, 2.0 * a * r * r);
+            }
+        };
     }
 
     namespace torus
@@ -82,6 +186,20 @@ namespace cagd
         DCoordinate3 d0(GLdouble);
         DCoordinate3 d1(GLdouble);
         DCoordinate3 d2(GLdouble);
+
+        // evaluates the zeroth, first and second order derivatives in a single call
+        class Derivatives
+        {
+        public:
+            inline GLvoid operator ()(GLdouble u, DCoordinate3& d0, DCoordinate3& d1, DCoordinate3& d2) const
+            {
+                GLdouble c = std::cos(u), s = std::sin(u);
+
+                d0 = DCoordinate3(p * s * c, p * s * s, p * c);
+                d1 = DCoordinate3(-p * (s * s - c * c), 2.0 * p * c * s, 0.0);
+                d2 = DCoordinate3(-4.0 * p * c * s, -2.0 * (s * s - c * c), 0.0);
+            }
+        };
     }
 
     // Surfaces
@@ -106,6 +224,25 @@ namespace cagd
         DCoordinate3 d00(GLdouble u, GLdouble v); // zeroth order partial derivative, i.e. surface point
         DCoordinate3 d10(GLdouble u, GLdouble v); // first order partial derivative in direction u
         DCoordinate3 d01(GLdouble u, GLdouble v); // first order partial derivative in direction v
+
+        // fused evaluator: fills pd(0, 0), pd(1, 0) and pd(1, 1) in a single call
+        GLvoid fused(GLdouble u, GLdouble v, TriangularMatrix<DCoordinate3>& pd);
+
+        // evaluates the surface point and the first order partial derivatives in a single call
+        class Derivatives
+        {
+        public:
+            inline GLvoid operator ()(GLdouble u, GLdouble v, DCoordinate3& d00, DCoordinate3& d10, DCoordinate3& d01) const
+            {
+                GLdouble cu = std::cos(u), su = std::sin(u);
+                GLdouble cv = std::cos(v), sv = std::sin(v);
+                GLdouble w  = r + p * cv;
+
+                d00 = DCoordinate3(w * cu, w * su, p * sv);
+                d10 = DCoordinate3(-w * su, w * cu, 0.0);
+                d01 = DCoordinate3(-p * cu * sv, -p * su * sv, p * cv);
+            }
+        };
     }
 
     namespace sphere
@@ -120,6 +257,24 @@ namespace cagd
         DCoordinate3 d00(GLdouble u, GLdouble v);
         DCoordinate3 d10(GLdouble u, GLdouble v);
         DCoordinate3 d01(GLdouble u, GLdouble v);
+
+        // fused evaluator: fills pd(0, 0), pd(1, 0) and pd(1, 1) in a single call
+        GLvoid fused(GLdouble u, GLdouble v, TriangularMatrix<DCoordinate3>& pd);
+
+        // evaluates the surface point and the first order partial derivatives in a single call
+        class Derivatives
+        {
+        public:
+            inline GLvoid operator ()(GLdouble u, GLdouble v, DCoordinate3& d00, DCoordinate3& d10, DCoordinate3& d01) const
+            {
+                GLdouble cu = std::cos(u), su = std::sin(u);
+                GLdouble cv = std::cos(v), sv = std::sin(v);
+
+                d00 = DCoordinate3(r * su * cv, r * su * sv, r * cu);
+                d10 = DCoordinate3(r * cv * cu, r * sv * cu, -r * su);
+                d01 = DCoordinate3(-r * su * sv, r * su * cv, 0.0);
+            }
+        };
     }
 
     namespace hyperboloid
@@ -134,6 +289,24 @@ namespace cagd
         DCoordinate3 d00(GLdouble u, GLdouble v);
         DCoordinate3 d10(GLdouble u, GLdouble v);
         DCoordinate3 d01(GLdouble u, GLdouble v);
+
+        // fused evaluator: fills pd(0, 0), pd(1, 0) and pd(1, 1) in a single call
+        GLvoid fused(GLdouble u, GLdouble v, TriangularMatrix<DCoordinate3>& pd);
+
+        // evaluates the surface point and the first order partial derivatives in a single call
+        class Derivatives
+        {
+        public:
+            inline GLvoid operator ()(GLdouble u, GLdouble v, DCoordinate3& d00, DCoordinate3& d10, DCoordinate3& d01) const
+            {
+                GLdouble w  = std::sqrt(1.0 + u * u);
+                GLdouble cv = std::cos(v), sv = std::sin(v);
+
+                d00 = DCoordinate3(a * w * cv, a * w * sv, c * u);
+                d10 = DCoordinate3(a * cv * u / w, a * sv * u / w, c);
+                d01 = DCoordinate3(-a * w * sv, a * w * cv, 0.0);
+            }
+        };
     }
 
     namespace plane
@@ -144,6 +317,21 @@ namespace cagd
         DCoordinate3 d00(GLdouble u, GLdouble v);
         DCoordinate3 d10(GLdouble u, GLdouble v);
         DCoordinate3 d01(GLdouble u, GLdouble v);
+
+        // fused evaluator: fills pd(0, 0), pd(1, 0) and pd(1, 1) in a single call
+        GLvoid fused(GLdouble u, GLdouble v, TriangularMatrix<DCoordinate3>& pd);
+
+        // evaluates the surface point and the first order partial derivatives in a single call
+        class Derivatives
+        {
+        public:
+            inline GLvoid operator ()(GLdouble u, GLdouble v, DCoordinate3& d00, DCoordinate3& d10, DCoordinate3& d01) const
+            {
+                d00 = DCoordinate3(u, v, (d - a * u - b * v) / c);
+                d10 = DCoordinate3(1.0, 0.0, -a / c);
+                d01 = DCoordinate3(0.0, 1.0, -b / c);
+            }
+        };
     }
 
     namespace cone
@@ -154,6 +342,23 @@ namespace cagd
         DCoordinate3 d00(GLdouble u, GLdouble v);
         DCoordinate3 d10(GLdouble u, GLdouble v);
         DCoordinate3 d01(GLdouble u, GLdouble v);
+
+        // fused evaluator: fills pd(0, 0), pd(1, 0) and pd(1, 1) in a single call
+        GLvoid fused(GLdouble u, GLdouble v, TriangularMatrix<DCoordinate3>& pd);
+
+        // evaluates the surface point and the first order partial derivatives in a single call
+        class Derivatives
+        {
+        public:
+            inline GLvoid operator ()(GLdouble u, GLdouble v, DCoordinate3& d00, DCoordinate3& d10, DCoordinate3& d01) const
+            {
+                GLdouble cv = std::cos(v), sv = std::sin(v);
+
+                d00 = DCoordinate3(u * cv, u * sv, a * u);
+                d10 = DCoordinate3(cv, sv, a);
+                d01 = DCoordinate3(-u * sv, u * cv, 0.0);
+            }
+        };
     }
 
     namespace cylinder
@@ -164,5 +369,22 @@ namespace cagd
         DCoordinate3 d00(GLdouble u, GLdouble v);
         DCoordinate3 d10(GLdouble u, GLdouble v);
         DCoordinate3 d01(GLdouble u, GLdouble v);
+
+        // fused evaluator: fills pd(0, 0), pd(1, 0) and pd(1, 1) in a single call
+        GLvoid fused(GLdouble u, GLdouble v, TriangularMatrix<DCoordinate3>& pd);
+
+        // evaluates the surface point and the first order partial derivatives in a single call
+        class Derivatives
+        {
+        public:
+            inline GLvoid operator ()(GLdouble u, GLdouble v, DCoordinate3& d00, DCoordinate3& d10, DCoordinate3& d01) const
+            {
+                GLdouble cu = std::cos(u), su = std::sin(u);
+
+                d00 = DCoordinate3(a * cu, a * su, v);
+                d10 = DCoordinate3(-a * su, a * cu, 0.0);
+                d01 = DCoordinate3(0.0, 0.0, 1.0);
+            }
+        };
     }
 }
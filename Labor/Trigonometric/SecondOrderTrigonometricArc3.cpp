@@ -65,37 +65,32 @@ GLdouble SecondOrderTrigonometricArc3::f3_2(GLdouble t) const
 }
 
 
-SecondOrderTrigonometricArc3::SecondOrderTrigonometricArc3(GLdouble alpha, GLenum data_usage_flag): LinearCombination3(0.0, alpha, 4, data_usage_flag)
+SecondOrderTrigonometricArc3::SecondOrderTrigonometricArc3(GLdouble alpha, GLenum data_usage_flag): FixedLinearCombination3<4, 2>(0.0, alpha, data_usage_flag)
 {
     _alpha = alpha;
 }
 
-GLboolean SecondOrderTrigonometricArc3::BlendingFunctionValues(GLdouble u, RowMatrix<GLdouble> &values) const
+GLboolean SecondOrderTrigonometricArc3::BlendingFunctionDerivatives(GLuint max_order_of_derivatives, GLdouble u, BlendingValues &values) const
 {
-    values.ResizeColumns(4);
-
-    values[0] = f0(u);
-    values[1] = f1(u);
-    values[2] = f2(u);
-    values[3] = f3(u);
-
-    return GL_TRUE;
-}
-
-GLboolean SecondOrderTrigonometricArc3::CalculateDerivatives(GLuint max_order_of_derivatives, GLdouble u, Derivatives &d) const
-{
-    d.ResizeRows(max_order_of_derivatives + 1);
-    d.LoadNullVectors();
-
-    d[0] = f0(u) * _data[0] + f1(u) * _data[1] + f2(u) * _data[2] + f3(u) * _data[3];
+    values[0][0] = f0(u);
+    values[0][1] = f1(u);
+    values[0][2] = f2(u);
+    values[0][3] = f3(u);
 
     if(max_order_of_derivatives >= 1) {
-        d[1] = f0_1(u) * _data[0] + f1_1(u) * _data[1] + f2_1(u) * _data[2] + f3_1(u) * _data[3];
+        values[1][0] = f0_1(u);
+        values[1][1] = f1_1(u);
+        values[1][2] = f2_1(u);
+        values[1][3] = f3_1(u);
     }
 
     if(max_order_of_derivatives == 2) {
-        d[2] = f0_2(u) * _data[0] + f1_2(u) * _data[1] + f2_2(u) * _data[2] + f3_2(u) * _data[3];
+        values[2][0] = f0_2(u);
+        values[2][1] = f1_2(u);
+        values[2][2] = f2_2(u);
+        values[2][3] = f3_2(u);
     }
+
     return GL_TRUE;
 }
 
@@ -103,6 +98,7 @@ GLboolean SecondOrderTrigonometricArc3::SetAlpha(GLdouble alpha)
 {
     _u_max = alpha;
     _alpha = alpha;
+    _InvalidateCollocationMatrix();
     return GL_TRUE;
 }
 GLdouble SecondOrderTrigonometricArc3::GetAlpha() const
@@ -1,9 +1,9 @@
-#include <Core/LinearCombination3.h>
+#include <Core/FixedLinearCombinations3.h>
 #include <Core/Constants.h>
 
 namespace cagd
 {
-    class SecondOrderTrigonometricArc3: public LinearCombination3
+    class SecondOrderTrigonometricArc3: public FixedLinearCombination3<4, 2>
     {
     private:
         SecondOrderTrigonometricArc3 *lArc;
@@ -28,8 +28,7 @@ namespace cagd
     public:
         SecondOrderTrigonometricArc3(GLdouble alpha = PI / 2.0, GLenum data_usage_flag = GL_STATIC_DRAW);
 
-        GLboolean BlendingFunctionValues(GLdouble u, RowMatrix<GLdouble> &values) const;
-        GLboolean CalculateDerivatives(GLuint max_order_of_derivatives, GLdouble u, Derivatives& d) const;
+        GLboolean BlendingFunctionDerivatives(GLuint max_order_of_derivatives, GLdouble u, BlendingValues& values) const;
 
         GLboolean SetAlpha(GLdouble alpha);
         GLdouble GetAlpha() const;
@@ -66,144 +66,51 @@ GLdouble SecondOrderTrigonometricPatch3::f3_2(GLdouble alpha, GLdouble t) const
 
 
 
-SecondOrderTrigonometricPatch3::SecondOrderTrigonometricPatch3(GLdouble u, GLdouble v): TensorProductSurface3(0.0, u, 0.0, v) { _alpha[0] = u; _alpha[1] = v; }
+SecondOrderTrigonometricPatch3::SecondOrderTrigonometricPatch3(GLdouble u, GLdouble v): FixedTensorProductSurface3<4, 4, 2>(0.0, u, 0.0, v) { _alpha[0] = u; _alpha[1] = v; }
 
-GLboolean SecondOrderTrigonometricPatch3::UBlendingFunctionValues(GLdouble u_knot, RowMatrix<GLdouble> &blending_values) const
+GLboolean SecondOrderTrigonometricPatch3::_BlendingFunctionDerivatives(GLdouble alpha, GLuint maximum_order_of_derivatives, GLdouble t, UBlendingValues &values) const
 {
-    if (u_knot < 0.0 || u_knot > _alpha[0])
+    if (t < 0.0 || t > alpha)
         return GL_FALSE;
 
-    blending_values.ResizeColumns(4);
+    values[0][0] = f0(alpha, t);
+    values[0][1] = f1(alpha, t);
+    values[0][2] = f2(alpha, t);
+    values[0][3] = f3(alpha, t);
 
-    blending_values[0] = f0(_alpha[0], u_knot);
-    blending_values[1] = f1(_alpha[0], u_knot);
-    blending_values[2] = f2(_alpha[0], u_knot);
-    blending_values[3] = f3(_alpha[0], u_knot);
-
-    return GL_TRUE;
-}
-
-GLboolean SecondOrderTrigonometricPatch3::VBlendingFunctionValues(GLdouble v_knot, RowMatrix<GLdouble> &blending_values) const
-{
-    if (v_knot < 0.0 || v_knot > _alpha[1])
-        return GL_FALSE;
-
-    blending_values.ResizeColumns(4);
-
-    blending_values[0] = f0(_alpha[1], v_knot);
-    blending_values[1] = f1(_alpha[1], v_knot);
-    blending_values[2] = f2(_alpha[1], v_knot);
-    blending_values[3] = f3(_alpha[1], v_knot);
-
-    return GL_TRUE;
-}
-
-GLboolean SecondOrderTrigonometricPatch3::U1BlendingFunctionValues(GLdouble u_knot, RowMatrix<GLdouble> &blending_values) const
-{
-    if (u_knot < 0.0 || u_knot > _alpha[0])
-        return GL_FALSE;
-
-    blending_values.ResizeColumns(4);
-
-    blending_values[0] = f0_1(_alpha[0], u_knot);
-    blending_values[1] = f1_1(_alpha[0], u_knot);
-    blending_values[2] = f2_1(_alpha[0], u_knot);
-    blending_values[3] = f3_1(_alpha[0], u_knot);
-
-    return GL_TRUE;
-}
-
-GLboolean SecondOrderTrigonometricPatch3::V2BlendingFunctionValues(GLdouble v_knot, RowMatrix<GLdouble> &blending_values) const
-{
-    if (v_knot < 0.0 || v_knot > _alpha[1])
-        return GL_FALSE;
-
-    blending_values.ResizeColumns(4);
-
-    blending_values[0] = f0_2(_alpha[1], v_knot);
-    blending_values[1] = f1_2(_alpha[1], v_knot);
-    blending_values[2] = f2_2(_alpha[1], v_knot);
-    blending_values[3] = f3_2(_alpha[1], v_knot);
-
-    return GL_TRUE;
-}
-
-GLboolean SecondOrderTrigonometricPatch3::U2BlendingFunctionValues(GLdouble u_knot, RowMatrix<GLdouble> &blending_values) const
-{
-    if (u_knot < 0.0 || u_knot > _alpha[0])
-        return GL_FALSE;
-
-    blending_values.ResizeColumns(4);
+    if (maximum_order_of_derivatives >= 1)
+    {
+        values[1][0] = f0_1(alpha, t);
+        values[1][1] = f1_1(alpha, t);
+        values[1][2] = f2_1(alpha, t);
+        values[1][3] = f3_1(alpha, t);
+    }
 
-    blending_values[0] = f0_2(_alpha[0], u_knot);
-    blending_values[1] = f1_2(_alpha[0], u_knot);
-    blending_values[2] = f2_2(_alpha[0], u_knot);
-    blending_values[3] = f3_2(_alpha[0], u_knot);
+    if (maximum_order_of_derivatives >= 2)
+    {
+        values[2][0] = f0_2(alpha, t);
+        values[2][1] = f1_2(alpha, t);
+        values[2][2] = f2_2(alpha, t);
+        values[2][3] = f3_2(alpha, t);
+    }
 
     return GL_TRUE;
 }
 
-GLboolean SecondOrderTrigonometricPatch3::V1BlendingFunctionValues(GLdouble v_knot, RowMatrix<GLdouble> &blending_values) const
+GLboolean SecondOrderTrigonometricPatch3::UBlendingFunctionDerivatives(GLuint maximum_order_of_derivatives, GLdouble u_knot, UBlendingValues &values) const
 {
-    if (v_knot < 0.0 || v_knot > _alpha[1])
-        return GL_FALSE;
-
-    blending_values.ResizeColumns(4);
-
-    blending_values[0] = f0_1(_alpha[1], v_knot);
-    blending_values[1] = f1_1(_alpha[1], v_knot);
-    blending_values[2] = f2_1(_alpha[1], v_knot);
-    blending_values[3] = f3_1(_alpha[1], v_knot);
-
-    return GL_TRUE;
+    return _BlendingFunctionDerivatives(_alpha[0], maximum_order_of_derivatives, u_knot, values);
 }
 
-GLboolean SecondOrderTrigonometricPatch3::CalculatePartialDerivatives(GLuint maximum_order_of_partial_derivatives, GLdouble u, GLdouble v, PartialDerivatives &pd) const
+GLboolean SecondOrderTrigonometricPatch3::VBlendingFunctionDerivatives(GLuint maximum_order_of_derivatives, GLdouble v_knot, VBlendingValues &values) const
 {
-    if (u < 0.0 || u > _alpha[0] || v < 0.0 || v > _alpha[1] || maximum_order_of_partial_derivatives > 2) // 2
-        return GL_FALSE;
-
-    // Blending values + derivatives in dir. u
-    RowMatrix<GLdouble> u_blending_values(4), d1_u_blending_values(4), d2_u_blending_values(4);
-
-    UBlendingFunctionValues(u, u_blending_values);
-    U1BlendingFunctionValues(u, d1_u_blending_values);
-    U2BlendingFunctionValues(u, d2_u_blending_values);
-
-    // Same VooDoo magic, but with dir. v
-    RowMatrix<GLdouble> v_blending_values(4), d1_v_blending_values(4), d2_v_blending_values(4);
-
-    VBlendingFunctionValues(v, v_blending_values);
-    V1BlendingFunctionValues(v, d1_v_blending_values);
-    V2BlendingFunctionValues(v, d2_v_blending_values);
-
-    pd.ResizeRows(3); // 3
-    pd.LoadNullVectors();
-
-    for (GLuint row = 0; row < 4; ++row)
-    {
-        DCoordinate3 aux_d0_v, aux_d1_v, aux_d2_v;
-        for (GLuint column = 0; column < 4; ++column)
-        {
-            aux_d0_v += _data(row, column) * v_blending_values(column);
-            aux_d1_v += _data(row, column) * d1_v_blending_values(column);
-            aux_d2_v += _data(row, column) * d2_v_blending_values(column);
-        }
-        pd(0, 0) += aux_d0_v * u_blending_values(row);          // surface point
-        pd(1, 0) += aux_d0_v * d1_u_blending_values(row);       // 1st order dir. u partial
-        pd(1, 1) += aux_d1_v * u_blending_values(row);          // 1st order dir. v partial
-
-        pd(2, 0) += aux_d0_v * d2_u_blending_values[row];
-        pd(2, 1) += aux_d1_v * d1_u_blending_values[row];
-        pd(2, 2) += aux_d2_v * u_blending_values[row];
-    }
-
-    return GL_TRUE;
+    return _BlendingFunctionDerivatives(_alpha[1], maximum_order_of_derivatives, v_knot, values);
 }
 
 GLboolean SecondOrderTrigonometricPatch3::SetUAlpha(GLdouble alpha) {
     _alpha[0] = alpha;
     _u_max = alpha;
+    _InvalidateUCollocationMatrix();
     return GL_TRUE;
 }
 GLdouble SecondOrderTrigonometricPatch3::GetUAlpha() {
@@ -213,6 +120,7 @@ GLdouble SecondOrderTrigonometricPatch3::GetUAlpha() {
 GLboolean SecondOrderTrigonometricPatch3::SetVAlpha(GLdouble alpha) {
     _alpha[1] = alpha;
     _v_max = alpha;
+    _InvalidateVCollocationMatrix();
     return GL_TRUE;
 }
 GLdouble SecondOrderTrigonometricPatch3::GetVAlpha() {
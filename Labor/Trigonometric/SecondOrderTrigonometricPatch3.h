@@ -1,11 +1,11 @@
 #pragma once
 
-#include "../Core/TensorProductSurfaces3.h"
+#include "../Core/FixedTensorProductSurfaces3.h"
 #include "../Core/Constants.h"
 
 namespace cagd
 {
-    class SecondOrderTrigonometricPatch3: public TensorProductSurface3
+    class SecondOrderTrigonometricPatch3: public FixedTensorProductSurface3<4, 4, 2>
     {
     private:
         GLdouble _alpha[2]; // _alpha[0], _alpha[1], possible shape parameters in dir. u and v
@@ -25,16 +25,14 @@ namespace cagd
         GLdouble f2_2(GLdouble alpha, GLdouble t) const;
         GLdouble f3_2(GLdouble alpha, GLdouble t) const;
 
+        // derivatives of the blending functions that correspond to the shape parameter alpha
+        GLboolean _BlendingFunctionDerivatives(GLdouble alpha, GLuint maximum_order_of_derivatives, GLdouble t, UBlendingValues& values) const;
+
     public:
         SecondOrderTrigonometricPatch3(GLdouble u_alpha = PI / 2.0, GLdouble v_alpha = 1.0);
 
-        GLboolean UBlendingFunctionValues(GLdouble u_knot, RowMatrix<GLdouble>& blending_values) const;
-        GLboolean VBlendingFunctionValues(GLdouble v_knot, RowMatrix<GLdouble>& blending_values) const;
-        GLboolean U1BlendingFunctionValues(GLdouble u_knot, RowMatrix<GLdouble>& blending_values) const;
-        GLboolean V1BlendingFunctionValues(GLdouble v_knot, RowMatrix<GLdouble>& blending_values) const;
-        GLboolean U2BlendingFunctionValues(GLdouble u_knot, RowMatrix<GLdouble>& blending_values) const;
-        GLboolean V2BlendingFunctionValues(GLdouble v_knot, RowMatrix<GLdouble>& blending_values) const;
-        GLboolean CalculatePartialDerivatives(GLuint maximum_order_of_partial_derivatives, GLdouble u, GLdouble v, PartialDerivatives& pd) const;
+        GLboolean UBlendingFunctionDerivatives(GLuint maximum_order_of_derivatives, GLdouble u_knot, UBlendingValues& values) const;
+        GLboolean VBlendingFunctionDerivatives(GLuint maximum_order_of_derivatives, GLdouble v_knot, VBlendingValues& values) const;
 
         GLboolean SetUAlpha(GLdouble alpha);
         GLdouble GetUAlpha();
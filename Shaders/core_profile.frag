@@ -0,0 +1,61 @@
+#version 330 core
+
+// color of unlit primitives
+uniform vec4 color;
+
+// directional light source (the position is given in eye coordinates) and front face material
+uniform int   lighting;
+uniform vec4  light_position;
+uniform vec4  light_ambient;
+uniform vec4  light_diffuse;
+uniform vec4  light_specular;
+uniform vec4  global_ambient;
+
+uniform vec4  material_ambient;
+uniform vec4  material_diffuse;
+uniform vec4  material_specular;
+uniform vec4  material_emissive;
+uniform float material_shininess;
+
+// the texture of unit 0 modulates the color
+uniform int       texturing;
+uniform sampler2D texture_unit;
+
+in vec3 eye_normal;
+in vec3 eye_position;
+in vec4 fragment_texture_coordinate;
+
+out vec4 fragment_color;
+
+// the same directional lighting as the fixed-function pipeline computes for the light source 0
+void main()
+{
+    vec4 result = color;
+
+    if (lighting != 0)
+    {
+        vec3 n = normalize(eye_normal);
+        vec3 light_direction = normalize(light_position.xyz);
+
+        result = material_emissive + material_ambient * (global_ambient + light_ambient);
+
+        float n_dot_l = max(dot(n, light_direction), 0.0);
+
+        if (n_dot_l > 0.0)
+        {
+            vec3 half_vector = normalize(light_direction - normalize(eye_position));
+
+            result += material_diffuse * light_diffuse * n_dot_l;
+            result += material_specular * light_specular * pow(max(dot(n, half_vector), 0.0), material_shininess);
+        }
+
+        result.a = material_diffuse.a;
+    }
+
+    if (texturing != 0)
+    {
+        result *= textureProj(texture_unit, fragment_texture_coordinate);
+    }
+
+    fragment_color = result;
+}
@@ -0,0 +1,25 @@
+#version 330 core
+
+// vertex attributes of the core profile rendering path (see GPU/RenderBackends.h)
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec3 normal;
+layout(location = 2) in vec4 texture_coordinate;
+
+uniform mat4 model_view_matrix;
+uniform mat4 projection_matrix;
+uniform mat3 normal_matrix;
+
+out vec3 eye_normal;
+out vec3 eye_position;
+out vec4 fragment_texture_coordinate;
+
+void main()
+{
+    vec4 eye = model_view_matrix * vec4(position, 1.0);
+
+    eye_normal                  = normal_matrix * normal;
+    eye_position                = eye.xyz;
+    fragment_texture_coordinate = texture_coordinate;
+
+    gl_Position = projection_matrix * eye;
+}
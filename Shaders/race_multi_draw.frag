@@ -0,0 +1,66 @@
+#version 430 compatibility
+
+struct Draw
+{
+    mat4 model_view;
+    mat4 normal_matrix;
+    vec4 color;
+    vec4 parameters;
+};
+
+// front face properties of the materials
+struct Material
+{
+    vec4 ambient;
+    vec4 diffuse;
+    vec4 specular;
+    vec4 emissive;
+    vec4 shininess;     // x: shininess
+};
+
+layout(std430, binding = 0) readonly buffer Draws
+{
+    Draw draws[];
+};
+
+layout(std430, binding = 1) readonly buffer Materials
+{
+    Material materials[];
+};
+
+in vec3 normal;
+in vec3 eye_position;
+flat in uint draw_index;
+
+// the same directional lighting as the fixed-function pipeline computes for the light source 0
+void main()
+{
+    int material_index = int(draws[draw_index].parameters.x);
+
+    if (material_index < 0)
+    {
+        gl_FragColor = draws[draw_index].color;
+        return;
+    }
+
+    Material material = materials[material_index];
+
+    vec3 n = normalize(normal);
+    vec3 light_direction = normalize(vec3(gl_LightSource[0].position));
+
+    vec4 color = material.emissive
+               + material.ambient * (gl_LightModel.ambient + gl_LightSource[0].ambient);
+
+    float n_dot_l = max(dot(n, light_direction), 0.0);
+
+    if (n_dot_l > 0.0)
+    {
+        vec3 half_vector = normalize(light_direction - normalize(eye_position));
+
+        color += material.diffuse * gl_LightSource[0].diffuse * n_dot_l;
+        color += material.specular * gl_LightSource[0].specular *
+                 pow(max(dot(n, half_vector), 0.0), material.shininess.x);
+    }
+
+    gl_FragColor = vec4(color.rgb, material.diffuse.a);
+}
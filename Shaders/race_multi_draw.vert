@@ -0,0 +1,33 @@
+#version 430 compatibility
+
+// per-draw data of the RenderQueue (see GPU/RenderQueues.cpp), the index of the draw is the instance
+// attribute draw_id, the value of which is the base instance of the indirect draw command
+struct Draw
+{
+    mat4 model_view;
+    mat4 normal_matrix;
+    vec4 color;
+    vec4 parameters;    // x: index of the material, or -1 for unlit draws
+};
+
+layout(std430, binding = 0) readonly buffer Draws
+{
+    Draw draws[];
+};
+
+layout(location = 1) in uint draw_id;
+
+out vec3 normal;
+out vec3 eye_position;
+flat out uint draw_index;
+
+void main()
+{
+    vec4 eye = draws[draw_id].model_view * gl_Vertex;
+
+    normal       = mat3(draws[draw_id].normal_matrix) * gl_Normal;
+    eye_position = eye.xyz;
+    draw_index   = draw_id;
+
+    gl_Position  = gl_ProjectionMatrix * eye;
+}